@@ -6,7 +6,7 @@
 
 int main(int argc, char ** argv){
 
-    int socket;
+    int socket(0);
     ExtCtrl::Location des_loc;
 
     des_loc.x = 0.;
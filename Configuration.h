@@ -0,0 +1,12 @@
+#ifndef CTRL_CONFIG_H
+#define CTRL_CONFIG_H
+
+#define THIS_COM "/root/repo/"
+
+#define PORT_EXT_CTRL         61123
+#define PORT_DATA_SETUP        61124
+#define PORT_DATA_RECEIVE      61125
+
+#define IP_ADDR_MYSELF "127.0.0.1"
+
+#endif
@@ -86,7 +86,7 @@ void BodyCtrl::OneStep(void* _cmd){
 
 void BodyCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
     // WBLC
-    wblc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(atlas::num_virtual, atlas::num_act_joint))
@@ -170,6 +170,7 @@ void BodyCtrl::CtrlInitialization(const std::string & setting_file_name){
     jpos_ini_ = sp_->Q_.segment(atlas::num_virtual, atlas::num_act_joint);
 
     ParamHandler handler(AtlasConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
 
     std::vector<double> tmp_vec;
     // Feedback Gain
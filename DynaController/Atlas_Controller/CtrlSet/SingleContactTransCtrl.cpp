@@ -89,7 +89,7 @@ void SingleContactTransCtrl::OneStep(void* _cmd){
 
 void SingleContactTransCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
 
-    wblc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(atlas::num_virtual, atlas::num_act_joint))
@@ -242,6 +242,7 @@ bool SingleContactTransCtrl::EndOfPhase(){
 void SingleContactTransCtrl::CtrlInitialization(const std::string & setting_file_name){
     std::vector<double> tmp_vec;
     ParamHandler handler(AtlasConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
     handler.getValue("max_rf_z", max_rf_z_);
     handler.getValue("min_rf_z", min_rf_z_);
 
@@ -91,7 +91,7 @@ void BodyFootPlanningCtrl::_contact_setup(){
 }
 
 void BodyFootPlanningCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    wblc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(cheetah3::num_virtual, cheetah3::num_act_joint))
@@ -273,6 +273,7 @@ void BodyFootPlanningCtrl::CtrlInitialization(
 
     // Setting Parameters
     ParamHandler handler(Cheetah3ConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
     handler.getValue("swing_height", swing_height_);
     handler.getValue("push_down_height", push_down_height_);
 
@@ -321,9 +322,7 @@ void BodyFootPlanningCtrl::_GetBsplineSwingTrajectory(){
     double vel[3];
     double acc[3];
 
-    foot_traj_.getCurvePoint(state_machine_time_, pos);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 1, vel);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 2, acc);
+    foot_traj_.getCurvePosVelAcc(state_machine_time_, pos, vel, acc);
 
     for(int i(0); i<3; ++i){
         curr_foot_pos_des_[i] = pos[i];
@@ -7,6 +7,14 @@
 #include <RobotSystems/RobotSystem.hpp>
 #include <Task.hpp>
 #include <ContactSpec.hpp>
+#include <WBC.hpp>
+#include <ParamHandler/ParamHandler.hpp>
+
+// Settings a controller reads from its setting file, built by
+// Controller::LoadParam and not modified afterwards
+struct CtrlParam{
+  virtual ~CtrlParam(){}
+};
 
 class Controller{
 public:
@@ -19,17 +27,43 @@ public:
   virtual bool EndOfPhase() = 0;
   virtual void CtrlInitialization(const std::string & setting_file_name) = 0;
 
+  // Reads the settings that can be hot reloaded (NULL: none). Throws when a
+  // key is missing or has the wrong size. It only reads the file, so the
+  // ParamWatcher thread calls it for a reload.
+  virtual const CtrlParam* LoadParam(const std::string & setting_file_name) const {
+    return NULL;
+  }
+  // Settings from LoadParam; copies into the members sized at construction
+  virtual void SetParam(const CtrlParam & param){}
+
 protected:
+  // Optional qp_solver key (QP_Solver::getType names) and stopping rules
+  // (QP_Solver::setStoppingRule) of the setting file; exits on an unknown name
+  void _SetQPSolver(ParamHandler & handler, WBC* wbc){
+    if(handler.hasKey("qp_solver")){
+      std::string name;
+      QP_Solver::Type type;
+      handler.getString("qp_solver", name);
+      if(!QP_Solver::getType(name, type)){
+        printf("[Error] unknown qp_solver: %s\n", name.c_str());
+        exit(0);
+      }
+      wbc->setQPSolver(type);
+    }
+    wbc->getQPSolver()->setStoppingRule(handler);
+  }
+
   void _DynConsistent_Inverse(const dynacore::Matrix & J, dynacore::Matrix & Jinv){
-      dynacore::Matrix Jtmp(J * Ainv_ * J.transpose());
+      dynacore::Matrix Jtmp, AinvJt;
+      A_ltl_.inverseGram(J, Jtmp, AinvJt);
       dynacore::Matrix Jtmp_inv;
       dynacore::pseudoInverse(Jtmp, 0.0001, Jtmp_inv, 0);
-      Jinv = Ainv_ * J.transpose() * Jtmp_inv;
+      Jinv = AinvJt * Jtmp_inv;
   }
 
   void _PreProcessing_Command(){
       robot_sys_->getMassInertia(A_);
-      robot_sys_->getInverseMassInertia(Ainv_);
+      robot_sys_->getMassInertiaFactor(A_ltl_);
       robot_sys_->getGravity(grav_);
       robot_sys_->getCoriolis(coriolis_);
 
@@ -46,7 +80,7 @@ protected:
   const RobotSystem* robot_sys_;
 
   dynacore::Matrix A_;
-  dynacore::Matrix Ainv_;
+  dynacore::TreeLTL A_ltl_; // A = L^T L, used for Ainv
   dynacore::Vector grav_;
   dynacore::Vector coriolis_;
 
@@ -3,6 +3,7 @@
 #include <DracoBip_Controller/DracoBip_StateProvider.hpp>
 #include <ParamHandler/ParamHandler.hpp>
 #include <Planner/PIPM_FootPlacementPlanner/Reversal_LIPM_Planner.hpp>
+#include <Planner/PIPM_FootPlacementPlanner/PlanningService.hpp>
 #include <Utils/utilities.hpp>
 #include <WBLC/KinWBC.hpp>
 #include <WBLC/WBLC.hpp>
@@ -22,8 +23,15 @@ BodyFootPlanningCtrl::BodyFootPlanningCtrl(
     des_jvel_(dracobip::num_act_joint),
     des_jacc_(dracobip::num_act_joint),
     Kp_(dracobip::num_act_joint),
-    Kd_(dracobip::num_act_joint)
+    Kd_(dracobip::num_act_joint),
+    b_planning_started_(false),
+    b_planning_requested_(false),
+    planning_request_time_(0.),
+    planning_deadline_(0.)
 {
+    planning_service_ = new PlanningService(planner);
+    planning_service_->start();
+
     des_jacc_.setZero();
     rfoot_contact_ = new ContactType(robot_sys_, dracobip_link::rAnkle);
     lfoot_contact_ = new ContactType(robot_sys_, dracobip_link::lAnkle);
@@ -112,14 +120,7 @@ void BodyFootPlanningCtrl::_contact_setup(){
 }
 
 void BodyFootPlanningCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<dracobip::num_act_joint; ++i){
-        A_rotor(i + dracobip::num_virtual, i + dracobip::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(dracobip::num_virtual, dracobip::num_act_joint))
@@ -223,23 +224,41 @@ void BodyFootPlanningCtrl::_task_setup(){
 
 void BodyFootPlanningCtrl::_CheckPlanning(){
     if( (state_machine_time_ > 0.5 * end_time_) && b_replanning_ && !b_replaned_) {
+        // Solved by the planning service thread and applied on a later tick.
+        // The deadline runs from the first try, so a worker that is still
+        // busy with a cancelled request cannot hold the planning either.
+        if(!b_planning_started_){
+            b_planning_started_ = true;
+            planning_request_time_ = state_machine_time_;
+            b_planning_requested_ = _RequestReplanning();
+            return;
+        }
         dynacore::Vect3 target_loc;
-        _Replanning(target_loc);
-
-        dynacore::Vect3 target_offset;
-        // X, Y target is originally set by intial_traget_loc
-        for(int i(0); i<2; ++i)
-            target_offset[i] = target_loc[i] - initial_target_loc_[i];
-
-        // Foot height (z) is set by the initial height
-        target_offset[2] = 0.; //target_loc[2] - ini_foot_pos_[2];
-
-        _SetMinJerkOffset(target_offset);
-        b_replaned_ = true;
+        OutputReversalPL pl_output;
+        if(b_planning_requested_ && planning_service_->getResult(target_loc, pl_output)){
+            _Replanning(target_loc, pl_output);
+
+            dynacore::Vect3 target_offset;
+            // X, Y target is originally set by intial_traget_loc
+            for(int i(0); i<2; ++i)
+                target_offset[i] = target_loc[i] - initial_target_loc_[i];
+
+            // Foot height (z) is set by the initial height
+            target_offset[2] = 0.; //target_loc[2] - ini_foot_pos_[2];
+
+            _SetMinJerkOffset(target_offset);
+            b_replaned_ = true;
+        }else if(state_machine_time_ - planning_request_time_ > planning_deadline_){
+            // Too late: keep the nominal target
+            planning_service_->Cancel();
+            b_replaned_ = true;
+        }else if(!b_planning_requested_){
+            b_planning_requested_ = _RequestReplanning();
+        }
     }
 }
 
-void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
+bool BodyFootPlanningCtrl::_RequestReplanning(){
     dynacore::Vect3 com_pos, com_vel;
     // Direct value used
     robot_sys_->getCoMPosition(com_pos);
@@ -255,12 +274,9 @@ void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
 
         // com_pos[i] = sp_->jjpos_body_pos_[i] + body_pt_offset_[i];
     }
-    printf("planning com state: %f, %f, %f, %f\n",
-            com_pos[0], com_pos[1],
-            com_vel[0], com_vel[1]);
-
-    OutputReversalPL pl_output;
     ParamReversalPL pl_param;
+    // the rest of the deadline is for the worker wake up and the pickup
+    pl_param.time_budget = 0.5 * planning_deadline_;
     pl_param.swing_time = end_time_ - state_machine_time_
         + transition_time_ * transition_phase_ratio_
         + stance_time_ * double_stance_ratio_;
@@ -277,10 +293,12 @@ void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
 
     dynacore::Vect3 tmp_global_pos_local = sp_->global_pos_local_;
 
-    planner_->getNextFootLocation(com_pos + tmp_global_pos_local,
-            com_vel,
-            target_loc,
-            &pl_param, &pl_output);
+    return planning_service_->Request(com_pos + tmp_global_pos_local,
+            com_vel, pl_param);
+}
+
+void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc,
+        const OutputReversalPL & pl_output){
     // Time Modification
     replan_moment_ = state_machine_time_;
     end_time_ += pl_output.time_modification;
@@ -292,11 +310,13 @@ void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
     for(int i(0); i<2; ++i){
         target_loc[i] += foot_landing_offset_[i];
     }
-    dynacore::pretty_print(target_loc, std::cout, "next foot loc");
 }
 
 void BodyFootPlanningCtrl::FirstVisit(){
     b_replaned_ = false;
+    b_planning_started_ = false;
+    b_planning_requested_ = false;
+    planning_service_->Cancel();
     ini_config_ = sp_->Q_;
     robot_sys_->getPos(dracobip_link::torso, ini_body_pos_);
     robot_sys_->getPos(swing_foot_, ini_foot_pos_);
@@ -374,6 +394,8 @@ void BodyFootPlanningCtrl::CtrlInitialization(
 
     // Setting Parameters
     ParamHandler handler(DracoBipConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
+    planning_deadline_ = ((Reversal_LIPM_Planner*)planner_)->getPlanningDeadline();
     handler.getValue("swing_height", swing_height_);
     handler.getValue("push_down_height", push_down_height_);
 
@@ -412,6 +434,7 @@ void BodyFootPlanningCtrl::CtrlInitialization(
 }
 
 BodyFootPlanningCtrl::~BodyFootPlanningCtrl(){
+    delete planning_service_;
     delete wblc_;
     delete lfoot_contact_;
     delete rfoot_contact_;
@@ -422,9 +445,7 @@ void BodyFootPlanningCtrl::_GetBsplineSwingTrajectory(){
     double vel[3];
     double acc[3];
 
-    foot_traj_.getCurvePoint(state_machine_time_, pos);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 1, vel);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 2, acc);
+    foot_traj_.getCurvePosVelAcc(state_machine_time_, pos, vel, acc);
 
     for(int i(0); i<3; ++i){
         curr_foot_pos_des_[i] = pos[i];
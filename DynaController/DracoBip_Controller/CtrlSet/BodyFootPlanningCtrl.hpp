@@ -5,6 +5,9 @@
 #include <Utils/minjerk_one_dim.hpp>
 #include <Utils/BSplineBasic.h>
 
+class PlanningService;
+class OutputReversalPL;
+
 class KinWBC;
 
 class BodyFootPlanningCtrl:public SwingPlanningCtrl{
@@ -30,7 +33,17 @@ class BodyFootPlanningCtrl:public SwingPlanningCtrl{
         WBDC_ContactSpec* lfoot_contact_;
 
         void _CheckPlanning();
-        void _Replanning(dynacore::Vect3 & target_loc);
+        bool _RequestReplanning();
+        void _Replanning(dynacore::Vect3 & target_loc,
+                const OutputReversalPL & pl_output);
+
+        PlanningService* planning_service_;
+        bool b_planning_started_;
+        bool b_planning_requested_; // accepted by the planning service
+        double planning_request_time_; // of the first try
+        // (sec) nominal target is kept after this, Reversal_LIPM_Planner::getPlanningDeadline
+        double planning_deadline_;
+
         void _contact_setup();
         void _task_setup();
         void _compute_torque_wblc(dynacore::Vector & gamma);
@@ -70,16 +70,9 @@ void CoMCtrl::OneStep(void* _cmd){
 
 void CoMCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
     // WBLC
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<dracobip::num_act_joint; ++i){
-        A_rotor(i + dracobip::num_virtual, i + dracobip::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
     std::vector<Task*> dummy_task_list_;
 
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(dracobip::num_virtual, dracobip::num_act_joint))
@@ -171,6 +164,7 @@ bool CoMCtrl::EndOfPhase(){
 void CoMCtrl::CtrlInitialization(const std::string & setting_file_name){
     jpos_ini_ = sp_->Q_.segment(dracobip::num_virtual, dracobip::num_act_joint);
     ParamHandler handler(DracoBipConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
 
     std::vector<double> tmp_vec;
     // Feedback Gain
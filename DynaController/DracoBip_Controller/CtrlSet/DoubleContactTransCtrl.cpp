@@ -81,14 +81,7 @@ void DoubleContactTransCtrl::OneStep(void* _cmd){
 }
 
 void DoubleContactTransCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<dracobip::num_act_joint; ++i){
-        A_rotor(i + dracobip::num_virtual, i + dracobip::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(dracobip::num_virtual, dracobip::num_act_joint))
@@ -152,7 +145,6 @@ void DoubleContactTransCtrl::_task_setup(){
     task_list_.push_back(selected_joint_task_);
     task_list_.push_back(base_task_);
 
-    kin_wbc_->Ainv_ = Ainv_;
     kin_wbc_->FindConfiguration(sp_->Q_, task_list_, contact_list_, 
             des_jpos_, des_jvel_, des_jacc_);
     //dynacore::pretty_print(sp_->Q_, std::cout, "curr_config");
@@ -201,6 +193,7 @@ bool DoubleContactTransCtrl::EndOfPhase(){
 void DoubleContactTransCtrl::CtrlInitialization(const std::string & setting_file_name){
     ini_jpos_ = sp_->Q_.segment(dracobip::num_virtual, dracobip::num_act_joint);
     ParamHandler handler(DracoBipConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
     handler.getValue("max_rf_z", max_rf_z_);
     handler.getValue("min_rf_z", min_rf_z_);
     // Feedback Gain
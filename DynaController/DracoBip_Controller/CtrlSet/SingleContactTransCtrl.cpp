@@ -86,14 +86,7 @@ void SingleContactTransCtrl::OneStep(void* _cmd){
 }
 
 void SingleContactTransCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<dracobip::num_act_joint; ++i){
-        A_rotor(i + dracobip::num_virtual, i + dracobip::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(dracobip::num_virtual, dracobip::num_act_joint))
@@ -243,6 +236,7 @@ bool SingleContactTransCtrl::EndOfPhase(){
 void SingleContactTransCtrl::CtrlInitialization(const std::string & setting_file_name){
     std::vector<double> tmp_vec;
     ParamHandler handler(DracoBipConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
     handler.getValue("max_rf_z", max_rf_z_);
     handler.getValue("min_rf_z", min_rf_z_);
 
@@ -12,6 +12,7 @@ DracoBip_MoCapManager::DracoBip_MoCapManager(const RobotSystem* robot):dynacore_
     led_kin_data_(3*NUM_MARKERS),
     led_pos_raw_data_(3*NUM_MARKERS),
     body_quat_(1.0, 0., 0., 0. ),
+    body_led_filter_(9, 2.*M_PI*50, dracobip::servo_rate),
     initialization_duration_(0.5),
     b_update_call_(false)
 {
@@ -33,12 +34,6 @@ DracoBip_MoCapManager::DracoBip_MoCapManager(const RobotSystem* robot):dynacore_
 
     sp_ = DracoBip_StateProvider::getStateProvider();
 
-    for(int i(0); i<3; ++i){
-        body_led0_filter_.push_back(new digital_lp_filter(2.*M_PI*50, dracobip::servo_rate));
-        body_led1_filter_.push_back(new digital_lp_filter(2.*M_PI*50, dracobip::servo_rate));
-        body_led2_filter_.push_back(new digital_lp_filter(2.*M_PI*50, dracobip::servo_rate));
-    }
-
     //printf("[Mo Cap Manager] Constructed\n");
 }
 
@@ -124,17 +119,13 @@ dynacore::Matrix DracoBip_MoCapManager::_GetOrientation(const dynacore::Vect3 &b
         const dynacore::Vect3 &b1_raw,
         const dynacore::Vect3 &b2_raw) {
 
-    dynacore::Vect3 b0, b1, b2;
+    Eigen::Matrix<double, 9, 1> led_raw;
+    led_raw << b0_raw, b1_raw, b2_raw;
+    body_led_filter_.input(led_raw);
 
-    for(int i(0); i<3; ++i){
-        body_led0_filter_[i]->input(b0_raw[i]);
-        body_led1_filter_[i]->input(b1_raw[i]);
-        body_led2_filter_[i]->input(b2_raw[i]);
-
-        b0[i] = body_led0_filter_[i]->output();
-        b1[i] = body_led1_filter_[i]->output();
-        b2[i] = body_led2_filter_[i]->output();    
-    }
+    dynacore::Vect3 b0 = body_led_filter_.output().segment<3>(0);
+    dynacore::Vect3 b1 = body_led_filter_.output().segment<3>(3);
+    dynacore::Vect3 b2 = body_led_filter_.output().segment<3>(6);
     
 
     dynacore::Vect3 normal;
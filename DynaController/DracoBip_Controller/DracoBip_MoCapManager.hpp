@@ -4,7 +4,7 @@
 #include <Utils/dynacore_pThread.hpp>
 #include <Utils/wrap_eigen.hpp>
 #include <DracoBip_Controller/StateEstimator/BodyEstimator.hpp>
-#include <Filter/filters.hpp>
+#include <Filter/filter_bank.hpp>
 
 class DracoBip_StateProvider;
 class RobotSystem;
@@ -43,9 +43,8 @@ class DracoBip_MoCapManager: public dynacore_pThread{
     protected:
         std::vector<dynacore::Vect3> healthy_led_list_;
 
-        std::vector<filter*> body_led0_filter_;
-        std::vector<filter*> body_led1_filter_;
-        std::vector<filter*> body_led2_filter_;
+        // x, y, z of the three body LEDs
+        digital_lp_filter_bank body_led_filter_;
 
         double initialization_duration_;
         dynacore::Vect3 offset_;
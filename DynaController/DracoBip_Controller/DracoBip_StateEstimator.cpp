@@ -6,26 +6,23 @@
 
 #include <DracoBip_Controller/StateEstimator/BasicAccumulation.hpp>
 #include <DracoBip_Controller/StateEstimator/BodyEstimator.hpp>
-#include <Filter/filters.hpp>
 
 DracoBip_StateEstimator::DracoBip_StateEstimator(RobotSystem* robot):
     curr_config_(dracobip::num_q),
-    curr_qdot_(dracobip::num_qdot)
+    curr_qdot_(dracobip::num_qdot),
+    mocap_vel_est_(2, dracobip::servo_rate, 0.01, 1.0)
 {
     sp_ = DracoBip_StateProvider::getStateProvider();
     robot_sys_ = robot;
     ori_est_ = new BasicAccumulation();
     
-    mocap_x_vel_est_ = new AverageFilter(dracobip::servo_rate, 0.01, 1.0);
-    mocap_y_vel_est_ = new AverageFilter(dracobip::servo_rate, 0.01, 1.5);
+    mocap_vel_est_.setLimit(1, 1.5);
     body_est_ = new BodyEstimator(robot);
 }
 
 DracoBip_StateEstimator::~DracoBip_StateEstimator(){
     delete ori_est_;
     delete body_est_;
-    delete mocap_x_vel_est_;
-    delete mocap_y_vel_est_;
 }
 
 void DracoBip_StateEstimator::Initialization(DracoBip_SensorData* data){
@@ -158,10 +155,9 @@ void DracoBip_StateEstimator::Update(DracoBip_SensorData* data){
     dynacore::Vect3 mocap_body_vel;
     body_est_->Update();
     body_est_->getMoCapBodyVel(mocap_body_vel);
-    mocap_x_vel_est_->input(mocap_body_vel[0]);
-    mocap_y_vel_est_->input(mocap_body_vel[1]);
+    mocap_vel_est_.input(mocap_body_vel.head<2>());
 
-    sp_->est_mocap_body_vel_[0] = mocap_x_vel_est_->output();
-    sp_->est_mocap_body_vel_[1] = mocap_y_vel_est_->output();
+    sp_->est_mocap_body_vel_[0] = mocap_vel_est_.output(0);
+    sp_->est_mocap_body_vel_[1] = mocap_vel_est_.output(1);
 }
 
@@ -3,12 +3,12 @@
 
 #include <Configuration.h>
 #include <Utils/wrap_eigen.hpp>
+#include <Filter/filter_bank.hpp>
 
 class DracoBip_StateProvider;
 class RobotSystem;
 class BasicAccumulation;
 class DracoBip_SensorData;
-class filter;
 class BodyEstimator;
 
 class DracoBip_StateEstimator{
@@ -31,8 +31,7 @@ class DracoBip_StateEstimator{
 
         BasicAccumulation* ori_est_;
         BodyEstimator* body_est_;
-        filter* mocap_x_vel_est_;
-        filter* mocap_y_vel_est_;
+        AverageFilterBank mocap_vel_est_; // x, y
 
         void _RBDL_TEST();
 };
@@ -151,6 +151,13 @@ bool DracoBip_interface::_Initialization(DracoBip_SensorData* data, DracoBip_Com
 
 void DracoBip_interface::_ParameterSetting(){
     ParamHandler handler(DracoBipConfigPath"INTERFACE_setup.yaml");
+    // reflected rotor inertia of the joints, part of the model mass matrix
+    if(handler.hasKey("rotor_inertia")){
+        dynacore::Vector rotor_inertia;
+        handler.getVector("rotor_inertia", rotor_inertia);
+        ((DracoBip_Model*)robot_sys_)->setRotorInertia(rotor_inertia);
+    }
+
     std::string tmp_string;
     bool b_tmp;
     // Test SETUP
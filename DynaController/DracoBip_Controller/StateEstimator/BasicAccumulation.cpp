@@ -4,16 +4,14 @@
 #include <Utils/DataManager.hpp>
 #include <DracoBip/DracoBip_Definition.h>
 
-BasicAccumulation::BasicAccumulation():filtered_acc_(3){
+BasicAccumulation::BasicAccumulation():filtered_acc_(3, 0., dracobip::servo_rate){
     global_ori_.w() = 1.;
     global_ori_.x() = 0.;
     global_ori_.y() = 0.;
     global_ori_.z() = 0.;
 
     cutoff_freq_ = 2.0* M_PI *1.0; // 1Hz // (2*pi*frequency) rads/s 
-    for(int i(0); i<3; ++i){
-        filtered_acc_[i] = new digital_lp_filter(cutoff_freq_, dracobip::servo_rate);
-    }
+    filtered_acc_.setCutoff(cutoff_freq_);
     global_ang_vel_.setZero();
 }
 void BasicAccumulation::EstimatorInitialization(      
@@ -22,8 +20,8 @@ void BasicAccumulation::EstimatorInitialization(
 
     for(int i(0); i<3; ++i){
         global_ang_vel_[i] = ang_vel[i];
-        filtered_acc_[i]->input(acc[i]);
     }
+    filtered_acc_.input(Eigen::Map<const dynacore::Vector>(&acc[0], 3));
     _InitIMUOrientationEstimateFromGravity();
 }
 
@@ -51,7 +49,7 @@ void BasicAccumulation::_InitIMUOrientationEstimateFromGravity(){
     for(int i(0); i<3; ++i){
         // We expect a negative number if gravity is pointing opposite of 
         // the IMU direction
-        g_B[i] = filtered_acc_[i]->output();
+        g_B[i] = filtered_acc_.output(i);
     }
     // Test Vector  ////////////////////////
     //g_B[0] = 0.1; g_B[1] = 0.4; g_B[2] = 0.5;
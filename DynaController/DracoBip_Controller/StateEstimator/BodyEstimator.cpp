@@ -5,7 +5,8 @@
 #include <DracoBip/DracoBip_Model.hpp>
 #include <DracoBip_Controller/DracoBip_StateProvider.hpp>
 
-BodyEstimator::BodyEstimator(const RobotSystem* robot)
+BodyEstimator::BodyEstimator(const RobotSystem* robot):
+    vel_filter_(3, 2.*50.*M_PI, dracobip::servo_rate)
 {
     mocap_manager_ = new DracoBip_MoCapManager(robot);
     mocap_manager_->start();
@@ -13,9 +14,6 @@ BodyEstimator::BodyEstimator(const RobotSystem* robot)
     robot_sys_ = robot;
 
     body_led_vel_.setZero();
-    for(int i(0); i<3 ; ++i){
-        vel_filter_.push_back(new deriv_lp_filter(2.*50.*M_PI, dracobip::servo_rate));
-    }
 
     DataManager::GetDataManager()->RegisterData(&body_led_vel_, VECT3, "Body_LED_vel", 3);
     sp_ = DracoBip_StateProvider::getStateProvider();
@@ -38,10 +36,8 @@ void BodyEstimator::getMoCapBodyPos(const dynacore::Quaternion& body_ori,
 }
 
 void BodyEstimator::Update(){
-    for(int i(0); i<3; ++i){
-        vel_filter_[i]->input(mocap_manager_->led_pos_data_[i]);
-        body_led_vel_[i] = vel_filter_[i]->output();
-    }
+    vel_filter_.input(mocap_manager_->led_pos_data_.head<3>());
+    body_led_vel_ = vel_filter_.output();
 }
 
 
@@ -2,7 +2,7 @@
 #define BODY_ESTIMATOR_DRACO_BIPED
 
 #include <Utils/wrap_eigen.hpp>
-#include <Filter/filters.hpp>
+#include <Filter/filter_bank.hpp>
 
 class DracoBip_MoCapManager;
 class RobotSystem;
@@ -27,7 +27,7 @@ class BodyEstimator{
         DracoBip_MoCapManager* mocap_manager_;
         DracoBip_StateProvider* sp_;
 
-        std::vector<filter*> vel_filter_;
+        deriv_lp_filter_bank vel_filter_;
         dynacore::Vect3 body_led_vel_;
 
         const RobotSystem* robot_sys_;
@@ -3,6 +3,7 @@
 #include <Mercury_Controller/Mercury_StateProvider.hpp>
 #include <ParamHandler/ParamHandler.hpp>
 #include <Planner/PIPM_FootPlacementPlanner/Reversal_LIPM_Planner.hpp>
+#include <Planner/PIPM_FootPlacementPlanner/PlanningService.hpp>
 #include <Utils/utilities.hpp>
 #include <WBLC/KinWBC.hpp>
 #include <WBLC/WBLC.hpp>
@@ -10,6 +11,7 @@
 #include <Mercury_Controller/TaskSet/BaseTask.hpp>
 #include <Mercury_Controller/TaskSet/FullBaseTask.hpp>
 #include <Mercury_Controller/TaskSet/FootTask.hpp>
+#include <memory>
 
 ConfigBodyFootPlanningCtrl::ConfigBodyFootPlanningCtrl(
         const RobotSystem* robot, int swing_foot, Planner* planner):
@@ -20,8 +22,15 @@ ConfigBodyFootPlanningCtrl::ConfigBodyFootPlanningCtrl(
     des_jacc_(mercury::num_act_joint),
     waiting_time_limit_(0.0),
     Kp_(mercury::num_act_joint),
-    Kd_(mercury::num_act_joint)
+    Kd_(mercury::num_act_joint),
+    b_planning_started_(false),
+    b_planning_requested_(false),
+    planning_request_time_(0.),
+    planning_deadline_(0.)
 {
+    planning_service_ = new PlanningService(planner);
+    planning_service_->start();
+
     des_jacc_.setZero();
     rfoot_contact_ = new SingleContact(robot_sys_, mercury_link::rightFoot);
     lfoot_contact_ = new SingleContact(robot_sys_, mercury_link::leftFoot);
@@ -88,7 +97,6 @@ void ConfigBodyFootPlanningCtrl::OneStep(void* _cmd){
     state_machine_time_ = sp_->curr_time_ - ctrl_start_time_;
     dynacore::Vector gamma;
 
-    kin_wbc_->Ainv_ = Ainv_;
     _contact_setup();
     _task_setup();
     _compute_torque_wblc(gamma);
@@ -109,14 +117,7 @@ void ConfigBodyFootPlanningCtrl::_contact_setup(){
 }
 
 void ConfigBodyFootPlanningCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint))
@@ -211,11 +212,14 @@ void ConfigBodyFootPlanningCtrl::_task_setup(){
 }
 
 void ConfigBodyFootPlanningCtrl::_CheckPlanning(){
-    if( state_machine_time_ > 
-            (end_time_/(planning_frequency_ + 1.) * (num_planning_ + 1.) + 0.002) ){
-        if(num_planning_<planning_frequency_){
-            dynacore::Vect3 target_loc;
-            _Replanning(target_loc);
+    // Solved by the planning service thread and applied on a later tick.
+    // The deadline runs from the first try, so a worker that is still busy
+    // with a cancelled request cannot hold the planning either.
+    if(b_planning_started_){
+        dynacore::Vect3 target_loc;
+        OutputReversalPL pl_output;
+        if(b_planning_requested_ && planning_service_->getResult(target_loc, pl_output)){
+            _Replanning(target_loc, pl_output);
 
             dynacore::Vect3 target_offset;
             // X, Y target is originally set by intial_traget_loc
@@ -226,21 +230,33 @@ void ConfigBodyFootPlanningCtrl::_CheckPlanning(){
             target_offset[2] = 0.; //target_loc[2] - ini_foot_pos_[2];
 
             _SetMinJerkOffset(target_offset);
+            b_planning_started_ = false;
+        }else if(state_machine_time_ - planning_request_time_ > planning_deadline_){
+            // Too late: keep the previous target
+            planning_service_->Cancel();
+            b_planning_started_ = false;
+        }else if(!b_planning_requested_){
+            b_planning_requested_ = _RequestReplanning();
+        }
+        return;
+    }
+    if( state_machine_time_ > 
+            (end_time_/(planning_frequency_ + 1.) * (num_planning_ + 1.) + 0.002) ){
+        if(num_planning_<planning_frequency_){
+            b_planning_started_ = true;
+            planning_request_time_ = state_machine_time_;
+            b_planning_requested_ = _RequestReplanning();
             ++num_planning_;
-
         }
     }
 }
 
-void ConfigBodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
+bool ConfigBodyFootPlanningCtrl::_RequestReplanning(){
     dynacore::Vect3 com_pos, com_vel;
     // Direct value used
     robot_sys_->getCoMPosition(com_pos);
     robot_sys_->getCoMVelocity(com_vel);
-    printf("CoM state: %f, %f, %f, %f\n",
-        com_pos[0], com_pos[1],
-        com_vel[0], com_vel[1]);
- 
+
     // Average velocity computation
     for(int i(0); i<2; ++i){ 
        sp_->average_vel_[i] = (sp_->Q_[i] - ini_config_[i])/state_machine_time_;
@@ -259,13 +275,10 @@ void ConfigBodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
         com_vel[i] = sp_->est_mocap_body_vel_[i];
         //com_vel[i] = sp_->Qdot_[i];
     }
-   printf("planning state: %f, %f, %f, %f\n",
-        com_pos[0], com_pos[1],
-        com_vel[0], com_vel[1]);
-
 
-    OutputReversalPL pl_output;
     ParamReversalPL pl_param;
+    // the rest of the deadline is for the worker wake up and the pickup
+    pl_param.time_budget = 0.5 * planning_deadline_;
     pl_param.swing_time = end_time_ - state_machine_time_
         + transition_time_ * transition_phase_ratio_
         + stance_time_ * double_stance_ratio_;
@@ -282,10 +295,12 @@ void ConfigBodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
     
     dynacore::Vect3 tmp_global_pos_local = sp_->global_pos_local_;
 
-    planner_->getNextFootLocation(com_pos + tmp_global_pos_local,
-            com_vel,
-            target_loc,
-            &pl_param, &pl_output);
+    return planning_service_->Request(com_pos + tmp_global_pos_local,
+            com_vel, pl_param);
+}
+
+void ConfigBodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc,
+        const OutputReversalPL & pl_output){
     // Time Modification
     replan_moment_ = state_machine_time_;
     end_time_ += pl_output.time_modification;
@@ -293,10 +308,12 @@ void ConfigBodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
  
     target_loc[2] = initial_target_loc_[2];
     // target_loc[2] -= push_down_height_;
-    dynacore::pretty_print(target_loc, std::cout, "next foot loc");
 }
 
 void ConfigBodyFootPlanningCtrl::FirstVisit(){
+    b_planning_started_ = false;
+    b_planning_requested_ = false;
+    planning_service_->Cancel();
     ini_config_ = sp_->Q_;
     robot_sys_->getPos(swing_foot_, ini_foot_pos_);
     ctrl_start_time_ = sp_->curr_time_;
@@ -373,33 +390,14 @@ bool ConfigBodyFootPlanningCtrl::EndOfPhase(){
 void ConfigBodyFootPlanningCtrl::CtrlInitialization(
         const std::string & setting_file_name){
     ini_base_height_ = sp_->Q_[mercury_joint::virtual_Z];
-    std::vector<double> tmp_vec;
 
     // Setting Parameters
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
-    handler.getValue("swing_height", swing_height_);
-    handler.getValue("push_down_height", push_down_height_);
+    _SetQPSolver(handler, wblc_);
+    planning_deadline_ = ((Reversal_LIPM_Planner*)planner_)->getPlanningDeadline();
 
-    handler.getVector("default_target_foot_location", tmp_vec);
-    for(int i(0); i<3; ++i){
-        default_target_loc_[i] = tmp_vec[i];
-    }
-
-    // Feedback Gain
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<mercury::num_act_joint; ++i){
-        Kp_[i] = tmp_vec[i];
-    }
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<mercury::num_act_joint; ++i){
-        Kd_[i] = tmp_vec[i];
-    }
-
-    // Body Point offset
-    handler.getVector("body_pt_offset", tmp_vec);
-    for(int i(0); i<2; ++i){
-        body_pt_offset_[i] = tmp_vec[i];
-    }
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
 
     static bool b_bodypute_eigenvalue(true);
     if(b_bodypute_eigenvalue){
@@ -412,7 +410,38 @@ void ConfigBodyFootPlanningCtrl::CtrlInitialization(
     //printf("[Body Foot JPos Planning Ctrl] Parameter Setup Completed\n");
 }
 
+const CtrlParam* ConfigBodyFootPlanningCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
+    dynacore::Vector tmp_vec;
+
+    handler.getValue("swing_height", param->swing_height);
+    handler.getValue("push_down_height", param->push_down_height);
+    handler.getVector("default_target_foot_location", tmp_vec, 3);
+    param->default_target_loc = tmp_vec;
+
+    // Feedback Gain
+    handler.getVector("Kp", param->Kp, mercury::num_act_joint);
+    handler.getVector("Kd", param->Kd, mercury::num_act_joint);
+
+    // Body Point offset
+    handler.getVector("body_pt_offset", tmp_vec, 2);
+    param->body_pt_offset = tmp_vec;
+    return param.release();
+}
+
+void ConfigBodyFootPlanningCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    swing_height_ = ctrl_param.swing_height;
+    push_down_height_ = ctrl_param.push_down_height;
+    default_target_loc_ = ctrl_param.default_target_loc;
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
+    body_pt_offset_ = ctrl_param.body_pt_offset;
+}
+
 ConfigBodyFootPlanningCtrl::~ConfigBodyFootPlanningCtrl(){
+    delete planning_service_;
     delete wblc_;
     delete lfoot_contact_;
     delete rfoot_contact_;
@@ -423,9 +452,7 @@ void ConfigBodyFootPlanningCtrl::_GetBsplineSwingTrajectory(){
     double vel[3];
     double acc[3];
     
-    foot_traj_.getCurvePoint(state_machine_time_, pos);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 1, vel);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 2, acc);
+    foot_traj_.getCurvePosVelAcc(state_machine_time_, pos, vel, acc);
 
     for(int i(0); i<3; ++i){
         curr_foot_pos_des_[i] = pos[i];
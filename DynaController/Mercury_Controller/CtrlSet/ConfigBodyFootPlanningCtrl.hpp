@@ -6,6 +6,8 @@
 #include <Utils/BSplineBasic.h>
 
 class KinWBC;
+class PlanningService;
+class OutputReversalPL;
 
 class ConfigBodyFootPlanningCtrl:public SwingPlanningCtrl{
    public:
@@ -17,7 +19,18 @@ class ConfigBodyFootPlanningCtrl:public SwingPlanningCtrl{
         virtual void LastVisit(){ sp_->des_jpos_prev_ = des_jpos_; }
         virtual bool EndOfPhase();
 
+        struct Param: public CtrlParam{
+            double swing_height;
+            double push_down_height;
+            dynacore::Vect3 default_target_loc;
+            dynacore::Vector Kp;
+            dynacore::Vector Kd;
+            dynacore::Vect2 body_pt_offset;
+        };
+
         virtual void CtrlInitialization(const std::string & setting_file_name);
+        virtual const CtrlParam* LoadParam(const std::string & setting_file_name) const;
+        virtual void SetParam(const CtrlParam & param);
     protected:
         double waiting_time_limit_;
         double ini_base_height_;
@@ -31,7 +44,17 @@ class ConfigBodyFootPlanningCtrl:public SwingPlanningCtrl{
         WBDC_ContactSpec* lfoot_contact_;
 
         void _CheckPlanning();
-        void _Replanning(dynacore::Vect3 & target_loc);
+        bool _RequestReplanning();
+        void _Replanning(dynacore::Vect3 & target_loc,
+                const OutputReversalPL & pl_output);
+
+        PlanningService* planning_service_;
+        bool b_planning_started_;
+        bool b_planning_requested_; // accepted by the planning service
+        double planning_request_time_; // of the first try
+        // (sec) previous target is kept after this, Reversal_LIPM_Planner::getPlanningDeadline
+        double planning_deadline_;
+
         void _contact_setup();
         void _task_setup();
         void _compute_torque_wblc(dynacore::Vector & gamma);
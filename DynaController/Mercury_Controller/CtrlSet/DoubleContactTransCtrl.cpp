@@ -7,6 +7,7 @@
 #include <WBLC/WBLC.hpp>
 #include <Mercury_Controller/Mercury_DynaControl_Definition.h>
 #include <ParamHandler/ParamHandler.hpp>
+#include <memory>
 
 DoubleContactTransCtrl::DoubleContactTransCtrl(RobotSystem* robot):
     Controller(robot),
@@ -57,7 +58,6 @@ void DoubleContactTransCtrl::OneStep(void* _cmd){
     _PreProcessing_Command();
     state_machine_time_ = sp_->curr_time_ - ctrl_start_time_;
 
-    kin_wbc_->Ainv_ = Ainv_;
     dynacore::Vector gamma;
     _contact_setup();
     _task_setup();
@@ -72,14 +72,7 @@ void DoubleContactTransCtrl::OneStep(void* _cmd){
 }
 
 void DoubleContactTransCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint))
@@ -165,16 +158,27 @@ bool DoubleContactTransCtrl::EndOfPhase(){
 void DoubleContactTransCtrl::CtrlInitialization(const std::string & setting_file_name){
     ini_jpos_ = sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint);
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
-    handler.getValue("max_rf_z", max_rf_z_);
-    handler.getValue("min_rf_z", min_rf_z_);
+    _SetQPSolver(handler, wblc_);
+
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
+}
+
+const CtrlParam* DoubleContactTransCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
+    handler.getValue("max_rf_z", param->max_rf_z);
+    handler.getValue("min_rf_z", param->min_rf_z);
     // Feedback Gain
-    std::vector<double> tmp_vec;
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i){
-        Kp_[i] = tmp_vec[i];
-    }
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i){
-        Kd_[i] = tmp_vec[i];
-    }
+    handler.getVector("Kp", param->Kp, mercury::num_act_joint);
+    handler.getVector("Kd", param->Kd, mercury::num_act_joint);
+    return param.release();
+}
+
+void DoubleContactTransCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    max_rf_z_ = ctrl_param.max_rf_z;
+    min_rf_z_ = ctrl_param.min_rf_z;
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
 }
@@ -6,6 +6,7 @@
 #include <ParamHandler/ParamHandler.hpp>
 #include <Utils/DataManager.hpp>
 #include <Mercury_Controller/Mercury_DynaControl_Definition.h>
+#include <memory>
 
 JPosCtrl::JPosCtrl(RobotSystem* robot):Controller(robot),
     end_time_(1000.0),
@@ -66,14 +67,7 @@ void JPosCtrl::OneStep(void* _cmd){
 }
 
 void JPosCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint))
@@ -155,12 +149,23 @@ void JPosCtrl::CtrlInitialization(const std::string & setting_file_name){
     jpos_ini_ = sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint);
 
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
+
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
+}
 
-    std::vector<double> tmp_vec;
+const CtrlParam* JPosCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
     // Feedback Gain
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i) Kp_[i] = tmp_vec[i]; 
+    handler.getVector("Kp", param->Kp, mercury::num_act_joint);
+    handler.getVector("Kd", param->Kd, mercury::num_act_joint);
+    return param.release();
+}
 
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i) Kd_[i] = tmp_vec[i];
+void JPosCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
 }
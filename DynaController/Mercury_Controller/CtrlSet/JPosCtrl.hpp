@@ -19,7 +19,14 @@ class JPosCtrl: public Controller{
         virtual void LastVisit();
         virtual bool EndOfPhase();
 
+        struct Param: public CtrlParam{
+            dynacore::Vector Kp;
+            dynacore::Vector Kd;
+        };
+
         virtual void CtrlInitialization(const std::string & setting_file_name);
+        virtual const CtrlParam* LoadParam(const std::string & setting_file_name) const;
+        virtual void SetParam(const CtrlParam & param);
 
         void setMovingTime(double time) { end_time_ = time; }
         void setPosture(const std::vector<double> & set_jpos){
@@ -7,6 +7,7 @@
 #include <Mercury/Mercury_Model.hpp>
 #include <Mercury_Controller/Mercury_DynaControl_Definition.h>
 #include <ParamHandler/ParamHandler.hpp>
+#include <memory>
 
 TransitionConfigCtrl::TransitionConfigCtrl(RobotSystem* robot, 
         int moving_foot, bool b_increase):
@@ -64,7 +65,6 @@ void TransitionConfigCtrl::OneStep(void* _cmd){
     state_machine_time_ = sp_->curr_time_ - ctrl_start_time_;
     dynacore::Vector gamma;
     
-    kin_wbc_->Ainv_ = Ainv_;
     _contact_setup();
     _task_setup();
     _compute_torque_wblc(gamma);
@@ -78,14 +78,7 @@ void TransitionConfigCtrl::OneStep(void* _cmd){
 }
 
 void TransitionConfigCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint))
@@ -224,15 +217,28 @@ bool TransitionConfigCtrl::EndOfPhase(){
     return false;
 }
 void TransitionConfigCtrl::CtrlInitialization(const std::string & setting_file_name){
-    std::vector<double> tmp_vec;
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
-    handler.getValue("max_rf_z", max_rf_z_);
-    handler.getValue("min_rf_z", min_rf_z_);
+    _SetQPSolver(handler, wblc_);
+
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
+}
 
+const CtrlParam* TransitionConfigCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
+    handler.getValue("max_rf_z", param->max_rf_z);
+    handler.getValue("min_rf_z", param->min_rf_z);
     // Feedback Gain
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i) Kp_[i] = tmp_vec[i];
+    handler.getVector("Kp", param->Kp, mercury::num_act_joint);
+    handler.getVector("Kd", param->Kd, mercury::num_act_joint);
+    return param.release();
+}
 
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i) Kd_[i] = tmp_vec[i];
+void TransitionConfigCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    max_rf_z_ = ctrl_param.max_rf_z;
+    min_rf_z_ = ctrl_param.min_rf_z;
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
 }
@@ -14,11 +14,10 @@ void ExtCtrlReceiver::run(){
         COMM::receive_data(socket_, PORT_EXT_CTRL, 
                 &des_loc_, sizeof(ExtCtrl::Location), IP_ADDR_MYSELF);
 
-        sp_->des_location_[0] = des_loc_.x;
-        sp_->des_location_[1] = des_loc_.y;
+        dynacore::Vect2 des_location(des_loc_.x, des_loc_.y);
+        sp_->ext_des_location_.write(des_location);
         printf("Current Desired Location (x, y): %f, %f\n", 
-                sp_->des_location_[0],
-                sp_->des_location_[1]);
+                des_location[0], des_location[1]);
     }
 }
 
@@ -25,6 +25,7 @@
 Mercury_StateEstimator::Mercury_StateEstimator(RobotSystem* robot):
     base_cond_(0),
     b_using_jpos_(false),
+    ext_des_location_version_(0),
     curr_config_(mercury::num_q),
     curr_qdot_(mercury::num_qdot)
 {
@@ -269,6 +270,10 @@ void Mercury_StateEstimator::Update(Mercury_SensorData* data){
 
     _FootContactUpdate(data);
     sp_->SaveCurrentData(data, robot_sys_);
+
+    // Desired location from the external command thread (only when a new
+    // command arrived, so the interface's walking schedule is kept otherwise)
+    sp_->ext_des_location_.readNew(sp_->des_location_, ext_des_location_version_);
 }
 
 void Mercury_StateEstimator::_JointUpdate(Mercury_SensorData* data){
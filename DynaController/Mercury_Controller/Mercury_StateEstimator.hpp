@@ -3,6 +3,7 @@
 
 #include <Configuration.h>
 #include <Utils/wrap_eigen.hpp>
+#include <stdint.h>
 
 class Mercury_StateProvider;
 class RobotSystem;
@@ -38,6 +39,7 @@ class Mercury_StateEstimator{
         dynacore::Vect3 body_ang_vel_;
 
         dynacore::Vect3 foot_pos_;
+        uint64_t ext_des_location_version_;
         Mercury_StateProvider* sp_;
         RobotSystem* robot_sys_;
 
@@ -27,8 +27,8 @@ Mercury_StateProvider::Mercury_StateProvider(): initialized_(false),
     num_step_copy_(0),
     led_kin_data_(3*NUM_MARKERS),
     des_jpos_prev_(mercury::num_act_joint),
-    first_LED_x_(0.),
-    first_LED_y_(0.)
+    first_LED_pos_(dynacore::Vect2::Zero()),
+    ext_des_location_(dynacore::Vect2::Zero())
 {
     mjpos_.setZero();
     des_jpos_prev_.setZero();
@@ -3,6 +3,7 @@
 
 #include <Utils/utilities.hpp>
 #include <Utils/wrap_eigen.hpp>
+#include <Utils/SeqLockData.hpp>
 #include <Configuration.h>
 #include "Mercury_DynaControl_Definition.h"
 
@@ -36,8 +37,8 @@ public:
   Vector Q_;
   Vector Qdot_;
 
-  double first_LED_x_;
-  double first_LED_y_;
+  // Written by the MoCap thread
+  dynacore::SeqLockData<dynacore::Vect2> first_LED_pos_;
 
   bool initialized_;
   double curr_time_;
@@ -56,6 +57,9 @@ public:
   dynacore::Vect3 global_jjpos_local_;
   
   dynacore::Vect2 des_location_;
+  // Written by the external command thread, copied to des_location_
+  // by the state estimator when a new command arrives
+  dynacore::SeqLockData<dynacore::Vect2> ext_des_location_;
 
   dynacore::Vect3 CoM_pos_;
   dynacore::Vect3 CoM_vel_;
@@ -9,6 +9,7 @@
 #include "Mercury_StateProvider.hpp"
 #include "Mercury_StateEstimator.hpp"
 #include <ParamHandler/ParamHandler.hpp>
+#include <ParamHandler/ParamWatcher.hpp>
 #include <Mercury/Mercury_Model.hpp>
 #include "ExtCtrlReceiver.hpp"
 
@@ -48,6 +49,8 @@ Mercury_interface::Mercury_interface():
     waiting_count_(1500),
     ramp_time_(0.5)
 {
+    // Before the MoCap/data logging/external command threads are made
+    _ThreadSetting();
     robot_sys_ = new Mercury_Model();
     
     sensed_torque_.setZero();
@@ -316,6 +319,7 @@ bool Mercury_interface::_Initialization(Mercury_SensorData* data){
     }
     //printf("count: %d/ %d\n", count_, waiting_count_);
     if(count_ < waiting_count_){
+        if(count_ == 0) _SetRotorInertia(data);
         for(int i(0); i<mercury::num_act_joint; ++i){
             test_cmd_->jtorque_cmd[i] = 0.;
             test_cmd_->jpos_cmd[i] = data->joint_jpos[i];
@@ -338,8 +342,49 @@ bool Mercury_interface::_Initialization(Mercury_SensorData* data){
     return false;
 }
 
+void Mercury_interface::_ThreadSetting(){
+    ParamHandler handler(MercuryConfigPath"INTERFACE_setup.yaml");
+
+    dynacore_pThreadOption option;
+    std::vector<double> cpu_list;
+    handler.getVector("background_thread_cpu", cpu_list);
+    for(int i(0); i<cpu_list.size(); ++i) option.cpu_list.push_back((int)cpu_list[i]);
+    handler.getBoolean("lock_memory", option.b_lock_memory);
+    if(option.b_lock_memory) option.prefault_stack_size = 64*1024;
+
+    dynacore_pThread::setDefaultThreadOption(option);
+    DataManager::GetDataManager()->setThreadOption(option);
+
+    bool b_hot_reload(false);
+    if(handler.hasKey("param_hot_reload")) handler.getBoolean("param_hot_reload", b_hot_reload);
+    if(b_hot_reload){
+        ParamWatcher::GetParamWatcher()->Enable();
+        ParamWatcher::GetParamWatcher()->start();
+    }
+}
+
+// The reflected rotor inertia of the model mass matrix comes with the first
+// sensor data, unless INTERFACE_setup.yaml sets rotor_inertia.
+void Mercury_interface::_SetRotorInertia(Mercury_SensorData* data){
+    dynacore::Vector sensed_rotor_inertia(mercury::num_act_joint);
+    for(int i(0); i<mercury::num_act_joint; ++i)
+        sensed_rotor_inertia[i] = data->reflected_rotor_inertia[i];
+
+    if(rotor_inertia_.size() == 0){
+        rotor_inertia_ = sensed_rotor_inertia;
+    } else if(rotor_inertia_.size() != mercury::num_act_joint ||
+            (rotor_inertia_ - sensed_rotor_inertia).cwiseAbs().maxCoeff() > 1.e-6){
+        printf("[Mercury Interface] rotor_inertia of the config differs from the sensor data, using the config\n");
+        dynacore::pretty_print(rotor_inertia_, std::cout, "config rotor inertia");
+        dynacore::pretty_print(sensed_rotor_inertia, std::cout, "sensed rotor inertia");
+    }
+    ((Mercury_Model*)robot_sys_)->setRotorInertia(rotor_inertia_);
+}
+
 void Mercury_interface::_ParameterSetting(){
     ParamHandler handler(MercuryConfigPath"INTERFACE_setup.yaml");
+    // overrides the reflected rotor inertia of the sensor data
+    if(handler.hasKey("rotor_inertia")) handler.getVector("rotor_inertia", rotor_inertia_);
 
     std::string tmp_string;
     bool b_tmp;
@@ -12,8 +12,10 @@ MoCapManager::MoCapManager(const RobotSystem* robot):dynacore_pThread(),
     led_kin_data_(3*NUM_MARKERS),
     led_pos_raw_data_(3*NUM_MARKERS),
     body_quat_(1.0, 0., 0., 0. ),
+    body_led_filter_(9, 2.*M_PI*50, mercury::servo_rate),
     initialization_duration_(0.5),
-    b_update_call_(false)
+    b_update_call_(false),
+    coord_update_seq_(0)
 {
     healthy_led_list_.resize(NUM_MARKERS);
 
@@ -25,6 +27,13 @@ MoCapManager::MoCapManager(const RobotSystem* robot):dynacore_pThread(),
     robot_sys_ = robot;
     marker_cond_.resize(NUM_MARKERS, 0.);
 
+    MoCapData init_data;
+    init_data.led_pos.setZero();
+    for(int i(0); i<NUM_MARKERS; ++i) init_data.marker_cond[i] = 0;
+    init_data.body_quat = body_quat_;
+    mocap_data_.write(init_data);
+    led_kin_pos_.write(init_data.led_pos);
+
     led_pos_data_.setZero();
     led_kin_data_.setZero();
     DataManager::GetDataManager()->RegisterData(&led_pos_data_, DYN_VEC, "LED_Pos", 3*NUM_MARKERS);
@@ -33,12 +42,6 @@ MoCapManager::MoCapManager(const RobotSystem* robot):dynacore_pThread(),
 
     sp_ = Mercury_StateProvider::getStateProvider();
 
-    for(int i(0); i<3; ++i){
-        body_led0_filter_.push_back(new digital_lp_filter(2.*M_PI*50, mercury::servo_rate));
-        body_led1_filter_.push_back(new digital_lp_filter(2.*M_PI*50, mercury::servo_rate));
-        body_led2_filter_.push_back(new digital_lp_filter(2.*M_PI*50, mercury::servo_rate));
-    }
-
     //printf("[Mo Cap Manager] Constructed\n");
 }
 
@@ -60,6 +63,7 @@ void MoCapManager::run(){
             }
             marker_cond_[i] = mercury_msg.visible[i];
         }
+        b_update_call_ = coord_update_call_.readNew(imu_body_ori_, coord_update_seq_);
         if( (sp_->curr_time_ < initialization_duration_) || b_update_call_ ){
             _CoordinateUpdate(mercury_msg);      
             b_update_call_ = false;
@@ -126,17 +130,13 @@ dynacore::Matrix MoCapManager::_GetOrientation(const dynacore::Vect3 &b0_raw,
         const dynacore::Vect3 &b1_raw,
         const dynacore::Vect3 &b2_raw) {
 
-    dynacore::Vect3 b0, b1, b2;
+    Eigen::Matrix<double, 9, 1> led_raw;
+    led_raw << b0_raw, b1_raw, b2_raw;
+    body_led_filter_.input(led_raw);
 
-    for(int i(0); i<3; ++i){
-        body_led0_filter_[i]->input(b0_raw[i]);
-        body_led1_filter_[i]->input(b1_raw[i]);
-        body_led2_filter_[i]->input(b2_raw[i]);
-
-        b0[i] = body_led0_filter_[i]->output();
-        b1[i] = body_led1_filter_[i]->output();
-        b2[i] = body_led2_filter_[i]->output();    
-    }
+    dynacore::Vect3 b0 = body_led_filter_.output().segment<3>(0);
+    dynacore::Vect3 b1 = body_led_filter_.output().segment<3>(3);
+    dynacore::Vect3 b2 = body_led_filter_.output().segment<3>(6);
     
 
     dynacore::Vect3 normal;
@@ -181,16 +181,21 @@ void MoCapManager::_print_message(const mercury_message & msg){
     }
 }
 
-void MoCapManager::_UpdateLEDPosData(const mercury_message & msg){
+void MoCapManager::UpdateLEDKinPos(){
+    Eigen::Matrix<double, 3*NUM_MARKERS, 1> led_kin_pos;
     dynacore::Vect3 pos;
 
-    int led_idx = mercury_link::LED_BODY_0;
-
     for(int i(0); i<NUM_MARKERS; ++i){
       robot_sys_->getPos(mercury_link::LED_BODY_0 + i, pos);
-
-      for (int j(0); j<3; ++j)  led_kin_data_[3*i + j] = pos[j];
+      led_kin_pos.segment<3>(3*i) = pos;
     }
+    led_kin_pos_.write(led_kin_pos);
+}
+
+void MoCapManager::_UpdateLEDPosData(const mercury_message & msg){
+    Eigen::Matrix<double, 3*NUM_MARKERS, 1> led_kin_pos;
+    led_kin_pos_.read(led_kin_pos);
+    led_kin_data_ = led_kin_pos;
 
     int led_number(0);
     for(int i(0); i<3*NUM_MARKERS; ++i){
@@ -202,8 +207,14 @@ void MoCapManager::_UpdateLEDPosData(const mercury_message & msg){
             ++led_number;
         }
     }
+    // Publish to the control thread
+    MoCapData data;
+    data.led_pos = led_pos_data_;
+    for(int i(0); i<NUM_MARKERS; ++i) data.marker_cond[i] = marker_cond_[i];
+    data.body_quat = body_quat_;
+    mocap_data_.write(data);
+
     // TEST
-    sp_->first_LED_x_ = led_pos_data_[0];
-    sp_->first_LED_y_ = led_pos_data_[1];
+    sp_->first_LED_pos_.write(led_pos_data_.head(2));
 
 }
@@ -3,8 +3,9 @@
 
 #include <Utils/dynacore_pThread.hpp>
 #include <Utils/wrap_eigen.hpp>
+#include <Utils/SeqLockData.hpp>
 #include <Mercury_Controller/StateEstimator/BodyFootPosEstimator.hpp>
-#include <Filter/filters.hpp>
+#include <Filter/filter_bank.hpp>
 class Mercury_StateProvider;
 class RobotSystem;
 
@@ -25,33 +26,53 @@ typedef struct{
   double data[NUM_MARKERS*3];
 }mercury_message;
 
+// Snapshot published by the MoCap thread for the control thread
+struct MoCapData{
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  Eigen::Matrix<double, 3*NUM_MARKERS, 1> led_pos;
+  int marker_cond[NUM_MARKERS];
+  dynacore::Quaternion body_quat;
+};
+
 
 class MoCapManager: public dynacore_pThread{
 public:
-    friend class BodyFootPosEstimator;
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
   MoCapManager(const RobotSystem* );
   virtual ~MoCapManager(){}
 
   virtual void run(void);
+  // Wait-free read of the latest LED positions, visibility and body orientation
+  void getMoCapData(MoCapData & data) const { mocap_data_.read(data); }
 
   dynacore::Quaternion body_quat_;
-  void CoordinateUpdateCall(){ b_update_call_ = true; }
+  // Control thread: the MoCap thread updates its coordinate with the next
+  // message (IMU body orientation at the time of the call)
+  void CoordinateUpdateCall(const dynacore::Quaternion & imu_body_ori){
+      coord_update_call_.write(imu_body_ori);
+  }
+  // Control thread, after the model update: LED positions of the model for
+  // the MoCap thread, which never touches the model itself
+  void UpdateLEDKinPos();
 
 protected:
   std::vector<dynacore::Vect3> healthy_led_list_;
 
-  std::vector<filter*> body_led0_filter_;
-  std::vector<filter*> body_led1_filter_;
-  std::vector<filter*> body_led2_filter_;
+  // x, y, z of the three body LEDs
+  digital_lp_filter_bank body_led_filter_;
 
   double initialization_duration_;
   dynacore::Vect3 offset_;
+  // MoCap thread only, taken from coord_update_call_
   dynacore::Quaternion imu_body_ori_;
+  bool b_update_call_;
+  uint64_t coord_update_seq_;
+  dynacore::SeqLockData<dynacore::Quaternion> coord_update_call_;
 
   Mercury_StateProvider * sp_;
   dynacore::Matrix R_coord_;
-  bool b_update_call_;
 
   void _print_message(const mercury_message & msg);
   void _UpdateLEDPosData(const mercury_message & msg);
@@ -66,11 +87,13 @@ protected:
   dynacore::Vector led_pos_data_;
   dynacore::Vector led_kin_data_;
   dynacore::Vector led_pos_raw_data_;
+  dynacore::SeqLockData<MoCapData> mocap_data_;
+  dynacore::SeqLockData<Eigen::Matrix<double, 3*NUM_MARKERS, 1> > led_kin_pos_;
 
   int lfoot_idx;
   int rfoot_idx;
 
-  const RobotSystem* robot_sys_;
+  const RobotSystem* robot_sys_; // control thread only
 };
 
 #endif
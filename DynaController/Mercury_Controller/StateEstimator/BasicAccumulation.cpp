@@ -5,16 +5,14 @@
 #include <Utils/DataManager.hpp>
 
 
-BasicAccumulation::BasicAccumulation():OriEstimator(), com_state_(6){
+BasicAccumulation::BasicAccumulation():OriEstimator(), com_state_(6),
+  bias_lp_frequency_cutoff(2.0*3.1415*1.0), // 1Hz // (2*pi*frequency) rads/s 
+  bias_low_pass_filter(3, bias_lp_frequency_cutoff, mercury::servo_rate){
   global_ori_.w() = 1.;
   global_ori_.x() = 0.;
   com_state_.setZero();
 
   // Bias Filter 
-  bias_lp_frequency_cutoff = 2.0*3.1415*1.0; // 1Hz // (2*pi*frequency) rads/s 
-  x_bias_low_pass_filter = new digital_lp_filter(bias_lp_frequency_cutoff, mercury::servo_rate);
-  y_bias_low_pass_filter = new digital_lp_filter(bias_lp_frequency_cutoff, mercury::servo_rate);
-  z_bias_low_pass_filter = new digital_lp_filter(bias_lp_frequency_cutoff, mercury::servo_rate);  
   x_acc_bias = 0.0;
   y_acc_bias = 0.0;  
   z_acc_bias = 0.0;
@@ -63,13 +61,11 @@ void BasicAccumulation::EstimatorInitialization(const dynacore::Quaternion & ini
     }
 
   // Update bias estimate
-  x_bias_low_pass_filter->input(acc[0]);
-  y_bias_low_pass_filter->input(acc[1]);
-  z_bias_low_pass_filter->input(acc[2]);
+  bias_low_pass_filter.input(Eigen::Map<const dynacore::Vector>(&acc[0], 3));
 
-  x_acc_bias = x_bias_low_pass_filter->output();
-  y_acc_bias = y_bias_low_pass_filter->output(); 
-  z_acc_bias = z_bias_low_pass_filter->output();     
+  x_acc_bias = bias_low_pass_filter.output(0);
+  y_acc_bias = bias_low_pass_filter.output(1);
+  z_acc_bias = bias_low_pass_filter.output(2);
 
   //printf("Basic Accumulation \n");
   InitIMUOrientationEstimateFromGravity();
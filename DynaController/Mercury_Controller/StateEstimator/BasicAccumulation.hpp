@@ -3,7 +3,7 @@
 
 #include "OriEstimator.hpp"
 
-#include <Filter/filters.hpp>
+#include <Filter/filter_bank.hpp>
 
 class BasicAccumulation:public OriEstimator{
 public:
@@ -29,9 +29,7 @@ protected:
 
 
   double bias_lp_frequency_cutoff;
-  digital_lp_filter* x_bias_low_pass_filter;
-  digital_lp_filter* y_bias_low_pass_filter;
-  digital_lp_filter* z_bias_low_pass_filter;
+  digital_lp_filter_bank bias_low_pass_filter; // x, y, z
 
   double x_acc_bias;
   double y_acc_bias;
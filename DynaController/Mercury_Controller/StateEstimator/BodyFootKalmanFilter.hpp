@@ -2,6 +2,7 @@
 #define BODY_FOOT_KALMAN_FILTER
 
 #include <Utils/wrap_eigen.hpp>
+#include <Filter/KalmanFilter.hpp>
 
 class Mercury_StateProvider;
 
@@ -32,6 +33,8 @@ class BodyFootInput{
 
 class BodyFootKalmanFilter{
     public:
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
         BodyFootKalmanFilter();
         ~BodyFootKalmanFilter();
 
@@ -53,7 +56,8 @@ class BodyFootKalmanFilter{
         static constexpr int num_state = 12;
         static constexpr int num_obs = 12;
         static constexpr int num_led = 5;
-        
+        typedef dynacore::KalmanFilter<num_state, num_obs> Filter;
+
         double dt_;
         double body_height_;
         double omega_;
@@ -61,20 +65,16 @@ class BodyFootKalmanFilter{
         int stance_foot_state_idx_;
         dynacore::Vect2 stance_loc_;
 
-        // body (x, y) rfoot in/ out(x, y) lfoot in/out (x, y)
-        // body vel (x, y)
-        dynacore::Vector state_;
-         // body (x, y) rfoot in/ out(x, y) lfoot in/out (x, y)
+        // state: body (x, y) rfoot in/ out(x, y) lfoot in/out (x, y)
         // body vel (x, y)
-        dynacore::Vector state_pred_;
-        dynacore::Vector obs_;
+        // F = I, process noise Q = I
+        Filter kf_;
+        Filter::StateVector state_pred_;
+        Filter::ObsVector obs_;
 
-        dynacore::Matrix P_;
-        
-        dynacore::Matrix F_;
-        dynacore::Matrix Q_; // prediction covariance
-        dynacore::Matrix H_;
-        dynacore::Matrix R_; // observation covariance
+        Filter::ObsMatrix H_;
+        Filter::ObsVector obs_var_; // diagonal of the observation covariance
+        Filter::ObsMask obs_valid_; // rows of hidden LEDs are skipped
 
         Mercury_StateProvider* sp_;
 };
@@ -6,17 +6,17 @@
 #include <Mercury_Controller/Mercury_StateProvider.hpp>
 #include "BodyFootKalmanFilter.hpp"
 
-BodyFootPosEstimator::BodyFootPosEstimator(const RobotSystem* robot)
+BodyFootPosEstimator::BodyFootPosEstimator(const RobotSystem* robot):
+    vel_filter_(3, 2.*50.*M_PI, mercury::servo_rate)
 {
     mocap_manager_ = new MoCapManager(robot);
+    mocap_data_ = new MoCapData();
+    mocap_manager_->getMoCapData(*mocap_data_);
     mocap_manager_->start();
 
     robot_sys_ = robot;
 
     body_led_vel_.setZero();
-    for(int i(0); i<3 ; ++i){
-        vel_filter_.push_back(new deriv_lp_filter(2.*50.*M_PI, mercury::servo_rate));
-    }
     body_foot_kalman_filter_ = new BodyFootKalmanFilter();
     kalman_obs_ = new BodyFootObs();
     kalman_input_ = new BodyFootInput();
@@ -27,6 +27,7 @@ BodyFootPosEstimator::BodyFootPosEstimator(const RobotSystem* robot)
 
 BodyFootPosEstimator::~BodyFootPosEstimator(){
     delete mocap_manager_;
+    delete mocap_data_;
     delete kalman_obs_;
     delete kalman_input_;
     delete body_foot_kalman_filter_;
@@ -46,10 +47,10 @@ void BodyFootPosEstimator::getMoCapBodyPos(const dynacore::Quaternion& body_ori,
 }
 
 void BodyFootPosEstimator::Update(){
-    for(int i(0); i<3; ++i){
-        vel_filter_[i]->input(mocap_manager_->led_pos_data_[i]);
-        body_led_vel_[i] = vel_filter_[i]->output();
-    }
+    mocap_manager_->UpdateLEDKinPos();
+    mocap_manager_->getMoCapData(*mocap_data_);
+    vel_filter_.input(mocap_data_->led_pos.head<3>());
+    body_led_vel_ = vel_filter_.output();
     
     _KalmanFilterOberservationSetup();
     _KalmanFilterPredictionInputSetup();
@@ -74,9 +75,9 @@ void BodyFootPosEstimator::_KalmanFilterPredictionInputSetup(){
     kalman_input_->stance_foot_idx_ = sp_->stance_foot_;
 }
 void BodyFootPosEstimator::Initialization(const dynacore::Quaternion & body_ori){
-    mocap_manager_->imu_body_ori_ = body_ori;
-    mocap_manager_->CoordinateUpdateCall();
+    mocap_manager_->CoordinateUpdateCall(body_ori);
 
+    mocap_manager_->getMoCapData(*mocap_data_);
     _KalmanFilterOberservationSetup();
     // Height
     body_foot_kalman_filter_->Initialization(kalman_obs_, sp_->Q_[2]);
@@ -84,32 +85,32 @@ void BodyFootPosEstimator::Initialization(const dynacore::Quaternion & body_ori)
 
 void BodyFootPosEstimator::_KalmanFilterOberservationSetup(){
     for(int i(0); i<2; ++i){
-        kalman_obs_->body_led_pos_[i] = mocap_manager_->led_pos_data_[i];
-        kalman_obs_->rfoot_out_led_pos_[i] = mocap_manager_->led_pos_data_[3*idx_rfoot_out + i];
-        kalman_obs_->rfoot_in_led_pos_[i] = mocap_manager_->led_pos_data_[3*idx_rfoot_in + i];
-        kalman_obs_->lfoot_out_led_pos_[i] = mocap_manager_->led_pos_data_[3*idx_lfoot_out + i];
-        kalman_obs_->lfoot_in_led_pos_[i] = mocap_manager_->led_pos_data_[3*idx_lfoot_in + i];
+        kalman_obs_->body_led_pos_[i] = mocap_data_->led_pos[i];
+        kalman_obs_->rfoot_out_led_pos_[i] = mocap_data_->led_pos[3*idx_rfoot_out + i];
+        kalman_obs_->rfoot_in_led_pos_[i] = mocap_data_->led_pos[3*idx_rfoot_in + i];
+        kalman_obs_->lfoot_out_led_pos_[i] = mocap_data_->led_pos[3*idx_lfoot_out + i];
+        kalman_obs_->lfoot_in_led_pos_[i] = mocap_data_->led_pos[3*idx_lfoot_in + i];
         kalman_obs_->body_led_vel_[i] = body_led_vel_[i];
     }
 
     kalman_obs_->led_visible_ = dynacore::Vector::Zero(5);
-    if(mocap_manager_->marker_cond_[0] > 0){ kalman_obs_->led_visible_[0] = 1.5; }
+    if(mocap_data_->marker_cond[0] > 0){ kalman_obs_->led_visible_[0] = 1.5; }
     else {kalman_obs_->led_visible_[0] = 0.0; }
 
-    if(mocap_manager_->marker_cond_[idx_rfoot_out] > 0){ kalman_obs_->led_visible_[1] = 1.5; }
+    if(mocap_data_->marker_cond[idx_rfoot_out] > 0){ kalman_obs_->led_visible_[1] = 1.5; }
     else {kalman_obs_->led_visible_[1] = 0.0; }
-    if(mocap_manager_->marker_cond_[idx_rfoot_in] > 0){ kalman_obs_->led_visible_[2] = 1.5; }
+    if(mocap_data_->marker_cond[idx_rfoot_in] > 0){ kalman_obs_->led_visible_[2] = 1.5; }
     else {kalman_obs_->led_visible_[2] = 0.0; }
 
-    if(mocap_manager_->marker_cond_[idx_lfoot_out] > 0){ kalman_obs_->led_visible_[3] = 1.5; }
+    if(mocap_data_->marker_cond[idx_lfoot_out] > 0){ kalman_obs_->led_visible_[3] = 1.5; }
     else {kalman_obs_->led_visible_[3] = 0.0; }
-    if(mocap_manager_->marker_cond_[idx_lfoot_in] > 0){ kalman_obs_->led_visible_[4] = 1.5; }
+    if(mocap_data_->marker_cond[idx_lfoot_in] > 0){ kalman_obs_->led_visible_[4] = 1.5; }
     else {kalman_obs_->led_visible_[4] = 0.0; }
 
 }
 
 void BodyFootPosEstimator::getMoCapBodyOri(dynacore::Quaternion & quat){
-    quat = mocap_manager_->body_quat_;
+    quat = mocap_data_->body_quat;
 }
 
 void BodyFootPosEstimator::getMoCapBodyVel(dynacore::Vect3 & body_vel){	
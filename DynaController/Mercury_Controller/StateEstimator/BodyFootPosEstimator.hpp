@@ -2,9 +2,10 @@
 #define BODY_FOOT_POSITON_ESTIMATOR
 
 #include <Utils/wrap_eigen.hpp>
-#include <Filter/filters.hpp>
+#include <Filter/filter_bank.hpp>
 
 class MoCapManager;
+struct MoCapData;
 class RobotSystem;
 class Mercury_StateProvider;
 class BodyFootKalmanFilter;
@@ -26,6 +27,8 @@ class BodyFootPosEstimator{
 
     protected:
         MoCapManager* mocap_manager_;
+        // Snapshot of the MoCap thread output taken once per tick
+        MoCapData* mocap_data_;
         Mercury_StateProvider* sp_;
 
         static constexpr int idx_rfoot_out = 6;
@@ -40,7 +43,7 @@ class BodyFootPosEstimator{
         void _KalmanFilterOberservationSetup();
         void _KalmanFilterPredictionInputSetup();
 
-        std::vector<filter*> vel_filter_;
+        deriv_lp_filter_bank vel_filter_;
         dynacore::Vect3 body_led_vel_;
 
         const RobotSystem* robot_sys_;
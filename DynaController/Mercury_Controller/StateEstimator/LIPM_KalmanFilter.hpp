@@ -6,9 +6,12 @@
 
 
 #include "CoMStateEstimator.hpp"
+#include <Filter/KalmanFilter.hpp>
 
 class LIPM_KalmanFilter: public CoMStateEstimator{
 public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   LIPM_KalmanFilter();
   virtual ~LIPM_KalmanFilter();
 
@@ -22,19 +25,12 @@ protected:
   std::vector<double> prediction_var_;
   std::vector<double> observation_var_;
 
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, 1> x_;
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, 1> x_pre_;
-
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, LIPM_KFILTER_STATE_DIM> F_;
-  Eigen::Matrix<double, LIPM_KFILTER_OBS_DIM, LIPM_KFILTER_STATE_DIM> H_;
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, LIPM_KFILTER_STATE_DIM> P_;
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, LIPM_KFILTER_STATE_DIM> P_pre_;
-
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, LIPM_KFILTER_OBS_DIM> K_;
-  Eigen::Matrix<double, LIPM_KFILTER_OBS_DIM, LIPM_KFILTER_OBS_DIM> S_;
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, LIPM_KFILTER_STATE_DIM> Q_;
-  Eigen::Matrix<double, LIPM_KFILTER_OBS_DIM, LIPM_KFILTER_OBS_DIM> R_;
+  typedef dynacore::KalmanFilter<LIPM_KFILTER_STATE_DIM, LIPM_KFILTER_OBS_DIM> Filter;
+  // F = I for the covariance; the state prediction adds the LIPM terms
+  Filter kf_;
+  Filter::StateVector x_pre_;
 
-  Eigen::Matrix<double, LIPM_KFILTER_STATE_DIM, LIPM_KFILTER_STATE_DIM> eye_;
+  Filter::ObsMatrix H_;
+  Filter::ObsVector R_; // diagonal
 };
 #endif
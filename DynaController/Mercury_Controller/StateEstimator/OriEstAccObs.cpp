@@ -1,7 +1,6 @@
 #include "OriEstAccObs.hpp"
 #include <Configuration.h>
 #include <Utils/utilities.hpp>
-#include <Utils/pseudo_inverse.hpp>
 #include <Mercury/Mercury_Definition.h>
 
 OriEstAccObs::OriEstAccObs():OriEstimator(),
@@ -18,19 +17,17 @@ OriEstAccObs::OriEstAccObs():OriEstimator(),
   ori_pred_.y() = 0.;
   ori_pred_.z() = 0.;
 
-  P_.setIdentity();
-  P_pred_.setIdentity();
-
   x_.setZero();
   x_pred_.setZero();
 
-  Q_.setIdentity();
-  R_.setIdentity();
+  Filter::StateMatrix Q = Filter::StateMatrix::Identity();
+  R_.setOnes();
   // Velocity
-  // Q_.block<3,3>(0,0) *= 1.0;
-  // Q_.block<3,3>(3,3) *= 10.0;
-  Q_.block<3,3>(6,6) *= 0.1;
-  // Q_.block<6,6>(9,9) *= 1.0;
+  // Q.block<3,3>(0,0) *= 1.0;
+  // Q.block<3,3>(3,3) *= 10.0;
+  Q.block<3,3>(6,6) *= 0.1;
+  // Q.block<6,6>(9,9) *= 1.0;
+  kf_.setProcessNoise(Q);
 
   // R_*=1000.0;
 }
@@ -85,7 +82,7 @@ void OriEstAccObs::setSensorData(const std::vector<double> & acc,
   F_.block<3,3>(0,3) = Eigen::Matrix3d::Identity() * mercury::servo_rate;
   F_.block<3,3>(6,9) = RotMtx * mercury::servo_rate;
   // dynacore::pretty_print((dynacore::Matrix)F_, std::cout, "F");
-  P_pred_ = F_ * P_ * F_.transpose() + Q_;
+  kf_.predict(Filter::StateVector::Zero(), F_);
 
   // Update Observation
   dynacore::Vect3 grav; grav.setZero();
@@ -120,13 +117,9 @@ void OriEstAccObs::setSensorData(const std::vector<double> & acc,
   // dynacore::pretty_print((dynacore::Matrix)a_g_skew, std::cout, "ag skew");
   // dynacore::pretty_print((dynacore::Matrix)H_, std::cout, "H");
 
-  dynacore::Matrix S = R_ + H_ * P_pred_ * H_.transpose();
-  // dynacore::Matrix K = P_pred_ * H_.transpose() * S.inverse();
-  dynacore::Matrix Sinv;
-  dynacore::pseudoInverse(S, 0.0001, Sinv);
-  dynacore::Matrix K = P_pred_ * H_.transpose() * Sinv;
-
-  dynacore::Vector delta = K*y_;
+  // R is diagonal and positive: sequential scalar updates, no inverse of S
+  kf_.update(y_, H_, R_);
+  dynacore::Vector delta = kf_.getState();
   x_pred_.head(6) += delta.head(6);
   x_pred_.tail(3) += delta.tail(3);
 
@@ -136,19 +129,12 @@ void OriEstAccObs::setSensorData(const std::vector<double> & acc,
   ori_pred_ = dynacore::QuatMultiply(quat_delta, ori_pred_);
 
   dynacore::pretty_print(x_, std::cout, "x");
-  // dynacore::pretty_print(S, std::cout, "S");
-  // dynacore::pretty_print(K, std::cout, "K");
   dynacore::pretty_print(delta, std::cout, "delta");
   dynacore::pretty_print(ori_pred_, std::cout, "ori updated");
 
-  dynacore::Matrix eye(DIM_STATE_EST_ACC_OBS, DIM_STATE_EST_ACC_OBS);
-  eye.setIdentity();
-  P_pred_ = (eye - K * H_) * P_pred_;
-
   // Set Angular Velocity
   _SetGlobalAngularVelocity(ang_vel);
   global_ori_ = ori_pred_;
-  P_ = P_pred_;
   x_ = x_pred_;
 }
 
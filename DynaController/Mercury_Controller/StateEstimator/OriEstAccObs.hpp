@@ -2,11 +2,14 @@
 #define ACCELERATION_OBSERVING_ESTIMATOR
 
 #include "OriEstimator.hpp"
+#include <Filter/KalmanFilter.hpp>
 #define DIM_STATE_EST_ACC_OBS 3*4
 #define DIM_OBSER_EST_ACC_OBS 3*2
 
 class OriEstAccObs:public OriEstimator{
 public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   OriEstAccObs();
   virtual ~OriEstAccObs();
 
@@ -19,14 +22,13 @@ public:
                              const std::vector<double> & ang_vel);
 
 protected:
-  Eigen::Matrix<double, DIM_STATE_EST_ACC_OBS, DIM_STATE_EST_ACC_OBS> F_;
-  Eigen::Matrix<double, DIM_OBSER_EST_ACC_OBS, DIM_STATE_EST_ACC_OBS> H_;
-
-  Eigen::Matrix<double, DIM_STATE_EST_ACC_OBS, DIM_STATE_EST_ACC_OBS> P_;
-  Eigen::Matrix<double, DIM_STATE_EST_ACC_OBS, DIM_STATE_EST_ACC_OBS> P_pred_;
-
-  Eigen::Matrix<double, DIM_STATE_EST_ACC_OBS, DIM_STATE_EST_ACC_OBS> Q_;
-  Eigen::Matrix<double, DIM_OBSER_EST_ACC_OBS, DIM_OBSER_EST_ACC_OBS> R_;
+  typedef dynacore::KalmanFilter<DIM_STATE_EST_ACC_OBS, DIM_OBSER_EST_ACC_OBS> Filter;
+  // error state: vel(3), acc(3), orientation(3), bias_omega(3),
+  // zero after every correction
+  Filter kf_;
+  Filter::StateMatrix F_;
+  Filter::ObsMatrix H_;
+  Filter::ObsVector R_; // diagonal
   // vel(3), acc(3), bias_omega(3), ...[orientation (3*)]
   dynacore::Vector x_;
   dynacore::Vector x_pred_;
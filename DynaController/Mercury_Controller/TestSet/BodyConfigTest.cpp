@@ -33,9 +33,9 @@ BodyConfigTest::~BodyConfigTest(){
 
 void BodyConfigTest::TestInitialization(){
   // Yaml file name
-  jpos_ctrl_->CtrlInitialization("CTRL_jpos_initialization");
-  body_up_ctrl_->CtrlInitialization("CTRL_move_to_target_height");
-  body_jpos_ctrl_->CtrlInitialization("CTRL_fix_config");
+  _CtrlInitialization(jpos_ctrl_, "CTRL_jpos_initialization");
+  _CtrlInitialization(body_up_ctrl_, "CTRL_move_to_target_height");
+  _CtrlInitialization(body_jpos_ctrl_, "CTRL_fix_config");
 }
 
 int BodyConfigTest::_NextPhase(const int & phase){
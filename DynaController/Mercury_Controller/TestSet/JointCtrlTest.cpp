@@ -22,8 +22,8 @@ JointCtrlTest::~JointCtrlTest(){
   delete jpos_ctrl_;
 }
 void JointCtrlTest::TestInitialization(){
-  jpos_ctrl_ini_->CtrlInitialization("CTRL_jpos_initialization");
-  jpos_ctrl_->CtrlInitialization("CTRL_jpos_swing");
+  _CtrlInitialization(jpos_ctrl_ini_, "CTRL_jpos_initialization");
+  _CtrlInitialization(jpos_ctrl_, "CTRL_jpos_swing");
 }
 
 int JointCtrlTest::_NextPhase(const int & phase){
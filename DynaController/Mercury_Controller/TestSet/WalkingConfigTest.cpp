@@ -95,17 +95,17 @@ void WalkingConfigTest::TestInitialization(){
     // Planner
     reversal_planner_->PlannerInitialization(MercuryConfigPath"PLANNER_velocity_reversal");
     // Yaml file name
-    jpos_ctrl_->CtrlInitialization("CTRL_jpos_initialization");
-    body_up_ctrl_->CtrlInitialization("CTRL_move_to_target_height");
-    config_body_fix_ctrl_->CtrlInitialization("CTRL_fix_config");
+    _CtrlInitialization(jpos_ctrl_, "CTRL_jpos_initialization");
+    _CtrlInitialization(body_up_ctrl_, "CTRL_move_to_target_height");
+    _CtrlInitialization(config_body_fix_ctrl_, "CTRL_fix_config");
     // Transition
-    right_swing_start_trans_ctrl_->CtrlInitialization("CTRL_config_trans");
-    right_swing_end_trans_ctrl_->CtrlInitialization("CTRL_config_trans");
-    left_swing_start_trans_ctrl_->CtrlInitialization("CTRL_config_trans");
-    left_swing_end_trans_ctrl_->CtrlInitialization("CTRL_config_trans");
+    _CtrlInitialization(right_swing_start_trans_ctrl_, "CTRL_config_trans");
+    _CtrlInitialization(right_swing_end_trans_ctrl_, "CTRL_config_trans");
+    _CtrlInitialization(left_swing_start_trans_ctrl_, "CTRL_config_trans");
+    _CtrlInitialization(left_swing_end_trans_ctrl_, "CTRL_config_trans");
     // Swing
-    config_right_swing_ctrl_->CtrlInitialization("CTRL_config_right_walking_swing");
-    config_left_swing_ctrl_->CtrlInitialization("CTRL_config_left_walking_swing");
+    _CtrlInitialization(config_right_swing_ctrl_, "CTRL_config_right_walking_swing");
+    _CtrlInitialization(config_left_swing_ctrl_, "CTRL_config_left_walking_swing");
 }
 
 int WalkingConfigTest::_NextPhase(const int & phase){
@@ -148,10 +148,12 @@ int WalkingConfigTest::_NextPhase(const int & phase){
     if( ( (phase == WkConfigPhase::double_contact_1) ||
                 (phase == WkConfigPhase::double_contact_2) ) &&
             (num_step_>1) ){
+        dynacore::Vect2 first_LED_pos;
+        sp_->first_LED_pos_.read(first_LED_pos);
         sp_->global_pos_local_[0] = 
-            sp_->first_LED_x_ +  (next_local_frame_location[0] - sp_->Q_[0]);
+            first_LED_pos[0] +  (next_local_frame_location[0] - sp_->Q_[0]);
         sp_->global_pos_local_[1] = 
-            sp_->first_LED_y_ + (next_local_frame_location[1] - sp_->Q_[1]);
+            first_LED_pos[1] + (next_local_frame_location[1] - sp_->Q_[1]);
     }
 
     sp_->num_step_copy_ = num_step_;
@@ -53,8 +53,7 @@ BodyFootJPosPlanningCtrl::BodyFootJPosPlanningCtrl(
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
                 body_foot_task_->getDim() + 
@@ -100,11 +99,7 @@ void BodyFootJPosPlanningCtrl::_body_foot_ctrl(dynacore::Vector & gamma){
         = std::chrono::high_resolution_clock::now();
 #endif
     dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -162,9 +157,7 @@ void BodyFootJPosPlanningCtrl::_task_setup(){
     double acc[3];
 
     // printf("time: %f\n", state_machine_time_);
-    foot_traj_.getCurvePoint(traj_time, pos);
-    foot_traj_.getCurveDerPoint(traj_time, 1, vel);
-    foot_traj_.getCurveDerPoint(traj_time, 2, acc);
+    foot_traj_.getCurvePosVelAcc(traj_time, pos, vel, acc);
     // printf("pos:%f, %f, %f\n", pos[0], pos[1], pos[2]);
 
     for(int i(0); i<3; ++i){
@@ -424,6 +417,7 @@ void BodyFootJPosPlanningCtrl::CtrlInitialization(const std::string & setting_fi
 
     // Setting Parameters
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_rotor_);
     handler.getValue("swing_height", swing_height_);
     handler.getValue("push_down_height", push_down_height_);
 
@@ -25,7 +25,7 @@ BodyJPosCtrl::BodyJPosCtrl(RobotSystem* robot):Controller(robot),
     
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor =  dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
    
     wbdc_rotor_data_->cost_weight = 
     dynacore::Vector::Constant(
@@ -71,11 +71,7 @@ void BodyJPosCtrl::OneStep(dynacore::Vector & gamma){
 
 void BodyJPosCtrl::_jpos_ctrl_wbdc_rotor(dynacore::Vector & gamma){
     dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -146,6 +142,7 @@ void BodyJPosCtrl::CtrlInitialization(const std::string & setting_file_name){
     jpos_ini_ = sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint);
 
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_rotor_);
 
     std::vector<double> tmp_vec;
     // Feedback Gain
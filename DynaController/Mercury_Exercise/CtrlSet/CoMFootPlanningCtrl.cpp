@@ -59,8 +59,7 @@ CoMFootPlanningCtrl::CoMFootPlanningCtrl(RobotSystem* robot, int swing_foot, Pla
     }
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
                 com_foot_task_->getDim() + 
@@ -107,11 +106,7 @@ void CoMFootPlanningCtrl::_com_foot_ctrl_wbdc_rotor(dynacore::Vector & gamma){
         = std::chrono::high_resolution_clock::now();
 #endif
     dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -145,21 +140,13 @@ void CoMFootPlanningCtrl::_com_foot_ctrl(dynacore::Vector & gamma){
 #endif
     dynacore::Vector jtorque_cmd(mercury::num_act_joint);
 
-    wbdc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
 
     gamma.head(mercury::num_act_joint) = jtorque_cmd;
 
     // Feedforward Torque command accounting rotor inertia
-    dynacore::Matrix A_rotor = A_;
-    for(int i(0); i<mercury::num_act_joint; ++i) {
-        A_rotor(i+mercury::num_virtual,i + mercury::num_virtual) 
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv;
-
-    dynacore::pseudoInverse(A_rotor, 0.00001, A_rotor_inv, 0);
-    wbdc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
     gamma.tail(mercury::num_act_joint) = jtorque_cmd;
 
@@ -236,9 +223,7 @@ void CoMFootPlanningCtrl::_task_setup(){
     double acc[3];
 
     // printf("time: %f\n", state_machine_time_);
-    foot_traj_.getCurvePoint(traj_time, pos);
-    foot_traj_.getCurveDerPoint(traj_time, 1, vel);
-    foot_traj_.getCurveDerPoint(traj_time, 2, acc);
+    foot_traj_.getCurvePosVelAcc(traj_time, pos, vel, acc);
     // printf("pos:%f, %f, %f\n", pos[0], pos[1], pos[2]);
 
     for(int i(0); i<3; ++i){
@@ -451,6 +436,8 @@ void CoMFootPlanningCtrl::CtrlInitialization(const std::string & setting_file_na
 
     // Setting Parameters
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_);
+    _SetQPSolver(handler, wbdc_rotor_);
     handler.getValue("swing_height", swing_height_);
     handler.getValue("push_down_height", push_down_height_);
 
@@ -43,8 +43,7 @@ CoMzRxRyRzCtrl::CoMzRxRyRzCtrl(RobotSystem* robot): Controller(robot),
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
                 com_task_->getDim() + 
@@ -82,7 +81,7 @@ void CoMzRxRyRzCtrl::OneStep(dynacore::Vector & gamma){
 }
 
 void CoMzRxRyRzCtrl::_com_ctrl(dynacore::Vector & gamma){
-    wbdc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, gamma, wbdc_data_);
 
     for(int i(0); i<6; ++i)
@@ -100,11 +99,7 @@ void CoMzRxRyRzCtrl::_com_ctrl_wbdc_rotor(dynacore::Vector & gamma){
    gamma = dynacore::Vector::Zero(mercury::num_act_joint * 2); 
     
    dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -236,6 +231,8 @@ void CoMzRxRyRzCtrl::CtrlInitialization(const std::string & setting_file_name){
     std::vector<double> tmp_vec;
 
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_);
+    _SetQPSolver(handler, wbdc_rotor_);
 
     // Feedback Gain
     handler.getVector("Kp", tmp_vec);
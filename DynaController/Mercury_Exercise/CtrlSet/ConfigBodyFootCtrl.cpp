@@ -44,8 +44,7 @@ ConfigBodyFootCtrl::ConfigBodyFootCtrl(RobotSystem* robot, int swing_foot):
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
                 config_body_foot_task_->getDim() + 
@@ -91,11 +90,7 @@ void ConfigBodyFootCtrl::_body_foot_ctrl(dynacore::Vector & gamma){
         = std::chrono::high_resolution_clock::now();
 #endif
     dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -154,9 +149,7 @@ void ConfigBodyFootCtrl::_task_setup(){
                 -amp_[i] * omega * omega * sin(omega * traj_time + phase_[i]);
         }
     }else {
-        foot_traj_.getCurvePoint(traj_time, pos);
-        foot_traj_.getCurveDerPoint(traj_time, 1, vel);
-        foot_traj_.getCurveDerPoint(traj_time, 2, acc);
+        foot_traj_.getCurvePosVelAcc(traj_time, pos, vel, acc);
     }
 
     // Foot position setup (and For save)
@@ -264,6 +257,7 @@ void ConfigBodyFootCtrl::CtrlInitialization(const std::string & setting_file_nam
     std::vector<double> tmp_vec;
     // Setting Parameters
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_rotor_);
 
     // Feedback Gain
     handler.getVector("Kp", tmp_vec);
@@ -23,8 +23,7 @@ ContactTransBodyCtrl::ContactTransBodyCtrl(RobotSystem* robot):
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
 
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
@@ -74,17 +73,13 @@ void ContactTransBodyCtrl::_body_ctrl_wbdc_rotor(dynacore::Vector & gamma){
    gamma = dynacore::Vector::Zero(mercury::num_act_joint * 2); 
     
    dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
 
     double ramp = (state_machine_time_)/(end_time_*0.5);
     if( state_machine_time_ > end_time_* 0.5 ) ramp = 1.;
     dynacore::Vector ramp_grav = ramp * grav_;
      
-    //wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, ramp_grav);
+    //wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, ramp_grav);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -168,6 +163,7 @@ void ContactTransBodyCtrl::CtrlInitialization(const std::string & setting_file_n
     ini_body_pos_ = sp_->Q_.head(3);
 
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_rotor_);
     handler.getValue("max_rf_z", max_rf_z_);
     handler.getValue("min_rf_z", min_rf_z_);
 
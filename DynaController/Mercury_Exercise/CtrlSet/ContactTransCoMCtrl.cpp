@@ -35,8 +35,7 @@ ContactTransCoMCtrl::ContactTransCoMCtrl(RobotSystem* robot):
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
 
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
@@ -81,24 +80,16 @@ void ContactTransCoMCtrl::_com_ctrl(dynacore::Vector & gamma){
    gamma = dynacore::Vector::Zero(mercury::num_act_joint * 2); 
     dynacore::Vector jtorque_cmd(mercury::num_act_joint);
 
-    wbdc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
 
     gamma.head(mercury::num_act_joint) = jtorque_cmd;
 
-    dynacore::Matrix A_rotor = A_;
-    for(int i(0); i<mercury::num_act_joint; ++i) {
-        A_rotor(i+mercury::num_virtual,i + mercury::num_virtual) 
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv;
-
-    dynacore::pseudoInverse(A_rotor, 0.00001, A_rotor_inv, 0);
-    wbdc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
     gamma.tail(mercury::num_act_joint) = jtorque_cmd;
 
-    //wbdc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    //wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     //wbdc_->MakeTorque(task_list_, contact_list_, gamma, wbdc_data_);
 
     for(int i(0); i<6; ++i)
@@ -116,17 +107,13 @@ void ContactTransCoMCtrl::_com_ctrl_wbdc_rotor(dynacore::Vector & gamma){
    gamma = dynacore::Vector::Zero(mercury::num_act_joint * 2); 
     
    dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
 
     double ramp = (state_machine_time_)/(end_time_*0.5);
     if( state_machine_time_ > end_time_* 0.5 ) ramp = 1.;
     dynacore::Vector ramp_grav = ramp * grav_;
      
-    //wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, ramp_grav);
+    //wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, ramp_grav);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -239,6 +226,8 @@ void ContactTransCoMCtrl::CtrlInitialization(const std::string & setting_file_na
     robot_sys_->getCoMPosition(ini_com_pos_);
 
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_);
+    _SetQPSolver(handler, wbdc_rotor_);
     handler.getValue("max_rf_z", max_rf_z_);
     handler.getValue("min_rf_z", min_rf_z_);
 
@@ -52,8 +52,7 @@ FootCtrl::FootCtrl(RobotSystem* robot, int swing_foot):Controller(robot),
     }
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
                 fixed_body_contact_->getDim() + 
@@ -92,11 +91,7 @@ void FootCtrl::OneStep(dynacore::Vector & gamma){
 }
 void FootCtrl::_foot_pos_ctrl_wbdc_rotor(dynacore::Vector & gamma){
     dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -106,20 +101,12 @@ void FootCtrl::_foot_pos_ctrl_wbdc_rotor(dynacore::Vector & gamma){
 void FootCtrl::_foot_pos_ctrl(dynacore::Vector & gamma){
     dynacore::Vector jtorque_cmd(mercury::num_act_joint);
 
-    wbdc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
 
     gamma.head(mercury::num_act_joint) = jtorque_cmd;
 
-    dynacore::Matrix A_rotor = A_;
-    for(int i(0); i<mercury::num_act_joint; ++i) {
-        A_rotor(i+mercury::num_virtual,i + mercury::num_virtual) 
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv;
-
-    dynacore::pseudoInverse(A_rotor, 0.00001, A_rotor_inv, 0);
-    wbdc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
     gamma.tail(mercury::num_act_joint) = jtorque_cmd;
 }
@@ -227,6 +214,8 @@ bool FootCtrl::EndOfPhase(){
 }
 void FootCtrl::CtrlInitialization(const std::string & setting_file_name){
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_);
+    _SetQPSolver(handler, wbdc_rotor_);
 
     std::vector<double> tmp_vec;
     handler.getVector("foot_Kp", tmp_vec);
@@ -38,8 +38,7 @@ JPosCtrl::JPosCtrl(RobotSystem* robot):Controller(robot),
     
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(fixed_body_contact_->getDim() + 
                 jpos_task_->getDim(), 100.0);
@@ -77,31 +76,19 @@ void JPosCtrl::OneStep(dynacore::Vector & gamma){
 void JPosCtrl::_jpos_ctrl(dynacore::Vector & gamma){
     dynacore::Vector jtorque_cmd(mercury::num_act_joint);
 
-    wbdc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
 
     gamma.head(mercury::num_act_joint) = jtorque_cmd;
 
-    dynacore::Matrix A_rotor = A_;
-    for(int i(0); i<mercury::num_act_joint; ++i) {
-        A_rotor(i+mercury::num_virtual,i + mercury::num_virtual) 
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv;
-
-    dynacore::pseudoInverse(A_rotor, 0.00001, A_rotor_inv, 0);
-    wbdc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, jtorque_cmd, wbdc_data_);
     gamma.tail(mercury::num_act_joint) = jtorque_cmd;
 }
 
 void JPosCtrl::_jpos_ctrl_wbdc_rotor(dynacore::Vector & gamma){
     dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma.head(mercury::num_act_joint) = fb_cmd;
@@ -193,6 +180,8 @@ void JPosCtrl::CtrlInitialization(const std::string & setting_file_name){
     jpos_ini_ = sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint);
 
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_);
+    _SetQPSolver(handler, wbdc_rotor_);
 
     std::vector<double> tmp_vec;
     // Feedback Gain
@@ -46,6 +46,8 @@ private:
   
   void _ParameterSetting();
   bool _Initialization(Mercury_SensorData* );
+  void _SetRotorInertia(Mercury_SensorData* );
+  dynacore::Vector rotor_inertia_; // of the model: the config or the first sensor data
 
   dynacore::Vector virtual_sensor_;
   dynacore::Vector torque_command_;
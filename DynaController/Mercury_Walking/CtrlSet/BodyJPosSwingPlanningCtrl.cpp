@@ -54,8 +54,7 @@ BodyJPosSwingPlanningCtrl::BodyJPosSwingPlanningCtrl(
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
 
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
@@ -103,11 +102,7 @@ void BodyJPosSwingPlanningCtrl::OneStep(void* _cmd){
 }
 void BodyJPosSwingPlanningCtrl::_body_foot_ctrl(dynacore::Vector & gamma){
     dynacore::Vector fb_cmd = dynacore::Vector::Zero(mercury::num_act_joint);
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            = sp_->rotor_inertia_[i];
-    }
-    wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     gamma = wbdc_rotor_data_->cmd_ff;
@@ -149,9 +144,7 @@ void BodyJPosSwingPlanningCtrl::_task_setup(){
     double vel[3];
     double acc[3];
 
-    foot_traj_.getCurvePoint(traj_time, pos);
-    foot_traj_.getCurveDerPoint(traj_time, 1, vel);
-    foot_traj_.getCurveDerPoint(traj_time, 2, acc);
+    foot_traj_.getCurvePosVelAcc(traj_time, pos, vel, acc);
 
     for(int i(0); i<3; ++i){
         curr_foot_pos_des_[i] = pos[i];
@@ -179,9 +172,7 @@ void BodyJPosSwingPlanningCtrl::_task_setup(){
     //TEST
     if(num_planning_ < 1){
     //if(num_planning_ < 2){
-        swing_leg_traj_.getCurvePoint(traj_time, pos);
-        swing_leg_traj_.getCurveDerPoint(traj_time, 1, vel);
-        swing_leg_traj_.getCurveDerPoint(traj_time, 2, acc);
+        swing_leg_traj_.getCurvePosVelAcc(traj_time, pos, vel, acc);
     }
 
 
@@ -662,6 +653,7 @@ void BodyJPosSwingPlanningCtrl::CtrlInitialization(const std::string & setting_f
 
     // Setting Parameters
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_rotor_);
     handler.getValue("swing_height", swing_height_);
     handler.getValue("push_down_height", push_down_height_);
 
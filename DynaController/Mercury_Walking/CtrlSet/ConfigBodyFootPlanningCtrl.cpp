@@ -74,12 +74,7 @@ void ConfigBodyFootPlanningCtrl::OneStep(void* _cmd){
 }
 
 void ConfigBodyFootPlanningCtrl::_body_foot_ctrl(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    wbwc_->UpdateSetting(A_rotor, coriolis_, grav_);
+    wbwc_->UpdateSetting(A_, coriolis_, grav_);
     wbwc_->computeTorque(des_jpos_, des_jvel_, des_jacc_, gamma);
 
     sp_->qddot_cmd_ = wbwc_->qddot_;
@@ -116,9 +111,7 @@ void ConfigBodyFootPlanningCtrl::_GetBsplineSwingTrajectory(){
     double vel[3];
     double acc[3];
     
-    foot_traj_.getCurvePoint(state_machine_time_, pos);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 1, vel);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 2, acc);
+    foot_traj_.getCurvePosVelAcc(state_machine_time_, pos, vel, acc);
 
     for(int i(0); i<3; ++i){
         curr_foot_pos_des_[i] = pos[i];
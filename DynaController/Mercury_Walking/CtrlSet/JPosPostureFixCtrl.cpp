@@ -36,8 +36,7 @@ JPosPostureFixCtrl::JPosPostureFixCtrl(RobotSystem* robot):Controller(robot),
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(contact_constraint_->getDim() + 
                 jpos_task_->getDim(), 1000.0);
@@ -91,12 +90,7 @@ void JPosPostureFixCtrl::OneStep(void* _cmd){
 
 void JPosPostureFixCtrl::_jpos_ctrl_wbdc_rotor(dynacore::Vector & gamma){
     // WBWC
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    wbwc_->UpdateSetting(A_rotor, coriolis_, grav_);
+    wbwc_->UpdateSetting(A_, coriolis_, grav_);
     wbwc_->computeTorque(des_jpos_, des_jvel_, des_jacc_, gamma);
     sp_->qddot_cmd_ = wbwc_->qddot_;
     sp_->reaction_forces_ = wbwc_->Fr_;
@@ -158,6 +152,7 @@ void JPosPostureFixCtrl::CtrlInitialization(const std::string & setting_file_nam
     jpos_ini_ = sp_->Q_.segment(mercury::num_virtual, mercury::num_act_joint);
 
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_rotor_);
 
     std::vector<double> tmp_vec;
     // Feedback Gain
@@ -104,8 +104,7 @@ JPosSwingCtrl::JPosSwingCtrl(
 
     wbdc_rotor_ = new WBDC_Rotor(act_list);
     wbdc_rotor_data_ = new WBDC_Rotor_ExtraData();
-    wbdc_rotor_data_->A_rotor = 
-        dynacore::Matrix::Zero(mercury::num_qdot, mercury::num_qdot);
+    robot_sys_->getRotorInertia(wbdc_rotor_data_->rotor_inertia);
 
     wbdc_rotor_data_->cost_weight = 
         dynacore::Vector::Constant(
@@ -199,7 +198,7 @@ void JPosSwingCtrl::_body_foot_ctrl(dynacore::Vector & gamma){
         //wbdc_rotor_data_->A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
             //= sp_->rotor_inertia_[i];
     //}
-    //wbdc_rotor_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    //wbdc_rotor_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     //wbdc_rotor_->MakeTorque(task_list_, contact_list_, fb_cmd, wbdc_rotor_data_);
 
     //gamma = wbdc_rotor_data_->cmd_ff;
@@ -214,12 +213,7 @@ void JPosSwingCtrl::_body_foot_ctrl(dynacore::Vector & gamma){
     //sp_->qddot_cmd_ = wbdc_rotor_data_->result_qddot_;
 
     // WBWC
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    wbwc_->UpdateSetting(A_rotor, coriolis_, grav_);
+    wbwc_->UpdateSetting(A_, coriolis_, grav_);
     wbwc_->computeTorque(des_jpos_, des_jvel_, des_jacc_, gamma);
 
     sp_->qddot_cmd_ = wbwc_->qddot_;
@@ -467,6 +461,7 @@ void JPosSwingCtrl::CtrlInitialization(const std::string & setting_file_name){
     std::vector<double> tmp_vec;
     // Setting Parameters
     ParamHandler handler(MercuryConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_rotor_);
     handler.getValue("push_down_height", push_down_height_);
 
     handler.getVector("jpos_swing_delta", tmp_vec);
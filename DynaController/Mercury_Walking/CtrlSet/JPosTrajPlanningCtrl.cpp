@@ -127,12 +127,7 @@ void JPosTrajPlanningCtrl::OneStep(void* _cmd){
     _PostProcessing_Command();
 }
 void JPosTrajPlanningCtrl::_body_foot_ctrl(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<mercury::num_act_joint; ++i){
-        A_rotor(i + mercury::num_virtual, i + mercury::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    wbwc_->UpdateSetting(A_rotor, coriolis_, grav_);
+    wbwc_->UpdateSetting(A_, coriolis_, grav_);
     wbwc_->computeTorque(des_jpos_, des_jvel_, des_jacc_, gamma);
 
     sp_->qddot_cmd_ = wbwc_->qddot_;
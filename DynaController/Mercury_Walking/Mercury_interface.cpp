@@ -219,6 +219,7 @@ bool Mercury_interface::_Initialization(Mercury_SensorData* data){
     }
     //printf("count: %d/ %d\n", count_, waiting_count_);
     if(count_ < waiting_count_){
+        if(count_ == 0) _SetRotorInertia(data);
         for(int i(0); i<mercury::num_act_joint; ++i){
             test_cmd_->jtorque_cmd[i] = 0.;
             test_cmd_->jpos_cmd[i] = data->joint_jpos[i];
@@ -240,8 +241,28 @@ bool Mercury_interface::_Initialization(Mercury_SensorData* data){
     return false;
 }
 
+// The reflected rotor inertia of the model mass matrix comes with the first
+// sensor data, unless INTERFACE_setup.yaml sets rotor_inertia.
+void Mercury_interface::_SetRotorInertia(Mercury_SensorData* data){
+    dynacore::Vector sensed_rotor_inertia(mercury::num_act_joint);
+    for(int i(0); i<mercury::num_act_joint; ++i)
+        sensed_rotor_inertia[i] = data->reflected_rotor_inertia[i];
+
+    if(rotor_inertia_.size() == 0){
+        rotor_inertia_ = sensed_rotor_inertia;
+    } else if(rotor_inertia_.size() != mercury::num_act_joint ||
+            (rotor_inertia_ - sensed_rotor_inertia).cwiseAbs().maxCoeff() > 1.e-6){
+        printf("[Mercury Interface] rotor_inertia of the config differs from the sensor data, using the config\n");
+        dynacore::pretty_print(rotor_inertia_, std::cout, "config rotor inertia");
+        dynacore::pretty_print(sensed_rotor_inertia, std::cout, "sensed rotor inertia");
+    }
+    ((Mercury_Model*)robot_sys_)->setRotorInertia(rotor_inertia_);
+}
+
 void Mercury_interface::_ParameterSetting(){
     ParamHandler handler(MercuryConfigPath"INTERFACE_setup.yaml");
+    // overrides the reflected rotor inertia of the sensor data
+    if(handler.hasKey("rotor_inertia")) handler.getVector("rotor_inertia", rotor_inertia_);
 
     std::string tmp_string;
     bool b_tmp;
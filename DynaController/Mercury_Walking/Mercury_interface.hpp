@@ -34,6 +34,8 @@ private:
   
   void _ParameterSetting();
   bool _Initialization(Mercury_SensorData* );
+  void _SetRotorInertia(Mercury_SensorData* );
+  dynacore::Vector rotor_inertia_; // of the model: the config or the first sensor data
 
   Mercury_Command* test_cmd_;
   // dynacore::Vector filtered_torque_command_;
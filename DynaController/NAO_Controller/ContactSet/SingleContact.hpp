@@ -20,7 +20,7 @@ protected:
   virtual bool _UpdateUf();
   virtual bool _UpdateInequalityVector();
 
-  void _setU(double x, double y, double mu, dynacore::Matrix & U);
+  dynacore::Matrix U_; // contact wrench cone and Fz limit, foot frame
   const RobotSystem* robot_sys_;
   NAO_StateProvider* sp_;
 
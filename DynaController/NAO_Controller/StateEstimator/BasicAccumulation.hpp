@@ -2,7 +2,7 @@
 #define ANGULAR_VELOCITY_ACCUMULATION_NAO
 
 #include <Utils/wrap_eigen.hpp>
-#include <Filter/filters.hpp>
+#include <Filter/filter_bank.hpp>
 
 class BasicAccumulation{
     public:
@@ -26,7 +26,7 @@ class BasicAccumulation{
 
     protected:
         double cutoff_freq_;
-        std::vector<filter*> filtered_acc_;
+        digital_lp_filter_bank filtered_acc_;
 
         void _InitIMUOrientationEstimateFromGravity();
         dynacore::Quaternion global_ori_;
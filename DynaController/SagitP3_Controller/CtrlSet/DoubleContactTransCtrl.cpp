@@ -75,14 +75,7 @@ void DoubleContactTransCtrl::OneStep(void* _cmd){
 }
 
 void DoubleContactTransCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<sagitP3::num_act_joint; ++i){
-        A_rotor(i + sagitP3::num_virtual, i + sagitP3::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(sagitP3::num_virtual, sagitP3::num_act_joint))
@@ -183,6 +176,7 @@ bool DoubleContactTransCtrl::EndOfPhase(){
 void DoubleContactTransCtrl::CtrlInitialization(const std::string & setting_file_name){
     ini_jpos_ = sp_->Q_.segment(sagitP3::num_virtual, sagitP3::num_act_joint);
     ParamHandler handler(SagitP3ConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
     handler.getValue("max_rf_z", max_rf_z_);
     handler.getValue("min_rf_z", min_rf_z_);
     // Feedback Gain
@@ -110,14 +110,7 @@ void FootSwingCtrl::_contact_setup(){
 }
 
 void FootSwingCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    dynacore::Matrix A_rotor = A_;
-    for (int i(0); i<sagitP3::num_act_joint; ++i){
-        A_rotor(i + sagitP3::num_virtual, i + sagitP3::num_virtual)
-            += sp_->rotor_inertia_[i];
-    }
-    dynacore::Matrix A_rotor_inv = A_rotor.inverse();
-
-    wblc_->UpdateSetting(A_rotor, A_rotor_inv, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(sagitP3::num_virtual, sagitP3::num_act_joint))
@@ -261,6 +254,7 @@ void FootSwingCtrl::CtrlInitialization(
 
     // Setting Parameters
     ParamHandler handler(SagitP3ConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
     handler.getValue("swing_height", swing_height_);
     handler.getValue("push_down_height", push_down_height_);
 
@@ -293,9 +287,7 @@ void FootSwingCtrl::_GetBsplineSwingTrajectory(){
     double vel[3];
     double acc[3];
     
-    foot_traj_.getCurvePoint(state_machine_time_, pos);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 1, vel);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 2, acc);
+    foot_traj_.getCurvePosVelAcc(state_machine_time_, pos, vel, acc);
 
     for(int i(0); i<3; ++i){
         curr_foot_pos_des_[i] = pos[i];
@@ -65,7 +65,7 @@ void JPosCtrl::OneStep(void* _cmd){
 }
 
 void JPosCtrl::_jpos_ctrl_wbdc_rotor(dynacore::Vector & gamma){
-    wbdc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wbdc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     wbdc_->MakeTorque(task_list_, contact_list_, gamma, wbdc_data_);
     //dynacore::pretty_print(grav_, std::cout, "gravity");
     //dynacore::pretty_print(gamma, std::cout, "gamma");
@@ -123,6 +123,7 @@ void JPosCtrl::CtrlInitialization(const std::string & setting_file_name){
     jpos_ini_ = sp_->Q_.segment(sagitP3::num_virtual, sagitP3::num_act_joint);
 
     ParamHandler handler(SagitP3ConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wbdc_);
 
     std::vector<double> tmp_vec;
     // Feedback Gain
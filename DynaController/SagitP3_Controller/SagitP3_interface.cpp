@@ -128,6 +128,13 @@ bool SagitP3_interface::_Initialization(SagitP3_SensorData* data){
 
 void SagitP3_interface::_ParameterSetting(){
     ParamHandler handler(SagitP3ConfigPath"INTERFACE_setup.yaml");
+    // reflected rotor inertia of the joints, part of the model mass matrix
+    if(handler.hasKey("rotor_inertia")){
+        dynacore::Vector rotor_inertia;
+        handler.getVector("rotor_inertia", rotor_inertia);
+        ((SagitP3_Model*)robot_sys_)->setRotorInertia(rotor_inertia);
+    }
+
     std::string tmp_string;
     bool b_tmp;
     // Test SETUP
@@ -2,11 +2,18 @@
 #include "Controller.hpp"
 #include <Utils/DataManager.hpp>
 
-Test::Test(RobotSystem* robot):b_first_visit_(true){
+Test::Test(RobotSystem* robot):b_first_visit_(true),
+  num_prepared_(0),
+  prepared_param_(NULL),
+  pending_param_(NULL),
+  applied_generation_(0)
+{
   DataManager::GetDataManager()->RegisterData(&phase_, INT, "phase");
+  ParamWatcher::GetParamWatcher()->addListener(this);
 }
 
 Test::~Test(){
+  ParamWatcher::GetParamWatcher()->removeListener(this);
 }
 
 void Test::getCommand(void* command){
@@ -21,5 +28,69 @@ void Test::getCommand(void* command){
     state_list_[phase_]->LastVisit();
     phase_ = _NextPhase(phase_);
     b_first_visit_ = true;
+    _SetReloadedParam();
   }
 }
+
+void Test::_CtrlInitialization(Controller* ctrl, const std::string & setting_file_name){
+  ctrl->CtrlInitialization(setting_file_name);
+
+  std::lock_guard<std::mutex> lock(reload_mutex_);
+  ReloadCtrl reload_ctrl;
+  reload_ctrl.ctrl = ctrl;
+  reload_ctrl.setting_file_name = setting_file_name;
+  reload_list_.push_back(reload_ctrl);
+}
+
+void Test::_SetReloadedParam(){
+  const ReloadedParamSet* param_set =
+    pending_param_.exchange(NULL, std::memory_order_acq_rel);
+  if(!param_set) return;
+
+  for(size_t i(0); i<param_set->param_list.size(); ++i){
+    param_set->param_list[i].ctrl->SetParam(*param_set->param_list[i].param);
+  }
+  applied_generation_.store(param_set->generation, std::memory_order_release);
+}
+
+// Watcher thread, reload_mutex_ locked
+void Test::_FreeParam(const ReloadedParamSet* param_set){
+  for(size_t i(0); i<reloaded_list_.size(); ++i){
+    if(reloaded_list_[i].get() == param_set){
+      reloaded_list_.erase(reloaded_list_.begin() + i);
+      return;
+    }
+  }
+}
+
+void Test::PrepareReload(){
+  std::lock_guard<std::mutex> lock(reload_mutex_);
+  // Sets the control thread is done with, and a round another listener rejected
+  unsigned long applied = applied_generation_.load(std::memory_order_acquire);
+  for(size_t i(reloaded_list_.size()); i>0; --i){
+    if(reloaded_list_[i - 1]->generation <= applied) reloaded_list_.erase(reloaded_list_.begin() + i - 1);
+  }
+  if(prepared_param_) _FreeParam(prepared_param_);
+  prepared_param_ = NULL;
+
+  std::unique_ptr<ReloadedParamSet> param_set(new ReloadedParamSet());
+  param_set->generation = ++num_prepared_;
+  for(size_t i(0); i<reload_list_.size(); ++i){
+    ReloadedParam reloaded;
+    reloaded.ctrl = reload_list_[i].ctrl;
+    reloaded.param.reset(reload_list_[i].ctrl->LoadParam(reload_list_[i].setting_file_name));
+    if(reloaded.param) param_set->param_list.push_back(reloaded);
+  }
+  prepared_param_ = param_set.get();
+  reloaded_list_.push_back(std::move(param_set));
+}
+
+void Test::CommitReload(){
+  std::lock_guard<std::mutex> lock(reload_mutex_);
+  if(!prepared_param_) return;
+  // Not taken by the control thread: it never sees it anymore
+  const ReloadedParamSet* replaced =
+    pending_param_.exchange(prepared_param_, std::memory_order_acq_rel);
+  if(replaced) _FreeParam(replaced);
+  prepared_param_ = NULL;
+}
@@ -3,11 +3,16 @@
 
 #include <Utils/wrap_eigen.hpp>
 #include <Configuration.h>
+#include <ParamHandler/ParamWatcher.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 class Controller;
+struct CtrlParam;
 class RobotSystem;
 
-class Test{
+class Test: public ParamReloadListener{
 public:
   Test(RobotSystem* );
   virtual ~Test();
@@ -17,13 +22,46 @@ public:
 
   int getPhase(){ return phase_;}
 
+  // ParamWatcher thread: settings of the controllers set up with
+  // _CtrlInitialization, swapped in at the next phase boundary
+  virtual void PrepareReload();
+  virtual void CommitReload();
+
 protected:
   virtual int _NextPhase(const int & phase) = 0;
+  // CtrlInitialization, and the controller follows the edits of its
+  // setting file from then on
+  void _CtrlInitialization(Controller* ctrl, const std::string & setting_file_name);
+  void _SetReloadedParam();
 
   bool b_first_visit_;
   int phase_;
   std::vector<Controller*> state_list_;
 
+  struct ReloadCtrl{
+    Controller* ctrl;
+    std::string setting_file_name;
+  };
+  struct ReloadedParam{
+    Controller* ctrl;
+    std::shared_ptr<const CtrlParam> param;
+  };
+  struct ReloadedParamSet{
+    unsigned long generation;
+    std::vector<ReloadedParam> param_list;
+  };
+  void _FreeParam(const ReloadedParamSet* param_set);
+
+  std::vector<ReloadCtrl> reload_list_;
+  std::mutex reload_mutex_;
+  // The control thread only takes a pointer and never frees: the watcher
+  // thread frees the sets up to the generation it has applied, and the
+  // ones replaced before it took them
+  std::vector<std::unique_ptr<ReloadedParamSet> > reloaded_list_;
+  unsigned long num_prepared_;
+  ReloadedParamSet* prepared_param_;
+  std::atomic<const ReloadedParamSet*> pending_param_;
+  std::atomic<unsigned long> applied_generation_;
 };
 
 
@@ -15,6 +15,7 @@
 
 #include <ParamHandler/ParamHandler.hpp>
 #include <Utils/DataManager.hpp>
+#include <memory>
 
 
 BodyCtrl::BodyCtrl(RobotSystem* robot):Controller(robot),
@@ -103,7 +104,7 @@ void BodyCtrl::OneStep(void* _cmd){
 
 void BodyCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
     // WBLC
-    wblc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(valkyrie::num_virtual, valkyrie::num_act_joint))
@@ -246,15 +247,23 @@ void BodyCtrl::CtrlInitialization(const std::string & setting_file_name){
     jpos_ini_ = sp_->Q_.segment(valkyrie::num_virtual, valkyrie::num_act_joint);
 
     ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
+    _SetQPSolver(handler, wblc_);
 
-    std::vector<double> tmp_vec;
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
+}
+
+const CtrlParam* BodyCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
     // Feedback Gain
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i){
-        Kp_[i] = tmp_vec[i];
-    }
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i){
-        Kd_[i] = tmp_vec[i];
-    }
+    handler.getVector("Kp", param->Kp, valkyrie::num_act_joint);
+    handler.getVector("Kd", param->Kd, valkyrie::num_act_joint);
+    return param.release();
+}
+
+void BodyCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
 }
@@ -20,7 +20,14 @@ class BodyCtrl: public Controller{
         virtual void LastVisit();
         virtual bool EndOfPhase();
 
+        struct Param: public CtrlParam{
+            dynacore::Vector Kp;
+            dynacore::Vector Kd;
+        };
+
         virtual void CtrlInitialization(const std::string & setting_file_name);
+        virtual const CtrlParam* LoadParam(const std::string & setting_file_name) const;
+        virtual void SetParam(const CtrlParam & param);
 
         void setStanceTime(double time) { end_time_ = time; }
         void setStanceHeight(double height){ 
@@ -3,6 +3,7 @@
 #include <Valkyrie_Controller/Valkyrie_StateProvider.hpp>
 #include <ParamHandler/ParamHandler.hpp>
 #include <Planner/PIPM_FootPlacementPlanner/Reversal_LIPM_Planner.hpp>
+#include <Planner/PIPM_FootPlacementPlanner/PlanningService.hpp>
 #include <Utils/utilities.hpp>
 
 #include <WBLC/KinWBC.hpp>
@@ -16,6 +17,7 @@
 #include <Valkyrie_Controller/TaskSet/SelectedJPosTask.hpp>
 
 #include <Valkyrie_Controller/ContactSet/SingleContact.hpp>
+#include <memory>
 
 BodyFootPlanningCtrl::BodyFootPlanningCtrl(
         const RobotSystem* robot, int swing_foot, Planner* planner):
@@ -26,8 +28,15 @@ BodyFootPlanningCtrl::BodyFootPlanningCtrl(
     des_jacc_(valkyrie::num_act_joint),
     waiting_time_limit_(0.02),
     Kp_(valkyrie::num_act_joint),
-    Kd_(valkyrie::num_act_joint)
+    Kd_(valkyrie::num_act_joint),
+    b_planning_started_(false),
+    b_planning_requested_(false),
+    planning_request_time_(0.),
+    planning_deadline_(0.)
 {
+    planning_service_ = new PlanningService(planner);
+    planning_service_->start();
+
     des_jacc_.setZero();
     rfoot_contact_ = new SingleContact(robot_sys_, valkyrie_link::rightFoot);
     lfoot_contact_ = new SingleContact(robot_sys_, valkyrie_link::leftFoot);
@@ -131,7 +140,7 @@ void BodyFootPlanningCtrl::_contact_setup(){
 }
 
 void BodyFootPlanningCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    wblc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(valkyrie::num_virtual, valkyrie::num_act_joint))
@@ -279,23 +288,41 @@ void BodyFootPlanningCtrl::_foot_pos_task_setup(){
 
 void BodyFootPlanningCtrl::_CheckPlanning(){
     if( (state_machine_time_ > 0.5 * end_time_) && b_replanning_ && !b_replaned_) {
+        // Solved by the planning service thread and applied on a later tick.
+        // The deadline runs from the first try, so a worker that is still
+        // busy with a cancelled request cannot hold the planning either.
+        if(!b_planning_started_){
+            b_planning_started_ = true;
+            planning_request_time_ = state_machine_time_;
+            b_planning_requested_ = _RequestReplanning();
+            return;
+        }
         dynacore::Vect3 target_loc;
-        _Replanning(target_loc);
-
-        dynacore::Vect3 target_offset;
-        // X, Y target is originally set by intial_traget_loc
-        for(int i(0); i<2; ++i)
-            target_offset[i] = target_loc[i] - initial_target_loc_[i];
-
-        // Foot height (z) is set by the initial height
-        target_offset[2] = 0.; //target_loc[2] - ini_foot_pos_[2];
-
-        _SetMinJerkOffset(target_offset);
-        b_replaned_ = true;
+        OutputReversalPL pl_output;
+        if(b_planning_requested_ && planning_service_->getResult(target_loc, pl_output)){
+            _Replanning(target_loc, pl_output);
+
+            dynacore::Vect3 target_offset;
+            // X, Y target is originally set by intial_traget_loc
+            for(int i(0); i<2; ++i)
+                target_offset[i] = target_loc[i] - initial_target_loc_[i];
+
+            // Foot height (z) is set by the initial height
+            target_offset[2] = 0.; //target_loc[2] - ini_foot_pos_[2];
+
+            _SetMinJerkOffset(target_offset);
+            b_replaned_ = true;
+        }else if(state_machine_time_ - planning_request_time_ > planning_deadline_){
+            // Too late: keep the nominal target
+            planning_service_->Cancel();
+            b_replaned_ = true;
+        }else if(!b_planning_requested_){
+            b_planning_requested_ = _RequestReplanning();
+        }
     }
 }
 
-void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
+bool BodyFootPlanningCtrl::_RequestReplanning(){
     dynacore::Vect3 com_pos, com_vel;
     // Direct value used
     robot_sys_->getCoMPosition(com_pos);
@@ -311,12 +338,9 @@ void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
 
         // com_pos[i] = sp_->jjpos_body_pos_[i] + body_pt_offset_[i];
     }
-    printf("planning com state: %f, %f, %f, %f\n",
-            com_pos[0], com_pos[1],
-            com_vel[0], com_vel[1]);
-
-    OutputReversalPL pl_output;
     ParamReversalPL pl_param;
+    // the rest of the deadline is for the worker wake up and the pickup
+    pl_param.time_budget = 0.5 * planning_deadline_;
     pl_param.swing_time = end_time_ - state_machine_time_
         + transition_time_ * transition_phase_ratio_
         + stance_time_ * double_stance_ratio_;
@@ -333,10 +357,12 @@ void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
 
     dynacore::Vect3 tmp_global_pos_local = sp_->global_pos_local_;
 
-    planner_->getNextFootLocation(com_pos + tmp_global_pos_local,
-            com_vel,
-            target_loc,
-            &pl_param, &pl_output);
+    return planning_service_->Request(com_pos + tmp_global_pos_local,
+            com_vel, pl_param);
+}
+
+void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc,
+        const OutputReversalPL & pl_output){
     // Time Modification
     replan_moment_ = state_machine_time_;
     end_time_ += pl_output.time_modification;
@@ -348,11 +374,13 @@ void BodyFootPlanningCtrl::_Replanning(dynacore::Vect3 & target_loc){
     for(int i(0); i<2; ++i){
         target_loc[i] += foot_landing_offset_[i];
     }
-    dynacore::pretty_print(target_loc, std::cout, "next foot loc");
 }
 
 void BodyFootPlanningCtrl::FirstVisit(){
     b_replaned_ = false;
+    b_planning_started_ = false;
+    b_planning_requested_ = false;
+    planning_service_->Cancel();
     ini_config_ = sp_->Q_;
     robot_sys_->getPos(valkyrie_link::leftPalm, ini_lhand_pos_);
     robot_sys_->getPos(valkyrie_link::pelvis, ini_body_pos_);
@@ -427,35 +455,14 @@ bool BodyFootPlanningCtrl::EndOfPhase(){
 void BodyFootPlanningCtrl::CtrlInitialization(
         const std::string & setting_file_name){
     ini_base_height_ = sp_->Q_[valkyrie_joint::virtual_Z];
-    std::vector<double> tmp_vec;
 
     // Setting Parameters
     ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
-    handler.getValue("swing_height", swing_height_);
-    handler.getValue("push_down_height", push_down_height_);
-
-    handler.getVector("default_target_foot_location", tmp_vec);
-    for(int i(0); i<3; ++i){
-        default_target_loc_[i] = tmp_vec[i];
-    }
-
-    // Feedback Gain
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<valkyrie::num_act_joint; ++i){
-        Kp_[i] = tmp_vec[i];
-    }
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<valkyrie::num_act_joint; ++i){
-        Kd_[i] = tmp_vec[i];
-    }
-
-    // Body Point offset
-    handler.getVector("body_pt_offset", tmp_vec);
-    for(int i(0); i<2; ++i){
-        body_pt_offset_[i] = tmp_vec[i];
-    }
+    _SetQPSolver(handler, wblc_);
+    planning_deadline_ = ((Reversal_LIPM_Planner*)planner_)->getPlanningDeadline();
 
-    handler.getVector("foot_landing_offset", foot_landing_offset_);
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
 
     static bool b_bodypute_eigenvalue(true);
     if(b_bodypute_eigenvalue){
@@ -468,7 +475,42 @@ void BodyFootPlanningCtrl::CtrlInitialization(
     //printf("[Body Foot JPos Planning Ctrl] Parameter Setup Completed\n");
 }
 
+const CtrlParam* BodyFootPlanningCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
+    dynacore::Vector tmp_vec;
+
+    handler.getValue("swing_height", param->swing_height);
+    handler.getValue("push_down_height", param->push_down_height);
+    handler.getVector("default_target_foot_location", tmp_vec, 3);
+    param->default_target_loc = tmp_vec;
+
+    // Feedback Gain
+    handler.getVector("Kp", param->Kp, valkyrie::num_act_joint);
+    handler.getVector("Kd", param->Kd, valkyrie::num_act_joint);
+
+    // Body Point offset
+    handler.getVector("body_pt_offset", tmp_vec, 2);
+    param->body_pt_offset = tmp_vec;
+    handler.getVector("foot_landing_offset", tmp_vec, 2);
+    param->foot_landing_offset = tmp_vec;
+    return param.release();
+}
+
+void BodyFootPlanningCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    swing_height_ = ctrl_param.swing_height;
+    push_down_height_ = ctrl_param.push_down_height;
+    default_target_loc_ = ctrl_param.default_target_loc;
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
+    body_pt_offset_ = ctrl_param.body_pt_offset;
+    foot_landing_offset_.assign(ctrl_param.foot_landing_offset.data(),
+            ctrl_param.foot_landing_offset.data() + 2);
+}
+
 BodyFootPlanningCtrl::~BodyFootPlanningCtrl(){
+    delete planning_service_;
     delete wblc_;
     delete lfoot_contact_;
     delete rfoot_contact_;
@@ -479,9 +521,7 @@ void BodyFootPlanningCtrl::_GetBsplineSwingTrajectory(){
     double vel[3];
     double acc[3];
 
-    foot_traj_.getCurvePoint(state_machine_time_, pos);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 1, vel);
-    foot_traj_.getCurveDerPoint(state_machine_time_, 2, acc);
+    foot_traj_.getCurvePosVelAcc(state_machine_time_, pos, vel, acc);
 
     for(int i(0); i<3; ++i){
         curr_foot_pos_des_[i] = pos[i];
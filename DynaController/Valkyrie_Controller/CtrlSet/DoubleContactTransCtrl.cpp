@@ -9,6 +9,7 @@
 #include <WBLC/WBLC.hpp>
 #include <Valkyrie_Controller/Valkyrie_DynaCtrl_Definition.h>
 #include <ParamHandler/ParamHandler.hpp>
+#include <memory>
 
 
 DoubleContactTransCtrl::DoubleContactTransCtrl(RobotSystem* robot):
@@ -82,7 +83,7 @@ void DoubleContactTransCtrl::OneStep(void* _cmd){
 }
 
 void DoubleContactTransCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
-    wblc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(valkyrie::num_virtual, valkyrie::num_act_joint))
@@ -182,16 +183,27 @@ bool DoubleContactTransCtrl::EndOfPhase(){
 void DoubleContactTransCtrl::CtrlInitialization(const std::string & setting_file_name){
     ini_jpos_ = sp_->Q_.segment(valkyrie::num_virtual, valkyrie::num_act_joint);
     ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
-    handler.getValue("max_rf_z", max_rf_z_);
-    handler.getValue("min_rf_z", min_rf_z_);
+    _SetQPSolver(handler, wblc_);
+
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
+}
+
+const CtrlParam* DoubleContactTransCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
+    handler.getValue("max_rf_z", param->max_rf_z);
+    handler.getValue("min_rf_z", param->min_rf_z);
     // Feedback Gain
-    std::vector<double> tmp_vec;
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i){
-        Kp_[i] = tmp_vec[i];
-    }
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i){
-        Kd_[i] = tmp_vec[i];
-    }
+    handler.getVector("Kp", param->Kp, valkyrie::num_act_joint);
+    handler.getVector("Kd", param->Kd, valkyrie::num_act_joint);
+    return param.release();
+}
+
+void DoubleContactTransCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    max_rf_z_ = ctrl_param.max_rf_z;
+    min_rf_z_ = ctrl_param.min_rf_z;
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
 }
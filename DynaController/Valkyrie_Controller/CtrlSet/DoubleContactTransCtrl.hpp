@@ -20,7 +20,16 @@ class DoubleContactTransCtrl: public Controller{
         virtual void LastVisit();
         virtual bool EndOfPhase();
 
+        struct Param: public CtrlParam{
+            double max_rf_z;
+            double min_rf_z;
+            dynacore::Vector Kp;
+            dynacore::Vector Kd;
+        };
+
         virtual void CtrlInitialization(const std::string & setting_file_name);
+        virtual const CtrlParam* LoadParam(const std::string & setting_file_name) const;
+        virtual void SetParam(const CtrlParam & param);
 
         void setStanceTime(double stance_time){ end_time_ = stance_time; }
         void setStanceHeight(double height) {
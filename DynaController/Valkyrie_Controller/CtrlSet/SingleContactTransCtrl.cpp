@@ -15,6 +15,7 @@
 #include <ParamHandler/ParamHandler.hpp>
 
 #include <Valkyrie_Controller/ContactSet/SingleContact.hpp>
+#include <memory>
 
 SingleContactTransCtrl::SingleContactTransCtrl(RobotSystem* robot, 
         int moving_foot, bool b_increase):
@@ -103,7 +104,7 @@ void SingleContactTransCtrl::OneStep(void* _cmd){
 
 void SingleContactTransCtrl::_compute_torque_wblc(dynacore::Vector & gamma){
 
-    wblc_->UpdateSetting(A_, Ainv_, coriolis_, grav_);
+    wblc_->UpdateSetting(A_, A_ltl_, coriolis_, grav_);
     dynacore::Vector des_jacc_cmd = des_jacc_ 
         + Kp_.cwiseProduct(des_jpos_ - 
                 sp_->Q_.segment(valkyrie::num_virtual, valkyrie::num_act_joint))
@@ -291,15 +292,28 @@ bool SingleContactTransCtrl::EndOfPhase(){
     return false;
 }
 void SingleContactTransCtrl::CtrlInitialization(const std::string & setting_file_name){
-    std::vector<double> tmp_vec;
     ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
-    handler.getValue("max_rf_z", max_rf_z_);
-    handler.getValue("min_rf_z", min_rf_z_);
+    _SetQPSolver(handler, wblc_);
 
+    std::unique_ptr<const CtrlParam> param(LoadParam(setting_file_name));
+    SetParam(*param);
+}
+
+const CtrlParam* SingleContactTransCtrl::LoadParam(const std::string & setting_file_name) const {
+    ParamHandler handler(ValkyrieConfigPath + setting_file_name + ".yaml");
+    std::unique_ptr<Param> param(new Param());
+    handler.getValue("max_rf_z", param->max_rf_z);
+    handler.getValue("min_rf_z", param->min_rf_z);
     // Feedback Gain
-    handler.getVector("Kp", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i) Kp_[i] = tmp_vec[i];
+    handler.getVector("Kp", param->Kp, valkyrie::num_act_joint);
+    handler.getVector("Kd", param->Kd, valkyrie::num_act_joint);
+    return param.release();
+}
 
-    handler.getVector("Kd", tmp_vec);
-    for(int i(0); i<tmp_vec.size(); ++i) Kd_[i] = tmp_vec[i];
+void SingleContactTransCtrl::SetParam(const CtrlParam & param){
+    const Param & ctrl_param = static_cast<const Param &>(param);
+    max_rf_z_ = ctrl_param.max_rf_z;
+    min_rf_z_ = ctrl_param.min_rf_z;
+    Kp_ = ctrl_param.Kp;
+    Kd_ = ctrl_param.Kd;
 }
@@ -31,8 +31,8 @@ BodyCtrlTest::~BodyCtrlTest(){
 
 void BodyCtrlTest::TestInitialization(){
   // Yaml file name
-  body_up_ctrl_->CtrlInitialization("CTRL_move_to_target_height");
-  body_ctrl_->CtrlInitialization("CTRL_stance");
+  _CtrlInitialization(body_up_ctrl_, "CTRL_move_to_target_height");
+  _CtrlInitialization(body_ctrl_, "CTRL_stance");
 }
 
 int BodyCtrlTest::_NextPhase(const int & phase){
@@ -8,6 +8,7 @@
 
 #include <ParamHandler/ParamHandler.hpp>
 #include <Planner/PIPM_FootPlacementPlanner/Reversal_LIPM_Planner.hpp>
+#include <Planner/PIPM_FootPlacementPlanner/Preview_LIPM_Planner.hpp>
 #include <Utils/DataManager.hpp>
 
 #include <Valkyrie/Valkyrie_Model.hpp>
@@ -22,7 +23,13 @@ WalkingTest::WalkingTest(RobotSystem* robot):Test(robot),
     sp_->global_pos_local_[1] = 0.07;
 
     robot_sys_ = robot;
-    reversal_planner_ = new Reversal_LIPM_Planner();
+    // Planner selection (velocity_reversal or preview)
+    ParamHandler handler(ValkyrieConfigPath"TEST_walking.yaml");
+    std::string planner_name("velocity_reversal");
+    if(handler.hasKey("planner")) handler.getString("planner", planner_name);
+    if(planner_name == "preview") reversal_planner_ = new Preview_LIPM_Planner();
+    else reversal_planner_ = new Reversal_LIPM_Planner();
+    planner_file_ = ValkyrieConfigPath"PLANNER_" + planner_name;
     //phase_ = WkPhase::lift_up;
     phase_ = WkPhase::double_contact_1;
 
@@ -70,18 +77,17 @@ WalkingTest::~WalkingTest(){
 
 void WalkingTest::TestInitialization(){
     // Planner
-    reversal_planner_->PlannerInitialization(
-            ValkyrieConfigPath"PLANNER_velocity_reversal");
+    reversal_planner_->PlannerInitialization(planner_file_);
     // Yaml file name
-    body_fix_ctrl_->CtrlInitialization("CTRL_stance");
+    _CtrlInitialization(body_fix_ctrl_, "CTRL_stance");
     // Transition
-    right_swing_start_trans_ctrl_->CtrlInitialization("CTRL_trans");
-    right_swing_end_trans_ctrl_->CtrlInitialization("CTRL_trans");
-    left_swing_start_trans_ctrl_->CtrlInitialization("CTRL_trans");
-    left_swing_end_trans_ctrl_->CtrlInitialization("CTRL_trans");
+    _CtrlInitialization(right_swing_start_trans_ctrl_, "CTRL_trans");
+    _CtrlInitialization(right_swing_end_trans_ctrl_, "CTRL_trans");
+    _CtrlInitialization(left_swing_start_trans_ctrl_, "CTRL_trans");
+    _CtrlInitialization(left_swing_end_trans_ctrl_, "CTRL_trans");
     // Swing
-    right_swing_ctrl_->CtrlInitialization("CTRL_right_walking_swing");
-    left_swing_ctrl_->CtrlInitialization("CTRL_left_walking_swing");
+    _CtrlInitialization(right_swing_ctrl_, "CTRL_right_walking_swing");
+    _CtrlInitialization(left_swing_ctrl_, "CTRL_left_walking_swing");
 }
 
 int WalkingTest::_NextPhase(const int & phase){
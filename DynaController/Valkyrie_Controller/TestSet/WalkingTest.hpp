@@ -33,6 +33,7 @@ protected:
   void _SettingParameter();
 
   Planner* reversal_planner_;
+  std::string planner_file_;
 
   Controller* body_up_ctrl_;
   Controller* body_fix_ctrl_;
@@ -11,6 +11,7 @@
 #include "Valkyrie_StateEstimator.hpp"
 
 #include <ParamHandler/ParamHandler.hpp>
+#include <ParamHandler/ParamWatcher.hpp>
 #include <Valkyrie/Valkyrie_Model.hpp>
 
 // Walking Test
@@ -152,7 +153,13 @@ bool Valkyrie_interface::_Initialization(Valkyrie_SensorData* data){
 void Valkyrie_interface::_ParameterSetting(){
     ParamHandler handler(ValkyrieConfigPath"INTERFACE_setup.yaml");
     std::string tmp_string;
-    bool b_tmp;
+    bool b_tmp(false);
+    // Watch the files the test loads from here on
+    if(handler.hasKey("param_hot_reload")) handler.getBoolean("param_hot_reload", b_tmp);
+    if(b_tmp){
+        ParamWatcher::GetParamWatcher()->Enable();
+        ParamWatcher::GetParamWatcher()->start();
+    }
     // Test SETUP
     handler.getString("test_name", tmp_string);
         // Walking Test ***********************************
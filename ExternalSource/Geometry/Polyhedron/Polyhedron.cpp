@@ -1,5 +1,9 @@
 #include "Polyhedron.h"
+#ifdef POLYHEDRON_USE_GUROBI
 #include <Optimizer/gurobi/src/gurobi_c++.h>
+#endif
+#include <stdexcept>
+#include <iostream>
 
 Polyhedron::Polyhedron()
     : matPtr_(nullptr)
@@ -37,25 +41,31 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> Polyhedron::hrep(const Eigen::Matrix
 std::pair<Eigen::MatrixXd, Eigen::VectorXd> Polyhedron::vrep()
 {
     dd_MatrixPtr mat = dd_CopyGenerators(polytope_);
-    return ddfMatrix2EigenMatrix(mat);
+    std::pair<Eigen::MatrixXd, Eigen::VectorXd> rep = ddfMatrix2EigenMatrix(mat);
+    dd_FreeMatrix(mat);
+    return rep;
 }
 
 std::pair<Eigen::MatrixXd, Eigen::VectorXd> Polyhedron::hrep()
 {
     dd_MatrixPtr mat = dd_CopyInequalities(polytope_);
-    return ddfMatrix2EigenMatrix(mat);
+    std::pair<Eigen::MatrixXd, Eigen::VectorXd> rep = ddfMatrix2EigenMatrix(mat);
+    dd_FreeMatrix(mat);
+    return rep;
 }
 
 void Polyhedron::printVrep()
 {
     dd_MatrixPtr mat = dd_CopyGenerators(polytope_);
     dd_WriteMatrix(stdout, mat);
+    dd_FreeMatrix(mat);
 }
 
 void Polyhedron::printHrep()
 {
     dd_MatrixPtr mat = dd_CopyInequalities(polytope_);
     dd_WriteMatrix(stdout, mat);
+    dd_FreeMatrix(mat);
 }
 
 /**
@@ -104,18 +114,30 @@ std::pair<Eigen::MatrixXd, Eigen::VectorXd> Polyhedron::ddfMatrix2EigenMatrix(dd
     double sign = (isFromGenerators_ ? -1 : 1);
     auto rows = mat->rowsize;
     auto cols = mat->colsize;
-    Eigen::MatrixXd mOut(rows, cols - 1);
-    Eigen::VectorXd vOut(rows);
+    // linearity rows (equalities, lines) are also added with the opposite sign
+    auto numLin = set_card(mat->linset);
+    Eigen::MatrixXd mOut(rows + numLin, cols - 1);
+    Eigen::VectorXd vOut(rows + numLin);
+    auto linRow = rows;
     for (auto row = 0; row < rows; ++row) {
         vOut(row) = mat->matrix[row][0][0];
         for (auto col = 1; col < cols; ++col)
             mOut(row, col - 1) = sign * mat->matrix[row][col][0];
+        if (set_member(row + 1, mat->linset)) {
+            vOut(linRow) = -vOut(row);
+            mOut.row(linRow) = -mOut.row(row);
+            ++linRow;
+        }
     }
 
     return std::make_pair(mOut, vOut);
 }
 
 Eigen::VectorXd Polyhedron::GetChebyshevCenter(Eigen::MatrixXd A, Eigen::VectorXd b) {
+#ifndef POLYHEDRON_USE_GUROBI
+    std::cout << "[Polyhedron] GetChebyshevCenter needs gurobi" << std::endl;
+    return Eigen::VectorXd::Zero(A.cols() + 1);
+#else
     int dimension(A.cols());
     int num_poly(A.rows());
     Eigen::VectorXd ret = Eigen::VectorXd::Zero(dimension+1); //last element is radius
@@ -172,6 +194,7 @@ Eigen::VectorXd Polyhedron::GetChebyshevCenter(Eigen::MatrixXd A, Eigen::VectorX
     }
 
     return ret;
+#endif
 }
 
 
@@ -1,3 +1,6 @@
+#ifndef POLYHEDRON_H
+#define POLYHEDRON_H
+
 #include <Eigen/Core>
 #include <cdd/src/setoper.h> // Must be included before cdd.h (wtf)
 #include <cdd/src/cdd.h>
@@ -23,7 +26,8 @@ public:
      * and b is a vector which is 1 for vertices and 0 for rays.
      * \param A The matrix part of the representation of the polyhedron.
      * \param b The vector part of the representation of the polyhedron.
-     * \return The H-representation of the polyhedron.
+     * \return The H-representation of the polyhedron, an equality of cdd
+     * (linearity) as two opposite inequalities.
      */
     std::pair<Eigen::MatrixXd, Eigen::VectorXd> hrep(const Eigen::MatrixXd& A, const Eigen::VectorXd& b);
     /* Get the V-representation of the polyhedron
@@ -49,6 +53,7 @@ public:
      *A -- matrix of polytope H-representation
      *b -- vector of polytope H-representation
      *Return (x, y, (z,) r)
+     *Needs gurobi (POLYHEDRON_USE_GUROBI), zero otherwise
      */
     Eigen::VectorXd GetChebyshevCenter(Eigen::MatrixXd A, Eigen::VectorXd b);
 
@@ -65,3 +70,5 @@ private:
     dd_PolyhedraPtr polytope_;
     dd_ErrorType err_;
 };
+
+#endif
@@ -858,6 +858,10 @@ namespace GolDIdnani{
 
     inline void resize(const unsigned int n, const unsigned int m);
     inline void resize(const T& a, const unsigned int n, const unsigned int m);
+    // Rows on external memory, row i at a + i * stride (column i of a column
+    // major matrix with that outer stride). Not copied nor freed; resize
+    // gives the matrix its own storage again.
+    inline void setView(T* a, const unsigned int n, const unsigned int m, const unsigned int stride);
 
 
     inline GVect<T> extractRow(const unsigned int i) const;
@@ -897,16 +901,17 @@ namespace GolDIdnani{
     unsigned int n; // number of rows
     unsigned int m; // number of columns
     T **v; // storage for data
+    bool view; // v[0] is external memory (setView)
   };
 
   template <typename T>
   GMatr<T>::GMatr()
-    : n(0), m(0), v(0)
+    : n(0), m(0), v(0), view(false)
   {}
 
   template <typename T>
   GMatr<T>::GMatr(unsigned int n, unsigned int m)
-    : v(new T*[n])
+    : v(new T*[n]), view(false)
   {
     unsigned int i;
     this->n = n; this->m = m;
@@ -917,7 +922,7 @@ namespace GolDIdnani{
 
   template <typename T>
   GMatr<T>::GMatr(const T& a, unsigned int n, unsigned int m)
-    : v(new T*[n])
+    : v(new T*[n]), view(false)
   {
     unsigned int i, j;
     this->n = n; this->m = m;
@@ -931,7 +936,7 @@ namespace GolDIdnani{
 
   template <class T>
   GMatr<T>::GMatr(const T* a, unsigned int n, unsigned int m)
-    : v(new T*[n])
+    : v(new T*[n]), view(false)
   {
     unsigned int i, j;
     this->n = n; this->m = m;
@@ -945,7 +950,7 @@ namespace GolDIdnani{
 
   template <class T>
   GMatr<T>::GMatr(MType t, const T& a, const T& o, unsigned int n, unsigned int m)
-    : v(new T*[n])
+    : v(new T*[n]), view(false)
   {
     unsigned int i, j;
     this->n = n; this->m = m;
@@ -969,7 +974,7 @@ namespace GolDIdnani{
 
   template <class T>
   GMatr<T>::GMatr(MType t, const GVect<T>& a, const T& o, unsigned int n, unsigned int m)
-    : v(new T*[n])
+    : v(new T*[n]), view(false)
   {
     unsigned int i, j;
     this->n = n; this->m = m;
@@ -993,7 +998,7 @@ namespace GolDIdnani{
 
   template <typename T>
   GMatr<T>::GMatr(const GMatr<T>& rhs)
-    : v(new T*[rhs.n])
+    : v(new T*[rhs.n]), view(false)
   {
     unsigned int i, j;
     n = rhs.n; m = rhs.m;
@@ -1009,7 +1014,8 @@ namespace GolDIdnani{
   GMatr<T>::~GMatr()
   {
     if (v != 0) {
-      delete[] (v[0]);
+      if (!view)
+        delete[] (v[0]);
       delete[] (v);
     }
   }
@@ -1046,20 +1052,44 @@ namespace GolDIdnani{
   inline void GMatr<T>::resize(const unsigned int n, const unsigned int m)
   {
     unsigned int i;
-    if (n == this->n && m == this->m)
+    if (n == this->n && m == this->m && !view)
       return;
     if (v != 0)
       {
-        delete[] (v[0]);
+        if (!view)
+          delete[] (v[0]);
         delete[] (v);
       }
     this->n = n; this->m = m;
+    view = false;
     v = new T*[n];
     v[0] = new T[m * n];
     for (i = 1; i < n; i++)
       v[i] = v[i - 1] + m;
   }
 
+  template <typename T>
+  inline void GMatr<T>::setView(T* a, const unsigned int n, const unsigned int m, const unsigned int stride)
+  {
+    unsigned int i;
+    if (v != 0)
+      {
+        if (!view)
+          delete[] (v[0]);
+        if (n != this->n)
+          {
+            delete[] (v);
+            v = 0;
+          }
+      }
+    if (v == 0)
+      v = new T*[n];
+    this->n = n; this->m = m;
+    view = true;
+    for (i = 0; i < n; i++)
+      v[i] = a + i * stride;
+  }
+
   template <typename T>
   inline void GMatr<T>::resize(const T& a, const unsigned int n, const unsigned int m)
   {
@@ -2176,7 +2206,7 @@ namespace GolDIdnani{
 
 #define det lu_det
 //#define inverse lu_inverse
-#define solve lu_solve
+//#define solve lu_solve // hides solve() members of the including code
 
   /* Random */
 
@@ -1,34 +1,198 @@
 #include "ParamHandler.hpp"
+#include "ParamWatcher.hpp"
+#include <dynacore_yaml-cpp/yaml.h>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <sys/stat.h>
+
+namespace {
+  struct CacheEntry{
+    long long mtime_ns;
+    long long file_size;
+    std::shared_ptr<const ParamTable> table;
+  };
+
+  std::mutex cache_mutex;
+  std::map<std::string, CacheEntry> & _GetCache(){
+    static std::map<std::string, CacheEntry> cache;
+    return cache;
+  }
+
+  template <typename T>
+  bool _Convert(const dynacore_YAML::Node & node, T & value){
+    try{
+      value = node.as<T>();
+    }catch(const dynacore_YAML::Exception &){
+      return false;
+    }
+    return true;
+  }
+
+  // Nested maps become dotted keys ("gain: {Kp: 1}" -> "gain.Kp")
+  void _AddMap(const dynacore_YAML::Node & map, const std::string & prefix,
+               ParamTable & table){
+    for(dynacore_YAML::const_iterator it = map.begin(); it != map.end(); ++it){
+      std::string key = prefix + it->first.as<std::string>();
+      const dynacore_YAML::Node & node = it->second;
+
+      if(node.IsMap()){
+        _AddMap(node, key + ".", table);
+        continue;
+      }
+      ParamEntry & entry = table.entry_map[key];
+      if(node.IsScalar()){
+        entry.b_string = _Convert(node, entry.str_value);
+        entry.b_double = _Convert(node, entry.double_value);
+        entry.b_bool = _Convert(node, entry.bool_value);
+        entry.b_int = _Convert(node, entry.int_value);
+      }else if(node.IsSequence()){
+        entry.b_vector = _Convert(node, entry.vec_value);
+      }
+    }
+  }
+}
+
+std::shared_ptr<const ParamTable> ParamHandler::ParseFile(const std::string & file_name){
+  std::shared_ptr<ParamTable> table(new ParamTable());
+  table->file_name = file_name;
+
+  dynacore_YAML::Node config = dynacore_YAML::LoadFile(file_name);
+  _AddMap(config, "", *table);
+  return table;
+}
+
+bool ParamHandler::GetFileStamp(const std::string & file_name,
+                                long long & mtime_ns, long long & file_size){
+  struct stat st;
+  mtime_ns = 0;
+  file_size = 0;
+  if(stat(file_name.c_str(), &st) != 0) return false;
+#ifdef __APPLE__
+  mtime_ns = st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+  mtime_ns = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+  file_size = st.st_size;
+  return true;
+}
+
+std::shared_ptr<const ParamTable> ParamHandler::LoadTable(const std::string & file_name){
+  // Watched files: latest table published by the watcher thread
+  ParamWatcher* watcher = ParamWatcher::GetParamWatcher();
+  if(watcher->isEnabled()){
+    std::shared_ptr<const ParamTable> table;
+    if(watcher->getTable(file_name, table)) return table;
+  }
+
+  long long mtime_ns, file_size;
+  GetFileStamp(file_name, mtime_ns, file_size);
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::map<std::string, CacheEntry> & cache = _GetCache();
+  std::map<std::string, CacheEntry>::iterator it = cache.find(file_name);
+  if(it != cache.end() &&
+      it->second.mtime_ns == mtime_ns && it->second.file_size == file_size){
+    return it->second.table;
+  }
+
+  CacheEntry entry;
+  entry.mtime_ns = mtime_ns;
+  entry.file_size = file_size;
+  entry.table = ParseFile(file_name);
+  cache[file_name] = entry;
+  if(watcher->isEnabled()) watcher->Watch(file_name, mtime_ns, file_size, entry.table);
+  return entry.table;
+}
+
+void ParamHandler::ClearCache(){
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  _GetCache().clear();
+}
 
 ParamHandler::ParamHandler(const std::string & file_name){
-  config_ = dynacore_YAML::LoadFile(file_name);
+  table_ = LoadTable(file_name);
 }
 
 ParamHandler::~ParamHandler(){}
 
+bool ParamHandler::hasKey(const std::string & key) const {
+  return table_->entry_map.find(key) != table_->entry_map.end();
+}
+
+const ParamEntry & ParamHandler::_GetEntry(const std::string & key) const {
+  std::map<std::string, ParamEntry>::const_iterator it = table_->entry_map.find(key);
+  if(it == table_->entry_map.end()){
+    std::cerr<<"[ParamHandler] "<<table_->file_name<<": no key '"<<key<<"'"<<std::endl;
+    throw std::runtime_error("[ParamHandler] no key " + key);
+  }
+  return it->second;
+}
+
+void ParamHandler::_ConversionError(const std::string & key, const char* type) const {
+  std::cerr<<"[ParamHandler] "<<table_->file_name<<": '"<<key<<
+    "' is not "<<type<<std::endl;
+  throw std::runtime_error("[ParamHandler] bad conversion " + key);
+}
+
 bool ParamHandler::getString(const std::string & key, std::string& str_value) {
-  str_value = config_[key].as<std::string>();
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_string) _ConversionError(key, "a string");
+  str_value = entry.str_value;
   return true;
 }
 
 bool ParamHandler::getVector(const std::string & key,
                              std::vector<double> & vec_value) {
-  vec_value = config_[key].as<std::vector<double> >();
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_vector) _ConversionError(key, "a vector");
+  vec_value = entry.vec_value;
+  return true;
+}
+
+bool ParamHandler::getVector(const std::string & key,
+                             Eigen::VectorXd & vec_value) {
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_vector) _ConversionError(key, "a vector");
+  vec_value = Eigen::Map<const Eigen::VectorXd>(
+      entry.vec_value.data(), entry.vec_value.size());
+  return true;
+}
+
+bool ParamHandler::getVector(const std::string & key,
+                             Eigen::VectorXd & vec_value, int size) {
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_vector) _ConversionError(key, "a vector");
+  if((int)entry.vec_value.size() != size) _ConversionError(key, "of the right size");
+  vec_value = Eigen::Map<const Eigen::VectorXd>(entry.vec_value.data(), size);
+  return true;
+}
+
+bool ParamHandler::getVector(const std::string & key, double* values, int size) {
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_vector) _ConversionError(key, "a vector");
+  if((int)entry.vec_value.size() < size) _ConversionError(key, "long enough");
+  for(int i(0); i<size; ++i) values[i] = entry.vec_value[i];
   return true;
 }
 
 bool ParamHandler::getValue(const std::string & key, double & double_value) {
-  double_value = config_[key].as<double>();
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_double) _ConversionError(key, "a number");
+  double_value = entry.double_value;
   return true;
 }
 
 bool ParamHandler::getBoolean(const std::string & key, bool & bool_value) {
-  bool_value = config_[key].as<bool>();
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_bool) _ConversionError(key, "a boolean");
+  bool_value = entry.bool_value;
   return true;
 }
 
 bool ParamHandler::getInteger(const std::string & key, int & int_value) {
-  int_value = config_[key].as<int>();
+  const ParamEntry & entry = _GetEntry(key);
+  if(!entry.b_int) _ConversionError(key, "an integer");
+  int_value = entry.int_value;
   return true;
 }
@@ -1,10 +1,41 @@
 #ifndef PARAMETER_HANDLER
 #define PARAMETER_HANDLER
 
-#include <dynacore_yaml-cpp/yaml.h>
+#include <Eigen/Dense>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+// One YAML file flattened into typed key -> value entries; the keys of a
+// nested map are joined with '.' ("parent.child").
+// Conversions are done once, when the file is parsed.
+struct ParamEntry{
+  ParamEntry(): b_string(false), b_double(false), b_bool(false),
+    b_int(false), b_vector(false), double_value(0.), bool_value(false),
+    int_value(0){}
+
+  bool b_string;
+  bool b_double;
+  bool b_bool;
+  bool b_int;
+  bool b_vector;
+
+  std::string str_value;
+  double double_value;
+  bool bool_value;
+  int int_value;
+  std::vector<double> vec_value;
+};
+
+struct ParamTable{
+  std::string file_name;
+  std::map<std::string, ParamEntry> entry_map;
+};
+
+// Each file is parsed at most once per process (and again only when its
+// modification time or size changes); every ParamHandler built on the same
+// file shares the same immutable table.
 class ParamHandler{
 public:
   ParamHandler(const std::string & file_name);
@@ -12,11 +43,29 @@ public:
 
   bool getString(const std::string & key, std::string & str_value);
   bool getVector(const std::string & key, std::vector<double> & vec_value);
+  // Fills an Eigen vector directly (resized to the number of elements)
+  bool getVector(const std::string & key, Eigen::VectorXd & vec_value);
+  // Throws unless the vector has exactly 'size' elements
+  bool getVector(const std::string & key, Eigen::VectorXd & vec_value, int size);
+  // Copies the first 'size' elements into 'values'
+  bool getVector(const std::string & key, double* values, int size);
   bool getValue(const std::string & key, double & double_value);
   bool getBoolean(const std::string & key, bool & bool_value);
   bool getInteger(const std::string & key, int & int_value);
 
+  bool hasKey(const std::string & key) const;
+
+  static std::shared_ptr<const ParamTable> LoadTable(const std::string & file_name);
+  static std::shared_ptr<const ParamTable> ParseFile(const std::string & file_name);
+  static bool GetFileStamp(const std::string & file_name,
+                           long long & mtime_ns, long long & file_size);
+  // Forget every parsed file (the next ParamHandler re-parses)
+  static void ClearCache();
+
 protected:
-  dynacore_YAML::Node config_;
+  const ParamEntry & _GetEntry(const std::string & key) const;
+  void _ConversionError(const std::string & key, const char* type) const;
+
+  std::shared_ptr<const ParamTable> table_;
 };
 #endif
@@ -0,0 +1,167 @@
+#include "ParamWatcher.hpp"
+#include <algorithm>
+#include <exception>
+
+thread_local const std::vector<ParamWatcher::NewTable>* ParamWatcher::preparing_list_(NULL);
+
+ParamWatcher* ParamWatcher::GetParamWatcher(){
+  static ParamWatcher watcher_;
+  return & watcher_;
+}
+
+ParamWatcher::ParamWatcher(): dynacore_pThread(),
+  num_watched_(0),
+  num_reader_(0),
+  b_enabled_(false),
+  num_reload_(0),
+  polling_period_(0.5)
+{
+  for(int i(0); i<MAX_NUM_WATCHED_FILE; ++i){
+    watched_list_[i].mtime_ns = 0;
+    watched_list_[i].file_size = 0;
+    watched_list_[i].current.store(NULL, std::memory_order_relaxed);
+  }
+}
+
+ParamWatcher::~ParamWatcher(){
+  int num_watched = num_watched_.load(std::memory_order_acquire);
+  for(int i(0); i<num_watched; ++i) delete watched_list_[i].current.load();
+  for(size_t i(0); i<retired_list_.size(); ++i) delete retired_list_[i];
+}
+
+void ParamWatcher::Enable(){
+  b_enabled_.store(true, std::memory_order_release);
+}
+
+// The reader count and the version swap are sequentially consistent: a
+// reader counted after the watcher saw none loads the new version
+bool ParamWatcher::getTable(const std::string & file_name,
+                            std::shared_ptr<const ParamTable> & table) const {
+  num_reader_.fetch_add(1);
+  const std::shared_ptr<const ParamTable> * version = _GetVersion(file_name);
+  if(version) table = *version;
+  num_reader_.fetch_sub(1);
+  return version != NULL;
+}
+
+const std::shared_ptr<const ParamTable> *
+ParamWatcher::_GetVersion(const std::string & file_name) const {
+  int num_watched = num_watched_.load(std::memory_order_acquire);
+  for(int i(0); i<num_watched; ++i){
+    if(watched_list_[i].file_name == file_name){
+      if(preparing_list_){
+        for(size_t j(0); j<preparing_list_->size(); ++j){
+          if((*preparing_list_)[j].idx == i) return &(*preparing_list_)[j].table;
+        }
+      }
+      return watched_list_[i].current.load();
+    }
+  }
+  return NULL;
+}
+
+// Called by ParamHandler::LoadTable (serialized by its cache lock)
+void ParamWatcher::Watch(const std::string & file_name,
+                         long long mtime_ns, long long file_size,
+                         const std::shared_ptr<const ParamTable> & table){
+  if(_GetVersion(file_name)) return;
+
+  int idx = num_watched_.load(std::memory_order_relaxed);
+  if(idx >= MAX_NUM_WATCHED_FILE){
+    printf("[ParamWatcher] too many files, %s is not watched\n", file_name.c_str());
+    return;
+  }
+  std::shared_ptr<const ParamTable> * version =
+    new std::shared_ptr<const ParamTable>(table);
+  watched_list_[idx].file_name = file_name;
+  watched_list_[idx].mtime_ns = mtime_ns;
+  watched_list_[idx].file_size = file_size;
+  watched_list_[idx].current.store(version, std::memory_order_relaxed);
+  num_watched_.store(idx + 1, std::memory_order_release);
+}
+
+void ParamWatcher::addListener(ParamReloadListener* listener){
+  std::lock_guard<std::mutex> lock(listener_mutex_);
+  listener_list_.push_back(listener);
+}
+
+void ParamWatcher::removeListener(ParamReloadListener* listener){
+  std::lock_guard<std::mutex> lock(listener_mutex_);
+  listener_list_.erase(std::remove(listener_list_.begin(), listener_list_.end(), listener),
+                       listener_list_.end());
+}
+
+// Watcher thread, listener_mutex_ locked
+bool ParamWatcher::_PrepareReload(const std::vector<NewTable> & new_list){
+  bool b_accepted(true);
+  preparing_list_ = &new_list;
+  for(size_t i(0); i<listener_list_.size(); ++i){
+    try{
+      listener_list_[i]->PrepareReload();
+    }catch(const std::exception & e){
+      b_accepted = false;
+      for(size_t j(0); j<new_list.size(); ++j){
+        printf("[ParamWatcher] reject %s (%s)\n",
+               watched_list_[new_list[j].idx].file_name.c_str(), e.what());
+      }
+      break;
+    }
+  }
+  preparing_list_ = NULL;
+  return b_accepted;
+}
+
+void ParamWatcher::run(){
+  startPeriod(polling_period_);
+  long long mtime_ns, file_size;
+  std::vector<NewTable> new_list;
+
+  while(true){
+    // No reader now: none can still hold a version retired before
+    if(!retired_list_.empty() && num_reader_.load() == 0){
+      for(size_t j(0); j<retired_list_.size(); ++j) delete retired_list_[j];
+      retired_list_.clear();
+    }
+    new_list.clear();
+    int num_watched = num_watched_.load(std::memory_order_acquire);
+    for(int i(0); i<num_watched; ++i){
+      WatchedFile & watched = watched_list_[i];
+      if(!ParamHandler::GetFileStamp(watched.file_name, mtime_ns, file_size)) continue;
+      if(mtime_ns == watched.mtime_ns && file_size == watched.file_size) continue;
+
+      watched.mtime_ns = mtime_ns;
+      watched.file_size = file_size;
+
+      std::shared_ptr<const ParamTable> table;
+      try{
+        table = ParamHandler::ParseFile(watched.file_name);
+      }catch(const std::exception & e){
+        // Half-written or broken file: keep the old table until it changes again
+        printf("[ParamWatcher] fail to reload %s (%s)\n",
+               watched.file_name.c_str(), e.what());
+        continue;
+      }
+      NewTable new_table;
+      new_table.idx = i;
+      new_table.table = table;
+      new_list.push_back(new_table);
+    }
+
+    if(!new_list.empty()){
+      std::lock_guard<std::mutex> listener_lock(listener_mutex_);
+      // Rejected: the old tables stay until the files change again
+      if(_PrepareReload(new_list)){
+        for(size_t j(0); j<new_list.size(); ++j){
+          WatchedFile & watched = watched_list_[new_list[j].idx];
+          std::shared_ptr<const ParamTable> * version =
+            new std::shared_ptr<const ParamTable>(new_list[j].table);
+          retired_list_.push_back(watched.current.exchange(version));
+          printf("[ParamWatcher] reload %s\n", watched.file_name.c_str());
+        }
+        num_reload_.fetch_add(1, std::memory_order_release);
+        for(size_t j(0); j<listener_list_.size(); ++j) listener_list_[j]->CommitReload();
+      }
+    }
+    waitNextPeriod();
+  }
+}
@@ -0,0 +1,93 @@
+#ifndef PARAMETER_WATCHER
+#define PARAMETER_WATCHER
+
+#include "ParamHandler.hpp"
+#include <Utils/dynacore_pThread.hpp>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#define MAX_NUM_WATCHED_FILE 128
+
+// Builds what it needs from reloaded files on the watcher thread, before the
+// new tables are published
+class ParamReloadListener{
+public:
+  virtual ~ParamReloadListener(){}
+
+  // ParamHandler objects built in here already see the new tables. Throwing
+  // rejects the reload: none of the new tables is published.
+  virtual void PrepareReload() = 0;
+  // The tables seen by PrepareReload are published
+  virtual void CommitReload() = 0;
+};
+
+// Re-parses edited YAML files off the control thread.
+//
+// Once started, every file loaded through ParamHandler is watched. When one
+// changes, the watcher thread parses it and publishes the new immutable
+// table with an atomic pointer swap; ParamHandler objects built afterwards
+// see the new values without touching the file system. A replaced version
+// is freed by the watcher on a later poll when no reader is inside
+// getTable: a reader that comes after the swap only sees the new one. The
+// readers never wait for (or are waited on by) the watcher.
+//
+// A round of edited files is published only when every listener could
+// build its settings from it (a half-saved file missing a key is rejected
+// and kept out until it changes again). Test uses this to prepare the
+// controller settings here and only swap them in at a phase boundary.
+class ParamWatcher: public dynacore_pThread{
+public:
+  static ParamWatcher* GetParamWatcher();
+  virtual ~ParamWatcher();
+
+  virtual void run();
+  void setPollingPeriod(double period){ polling_period_ = period; }
+  bool isEnabled() const { return b_enabled_.load(std::memory_order_acquire); }
+  void Enable();
+
+  // Latest table of a watched file (false when it is not watched)
+  bool getTable(const std::string & file_name,
+                std::shared_ptr<const ParamTable> & table) const;
+  void Watch(const std::string & file_name, long long mtime_ns, long long file_size,
+             const std::shared_ptr<const ParamTable> & table);
+
+  unsigned long getNumReload() const { return num_reload_.load(std::memory_order_acquire); }
+
+  void addListener(ParamReloadListener* listener);
+  void removeListener(ParamReloadListener* listener);
+
+private:
+  ParamWatcher();
+
+  struct NewTable{
+    int idx;
+    std::shared_ptr<const ParamTable> table;
+  };
+  bool _PrepareReload(const std::vector<NewTable> & new_list);
+  const std::shared_ptr<const ParamTable> * _GetVersion(const std::string & file_name) const;
+  // Tables of the round being prepared, seen only by the watcher thread
+  static thread_local const std::vector<NewTable>* preparing_list_;
+
+  struct WatchedFile{
+    std::string file_name;
+    long long mtime_ns; // watcher thread only (after registration)
+    long long file_size;
+    std::atomic<const std::shared_ptr<const ParamTable>*> current;
+  };
+
+  WatchedFile watched_list_[MAX_NUM_WATCHED_FILE];
+  std::atomic<int> num_watched_;
+  // Threads inside getTable, and the versions they may still be reading
+  // (watcher thread only)
+  mutable std::atomic<int> num_reader_;
+  std::vector<const std::shared_ptr<const ParamTable>*> retired_list_;
+  std::vector<ParamReloadListener*> listener_list_;
+  std::mutex listener_mutex_;
+
+  std::atomic<bool> b_enabled_;
+  std::atomic<unsigned long> num_reload_;
+  double polling_period_;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef DYNACORE_KALMAN_FILTER
+#define DYNACORE_KALMAN_FILTER
+
+#include <Eigen/Dense>
+
+namespace dynacore{
+// Kalman filter (and EKF) core with fixed state / observation dimensions.
+//
+// Prediction: the caller propagates the state (linear or not) and gives
+// the transition (Jacobian) F; without F the covariance only grows by Q.
+//
+// Update: with diagonal observation noise the rows are processed one at a
+// time as scalar updates, which needs no matrix inverse and lets masked
+// rows (e.g. an invisible marker) be skipped. The covariance uses the
+// Joseph form, (I - k h) P (I - k h)' + r k k', as a rank-2 update that
+// only reads the columns of P where h is non-zero. updateBatch() takes a
+// full R instead.
+template <int NX, int NZ>
+class KalmanFilter{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    typedef Eigen::Matrix<double, NX, 1> StateVector;
+    typedef Eigen::Matrix<double, NX, NX> StateMatrix;
+    typedef Eigen::Matrix<double, NZ, 1> ObsVector;
+    typedef Eigen::Matrix<double, NZ, NX> ObsMatrix;
+    typedef Eigen::Matrix<double, NZ, NZ> ObsCovMatrix;
+    typedef Eigen::Matrix<bool, NZ, 1> ObsMask;
+
+    KalmanFilter(){
+        x_.setZero();
+        P_.setIdentity();
+        Q_.setIdentity();
+    }
+
+    const StateVector & getState() const { return x_; }
+    const StateMatrix & getCovariance() const { return P_; }
+    const StateMatrix & getProcessNoise() const { return Q_; }
+    void setState(const StateVector & x){ x_ = x; }
+    void setCovariance(const StateMatrix & P){ P_ = P; }
+    void setProcessNoise(const StateMatrix & Q){ Q_ = Q; }
+
+    // x = x_pred, P = P + Q (F = I)
+    void predict(const StateVector & x_pred){
+        x_ = x_pred;
+        P_ += Q_;
+    }
+    // x = x_pred, P = F P F' + Q
+    void predict(const StateVector & x_pred, const StateMatrix & F){
+        x_ = x_pred;
+        StateMatrix FP;
+        FP.noalias() = F * P_;
+        P_.noalias() = FP * F.transpose();
+        P_ += Q_;
+    }
+
+    // z: measurement of H x, r: variance of each row
+    void update(const ObsVector & z, const ObsMatrix & H, const ObsVector & r){
+        for(int i(0); i<NZ; ++i) _ScalarUpdate(z[i], H.row(i), r[i]);
+    }
+    // Rows with valid[i] == false are skipped
+    void update(const ObsVector & z, const ObsMatrix & H, const ObsVector & r,
+                const ObsMask & valid){
+        for(int i(0); i<NZ; ++i){
+            if(valid[i]) _ScalarUpdate(z[i], H.row(i), r[i]);
+        }
+    }
+    // Correlated observation noise
+    void updateBatch(const ObsVector & z, const ObsMatrix & H, const ObsCovMatrix & R){
+        Eigen::Matrix<double, NX, NZ> PHt;
+        PHt.noalias() = P_ * H.transpose();
+        ObsCovMatrix S = R;
+        S.noalias() += H * PHt;
+        Eigen::Matrix<double, NX, NZ> K = S.ldlt().solve(PHt.transpose()).transpose();
+
+        x_.noalias() += K * (z - H * x_);
+        StateMatrix A = StateMatrix::Identity();
+        A.noalias() -= K * H;
+        StateMatrix AP;
+        AP.noalias() = A * P_;
+        P_.noalias() = AP * A.transpose();
+        P_.noalias() += K * R * K.transpose();
+    }
+
+protected:
+    StateVector x_;
+    StateMatrix P_;
+    StateMatrix Q_; // process noise
+
+    void _ScalarUpdate(double z, const Eigen::Matrix<double, 1, NX> & h, double r){
+        StateVector Ph; Ph.setZero();
+        double hx(0.);
+        for(int j(0); j<NX; ++j){
+            if(h[j] == 0.) continue;
+            Ph += P_.col(j) * h[j];
+            hx += h[j] * x_[j];
+        }
+        double s(r);
+        for(int j(0); j<NX; ++j){
+            if(h[j] != 0.) s += h[j] * Ph[j];
+        }
+        StateVector k = Ph / s;
+        x_ += k * (z - hx);
+        // Joseph form: P - k Ph' - Ph k' + s k k'
+        P_.noalias() -= k * Ph.transpose();
+        P_.noalias() -= Ph * k.transpose();
+        P_.noalias() += (s * k) * k.transpose();
+    }
+};
+}
+
+#endif
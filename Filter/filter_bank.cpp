@@ -0,0 +1,129 @@
+#include <math.h>
+#include <stdio.h>
+#include "filter_bank.hpp"
+
+iir2_filter_bank::iir2_filter_bank(int num_channel):
+    num_channel_(num_channel),
+    t_s_(0.)
+{
+    in1_ = dynacore::Vector::Zero(num_channel_);
+    in2_ = dynacore::Vector::Zero(num_channel_);
+    in3_ = dynacore::Vector::Zero(num_channel_);
+    out1_ = dynacore::Vector::Zero(num_channel_);
+    out2_ = dynacore::Vector::Zero(num_channel_);
+    for(int i(0); i<2; ++i){
+        in_prev_[i] = dynacore::Vector::Zero(num_channel_);
+        out_prev_[i] = dynacore::Vector::Zero(num_channel_);
+    }
+}
+
+iir2_filter_bank::~iir2_filter_bank(void)
+{
+}
+
+void iir2_filter_bank::input(const Eigen::Ref<const dynacore::Vector> & lpf_in)
+{
+    // new output written over y[-2], then the histories are rotated
+    out_prev_[1].array() = in1_.array()*lpf_in.array() + in2_.array()*in_prev_[0].array()
+        + in3_.array()*in_prev_[1].array() //input component
+        + out1_.array()*out_prev_[0].array() + out2_.array()*out_prev_[1].array(); //output component
+    out_prev_[0].swap(out_prev_[1]);
+    in_prev_[0].swap(in_prev_[1]);
+    in_prev_[0] = lpf_in;
+}
+
+void iir2_filter_bank::clear(void)
+{
+    for(int i(0); i<2; ++i){
+        in_prev_[i].setZero();
+        out_prev_[i].setZero();
+    }
+}
+
+void iir2_filter_bank::setCutoff(double w_c)
+{
+    for(int i(0); i<num_channel_; ++i) _SetCoefficient(i, w_c);
+}
+
+void iir2_filter_bank::setCutoff(int idx, double w_c)
+{
+    _SetCoefficient(idx, w_c);
+}
+
+void iir2_filter_bank::setCutoff(const dynacore::Vector & w_c)
+{
+    if(w_c.size() != num_channel_){
+        printf("[Filter Bank] cutoff size (%d) does not match the channels (%d)\n",
+               (int)w_c.size(), num_channel_);
+        return;
+    }
+    for(int i(0); i<num_channel_; ++i) _SetCoefficient(i, w_c[i]);
+}
+
+
+digital_lp_filter_bank::digital_lp_filter_bank(int num_channel, double w_c, double t_s):
+    iir2_filter_bank(num_channel)
+{
+    t_s_ = t_s;
+    setCutoff(w_c);
+}
+
+digital_lp_filter_bank::~digital_lp_filter_bank(void)
+{
+}
+
+// same coefficients as digital_lp_filter (including its float denominator)
+void digital_lp_filter_bank::_SetCoefficient(int idx, double w_c)
+{
+    double t_s(t_s_);
+    float den = 2500*t_s*t_s*w_c*w_c  + 7071*t_s*w_c + 10000;
+
+    in1_[idx] = 2500*t_s*t_s*w_c*w_c / den;
+    in2_[idx] = 5000*t_s*t_s*w_c*w_c / den;
+    in3_[idx] = 2500*t_s*t_s*w_c*w_c / den;
+    out1_[idx] = -(5000*t_s*t_s*w_c*w_c  - 20000) / den;
+    out2_[idx] = -(2500*t_s*t_s*w_c*w_c  - 7071*t_s*w_c + 10000) / den;
+}
+
+
+deriv_lp_filter_bank::deriv_lp_filter_bank(int num_channel, double w_c, double t_s):
+    iir2_filter_bank(num_channel)
+{
+    t_s_ = t_s;
+    setCutoff(w_c);
+}
+
+deriv_lp_filter_bank::~deriv_lp_filter_bank(void)
+{
+}
+
+// same coefficients as deriv_lp_filter
+void deriv_lp_filter_bank::_SetCoefficient(int idx, double w_c)
+{
+    double t_s(t_s_);
+    double a = 1.4142;
+    double den = 4 + 2*a*w_c*t_s + t_s*t_s*w_c*w_c;
+
+    in1_[idx] = 2*t_s*w_c*w_c / den;
+    in2_[idx] = 0;
+    in3_[idx] = -2.*t_s*w_c*w_c / den;
+    out1_[idx] = -1. *(-8 + t_s*t_s*w_c*w_c*2) / den;
+    out2_[idx] = -1. *(4 - 2*a * w_c*t_s + t_s*t_s*w_c*w_c) / den;
+}
+
+
+AverageFilterBank::AverageFilterBank(int num_channel, double dt, double t_const, double limit):
+    dt_(dt), t_const_(t_const)
+{
+    est_value_ = dynacore::Vector::Zero(num_channel);
+    update_value_ = dynacore::Vector::Zero(num_channel);
+    limit_ = dynacore::Vector::Constant(num_channel, limit);
+}
+
+AverageFilterBank::~AverageFilterBank(){}
+void AverageFilterBank::clear(){ est_value_.setZero(); }
+void AverageFilterBank::input(const Eigen::Ref<const dynacore::Vector> & input){
+    update_value_ = input - est_value_;
+    update_value_ = (update_value_.array().abs() > limit_.array()).select(0., update_value_);
+    est_value_ += (dt_/(dt_ + t_const_))*update_value_;
+}
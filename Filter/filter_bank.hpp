@@ -0,0 +1,81 @@
+#ifndef FILTER_BANK_
+#define FILTER_BANK_
+
+#include <Utils/wrap_eigen.hpp>
+
+// N channels of one filter type, stored as one array per coefficient /
+// history term (structure of arrays) so that a single input() call updates
+// every channel with vectorized element-wise operations. Each channel gives
+// the same response as the scalar filter in filters.hpp.
+
+// Second order IIR:
+// y = in1 x + in2 x[-1] + in3 x[-2] + out1 y[-1] + out2 y[-2]
+class iir2_filter_bank
+{
+public:
+	iir2_filter_bank(int num_channel);
+	virtual ~iir2_filter_bank(void);
+	void input(const Eigen::Ref<const dynacore::Vector> & input_value);
+	const dynacore::Vector & output(void) const { return out_prev_[0]; }
+	double output(int idx) const { return out_prev_[0][idx]; }
+	void clear(void);
+	int getNumChannel(void) const { return num_channel_; }
+
+	// per channel cutoff [rad/s]
+	void setCutoff(double w_c);
+	void setCutoff(int idx, double w_c);
+	void setCutoff(const dynacore::Vector & w_c);
+
+protected:
+	virtual void _SetCoefficient(int idx, double w_c) = 0;
+
+	int num_channel_;
+	double t_s_;
+	dynacore::Vector in1_, in2_, in3_, out1_, out2_;
+	dynacore::Vector in_prev_[2];
+	dynacore::Vector out_prev_[2];
+};
+
+// Bank of digital_lp_filter
+class digital_lp_filter_bank : public iir2_filter_bank
+{
+public:
+	digital_lp_filter_bank(int num_channel, double w_c, double t_s);
+	virtual ~digital_lp_filter_bank(void);
+protected:
+	virtual void _SetCoefficient(int idx, double w_c);
+};
+
+// Bank of deriv_lp_filter
+class deriv_lp_filter_bank : public iir2_filter_bank
+{
+public:
+	deriv_lp_filter_bank(int num_channel, double w_c, double t_s);
+	virtual ~deriv_lp_filter_bank(void);
+protected:
+	virtual void _SetCoefficient(int idx, double w_c);
+};
+
+// Bank of AverageFilter, with a rejection limit per channel
+class AverageFilterBank
+{
+public:
+	AverageFilterBank(int num_channel, double dt, double t_const, double limit);
+	~AverageFilterBank();
+	void input(const Eigen::Ref<const dynacore::Vector> & input_value);
+	const dynacore::Vector & output(void) const { return est_value_; }
+	double output(int idx) const { return est_value_[idx]; }
+	void clear(void);
+	int getNumChannel(void) const { return est_value_.size(); }
+
+	void setLimit(int idx, double limit){ limit_[idx] = limit; }
+	void setLimit(const dynacore::Vector & limit){ limit_ = limit; }
+
+private:
+	dynacore::Vector est_value_;
+	dynacore::Vector update_value_;
+	dynacore::Vector limit_;
+	double dt_;
+	double t_const_;
+};
+#endif
@@ -0,0 +1,81 @@
+#include "PlanningService.hpp"
+#include <errno.h>
+#include <mutex>
+
+namespace {
+  // Left and right swing controllers share one planner; never run it twice at once
+  std::mutex planner_mutex;
+}
+
+PlanningService::PlanningService(Planner* planner):
+  dynacore_pThread(),
+  planner_(planner),
+  state_(IDLE),
+  b_stop_(false),
+  request_id_(0),
+  result_id_(0),
+  wanted_id_(0)
+{
+  sem_init(&request_sem_, 0, 0);
+  com_pos_.setZero();
+  com_vel_.setZero();
+  target_loc_.setZero();
+}
+
+PlanningService::~PlanningService(){
+  // Let the worker finish the current solve (it may hold the planner lock)
+  if(isRunning){
+    b_stop_.store(true, std::memory_order_release);
+    sem_post(&request_sem_);
+    pthread_join(sejong_thread, NULL);
+    isRunning = false;
+  }
+  sem_destroy(&request_sem_);
+}
+
+bool PlanningService::Request(const dynacore::Vect3 & com_pos,
+                              const dynacore::Vect3 & com_vel,
+                              const ParamReversalPL & param){
+  if(state_.load(std::memory_order_acquire) == REQUESTED) return false;
+
+  com_pos_ = com_pos;
+  com_vel_ = com_vel;
+  param_ = param;
+  wanted_id_ = ++request_id_;
+
+  state_.store(REQUESTED, std::memory_order_release);
+  sem_post(&request_sem_);
+  return true;
+}
+
+bool PlanningService::getResult(dynacore::Vect3 & target_loc,
+                                OutputReversalPL & output){
+  if(state_.load(std::memory_order_acquire) != DONE) return false;
+  if(wanted_id_ == 0 || result_id_ != wanted_id_) return false;
+
+  target_loc = target_loc_;
+  output = output_;
+  wanted_id_ = 0;
+  return true;
+}
+
+void PlanningService::run(){
+  while(true){
+    if(sem_wait(&request_sem_) != 0){
+      if(errno == EINTR) continue;
+      printf("[Planning Service] sem_wait failed\n");
+      return;
+    }
+    if(b_stop_.load(std::memory_order_acquire)) return;
+    if(state_.load(std::memory_order_acquire) != REQUESTED) continue;
+
+    {
+      std::lock_guard<std::mutex> lock(planner_mutex);
+      planner_->getNextFootLocation(com_pos_, com_vel_, target_loc_,
+                                    &param_, &output_);
+    }
+    result_id_ = request_id_;
+
+    state_.store(DONE, std::memory_order_release);
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef PLANNING_SERVICE
+#define PLANNING_SERVICE
+
+#include "Reversal_LIPM_Planner.hpp"
+#include <Utils/dynacore_pThread.hpp>
+#include <atomic>
+#include <semaphore.h>
+
+// Runs Reversal_LIPM_Planner::getNextFootLocation on a worker thread.
+//
+// The control thread posts a CoM state snapshot with Request() and polls
+// getResult() on the following ticks. Neither call blocks, allocates or
+// prints; the worker does not print either, the CoM state, target and
+// swing time of each solve are in the "planner_data" log it writes. A request that is not needed anymore (deadline, phase change) is
+// dropped with Cancel(); its result is never returned.
+class PlanningService: public dynacore_pThread{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  PlanningService(Planner* planner);
+  virtual ~PlanningService();
+
+  virtual void run();
+
+  // false when the worker is still busy with an earlier request
+  bool Request(const dynacore::Vect3 & com_pos,
+               const dynacore::Vect3 & com_vel,
+               const ParamReversalPL & param);
+  // true once, when the solution of the last request is ready
+  bool getResult(dynacore::Vect3 & target_loc, OutputReversalPL & output);
+  void Cancel(){ wanted_id_ = 0; }
+
+private:
+  enum State{ IDLE, REQUESTED, DONE };
+
+  Planner* planner_;
+  sem_t request_sem_;
+  std::atomic<int> state_;
+  std::atomic<bool> b_stop_;
+
+  // written by the control thread unless state_ == REQUESTED
+  unsigned long request_id_;
+  dynacore::Vect3 com_pos_;
+  dynacore::Vect3 com_vel_;
+  ParamReversalPL param_;
+
+  // written by the worker while state_ == REQUESTED
+  unsigned long result_id_;
+  dynacore::Vect3 target_loc_;
+  OutputReversalPL output_;
+
+  // control thread only
+  unsigned long wanted_id_;
+};
+
+#endif
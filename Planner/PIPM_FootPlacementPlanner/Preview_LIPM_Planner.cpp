@@ -0,0 +1,275 @@
+#include "Preview_LIPM_Planner.hpp"
+#include <ParamHandler/ParamHandler.hpp>
+#include <Utils/utilities.hpp>
+
+Preview_LIPM_Planner::Preview_LIPM_Planner():
+  Reversal_LIPM_Planner(),
+  num_step_(0),
+  max_qp_iter_(50),
+  nominal_step_time_(0.4),
+  nominal_step_width_(0.25),
+  time_modification_limit_(2, 0.),
+  step_weight_(1.),
+  time_weight_(1.),
+  dcm_weight_(10.),
+  b_warm_start_(false),
+  num_qp_iter_(0),
+  b_qp_converged_(false),
+  time_budget_(0.)
+{
+  prev_stance_.setZero();
+  setNumPreviewStep(3);
+}
+
+Preview_LIPM_Planner::~Preview_LIPM_Planner(){}
+
+void Preview_LIPM_Planner::setNumPreviewStep(int num_step){
+  if(num_step < 1) num_step = 1;
+  num_step_ = num_step;
+
+  int dim(1 + 2*num_step_);
+  H_ = dynacore::Matrix::Zero(dim, dim);
+  g_ = dynacore::Vector::Zero(dim);
+  lb_ = dynacore::Vector::Zero(dim);
+  ub_ = dynacore::Vector::Zero(dim);
+  z_ = dynacore::Vector::Zero(dim);
+  active_.assign(dim, 0);
+  b_warm_start_ = false;
+}
+
+void Preview_LIPM_Planner::PlannerInitialization(const std::string & file){
+  Reversal_LIPM_Planner::PlannerInitialization(file);
+  ParamHandler handler(file + ".yaml");
+
+  int num_step;
+  handler.getInteger("num_preview_step", num_step);
+  setNumPreviewStep(num_step);
+  handler.getInteger("max_qp_iteration", max_qp_iter_);
+
+  handler.getValue("nominal_step_time", nominal_step_time_);
+  handler.getValue("nominal_step_width", nominal_step_width_);
+  handler.getVector("time_modification_limit", time_modification_limit_);
+
+  handler.getValue("step_weight", step_weight_);
+  handler.getValue("time_weight", time_weight_);
+  handler.getValue("dcm_weight", dcm_weight_);
+
+  printf("[Preview Planner] Parameter Setup is completed (%d steps)\n", num_step_);
+}
+
+// global CoM pos
+void Preview_LIPM_Planner::getNextFootLocation(
+                              const dynacore::Vect3 & com_pos,
+                              const dynacore::Vect3 & com_vel,
+                              dynacore::Vect3 & target_loc,
+                              const void* additional_input,
+                              void* additional_output){
+  if(!b_set_omega_){
+    printf("[Preview Planner] Omega is not set\n");
+    exit(0);
+  }
+  clock_.start();
+  const ParamReversalPL* _input = ((const ParamReversalPL*) additional_input);
+  OutputReversalPL* _output = ((OutputReversalPL*) additional_output);
+  time_budget_ = _input->time_budget * 1000.;
+
+  dynacore::Vect2 dcm, stance;
+  for(int i(0); i<2; ++i){
+    dcm[i] = com_pos[i] + com_vel[i]/omega_;
+    stance[i] = _input->stance_foot_loc[i];
+  }
+
+  _BuildQP(dcm, stance, _input);
+  _WarmStart(stance);
+  _SolveBoxQP();
+  prev_stance_ = stance;
+  b_warm_start_ = true;
+
+  double new_swing_time = log(z_[0])/omega_;
+  _output->time_modification = new_swing_time - _input->swing_time;
+
+  target_loc[0] = stance[0] + z_[1];
+  target_loc[1] = stance[1] + z_[1 + num_step_];
+  target_loc[2] = 0.;
+
+  std::vector<dynacore::Vect2> switch_state(2);
+  _computeSwitchingState(new_swing_time, com_pos, com_vel,
+                         _input->stance_foot_loc, switch_state);
+  _output->switching_state[0] = switch_state[0][0];
+  _output->switching_state[1] = switch_state[1][0];
+  _output->switching_state[2] = switch_state[0][1];
+  _output->switching_state[3] = switch_state[1][1];
+
+  // save data
+  for(int i(0); i<2; ++i){
+    planner_save_data_[i] = com_pos[i];
+    planner_save_data_[2 + i] = com_vel[i];
+    planner_save_data_[4 + i] = switch_state[i][0];
+    planner_save_data_[6 + i] = switch_state[i][1];
+    planner_save_data_[8 + i] = target_loc[i];
+  }
+  planner_save_data_[10] = new_swing_time;
+  dynacore::saveVector(planner_save_data_, "planner_data");
+}
+
+void Preview_LIPM_Planner::_BuildQP(const dynacore::Vect2 & dcm,
+                                    const dynacore::Vect2 & stance,
+                                    const ParamReversalPL* input){
+  int dim(1 + 2*num_step_);
+  double a = exp(omega_ * nominal_step_time_);
+  H_.setZero();
+  g_.setZero();
+
+  // Timing: tau = exp(omega * t_switch)
+  double min_time = std::max(input->swing_time + time_modification_limit_[0], 0.01);
+  double max_time = std::max(input->swing_time + time_modification_limit_[1], min_time);
+  lb_[0] = exp(omega_ * min_time);
+  ub_[0] = exp(omega_ * max_time);
+  double tau_nom = std::min(std::max(exp(omega_ * input->swing_time), lb_[0]), ub_[0]);
+  H_(0, 0) += time_weight_;
+  g_[0] -= time_weight_ * tau_nom;
+
+  // Nominal steps: toward des_loc, alternating sides
+  double side = input->b_positive_sidestep ? 1. : -1.;
+  dynacore::Vect2 drift;
+  for(int i(0); i<2; ++i) drift[i] = (input->des_loc[i] - stance[i])/num_step_;
+
+  dynacore::Vector m(dim);
+  for(int axis(0); axis<2; ++axis){
+    int offset(1 + axis*num_step_);
+    // xi_1 = u0 + (xi_0 - u0) * tau ;  u_k = u0 + sum(d_j)
+    dynacore::Vector xi_m = dynacore::Vector::Zero(dim);
+    dynacore::Vector u_m = dynacore::Vector::Zero(dim);
+    xi_m[0] = dcm[axis] - stance[axis];
+    double step_side(side);
+    double d_nom(0.);
+
+    for(int k(0); k<num_step_; ++k){
+      int idx(offset + k);
+      if(axis == 0){
+        lb_[idx] = x_step_length_limit_[0];
+        ub_[idx] = x_step_length_limit_[1];
+        d_nom = drift[0];
+      }else{
+        if(step_side > 0.){
+          lb_[idx] = y_step_length_limit_[0];
+          ub_[idx] = y_step_length_limit_[1];
+        }else{
+          lb_[idx] = -y_step_length_limit_[1];
+          ub_[idx] = -y_step_length_limit_[0];
+        }
+        d_nom = step_side * nominal_step_width_ + drift[1];
+      }
+      d_nom = std::min(std::max(d_nom, lb_[idx]), ub_[idx]);
+      H_(idx, idx) += step_weight_;
+      g_[idx] -= step_weight_ * d_nom;
+
+      // next stance and the DCM at the end of its step (nominal period)
+      u_m[idx] = 1.;
+      xi_m = (1. - a) * u_m + a * xi_m;
+      step_side = -step_side;
+    }
+
+    // Terminal DCM offset of the periodic gait for the next nominal step
+    double o_nom;
+    if(axis == 0) o_nom = d_nom/(a - 1.);
+    else o_nom = step_side * nominal_step_width_/(1. + a);
+
+    // xi_{N+1} - u_N (relative to u0, constants cancel), scaled back by
+    // a^N so that long horizons stay well conditioned
+    double scale = pow(a, -num_step_);
+    m = scale * (xi_m - u_m);
+    o_nom *= scale;
+    H_ += dcm_weight_ * m * m.transpose();
+    g_ -= dcm_weight_ * o_nom * m;
+  }
+  H_ += 1.e-8 * dynacore::Matrix::Identity(dim, dim);
+}
+
+void Preview_LIPM_Planner::_WarmStart(const dynacore::Vect2 & stance){
+  int dim(1 + 2*num_step_);
+  if(b_warm_start_ && (stance - prev_stance_).norm() > 1.e-6){
+    // One step was taken: shift the previewed steps
+    for(int axis(0); axis<2; ++axis){
+      int offset(1 + axis*num_step_);
+      for(int k(0); k<num_step_ - 1; ++k) z_[offset + k] = z_[offset + k + 1];
+    }
+  }else if(!b_warm_start_){
+    z_ = 0.5 * (lb_ + ub_);
+  }
+  for(int i(0); i<dim; ++i){
+    if(z_[i] <= lb_[i]){ z_[i] = lb_[i]; active_[i] = -1; }
+    else if(z_[i] >= ub_[i]){ z_[i] = ub_[i]; active_[i] = 1; }
+    else active_[i] = 0;
+  }
+}
+
+// Primal active-set method for box constraints. Every iterate is feasible,
+// so stopping at max_qp_iter_ still gives a usable plan.
+void Preview_LIPM_Planner::_SolveBoxQP(){
+  int dim(1 + 2*num_step_);
+  std::vector<int> free_idx;
+  free_idx.reserve(dim);
+  b_qp_converged_ = false;
+
+  bool b_free_optimal(false);
+
+  for(num_qp_iter_ = 0; num_qp_iter_ < max_qp_iter_; ++num_qp_iter_){
+    // Out of time: keep the last (feasible) iterate
+    if(time_budget_ > 0. && clock_.stop() > time_budget_) break;
+    dynacore::Vector grad = H_ * z_ + g_;
+
+    free_idx.clear();
+    for(int i(0); i<dim; ++i) if(active_[i] == 0) free_idx.push_back(i);
+    int num_free(free_idx.size());
+
+    dynacore::Vector p_free = dynacore::Vector::Zero(num_free);
+    if(num_free > 0 && !b_free_optimal){
+      dynacore::Matrix H_free(num_free, num_free);
+      dynacore::Vector grad_free(num_free);
+      for(int i(0); i<num_free; ++i){
+        grad_free[i] = grad[free_idx[i]];
+        for(int j(0); j<num_free; ++j) H_free(i, j) = H_(free_idx[i], free_idx[j]);
+      }
+      p_free = -H_free.ldlt().solve(grad_free);
+    }
+
+    if(b_free_optimal || p_free.norm() < 1.e-10){
+      b_free_optimal = false;
+      // Stationary on the free set: release the bound with the worst multiplier
+      int release(-1);
+      double worst(1.e-10);
+      for(int i(0); i<dim; ++i){
+        double violation = active_[i] * grad[i];
+        if(active_[i] != 0 && violation > worst){ worst = violation; release = i; }
+      }
+      if(release < 0){
+        b_qp_converged_ = true;
+        break;
+      }
+      active_[release] = 0;
+      continue;
+    }
+
+    // Longest feasible step along p
+    double alpha(1.);
+    int block(-1);
+    for(int i(0); i<num_free; ++i){
+      int idx(free_idx[i]);
+      if(p_free[i] < 0.){
+        double t = (lb_[idx] - z_[idx])/p_free[i];
+        if(t < alpha){ alpha = t; block = idx; }
+      }else if(p_free[i] > 0.){
+        double t = (ub_[idx] - z_[idx])/p_free[i];
+        if(t < alpha){ alpha = t; block = idx; }
+      }
+    }
+    for(int i(0); i<num_free; ++i) z_[free_idx[i]] += alpha * p_free[i];
+    // Full Newton step: minimum on this free set, check multipliers next
+    b_free_optimal = (block < 0);
+    if(block >= 0){
+      active_[block] = (z_[block] - lb_[block] < ub_[block] - z_[block]) ? -1 : 1;
+      z_[block] = (active_[block] < 0) ? lb_[block] : ub_[block];
+    }
+  }
+}
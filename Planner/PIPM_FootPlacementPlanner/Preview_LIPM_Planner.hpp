@@ -0,0 +1,75 @@
+#ifndef PREVIEW_PLANNER_LINEAR_INVERTED_PENDULUM
+#define PREVIEW_PLANNER_LINEAR_INVERTED_PENDULUM
+
+#include "Reversal_LIPM_Planner.hpp"
+#include <Utils/Clock.hpp>
+
+// Receding-horizon footstep planner on the LIPM divergent component of
+// motion (DCM, xi = x + xdot/omega).
+//
+// Decision variables: tau = exp(omega * t_switch) of the current step and
+// the next N step vectors (dx, dy). With the later steps on the nominal
+// period the DCM at every touchdown is affine in them, so the problem is a
+// QP with box constraints only (step length limits, timing limits). It is
+// solved with a primal active-set method that is warm-started from the
+// previous solution and stops after max_qp_iteration or when
+// ParamReversalPL::time_budget has passed since getNextFootLocation was
+// called (the iterate is always feasible, isQPConverged() is false).
+//
+// Takes the same ParamReversalPL / OutputReversalPL as the reversal
+// planner, so it can replace it in the swing controllers.
+class Preview_LIPM_Planner: public Reversal_LIPM_Planner{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  Preview_LIPM_Planner();
+  virtual ~Preview_LIPM_Planner();
+
+  virtual void PlannerInitialization(const std::string & setting_file);
+
+  virtual void getNextFootLocation(const dynacore::Vect3 & com_pos,
+                                   const dynacore::Vect3 & com_vel,
+                                   dynacore::Vect3 & target_loc,
+                                   const void* additional_input = NULL,
+                                   void* additional_output = NULL);
+
+  void setNumPreviewStep(int num_step);
+  int getNumPreviewStep() const { return num_step_; }
+  int getNumQPIteration() const { return num_qp_iter_; }
+  bool isQPConverged() const { return b_qp_converged_; }
+
+protected:
+  int num_step_;
+  int max_qp_iter_;
+  double nominal_step_time_;
+  double nominal_step_width_;
+  std::vector<double> time_modification_limit_;
+
+  double step_weight_;
+  double time_weight_;
+  double dcm_weight_;
+
+  // QP: min 0.5 z'Hz + g'z, lb <= z <= ub
+  dynacore::Matrix H_;
+  dynacore::Vector g_;
+  dynacore::Vector lb_;
+  dynacore::Vector ub_;
+  dynacore::Vector z_;
+  std::vector<int> active_; // -1: lower, 1: upper, 0: free
+
+  // warm start
+  bool b_warm_start_;
+  dynacore::Vect2 prev_stance_;
+
+  int num_qp_iter_;
+  bool b_qp_converged_;
+  dynacore::Clock clock_;
+  double time_budget_; // (ms)
+
+  void _BuildQP(const dynacore::Vect2 & dcm, const dynacore::Vect2 & stance,
+                const ParamReversalPL* input);
+  void _WarmStart(const dynacore::Vect2 & stance);
+  void _SolveBoxQP();
+};
+
+#endif
@@ -8,6 +8,7 @@ Reversal_LIPM_Planner::Reversal_LIPM_Planner():
   Planner(),
   com_vel_limit_(2),
   b_set_omega_(false),
+  planning_deadline_(0.),
   planner_save_data_(11)
 {
 
@@ -62,10 +63,8 @@ void Reversal_LIPM_Planner::getNextFootLocation(
   while(check_switch != 0){
     if(check_switch > 0){ // Too small velocity increase time
       new_swing_time *= 1.1;
-      printf("Too small velocity.. increase time: %f\n", new_swing_time);
     } else{ // Too larget velocity decrease time
       new_swing_time *= 0.9;
-      printf("Too large velocity.. decrease time: %f\n", new_swing_time);
     }
     _computeSwitchingState(new_swing_time, com_pos, com_vel, _input->stance_foot_loc, switch_state);
 
@@ -220,6 +219,7 @@ void Reversal_LIPM_Planner::PlannerInitialization(const std::string & file){
   handler.getVector("x_step_length_limit", x_step_length_limit_);
   handler.getVector("y_step_length_limit", y_step_length_limit_);
   handler.getVector("com_velocity_limit", com_vel_limit_);
+  handler.getValue("planning_deadline", planning_deadline_);
 
   printf("[Reversal Planner] Parameter Setup is completed\n");
 }
@@ -6,10 +6,13 @@
 
 class ParamReversalPL{
 public:
+  ParamReversalPL(): time_budget(0.){}
+
   double swing_time;
   dynacore::Vect2 des_loc;
   dynacore::Vect3 stance_foot_loc;
   bool b_positive_sidestep;
+  double time_budget; // (sec) of the planner's iterations, <= 0: no limit
 };
 
 class OutputReversalPL{
@@ -37,6 +40,8 @@ public:
     omega_ = sqrt(9.81/com_height);
   }
   void CheckEigenValues(double swing_time);
+  // (sec) a controller keeps its target when the solve takes longer
+  double getPlanningDeadline() const { return planning_deadline_; }
 
 protected:
   // current com state: (x, y, xdot, ydot) : 4
@@ -54,6 +59,7 @@ protected:
 
   double omega_;
   bool b_set_omega_;
+  double planning_deadline_;
 
   void _computeSwitchingState(double swing_time,
                               const dynacore::Vect3& com_pos,
@@ -1,5 +1,5 @@
 #include "Obstacle.h"
-#include <Utils/utilities.h>
+#include <Utils/utilities.hpp>
 
 MovementParam::MovementParam()
 {
@@ -7,13 +7,13 @@ MovementParam::MovementParam()
   axis_ = X_AXIS;
   joint_ = REVOLUTE;
   plan_ = LINEAR;
-  xyz_axis_offset_ = sejong::Vect3::Zero();
+  xyz_axis_offset_ = dynacore::Vect3::Zero();
   velocity_ = M_PI/4.;
   offset_   = 0.;
 }
 
 MovementParam::MovementParam(movement_axis axis, joint_type joint, motion_plan plan,
-              sejong::Vect3 xyz_axis_offset, double plan_amp_or_vel, double plan_freq_or_offset )
+              dynacore::Vect3 xyz_axis_offset, double plan_amp_or_vel, double plan_freq_or_offset )
 {
   axis_  = axis;
   joint_ = joint;
@@ -35,7 +35,7 @@ MovementParam::MovementParam(movement_axis axis, joint_type joint, motion_plan p
 }
 
 MovementParam::MovementParam(movement_axis axis, joint_type joint, motion_plan plan,
-              sejong::Vect3 xyz_axis_offset, double plan_amp, double plan_freq, double plan_offset )
+              dynacore::Vect3 xyz_axis_offset, double plan_amp, double plan_freq, double plan_offset )
 {
   axis_  = axis;
   joint_ = joint;
@@ -59,11 +59,11 @@ MovementParam::MovementParam(movement_axis axis, joint_type joint, motion_plan p
 Obstacle::Obstacle()
 {
   IsStatic = false;
-  init_pos_ = sejong::Vect3::Zero();
-  lwh_      = sejong::Vect3::Ones();
+  init_pos_ = dynacore::Vect3::Zero();
+  lwh_      = dynacore::Vect3::Ones();
 }
 
-Obstacle::Obstacle(const sejong::Vect3& init_pos, const sejong::Vect3& lwh)
+Obstacle::Obstacle(const dynacore::Vect3& init_pos, const dynacore::Vect3& lwh)
 {
   IsStatic = false;
   init_pos_ = init_pos;
@@ -80,8 +80,8 @@ void Obstacle::add_movement(const MovementParam& param) {
 }
 
 
-void Obstacle::get_transform(const double& sim_time_, sejong::Transform& tf) const {
-  tf = sejong::Transform::Identity();
+void Obstacle::get_transform(const double& sim_time_, dynacore::Transform& tf) const {
+  tf = dynacore::Transform::Identity();
   double pos_adj;
 
   // std::vector<const MovementParam>::iterator it;
@@ -101,11 +101,11 @@ void Obstacle::get_transform(const double& sim_time_, sejong::Transform& tf) con
   //   {
   //     case MovementParam::REVOLUTE:
   //       tf *= Eigen::Translation<double,3>( init_pos_ + it->xyz_axis_offset_);
-  //       tf *= Eigen::AngleAxis<double>(pos_adj, sejong::Vect3::Unit(it->axis_));
+  //       tf *= Eigen::AngleAxis<double>(pos_adj, dynacore::Vect3::Unit(it->axis_));
   //       tf *= Eigen::Translation<double,3>( -init_pos_ - it->xyz_axis_offset_);
   //       break;
   //     case MovementParam::PRISMATIC:
-  //       tf *= Eigen::Translation<double,3>(pos_adj * sejong::Vect3::Unit(it->axis_));
+  //       tf *= Eigen::Translation<double,3>(pos_adj * dynacore::Vect3::Unit(it->axis_));
   //       break;
   //   }
   // }
@@ -126,11 +126,11 @@ void Obstacle::get_transform(const double& sim_time_, sejong::Transform& tf) con
     {
       case MovementParam::REVOLUTE:
         tf *= Eigen::Translation<double,3>( init_pos_ + movements[i].xyz_axis_offset_);
-        tf *= Eigen::AngleAxis<double>(pos_adj, sejong::Vect3::Unit(movements[i].axis_));
+        tf *= Eigen::AngleAxis<double>(pos_adj, dynacore::Vect3::Unit(movements[i].axis_));
         tf *= Eigen::Translation<double,3>( -init_pos_ - movements[i].xyz_axis_offset_);
         break;
       case MovementParam::PRISMATIC:
-        tf *= Eigen::Translation<double,3>(pos_adj * sejong::Vect3::Unit(movements[i].axis_));
+        tf *= Eigen::Translation<double,3>(pos_adj * dynacore::Vect3::Unit(movements[i].axis_));
         break;
     }
   }
@@ -138,11 +138,11 @@ void Obstacle::get_transform(const double& sim_time_, sejong::Transform& tf) con
 
 
 bool Obstacle::is_collision(const double& sim_time_, const double x, const double y, const double radius) const {
-  sejong::Transform tf;
+  dynacore::Transform tf;
   get_transform(sim_time_, tf);
   tf = tf.inverse();
 
-  sejong::Vect3 pos;
+  dynacore::Vect3 pos;
   pos << x, y, 0.;
   pos = tf * pos;
 
@@ -160,39 +160,39 @@ bool Obstacle::is_collision(const double& sim_time_, const double x, const doubl
 }
 
 
-void Obstacle::get_init_corner( const int& index, sejong::Vect3& coordinates ) const
+void Obstacle::get_init_corner( const int& index, dynacore::Vect3& coordinates ) const
 {
   switch(index)
   {
     case 0:  coordinates = init_pos_; break;
-    case 1:  coordinates = init_pos_ + lwh_.cwiseProduct( sejong::Vect3(1.,0.,0.) ); break;
-    case 2:  coordinates = init_pos_ + lwh_.cwiseProduct( sejong::Vect3(1.,1.,0.) ); break;
-    case 3:  coordinates = init_pos_ + lwh_.cwiseProduct( sejong::Vect3(0.,1.,0.) ); break;
-    case 4:  coordinates = init_pos_ + lwh_.cwiseProduct( sejong::Vect3(0.,0.,1.) ); break;
-    case 5:  coordinates = init_pos_ + lwh_.cwiseProduct( sejong::Vect3(1.,0.,1.) ); break;
-    case 6:  coordinates = init_pos_ + lwh_.cwiseProduct( sejong::Vect3(1.,1.,1.) ); break;
-    case 7:  coordinates = init_pos_ + lwh_.cwiseProduct( sejong::Vect3(0.,1.,1.) ); break;
+    case 1:  coordinates = init_pos_ + lwh_.cwiseProduct( dynacore::Vect3(1.,0.,0.) ); break;
+    case 2:  coordinates = init_pos_ + lwh_.cwiseProduct( dynacore::Vect3(1.,1.,0.) ); break;
+    case 3:  coordinates = init_pos_ + lwh_.cwiseProduct( dynacore::Vect3(0.,1.,0.) ); break;
+    case 4:  coordinates = init_pos_ + lwh_.cwiseProduct( dynacore::Vect3(0.,0.,1.) ); break;
+    case 5:  coordinates = init_pos_ + lwh_.cwiseProduct( dynacore::Vect3(1.,0.,1.) ); break;
+    case 6:  coordinates = init_pos_ + lwh_.cwiseProduct( dynacore::Vect3(1.,1.,1.) ); break;
+    case 7:  coordinates = init_pos_ + lwh_.cwiseProduct( dynacore::Vect3(0.,1.,1.) ); break;
   }
 }
 
-void Obstacle::get_velocity( const double& sim_time_, sejong::Vect3& vel ){
+void Obstacle::get_velocity( const double& sim_time_, dynacore::Vect3& vel ){
   double dt(0.0001);
-  sejong::Transform tf_1;
-  sejong::Transform tf_2;
+  dynacore::Transform tf_1;
+  dynacore::Transform tf_2;
   get_transform(sim_time_, tf_1);
   get_transform(sim_time_+dt, tf_2);
-  sejong::Vect3 delta_pos;
-  sejong::Vect3 cent;
+  dynacore::Vect3 delta_pos;
+  dynacore::Vect3 cent;
   get_centroid(cent);
   delta_pos = tf_2 * cent - tf_1 * cent;
   vel = delta_pos/dt;
 }
 
-void Obstacle::get_position( const double& sim_time_, sejong::Vector& pos ){
+void Obstacle::get_position( const double& sim_time_, dynacore::Vector& pos ){
   pos.setZero();
-  sejong::Transform tf;
-  sejong::Vect3 delta_pos;
-  sejong::Vect3 cent;
+  dynacore::Transform tf;
+  dynacore::Vect3 delta_pos;
+  dynacore::Vect3 cent;
   get_transform(sim_time_, tf);
   get_centroid(cent);
   //pos.head(3) = tf * cent - cent;
@@ -201,7 +201,7 @@ void Obstacle::get_position( const double& sim_time_, sejong::Vector& pos ){
   pos.tail(3) = (tf.rotation()).eulerAngles(0,1,2);
 }
 
-void Obstacle::get_centroid( sejong::Vect3& coordinates )
+void Obstacle::get_centroid( dynacore::Vect3& coordinates )
 {
   coordinates = init_pos_ + lwh_/2.;
 }
@@ -25,13 +25,13 @@ void ObstacleBuilder::save_obs_vectors(const std::vector<Obstacle> &obs_list)
 
 void ObstacleBuilder::save_obs_vectors(const std::vector<Obstacle> & obs_list, double sim_time, double step_size)
 {
-    sejong::Transform tf;
+    dynacore::Transform tf;
 
-    sejong::Vector corners(9);
-    sejong::Vect3 one_corner(3);
+    dynacore::Vector corners(9);
+    dynacore::Vect3 one_corner(3);
 
     corners.setConstant(obs_list.size());// First line should tell matlab how many obstacles to read per frame
-    sejong::saveVector(corners, "obs_anim");  // First line should tell matlab how many obstacles to read per frame
+    dynacore::saveVector(corners, "obs_anim");  // First line should tell matlab how many obstacles to read per frame
 
     for(double t = 0.; t < sim_time; t += step_size)
     {
@@ -60,7 +60,7 @@ void ObstacleBuilder::save_obs_vectors(const std::vector<Obstacle> & obs_list, d
         corners[7] = one_corner[0];
         corners[8] = one_corner[1];
 
-        sejong::saveVector(corners, "obs_anim");
+        dynacore::saveVector(corners, "obs_anim");
       }
     }
 }
@@ -73,16 +73,16 @@ void ObstacleBuilder::add_kiva_bots()
   double phase_lag(M_PI/10.);
 
   mov_param_1 = MovementParam(MovementParam::Y_AXIS, MovementParam::PRISMATIC, MovementParam::SINUSOID,
-                              sejong::Vect3::Zero(), 2, freq , 0.);
+                              dynacore::Vect3::Zero(), 2, freq , 0.);
 
   mov_param_2 = MovementParam(MovementParam::X_AXIS, MovementParam::PRISMATIC, MovementParam::SINUSOID,
-                              sejong::Vect3::Zero(), 2., freq , 0.);
+                              dynacore::Vect3::Zero(), 2., freq , 0.);
 
-  mov_param_3 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, sejong::Vect3::Zero(), 0, M_PI/4);
+  mov_param_3 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, dynacore::Vect3::Zero(), 0, M_PI/4);
 
-  mov_param_4 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, sejong::Vect3::Zero(), 0, M_PI/2);
+  mov_param_4 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, dynacore::Vect3::Zero(), 0, M_PI/2);
 
-  mov_param_5 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, sejong::Vect3::Zero(), 0, -M_PI/4);
+  mov_param_5 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, dynacore::Vect3::Zero(), 0, -M_PI/4);
 
   init_pos << 2., -3., 0.;
   lwh      <<   0.445, 0.277, 0.17;
@@ -123,9 +123,9 @@ void ObstacleBuilder::add_kiva_bots()
   // obs_list_.push_back(obs);
 
   //test
-  // mov_param_5 = MovementParam(MovementParam::X_AXIS, MovementParam::PRISMATIC, MovementParam::LINEAR, sejong::Vect3::Zero(), 1., 0.);
+  // mov_param_5 = MovementParam(MovementParam::X_AXIS, MovementParam::PRISMATIC, MovementParam::LINEAR, dynacore::Vect3::Zero(), 1., 0.);
 
-  // mov_param_6 = MovementParam(MovementParam::Y_AXIS, MovementParam::PRISMATIC, MovementParam::SINUSOID, sejong::Vect3::Zero(), 0.5, M_PI/4.);
+  // mov_param_6 = MovementParam(MovementParam::Y_AXIS, MovementParam::PRISMATIC, MovementParam::SINUSOID, dynacore::Vect3::Zero(), 0.5, M_PI/4.);
 
   // mov_param_7 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::SINUSOID, lwh/2, M_PI/8., M_PI/4.0, M_PI/4.0);
 
@@ -143,9 +143,9 @@ void ObstacleBuilder::add_kiva_bots()
 
 
   // mov_param_1 = MovementParam(MovementParam::X_AXIS, MovementParam::PRISMATIC, MovementParam::LINEAR,
-  //                             sejong::Vect3::Zero(), amp*freq, 0. );
+  //                             dynacore::Vect3::Zero(), amp*freq, 0. );
   // mov_param_2 = MovementParam(MovementParam::X_AXIS, MovementParam::PRISMATIC, MovementParam::SINUSOID,
-  //                             sejong::Vect3::Zero(), amp, freq , 0.);
+  //                             dynacore::Vect3::Zero(), amp, freq , 0.);
 
   //pioneer2dx configuration: height 0.16, lwh = 0.445, 0.277, 0.17
 
@@ -266,14 +266,14 @@ void ObstacleBuilder::add_rot_arm()
   init_pos << 0., -14., 0.;
   lwh      <<   0.445, 0.277, 0.17;
   obs = Obstacle( init_pos, lwh );
-  mov_param_1 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::SINUSOID, sejong::Vect3(lwh[0]/2,2,0.) , 2., 0.4, 0. );
+  mov_param_1 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::SINUSOID, dynacore::Vect3(lwh[0]/2,2,0.) , 2., 0.4, 0. );
   obs.add_movement(mov_param_1);
   obs_list_.push_back(obs);
 
   init_pos << 4.25, -10.75, 0.;
   lwh      <<   0.445, 0.277, 0.17;
   obs = Obstacle( init_pos, lwh );
-  mov_param_1 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, sejong::Vect3(lwh[0]/2,2,0.) , 0.3, 0. );
+  mov_param_1 = MovementParam(MovementParam::Z_AXIS, MovementParam::REVOLUTE, MovementParam::LINEAR, dynacore::Vect3(lwh[0]/2,2,0.) , 0.3, 0. );
   obs.add_movement(mov_param_1);
   obs_list_.push_back(obs);
 }
@@ -1,9 +1,9 @@
 #ifndef OBS_BUILD
 #define OBS_BUILD
 
-#include "LocomotionPlanner/EnvironmentSetup/Obstacle.h"
-#include "Utils/wrap_eigen.hpp"
-#include "Utils/utilities.h"
+#include "Obstacle.h"
+#include <Utils/wrap_eigen.hpp>
+#include <Utils/utilities.hpp>
 
 
 class ObstacleBuilder{
@@ -21,7 +21,7 @@ private:
   void add_table();
   void add_rot_arm();
 
-  sejong::Vect3 init_pos, lwh;
+  dynacore::Vect3 init_pos, lwh;
   MovementParam mov_param_1, mov_param_2, mov_param_3, mov_param_4;
   MovementParam mov_param_5, mov_param_6, mov_param_7, mov_param_8;
   Obstacle obs;
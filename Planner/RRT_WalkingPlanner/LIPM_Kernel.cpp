@@ -0,0 +1,164 @@
+#include "LIPM_Kernel.h"
+
+const int LIPM_Kernel::MAX_BATCH;
+
+LIPM_Kernel::LIPM_Kernel(const double& omega):
+  omega_(omega),
+  grid_dt_(0.)
+{}
+
+LIPM_Kernel::~LIPM_Kernel(){}
+
+void LIPM_Kernel::set_omega(const double& omega)
+{
+  omega_ = omega;
+  if (!exp_pos_table_.empty()) set_time_grid(grid_dt_, (int)exp_pos_table_.size());
+}
+
+void LIPM_Kernel::set_time_grid(const double& dt, const int& num)
+{
+  grid_dt_ = dt;
+  exp_pos_table_.resize(num);
+  exp_neg_table_.resize(num);
+  for (int k(0); k < num; ++k)
+  {
+    double t(k * dt);
+    exp_pos_table_[k] = exp(omega_ * t);
+    exp_neg_table_[k] = exp(-omega_ * t);
+  }
+}
+
+void LIPM_Kernel::get_exp(const double& t, double& exp_pos, double& exp_neg) const
+{
+  if (grid_dt_ > 0.)
+  {
+    double k_real( floor(t / grid_dt_ + 0.5) );
+    if (k_real >= 0. && k_real < exp_pos_table_.size())
+    {
+      int k((int)k_real);
+      // only where it is the same number as exp(omega * t)
+      if (k * grid_dt_ == t)
+      {
+        exp_pos = exp_pos_table_[k];
+        exp_neg = exp_neg_table_[k];
+        return;
+      }
+    }
+  }
+  exp_pos = exp(omega_ * t);
+  exp_neg = exp(-omega_ * t);
+}
+
+void LIPM_Kernel::get_exp(const Array& t, Array& exp_pos, Array& exp_neg) const
+{
+  exp_pos = (omega_ * t).exp();
+  exp_neg = (-omega_ * t).exp();
+}
+
+void LIPM_Kernel::get_state(const double& x0, const double& x0dot, const double& xp, const double& t,
+                            double& x, double& xdot) const
+{
+  double A (0.5 * ( (x0 - xp) + 1./omega_ * x0dot));
+  double B (0.5 * ( (x0 - xp) - 1./omega_ * x0dot));
+  double exp_pos, exp_neg;
+  get_exp(t, exp_pos, exp_neg);
+
+  x = A * exp_pos + B * exp_neg + xp;
+  xdot = omega_ * ( A * exp_pos - B * exp_neg );
+}
+
+void LIPM_Kernel::get_state(const Array& x0, const Array& x0dot, const Array& xp,
+                            const Array& exp_pos, const Array& exp_neg,
+                            Array& x, Array& xdot) const
+{
+  Array A( 0.5 * ( (x0 - xp) + 1./omega_ * x0dot) );
+  Array B( 0.5 * ( (x0 - xp) - 1./omega_ * x0dot) );
+
+  x = A * exp_pos + B * exp_neg + xp;
+  xdot = omega_ * ( A * exp_pos - B * exp_neg );
+}
+
+double LIPM_Kernel::get_time(const double& x, const double& xdot,
+                             const double& x0, const double& x0dot, const double& xp) const
+{
+  double A ( 0.5 * ((x0-xp) + 1/omega_ * x0dot) );
+  return 1/omega_ * log ( (x + 1/omega_ * xdot - xp)/(2*A) );
+}
+
+void LIPM_Kernel::get_time(const Array& x, const Array& xdot,
+                           const Array& x0, const Array& x0dot, const Array& xp, Array& t) const
+{
+  Array A( 0.5 * ((x0-xp) + 1/omega_ * x0dot) );
+  t = 1/omega_ * ( (x + 1/omega_ * xdot - xp)/(2*A) ).log();
+}
+
+double LIPM_Kernel::get_velocity(const double& x, const double& xp,
+                                 const double& x0, const double& x0dot) const
+{
+  double sign(1.0);
+  if(x0dot < 0) sign = -1.0;
+
+  return sign * sqrt( pow(omega_,2) * ( pow(x - xp, 2) - pow(x0 - xp, 2) ) + pow(x0dot, 2) );
+}
+
+void LIPM_Kernel::get_velocity(const Array& x, const Array& xp,
+                               const Array& x0, const Array& x0dot, Array& xdot) const
+{
+  Array speed( ( omega_ * omega_ * ( (x - xp).square() - (x0 - xp).square() ) + x0dot.square() ).sqrt() );
+  xdot = (x0dot < 0.).select(-speed, speed);
+}
+
+double LIPM_Kernel::get_switching_state_x(const double& xp1, const double& xp2,
+                                          const double& x0, const double& x0dot,
+                                          const double& v_apex) const
+{
+  double C ( pow(x0 - xp1, 2.) + (pow(v_apex, 2.) - pow(x0dot, 2.))/pow(omega_, 2.) );
+  return 0.5 * (C / (xp2 - xp1) + (xp1 + xp2) );
+}
+
+void LIPM_Kernel::get_switching_state_x(const Array& xp1, const Array& xp2,
+                                        const Array& x0, const Array& x0dot,
+                                        const Array& v_apex, Array& x_switch) const
+{
+  Array C( (x0 - xp1).square() + (v_apex.square() - x0dot.square())/(omega_ * omega_) );
+  x_switch = 0.5 * (C / (xp2 - xp1) + (xp1 + xp2) );
+}
+
+double LIPM_Kernel::get_yp(const double& y0, const double& y0dot, const double& t_apex,
+                           const double& ydot_des) const
+{
+  return y0 - (1 + exp( 2* omega_ * t_apex))/ (1 - exp( 2* omega_ * t_apex)) * (y0dot/ omega_)
+    + 2 * ydot_des/(( exp(-omega_ * t_apex) - exp(omega_*t_apex) ) * omega_);
+}
+
+void LIPM_Kernel::get_yp(const Array& y0, const Array& y0dot,
+                         const Array& exp_pos, const Array& exp_neg,
+                         const Array& ydot_des, Array& yp) const
+{
+  Array exp_2( exp_pos.square() );
+  yp = y0 - (1 + exp_2)/ (1 - exp_2) * (y0dot/ omega_)
+    + 2 * ydot_des/(( exp_neg - exp_pos ) * omega_);
+}
+
+double LIPM_Kernel::get_yp_vel_constraint(const double& y0, const double& ydot0,
+                                          const double& t_apex, const double& ydot_apex) const
+{
+  double C = 0.5 * ( y0 + 1/omega_ * ydot0 );
+  double D = 0.5 * ( y0 - 1/omega_ * ydot0 );
+  double exp_pos, exp_neg;
+  get_exp(t_apex, exp_pos, exp_neg);
+  double X = omega_ * C * exp_pos -  omega_ * D * exp_neg;
+  double Y = 0.5 * (omega_ * exp_neg - omega_ * exp_pos);
+  return (ydot_apex - X)/Y;
+}
+
+void LIPM_Kernel::get_yp_vel_constraint(const Array& y0, const Array& ydot0,
+                                        const Array& exp_pos, const Array& exp_neg,
+                                        const Array& ydot_apex, Array& yp) const
+{
+  Array C( 0.5 * ( y0 + 1/omega_ * ydot0 ) );
+  Array D( 0.5 * ( y0 - 1/omega_ * ydot0 ) );
+  Array X( omega_ * C * exp_pos -  omega_ * D * exp_neg );
+  Array Y( 0.5 * (omega_ * exp_neg - omega_ * exp_pos) );
+  yp = (ydot_apex - X)/Y;
+}
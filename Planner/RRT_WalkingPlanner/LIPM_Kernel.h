@@ -0,0 +1,81 @@
+#ifndef LIPM_KERNEL
+#define LIPM_KERNEL
+
+#include <Eigen/Dense>
+#include <vector>
+#include <cmath>
+
+// Closed forms of the linear inverted pendulum, xddot = omega^2 (x - xp),
+// shared by the planners. The double versions give exactly the planners'
+// former results; the Array versions evaluate up to MAX_BATCH candidates at
+// once (structure of arrays, no heap) with Eigen's vectorized exp / log /
+// sqrt, which agree with libm to the last bit or two. They take
+// exp(omega t) and exp(-omega t) from get_exp() so that the states sharing
+// a time share the exponentials.
+class LIPM_Kernel{
+public:
+  static const int MAX_BATCH = 64;
+  typedef Eigen::Array<double, Eigen::Dynamic, 1, Eigen::ColMajor, MAX_BATCH, 1> Array;
+
+  LIPM_Kernel(const double& omega = 1.);
+  ~LIPM_Kernel();
+
+  void set_omega(const double& omega);
+  double get_omega() const { return omega_; }
+
+  // exp(omega t) and exp(-omega t) are tabulated at t = k * dt, k < num;
+  // get_exp() uses the table for exactly those times, exp() otherwise
+  void set_time_grid(const double& dt, const int& num);
+  void get_exp(const double& t, double& exp_pos, double& exp_neg) const;
+  void get_exp(const Array& t, Array& exp_pos, Array& exp_neg) const;
+
+  // state at t from (x0, x0dot), pivot xp
+  void get_state(const double& x0, const double& x0dot, const double& xp, const double& t,
+                 double& x, double& xdot) const;
+  void get_state(const Array& x0, const Array& x0dot, const Array& xp,
+                 const Array& exp_pos, const Array& exp_neg,
+                 Array& x, Array& xdot) const;
+
+  // time from (x0, x0dot) to (x, xdot)
+  double get_time(const double& x, const double& xdot,
+                  const double& x0, const double& x0dot, const double& xp) const;
+  void get_time(const Array& x, const Array& xdot,
+                const Array& x0, const Array& x0dot, const Array& xp, Array& t) const;
+
+  // velocity at x on the orbit of (x0, x0dot), same sign as x0dot
+  double get_velocity(const double& x, const double& xp,
+                      const double& x0, const double& x0dot) const;
+  void get_velocity(const Array& x, const Array& xp,
+                    const Array& x0, const Array& x0dot, Array& xdot) const;
+
+  // switching position between the orbit around xp1 through (x0, x0dot) and
+  // the one around xp2 with apex velocity v_apex
+  double get_switching_state_x(const double& xp1, const double& xp2,
+                               const double& x0, const double& x0dot,
+                               const double& v_apex) const;
+  void get_switching_state_x(const Array& xp1, const Array& xp2,
+                             const Array& x0, const Array& x0dot,
+                             const Array& v_apex, Array& x_switch) const;
+
+  // pivot reaching ydot_des after t_apex from (y0, y0dot)
+  double get_yp(const double& y0, const double& y0dot, const double& t_apex,
+                const double& ydot_des = 0.) const;
+  void get_yp(const Array& y0, const Array& y0dot,
+              const Array& exp_pos, const Array& exp_neg,
+              const Array& ydot_des, Array& yp) const;
+
+  // same pivot, in the form used by the RRT solver
+  double get_yp_vel_constraint(const double& y0, const double& ydot0,
+                               const double& t_apex, const double& ydot_apex) const;
+  void get_yp_vel_constraint(const Array& y0, const Array& ydot0,
+                             const Array& exp_pos, const Array& exp_neg,
+                             const Array& ydot_apex, Array& yp) const;
+
+protected:
+  double omega_;
+  double grid_dt_;
+  std::vector<double> exp_pos_table_;
+  std::vector<double> exp_neg_table_;
+};
+
+#endif
@@ -1,7 +1,7 @@
 #include "PIPM_Planner_Analytic.h"
 #include "EnvironmentSetup/Terrain.h"
 #include "EnvironmentSetup/CoMSurface.h"
-#include <Utils/utilities.h>
+#include <Utils/utilities.hpp>
 #include <iostream>
 #include <stdio.h>
 
@@ -29,9 +29,9 @@ void Planner_Analytic::_SetAB(int idx, double * A, double * B){
 }
 
 
-bool Planner_Analytic::GetCoMState(int step_idx, double time, sejong::Vector & com_full_state) {
+bool Planner_Analytic::GetCoMState(int step_idx, double time, dynacore::Vector & com_full_state) {
   // (x, y, z, xdot, ydot, zdot, xddot, yddot, zddot)
-  com_full_state = sejong::Vector::Zero(9);
+  com_full_state = dynacore::Vector::Zero(9);
   double foot_pos[2];
 
   foot_pos[0] = foot_list_[step_idx][0];
@@ -67,7 +67,7 @@ double Planner_Analytic::GetFinTime(int step_idx) {
 }
 
 bool Planner_Analytic::GetFootPlacement(int sequence_idx,
-                      sejong::Vector & foot_placement){
+                      dynacore::Vector & foot_placement){
   if(sequence_idx > num_sequence_){ return false; }
   else {
     foot_placement = foot_list_[sequence_idx];
@@ -75,15 +75,15 @@ bool Planner_Analytic::GetFootPlacement(int sequence_idx,
   return true;
 }
 
-bool Planner_Analytic::GetOrientation(int sequence_idx, sejong::Quaternion & ori){
+bool Planner_Analytic::GetOrientation(int sequence_idx, dynacore::Quaternion & ori){
   if(sequence_idx > num_sequence_){ return false; }
   else {
     ori = ori_list_[sequence_idx];
     return true;
   }
 }
-sejong::Quaternion Planner_Analytic::_Quaternion_RotZ(double theta){
-  sejong::Quaternion ret_quat;
+dynacore::Quaternion Planner_Analytic::_Quaternion_RotZ(double theta){
+  dynacore::Quaternion ret_quat;
   ret_quat.w() = cos(theta/2.);
   ret_quat.x() = 0.;
   ret_quat.y() = 0.;
@@ -94,11 +94,12 @@ sejong::Quaternion Planner_Analytic::_Quaternion_RotZ(double theta){
 bool Planner_Analytic::_SolvePlanning(PlanningParam* param){
   AnalyticPL_Param* _param = static_cast<AnalyticPL_Param*>(param);
   omega = sqrt(9.81/_param->curr_com_state[2]);
+  lipm_.set_omega(omega);
   num_sequence_ = (_param->xp_list).size();
 
   // Initial
   int start_idx(0);
-  sejong::Vector ini_state(6);
+  dynacore::Vector ini_state(6);
   if(_param->is_initial){
     foot_list_.push_back(_param->fixed_pivot);
     initial_state_list_.push_back(_param->curr_com_state);
@@ -115,19 +116,19 @@ bool Planner_Analytic::_SolvePlanning(PlanningParam* param){
     foot_list_.push_back(_param->fixed_pivot);
   }
 
-  sejong::Vect3 nx_foot, local_nx_foot;
+  dynacore::Vect3 nx_foot, local_nx_foot;
 
-  sejong::Vect3 curr_foot(foot_list_[start_idx]);
-  sejong::Vect3 vect3_zero;
+  dynacore::Vect3 curr_foot(foot_list_[start_idx]);
+  dynacore::Vect3 vect3_zero;
   vect3_zero.setZero();
-  sejong::Vector curr_state(ini_state);
-  sejong::Vector local_state;
+  dynacore::Vector curr_state(ini_state);
+  dynacore::Vector local_state;
 
   double switching_time;
   double xp;
   double v_apex, ydot_des;
-  sejong::Vector switching_state(6);
-  sejong::Vector local_switching_state(6);
+  dynacore::Vector switching_state(6);
+  dynacore::Vector local_switching_state(6);
 
   double theta;
 
@@ -146,8 +147,8 @@ bool Planner_Analytic::_SolvePlanning(PlanningParam* param){
     _ChangeFrameBack(local_switching_state, curr_foot,  theta, switching_state);
     _ChangeFrameBack(local_nx_foot, curr_foot,  theta, nx_foot);
 
-    sejong::pretty_print(switching_state, std::cout, "switching state");
-    sejong::pretty_print((sejong::Vector)nx_foot, std::cout, "nx foot");
+    dynacore::pretty_print(switching_state, std::cout, "switching state");
+    dynacore::pretty_print((dynacore::Vector)nx_foot, std::cout, "nx foot");
     printf ("switching time: %f \n \n", switching_time);
 
     foot_list_.push_back(nx_foot);
@@ -163,23 +164,23 @@ bool Planner_Analytic::_SolvePlanning(PlanningParam* param){
 
   return true;
 }
-void Planner_Analytic::_ChangeFrameBack(const sejong::Vect3 & pos,
-                                        const sejong::Vect3 & offset,
+void Planner_Analytic::_ChangeFrameBack(const dynacore::Vect3 & pos,
+                                        const dynacore::Vect3 & offset,
                                         double theta,
-                                        sejong::Vect3 & changed_pos){
+                                        dynacore::Vect3 & changed_pos){
   changed_pos = pos;
   // Position
   changed_pos.head(2) = _2D_Rotate(pos.head(2), theta);
   changed_pos.head(2) += offset.head(2);
 }
 
-void Planner_Analytic::_ChangeFrameBack(const sejong::Vector & state,
-                                        const sejong::Vect3 & offset,
+void Planner_Analytic::_ChangeFrameBack(const dynacore::Vector & state,
+                                        const dynacore::Vect3 & offset,
                                         double theta,
-                                        sejong::Vector & changed_state){
+                                        dynacore::Vector & changed_state){
   changed_state = state;
   // Position
-  sejong::Vector original_pos = state.head(2);
+  dynacore::Vector original_pos = state.head(2);
   original_pos = _2D_Rotate(original_pos, theta);
   original_pos += offset.head(2);
   changed_state.head(2) = original_pos;
@@ -188,34 +189,34 @@ void Planner_Analytic::_ChangeFrameBack(const sejong::Vector & state,
 
 }
 
-void Planner_Analytic::_ChangeFrame(const sejong::Vector & state,
-                                    const sejong::Vect3 & offset,
+void Planner_Analytic::_ChangeFrame(const dynacore::Vector & state,
+                                    const dynacore::Vect3 & offset,
                                     double theta,
-                                    sejong::Vector & changed_state){
+                                    dynacore::Vector & changed_state){
   changed_state = state;
   //Position
-  sejong::Vector local_pos = state.head(3) - offset;
+  dynacore::Vector local_pos = state.head(3) - offset;
   local_pos.head(2) = _2D_Rotate(local_pos.head(2), -theta);
   changed_state.head(2) = local_pos.head(2);
   // Velocity
   changed_state.segment(3,2) = _2D_Rotate(changed_state.segment(3,2), -theta);
 }
 
-sejong::Vector Planner_Analytic::_2D_Rotate(const sejong::Vector & vec2,
+dynacore::Vector Planner_Analytic::_2D_Rotate(const dynacore::Vector & vec2,
                                             double theta){
-  sejong::Vector vec2_tran(2);
+  dynacore::Vector vec2_tran(2);
   vec2_tran[0] = vec2[0] * cos(theta) - vec2[1] * sin(theta);
   vec2_tran[1] = vec2[0] * sin(theta) + vec2[1] * cos(theta);
 
   return vec2_tran;
 }
 
-bool Planner_Analytic::_find_initial(const sejong::Vector & curr_com,
-                                     const sejong::Vect3 & curr_foot,
+bool Planner_Analytic::_find_initial(const dynacore::Vector & curr_com,
+                                     const dynacore::Vect3 & curr_foot,
                                      double nx_xp, double v_apex,
-                                     sejong::Vector & ini_state){
-  sejong::pretty_print(curr_com, std::cout, "ini com");
-  sejong::pretty_print((sejong::Vector)curr_foot, std::cout, "curr foot");
+                                     dynacore::Vector & ini_state){
+  dynacore::pretty_print(curr_com, std::cout, "ini com");
+  dynacore::pretty_print((dynacore::Vector)curr_foot, std::cout, "curr foot");
 
   // x, xdot, z, zdot are same
   double yini(-0.0);
@@ -257,7 +258,7 @@ bool Planner_Analytic::_find_initial(const sejong::Vector & curr_com,
                                     ini_state[1],
                                     ini_state[3],
                                     ini_state[4]);
-  sejong::pretty_print(ini_state, std::cout, "ini state");
+  dynacore::pretty_print(ini_state, std::cout, "ini state");
   double x1(ini_state[0]);
   double x1dot(ini_state[3]);
 
@@ -266,11 +267,11 @@ bool Planner_Analytic::_find_initial(const sejong::Vector & curr_com,
 
   double t_apex = 1./(2 * omega) * log  ( - B_nx/ A_nx);
   printf("t apex: %f\n", t_apex);
-  sejong::Vect3 nx_foot;
+  dynacore::Vect3 nx_foot;
   nx_foot[0] = nx_xp;
   nx_foot[1] = _find_yp(ini_state[1], ini_state[4], t_apex);
   nx_foot[2] = terrain_->getZp(nx_foot[0], nx_foot[1]);
-  sejong::pretty_print((sejong::Vector)nx_foot, std::cout, "nx foot");
+  dynacore::pretty_print((dynacore::Vector)nx_foot, std::cout, "nx foot");
 
   foot_list_.push_back(nx_foot);
   return true;
@@ -278,14 +279,14 @@ bool Planner_Analytic::_find_initial(const sejong::Vector & curr_com,
 
 bool Planner_Analytic::_find_switching(double xp,
                                        double v_apex, double ydot_des,
-                                       const sejong::Vector & curr_state,
-                                       const sejong::Vect3 & curr_foot,
-                                       sejong::Vector & switching_state,
-                                       sejong::Vect3 & nx_foot,
+                                       const dynacore::Vector & curr_state,
+                                       const dynacore::Vect3 & curr_foot,
+                                       dynacore::Vector & switching_state,
+                                       dynacore::Vect3 & nx_foot,
                                        double & switching_time){
   nx_foot[0] = xp;
-  sejong::pretty_print((sejong::Vector)curr_foot, std::cout, "curr foot");
-  sejong::pretty_print(curr_state, std::cout, "curr state");
+  dynacore::pretty_print((dynacore::Vector)curr_foot, std::cout, "curr foot");
+  dynacore::pretty_print(curr_state, std::cout, "curr state");
 
   switching_state[0] = _switching_state_x(curr_foot[0], xp,
                                           curr_state[0], curr_state[3],
@@ -327,8 +328,7 @@ double Planner_Analytic::_find_yp( double y0, double y0dot, double t_apex){
   return _find_yp(y0, y0dot, t_apex, 0.);
 }
 double Planner_Analytic::_find_yp( double y0, double y0dot, double t_apex,double ydot_des){
-  double yp ( y0 - (1 + exp( 2* omega * t_apex))/ (1 - exp( 2* omega * t_apex)) * (y0dot/ omega)  + 2 * ydot_des/(( exp(-omega * t_apex) - exp(omega*t_apex)  ) * omega) );
-  return yp;
+  return lipm_.get_yp(y0, y0dot, t_apex, ydot_des);
 }
 
 
@@ -338,11 +338,7 @@ void Planner_Analytic::_find_y_switching_state(double y0, double y0dot,
                                                double yp,
                                                double & sw_pos,
                                                double & sw_vel){
-  double A (0.5 * ( (y0 - yp) + 1./omega * y0dot));
-  double B (0.5 * ( (y0 - yp) - 1./omega * y0dot));
-
-  sw_pos = A * exp(omega * t_switch) + B * exp(-omega * t_switch) + yp;
-  sw_vel = omega * ( A * exp(omega * t_switch) - B * exp (-omega * t_switch));
+  lipm_.get_state(y0, y0dot, yp, t_switch, sw_pos, sw_vel);
   // printf("y0 pos, vel, yp: (%f, %f, %f)\n", y0, y0dot, yp);
 
   // printf("y sw pos, vel: (%f, %f)\n", sw_pos, sw_vel);
@@ -351,18 +347,11 @@ void Planner_Analytic::_find_y_switching_state(double y0, double y0dot,
 double Planner_Analytic::_find_time(double x, double xdot,
                                     double x0, double x0dot,
                                     double xp){
-  double A ( 0.5 * ((x0-xp) + 1/omega * x0dot) );
-  double time = 1/omega * log ( (x + 1/omega * xdot - xp)/(2*A) );
-  return time;
+  return lipm_.get_time(x, xdot, x0, x0dot, xp);
 }
 
 double Planner_Analytic::_find_velocity(double x, double xp, double x0, double x0dot){
-  double sign(1.0);
-  if(x0dot < 0) sign = -1.0;
-
-  double xdot = sign * sqrt( pow(omega,2) * ( pow(x - xp, 2) - pow(x0 - xp, 2) ) + pow(x0dot, 2) );
-
-  return xdot;
+  return lipm_.get_velocity(x, xp, x0, x0dot);
 }
 double Planner_Analytic::_switching_state_x(double xp1, double xp2,
                                             double x0, double x0dot,
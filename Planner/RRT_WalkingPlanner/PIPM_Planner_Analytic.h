@@ -2,16 +2,17 @@
 #define PIPM_PLANNER_ANALYTIC
 
 #include "Planner.h"
+#include "LIPM_Kernel.h"
 
 class AnalyticPL_Param : public PlanningParam{
 public:
   //(x, y, z, xdot, ydot, zdot)
-  sejong::Vector curr_com_state;
+  dynacore::Vector curr_com_state;
   std::vector<double> xp_list;
   std::vector<double> apex_vel_list;
   std::vector<double> theta_list;
   bool is_initial;
-  sejong::Vect3 fixed_pivot; // (xp, yp, zp)
+  dynacore::Vect3 fixed_pivot; // (xp, yp, zp)
 };
 
 class Planner_Analytic : public Planner{
@@ -19,29 +20,29 @@ public:
   Planner_Analytic();
   virtual ~Planner_Analytic();
 
-  virtual bool GetCoMState(int step_idx, double time, sejong::Vector & com_full_state) ;
+  virtual bool GetCoMState(int step_idx, double time, dynacore::Vector & com_full_state) ;
   virtual double GetFinTime(int step_idx) ;
   virtual bool GetFootPlacement(int sequence_idx,
-                                sejong::Vector & foot_placement);
-  virtual bool GetOrientation(int sequence_idx, sejong::Quaternion &ori);
+                                dynacore::Vector & foot_placement);
+  virtual bool GetOrientation(int sequence_idx, dynacore::Quaternion &ori);
 
 protected:
-  sejong::Vector _2D_Rotate(const sejong::Vector & vec2,
+  dynacore::Vector _2D_Rotate(const dynacore::Vector & vec2,
                             double theta);
-  sejong::Quaternion _Quaternion_RotZ(double theta);
+  dynacore::Quaternion _Quaternion_RotZ(double theta);
 
-  void _ChangeFrame(const sejong::Vector & state,
-                    const sejong::Vect3 & offset,
+  void _ChangeFrame(const dynacore::Vector & state,
+                    const dynacore::Vect3 & offset,
                     double theta,
-                    sejong::Vector & changed_state);
-  void _ChangeFrameBack(const sejong::Vector & state,
-                        const sejong::Vect3 & offset,
+                    dynacore::Vector & changed_state);
+  void _ChangeFrameBack(const dynacore::Vector & state,
+                        const dynacore::Vect3 & offset,
                         double theta,
-                        sejong::Vector & changed_state);
-  void _ChangeFrameBack(const sejong::Vect3 & pos,
-                        const sejong::Vect3 & offset,
+                        dynacore::Vector & changed_state);
+  void _ChangeFrameBack(const dynacore::Vect3 & pos,
+                        const dynacore::Vect3 & offset,
                         double theta,
-                        sejong::Vect3 & changed_pos);
+                        dynacore::Vect3 & changed_pos);
 
 
   virtual bool _SolvePlanning(PlanningParam* );
@@ -52,16 +53,16 @@ protected:
                               CoMSurface* com_surf);
 
   // Calculation Function
-  bool _find_initial(const sejong::Vector & curr_com,
-                     const sejong::Vect3 & curr_foot,
+  bool _find_initial(const dynacore::Vector & curr_com,
+                     const dynacore::Vect3 & curr_foot,
                      double nx_xp, double v_apex,
-                     sejong::Vector & ini_state);
+                     dynacore::Vector & ini_state);
 
   bool _find_switching(double xp, double v_apex, double ydot_des,
-                       const sejong::Vector & curr_state,
-                       const sejong::Vect3 & curr_foot,
-                       sejong::Vector & switching_state,
-                       sejong::Vect3 & nx_foot,
+                       const dynacore::Vector & curr_state,
+                       const dynacore::Vect3 & curr_foot,
+                       dynacore::Vector & switching_state,
+                       dynacore::Vect3 & nx_foot,
                        double & switching_time);
   double _find_yp( double y0, double y0dot, double t_apex);
   double _find_yp( double y0, double y0dot, double t_apex,double ydot_des);
@@ -85,16 +86,17 @@ protected:
 
 
 
-  std::vector<sejong::Vector> foot_list_;
-  std::vector<sejong::Quaternion> ori_list_;
+  std::vector<dynacore::Vector> foot_list_;
+  std::vector<dynacore::Quaternion> ori_list_;
 
-  std::vector<sejong::Vector> initial_state_list_;
+  std::vector<dynacore::Vector> initial_state_list_;
   std::vector<double> switching_time_list_;
 
   int num_sequence_;
   double A[2]; // x, y
   double B[2]; // x, y
   double omega;
+  LIPM_Kernel lipm_; // same omega
 };
 
 #endif
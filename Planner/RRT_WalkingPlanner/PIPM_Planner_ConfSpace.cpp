@@ -2,13 +2,14 @@
 #include "EnvironmentSetup/Terrain.h"
 #include "EnvironmentSetup/CoMSurface.h"
 #include "Configuration.h"
-#include <Utils/utilities.h>
+#include <Utils/utilities.hpp>
 #include <iostream>
 #include <fstream>
 #include <math.h>
 #include <cmath>
 
-RRT_Analytic_Solver::RRT_Analytic_Solver():Planner(){
+RRT_Analytic_Solver::RRT_Analytic_Solver():Planner(), node_pool_(NULL){
+  lipm_.set_time_grid(0.001, 2000);
 }
 RRT_Analytic_Solver::~RRT_Analytic_Solver(){
 }
@@ -72,10 +73,10 @@ void RRT_Analytic_Solver::_Set_local_AB_to_peak(int idx, double * A, double * B)
   B[1] = 0.5 * ( (y0 - yp) - 1./omega * y0dot);
 }
 
-bool RRT_Analytic_Solver::GetCoMState(int step_idx, double time, sejong::Vector & com_full_state) {
+bool RRT_Analytic_Solver::GetCoMState(int step_idx, double time, dynacore::Vector & com_full_state) {
   if((step_idx == 0) || (step_idx == 1 && time <= apex_time_list_[step_idx - 1])){
     // (x, y, z, xdot, ydot, zdot, xddot, yddot, zddot)
-    com_full_state = sejong::Vector::Zero(9);
+    com_full_state = dynacore::Vector::Zero(9);
     double foot_pos[2];
 
     foot_pos[0] = foot_list_[step_idx][0];
@@ -85,9 +86,11 @@ bool RRT_Analytic_Solver::GetCoMState(int step_idx, double time, sejong::Vector
     double B[2];
     _SetAB(step_idx, A, B);
 
+    double exp_pos, exp_neg;
+    lipm_.get_exp(time, exp_pos, exp_neg);
     for (int i(0); i < 2; ++i){
-      com_full_state[i] = A[i] * exp(omega*time) + B[i] * exp(-omega*time) + foot_pos[i];
-      com_full_state[3 + i] = omega * (A[i] * exp(omega*time) - B[i] * exp(-omega*time));
+      com_full_state[i] = A[i] * exp_pos + B[i] * exp_neg + foot_pos[i];
+      com_full_state[3 + i] = omega * (A[i] * exp_pos - B[i] * exp_neg);
       com_full_state[6 + i] = omega * omega * (com_full_state[i] - foot_pos[i]);
     }
     // com_full_state[2] = com_surf_->getZ(com_full_state[0],
@@ -110,7 +113,7 @@ bool RRT_Analytic_Solver::GetCoMState(int step_idx, double time, sejong::Vector
   } else{
     if(time <= apex_time_list_[step_idx - 1]){
       //peak -> apex
-      com_full_state = sejong::Vector::Zero(9);
+      com_full_state = dynacore::Vector::Zero(9);
 
       double foot_pos[2];
       foot_pos[0] = (next_pivot_list_[step_idx - 2])[0];
@@ -120,9 +123,11 @@ bool RRT_Analytic_Solver::GetCoMState(int step_idx, double time, sejong::Vector
       double B[2];
       _Set_local_AB_to_apex(step_idx, A, B);
 
+      double exp_pos, exp_neg;
+      lipm_.get_exp(time, exp_pos, exp_neg);
       for (int i(0); i < 2; ++i){
-        com_full_state[i] = A[i] * exp(omega*time) + B[i] * exp(-omega*time) + foot_pos[i];
-        com_full_state[3 + i] = omega * (A[i] * exp(omega*time) - B[i] * exp(-omega*time));
+        com_full_state[i] = A[i] * exp_pos + B[i] * exp_neg + foot_pos[i];
+        com_full_state[3 + i] = omega * (A[i] * exp_pos - B[i] * exp_neg);
         com_full_state[6 + i] = omega * omega * (com_full_state[i] - foot_pos[i]);
       }
       com_full_state[2] = com_surf_->getZ(com_full_state[0],
@@ -145,7 +150,7 @@ bool RRT_Analytic_Solver::GetCoMState(int step_idx, double time, sejong::Vector
     } else{
       //apex -> peak
       time -= apex_time_list_[step_idx - 1];
-      com_full_state = sejong::Vector::Zero(9);
+      com_full_state = dynacore::Vector::Zero(9);
 
       double foot_pos[2];
       if(step_idx == 1){
@@ -160,9 +165,11 @@ bool RRT_Analytic_Solver::GetCoMState(int step_idx, double time, sejong::Vector
       double B[2];
       _Set_local_AB_to_peak(step_idx, A, B);
 
+      double exp_pos, exp_neg;
+      lipm_.get_exp(time, exp_pos, exp_neg);
       for (int i(0); i < 2; ++i){
-        com_full_state[i] = A[i] * exp(omega*time) + B[i] * exp(-omega*time) + foot_pos[i];
-        com_full_state[3 + i] = omega * (A[i] * exp(omega*time) - B[i] * exp(-omega*time));
+        com_full_state[i] = A[i] * exp_pos + B[i] * exp_neg + foot_pos[i];
+        com_full_state[3 + i] = omega * (A[i] * exp_pos - B[i] * exp_neg);
         com_full_state[6 + i] = omega * omega * (com_full_state[i] - foot_pos[i]);
       }
       com_full_state[2] = com_surf_->getZ(com_full_state[0],
@@ -192,7 +199,7 @@ double RRT_Analytic_Solver::GetFinTime(int step_idx) {
 }
 
 bool RRT_Analytic_Solver::GetFootPlacement(int sequence_idx,
-                                           sejong::Vector & foot_placement){
+                                           dynacore::Vector & foot_placement){
   if(sequence_idx > num_sequence_){ return false; }
   else {
     foot_placement = (foot_list_[sequence_idx]).head(3);
@@ -200,12 +207,12 @@ bool RRT_Analytic_Solver::GetFootPlacement(int sequence_idx,
   }
 }
 
-bool RRT_Analytic_Solver::GetOrientation(int sequence_idx, sejong::Quaternion & ori){
+bool RRT_Analytic_Solver::GetOrientation(int sequence_idx, dynacore::Quaternion & ori){
   if(sequence_idx > num_sequence_){ return false; }
   else {
-    sejong::convert((foot_list_[sequence_idx])[3], 0., 0., ori);
+    dynacore::convert((foot_list_[sequence_idx])[3], 0., 0., ori);
     // printf("%d th theta: %f\n", sequence_idx, foot_list_[sequence_idx][3]);
-    // sejong::pretty_print(ori, std::cout, "ori_quat");
+    // dynacore::pretty_print(ori, std::cout, "ori_quat");
     return true;
   }
 }
@@ -218,33 +225,32 @@ bool RRT_Analytic_Solver::_SolvePlanning(PlanningParam* param){
   if(_param->planning){
 
     //PARAMETER DISTRIBUTING
-    RRT_Node* temp = new RRT_Node(0,0,0);
     num_sequence_ = _param->sol_node->idx_;
-    temp = _param->sol_node;
+    RRT_Node* temp = _param->sol_node;
     // for(int i(0); i<_param->sol_node->idx_ - 1; ++i){
     for(int i(0); i<num_sequence_ - 1; ++i){
-      temp->parent_->sol_child_ = temp;
-      temp = temp->parent_;
+      _parent(temp)->sol_child_ = temp->id_;
+      temp = _parent(temp);
     }
-    temp = _param->root_node->sol_child_;
+    temp = node_pool_->get(_param->root_node->sol_child_);
 
     // for(int i(2); i < _param->sol_node->idx_ + 1; ++i){
     for(int i(2); i < num_sequence_ + 1; ++i){
-      foot_list_.push_back(temp->foot_glob_);
-      apex_vel_decomp_.push_back(temp->apex_vel_decomp_prev_frame_);
-      next_pivot_list_.push_back(temp->foot_prev_frame_);
-      curr_pivot_list_.push_back(temp->foot_curr_frame_);
-      SE3_list_.push_back(temp->SE3_);
-      inv_SE3_list_.push_back(temp->inv_SE3_);
-      initial_state_list_.push_back(temp->initial_state_prev_frame_);
-      apex_state_list_.push_back(temp->apex_state_curr_frame_);
-      apex_time_list_.push_back(temp->apex_time_);
-      switching_time_list_.push_back(temp->switching_time_);
+      const RRT_NodeState& state(_state(temp));
+      foot_list_.push_back(state.foot_glob_);
+      apex_vel_decomp_.push_back(state.apex_vel_decomp_prev_frame_);
+      next_pivot_list_.push_back(state.foot_prev_frame_);
+      curr_pivot_list_.push_back(state.foot_curr_frame_);
+      SE3_list_.push_back(state.SE3_);
+      inv_SE3_list_.push_back(state.inv_SE3_);
+      initial_state_list_.push_back(state.initial_state_prev_frame_);
+      apex_state_list_.push_back(state.apex_state_curr_frame_);
+      apex_time_list_.push_back(state.apex_time_);
+      switching_time_list_.push_back(state.switching_time_);
 
       if(i != _param->sol_node->idx_)
-        temp = temp->sol_child_;
+        temp = node_pool_->get(temp->sol_child_);
     }
-    delete temp;
     _save_param();
   } else{
     _read_param_from_text(_param->curr_com_state[2]);
@@ -276,10 +282,10 @@ void RRT_Analytic_Solver::_read_param_from_text(double curr_com_state){
 
   std::string output;
   double val(0);
-  sejong::Vector four_dim(4);
-  sejong::Matrix mat(3,3);
-  sejong::Vector six_dim(6);
-  sejong::Vect3 three_dim;
+  dynacore::Vector four_dim(4);
+  dynacore::Matrix mat(3,3);
+  dynacore::Vector six_dim(6);
+  dynacore::Vect3 three_dim;
   std::string file_name = path+"experiment_data/_foot_list.txt"; 
   foot_file.open(file_name.c_str());
   file_name = path+"experiment_data/_apex_vel_decomp.txt"; 
@@ -402,19 +408,20 @@ void RRT_Analytic_Solver::_read_param_from_text(double curr_com_state){
   //std::cout<<foot_list_.size()<<std::endl;
 
   omega = sqrt(9.81/curr_com_state);
+  lipm_.set_omega(omega);
   num_sequence_ = foot_list_.size();
 }
 
 void RRT_Analytic_Solver::_save_param(){
   for(int i(0); i<foot_list_.size(); ++i){
-    sejong::saveVector(foot_list_[i],"_foot_list");
-    sejong::saveVector(initial_state_list_[i],"_initial_state_list");
+    dynacore::saveVector(foot_list_[i],"_foot_list");
+    dynacore::saveVector(initial_state_list_[i],"_initial_state_list");
   }
 
   for(int i(0); i<apex_vel_decomp_.size(); ++i){
-    sejong::saveVector(apex_vel_decomp_[i],"_apex_vel_decomp");
-    sejong::saveVector(next_pivot_list_[i],"_next_pivot_list");
-    sejong::saveVector(curr_pivot_list_[i],"_curr_pivot_list");
+    dynacore::saveVector(apex_vel_decomp_[i],"_apex_vel_decomp");
+    dynacore::saveVector(next_pivot_list_[i],"_next_pivot_list");
+    dynacore::saveVector(curr_pivot_list_[i],"_curr_pivot_list");
   }
   std::ofstream se3;
   std::ofstream inv_se3;
@@ -423,18 +430,19 @@ void RRT_Analytic_Solver::_save_param(){
   se3.open("_SE3_list.txt");
   inv_se3.open("_inv_SE3_list.txt");
   for(int i(0); i<SE3_list_.size(); ++i){
-    sejong::pretty_print(SE3_list_[i],se3,"","");
-    sejong::pretty_print(inv_SE3_list_[i],inv_se3,"","");
-    sejong::saveVector(apex_state_list_[i],"_apex_state_list");
-    sejong::saveValue(apex_time_list_[i],"_apex_time_list");
-    sejong::saveValue(switching_time_list_[i],"_switching_time_list");
+    dynacore::pretty_print(SE3_list_[i],se3,"","");
+    dynacore::pretty_print(inv_SE3_list_[i],inv_se3,"","");
+    dynacore::saveVector(apex_state_list_[i],"_apex_state_list");
+    dynacore::saveValue(apex_time_list_[i],"_apex_time_list");
+    dynacore::saveValue(switching_time_list_[i],"_switching_time_list");
   }
 }
 
-bool RRT_Analytic_Solver::_find_initial_root(const sejong::Vector & curr_com,
-                                             const sejong::Vector & curr_foot,
+bool RRT_Analytic_Solver::_find_initial_root(const dynacore::Vector & curr_com,
+                                             const dynacore::Vector & curr_foot,
                                              double nx_xp, double v_apex, RRT_Node * root,
-                                             sejong::Vector & ini_state){
+                                             dynacore::Vector & ini_state){
+  RRT_NodeState& state(_state(root));
   double yini(-0.0);
   ini_state[1] = yini;
 
@@ -452,8 +460,8 @@ bool RRT_Analytic_Solver::_find_initial_root(const sejong::Vector & curr_com,
   }
 
   double t_s = 1./omega * log (exp_omega_t);
-  root->switching_time_ = floor(t_s*1000)*0.001;
-  switching_time_list_.push_back(root->switching_time_);
+  state.switching_time_ = floor(t_s*1000)*0.001;
+  switching_time_list_.push_back(state.switching_time_);
 
   ini_state[4] = omega * (A * exp(omega * t_s) - B * exp(-omega * t_s));
 
@@ -476,33 +484,28 @@ bool RRT_Analytic_Solver::_find_initial_root(const sejong::Vector & curr_com,
   double B_nx(0.5 * ((x1 - nx_xp) - 1./omega * x1dot ) );
 
   double t_apex = 1./(2 * omega) * log  ( - B_nx/ A_nx);
-  root->apex_time_ = floor(t_apex*1000)*0.001;
-  apex_time_list_.push_back(root->apex_time_);
+  state.apex_time_ = floor(t_apex*1000)*0.001;
+  apex_time_list_.push_back(state.apex_time_);
 
-  sejong::Vect3 nx_foot;
+  dynacore::Vect3 nx_foot;
   nx_foot[0] = nx_xp;
   nx_foot[1] = _find_yp(ini_state[1], ini_state[4], t_apex);
   nx_foot[2] = 0.;
 
-  root->foot_curr_frame_.tail(2) = nx_foot.tail(2);
-  root->foot_glob_.head(3) = nx_foot;
-  root->foot_glob_[3] = root->theta_;
-  foot_list_.push_back(root->foot_glob_);
+  state.foot_curr_frame_.tail(2) = nx_foot.tail(2);
+  state.foot_glob_.head(3) = nx_foot;
+  state.foot_glob_[3] = root->theta_;
+  foot_list_.push_back(state.foot_glob_);
 
   return true;
 }
 
 double RRT_Analytic_Solver::_find_yp( double y0, double y0dot, double t_apex){
-  double yp ( y0 - (1 + exp( 2* omega * t_apex))/ (1 - exp( 2* omega * t_apex)) * (y0dot/ omega) );
-  return yp;
+  return lipm_.get_yp(y0, y0dot, t_apex);
 }
 
 void RRT_Analytic_Solver::_get_yp_vel_constraint(double y0, double ydot0, double t_apex, double ydot_apex, double &yp){
-  double C = 0.5 * ( y0 + 1/omega * ydot0 );
-  double D = 0.5 * ( y0 - 1/omega * ydot0 );
-  double X = omega * C * exp(omega*t_apex) -  omega * D * exp(-omega*t_apex);
-  double Y = 0.5 * (omega * exp(-omega*t_apex) - omega * exp(omega*t_apex));
-  yp = (ydot_apex - X)/Y;
+  yp = lipm_.get_yp_vel_constraint(y0, ydot0, t_apex, ydot_apex);
 }
 
 void RRT_Analytic_Solver::_find_y_switching_state(double y0, double y0dot,
@@ -510,37 +513,22 @@ void RRT_Analytic_Solver::_find_y_switching_state(double y0, double y0dot,
                                                   double yp,
                                                   double & sw_pos,
                                                   double & sw_vel){
-  double A (0.5 * ( (y0 - yp) + 1./omega * y0dot));
-  double B (0.5 * ( (y0 - yp) - 1./omega * y0dot));
-
-  sw_pos = A * exp(omega * t_switch) + B * exp(-omega * t_switch) + yp;
-  sw_vel = omega * ( A * exp(omega * t_switch) - B * exp (-omega * t_switch));
+  lipm_.get_state(y0, y0dot, yp, t_switch, sw_pos, sw_vel);
 }
 
 double RRT_Analytic_Solver::_find_time(double x, double xdot,
                                        double x0, double x0dot,
                                        double xp){
-  double A ( 0.5 * ((x0-xp) + 1/omega * x0dot) );
-  double time = 1/omega * log ( (x + 1/omega * xdot - xp)/(2*A) );
-  return time;
+  return lipm_.get_time(x, xdot, x0, x0dot, xp);
 }
 
 double RRT_Analytic_Solver::_find_velocity(double x, double xp, double x0, double x0dot){
-  double sign(1.0);
-  if(x0dot < 0) sign = -1.0;
-
-  double xdot = sign * sqrt( pow(omega,2) * ( pow(x - xp, 2) - pow(x0 - xp, 2) ) + pow(x0dot, 2) );
-
-  return xdot;
+  return lipm_.get_velocity(x, xp, x0, x0dot);
 }
 double RRT_Analytic_Solver::_switching_state_x(double xp1, double xp2,
                                                double x0, double x0dot,
                                                double v_apex){
-  double C ( pow(x0 - xp1, 2.) + (pow(v_apex, 2.) - pow(x0dot, 2.))/pow(omega, 2.) );
-
-  double x_switch( 0.5 * (C / (xp2 - xp1) + (xp1 + xp2) ) );
-
-  return x_switch;
+  return lipm_.get_switching_state_x(xp1, xp2, x0, x0dot, v_apex);
 }
 
 void RRT_Analytic_Solver::_PreProcessing(Terrain* terrain,
@@ -549,24 +537,28 @@ void RRT_Analytic_Solver::_PreProcessing(Terrain* terrain,
   com_surf_ = com_surf;
 }
 
-void RRT_Analytic_Solver::_get_SE3(double x, double y, double theta, sejong::Matrix &SE3){
-  SE3 << cos(theta), -sin(theta), x,
-    sin(theta), cos(theta), y,
+void RRT_Analytic_Solver::_get_SE3(double x, double y, double theta, RRT_NodeState::SE2 &SE3){
+  double c(cos(theta));
+  double s(sin(theta));
+  SE3 << c, -s, x,
+    s, c, y,
     0, 0, 1;
 }
 
-void RRT_Analytic_Solver::_get_inv_SE3(double x, double y, double theta, sejong::Matrix &SE3_inv){
-  SE3_inv << cos(theta), sin(theta),-(x*cos(theta) + y*sin(theta)),
-    -sin(theta), cos(theta), -(y*cos(theta) - x*sin(theta)),
+void RRT_Analytic_Solver::_get_inv_SE3(double x, double y, double theta, RRT_NodeState::SE2 &SE3_inv){
+  double c(cos(theta));
+  double s(sin(theta));
+  SE3_inv << c, s,-(x*c + y*s),
+    -s, c, -(y*c - x*s),
     0, 0, 1;
 }
 
 
-void RRT_Analytic_Solver::_get_next_xp_in_prev_frame(sejong::Vector curr_node, sejong::Vector next_node, double & next_xp_in_prev_frame){
-  sejong::Matrix SE3_next(3,3);
-  sejong::Matrix SE3_inv_prev(3,3);
-  sejong::Vector origin_loc(3);
-  sejong::Vector sol(3);
+void RRT_Analytic_Solver::_get_next_xp_in_prev_frame(dynacore::Vector curr_node, dynacore::Vector next_node, double & next_xp_in_prev_frame){
+  RRT_NodeState::SE2 SE3_next;
+  RRT_NodeState::SE2 SE3_inv_prev;
+  dynacore::Vector origin_loc(3);
+  dynacore::Vector sol(3);
   origin_loc.setZero();
   _get_inv_SE3(curr_node[0], curr_node[1], curr_node[2], SE3_inv_prev);
   _get_SE3(next_node[0], next_node[1], next_node[2], SE3_next);
@@ -576,31 +568,32 @@ void RRT_Analytic_Solver::_get_next_xp_in_prev_frame(sejong::Vector curr_node, s
 }
 
 void RRT_Analytic_Solver::_get_curr_xp_in_prev_frame(RRT_Node * node){
-  sejong::Vector origin_loc(3);
-  sejong::Vector sol(3);
+  RRT_NodeState& state(_state(node));
+  const RRT_NodeState& parent_state(_state(_parent(node)));
+  dynacore::Vect3 origin_loc;
   origin_loc.setZero();
   origin_loc[2] = 1.0;
-  sol = node->parent_->inv_SE3_ * node->SE3_ * origin_loc;
-  node->foot_prev_frame_ = sol; //only sol[0] is valid
+  state.foot_prev_frame_ = parent_state.inv_SE3_ * state.SE3_ * origin_loc; //only [0] is valid
 }
 
 void RRT_Analytic_Solver::_get_apex_vel_decomp_in_prev_frame(RRT_Node * node){
-  node->apex_vel_decomp_prev_frame_[0] = VEL;
-  node->apex_vel_decomp_prev_frame_[1] = VEL * cos( node->theta_ - node->parent_->theta_ );
-  node->apex_vel_decomp_prev_frame_[2] = VEL * sin( node->theta_ - node->parent_->theta_ );
+  RRT_NodeState& state(_state(node));
+  state.apex_vel_decomp_prev_frame_[0] = VEL;
+  state.apex_vel_decomp_prev_frame_[1] = VEL * cos( node->theta_ - _parent(node)->theta_ );
+  state.apex_vel_decomp_prev_frame_[2] = VEL * sin( node->theta_ - _parent(node)->theta_ );
 }
 
-void RRT_Analytic_Solver::_TF_to_global(int node_idx, sejong::Vector & com_full_state){
-  sejong::Vector glob_xy(3);
-  sejong::Vector local_xy(3);
+void RRT_Analytic_Solver::_TF_to_global(int node_idx, dynacore::Vector & com_full_state){
+  dynacore::Vector glob_xy(3);
+  dynacore::Vector local_xy(3);
   local_xy[0] = com_full_state[0];
   local_xy[1] = com_full_state[1];
   local_xy[2] = 1.;
   glob_xy = SE3_list_[node_idx] * local_xy;
 
-  sejong::Vector glob_xy_dot(3);
-  sejong::Vector local_xy_dot(3);
-  sejong::Vector local_origin(3);
+  dynacore::Vector glob_xy_dot(3);
+  dynacore::Vector local_xy_dot(3);
+  dynacore::Vector local_origin(3);
   local_origin.setZero();
   local_origin[2] = 1.;
   local_xy_dot[0] = com_full_state[3];
@@ -608,8 +601,8 @@ void RRT_Analytic_Solver::_TF_to_global(int node_idx, sejong::Vector & com_full_
   local_xy_dot[2] = 1.;
   glob_xy_dot = SE3_list_[node_idx] * (local_xy_dot - local_origin);
 
-  sejong::Vector glob_xy_ddot(3);
-  sejong::Vector local_xy_ddot(3);
+  dynacore::Vector glob_xy_ddot(3);
+  dynacore::Vector local_xy_ddot(3);
   local_origin.setZero();
   local_origin[2] = 1.;
   local_xy_ddot[0] = com_full_state[6];
@@ -625,32 +618,31 @@ void RRT_Analytic_Solver::_TF_to_global(int node_idx, sejong::Vector & com_full_
   com_full_state[7] = glob_xy_ddot[1];
 }
 
-void RRT_Analytic_Solver::_TF_to_global(RRT_Node * node, sejong::Vector & com_full_state){
-  sejong::Vector glob_xy(3);
-  sejong::Vector local_xy(3);
+void RRT_Analytic_Solver::_TF_to_global(RRT_Node * node, dynacore::Vector & com_full_state){
+  const RRT_NodeState& parent_state(_state(_parent(node)));
+  dynacore::Vect3 glob_xy;
+  dynacore::Vect3 local_xy;
   local_xy[0] = com_full_state[0];
   local_xy[1] = com_full_state[1];
   local_xy[2] = 1.;
-  glob_xy = node->parent_->SE3_ * local_xy;
+  glob_xy = parent_state.SE3_ * local_xy;
 
-  sejong::Vector glob_xy_dot(3);
-  sejong::Vector local_xy_dot(3);
-  sejong::Vector local_origin(3);
+  dynacore::Vect3 glob_xy_dot;
+  dynacore::Vect3 local_xy_dot;
+  dynacore::Vect3 local_origin;
   local_origin.setZero();
   local_origin[2] = 1.;
   local_xy_dot[0] = com_full_state[3];
   local_xy_dot[1] = com_full_state[4];
   local_xy_dot[2] = 1.;
-  glob_xy_dot = node->parent_->SE3_ * (local_xy_dot - local_origin);
+  glob_xy_dot = parent_state.SE3_ * (local_xy_dot - local_origin);
 
-  sejong::Vector glob_xy_ddot(3);
-  sejong::Vector local_xy_ddot(3);
-  local_origin.setZero();
-  local_origin[2] = 1.;
+  dynacore::Vect3 glob_xy_ddot;
+  dynacore::Vect3 local_xy_ddot;
   local_xy_ddot[0] = com_full_state[6];
   local_xy_ddot[1] = com_full_state[7];
   local_xy_ddot[2] = 1.;
-  glob_xy_ddot = node->parent_->SE3_ * (local_xy_ddot - local_origin);
+  glob_xy_ddot = parent_state.SE3_ * (local_xy_ddot - local_origin);
 
   com_full_state[0] = glob_xy[0];
   com_full_state[1] = glob_xy[1];
@@ -673,23 +665,23 @@ double RRT_Analytic_Solver::Get_Cost(std::vector<RRT_Node *>& node_vector){
 //previous get param
 // void RRT_Analytic_Solver::Get_param(std::vector<RRT_Node *>& node_vector){
 //   std::vector<RRT_Node*>::iterator iter;
-//   sejong::Vector full_apex_state(9);
-//   sejong::Vector apex_xy(3);
-//   sejong::Vector apex_xy_next_frame(3);
-//   sejong::Vector foot_xy(3);
-//   sejong::Vector foot_xy_next_frame(3);
+//   dynacore::Vector full_apex_state(9);
+//   dynacore::Vector apex_xy(3);
+//   dynacore::Vector apex_xy_next_frame(3);
+//   dynacore::Vector foot_xy(3);
+//   dynacore::Vector foot_xy_next_frame(3);
 
 //   for(iter = node_vector.begin() + 1; iter != node_vector.end(); ++iter){
 //     (*iter)->parent_ = *(iter - 1);
-//     (*iter)->initial_state_prev_frame_ = sejong::Vector::Zero(6);
-//     (*iter)->foot_curr_frame_ = sejong::Vector::Zero(3);
-//     (*iter)->foot_prev_frame_ = sejong::Vector::Zero(3);
-//     (*iter)->apex_state_curr_frame_ = sejong::Vector::Zero(4);
-//     (*iter)->foot_glob_ = sejong::Vector::Zero(4);
-//     (*iter)->SE3_ = sejong::Matrix(3,3);
-//     (*iter)->inv_SE3_ = sejong::Matrix(3,3);
+//     (*iter)->initial_state_prev_frame_ = dynacore::Vector::Zero(6);
+//     (*iter)->foot_curr_frame_ = dynacore::Vector::Zero(3);
+//     (*iter)->foot_prev_frame_ = dynacore::Vector::Zero(3);
+//     (*iter)->apex_state_curr_frame_ = dynacore::Vector::Zero(4);
+//     (*iter)->foot_glob_ = dynacore::Vector::Zero(4);
+//     (*iter)->SE3_ = dynacore::Matrix(3,3);
+//     (*iter)->inv_SE3_ = dynacore::Matrix(3,3);
 //     (*iter)->idx_ = (*iter)->parent_->idx_ + 1;
-//     (*iter)->apex_vel_decomp_prev_frame_ = sejong::Vector::Zero(3);
+//     (*iter)->apex_vel_decomp_prev_frame_ = dynacore::Vector::Zero(3);
 
 //     _get_SE3((*iter)->x_, (*iter)->y_, (*iter)->theta_, (*iter)->SE3_);
 //     _get_inv_SE3((*iter)->x_, (*iter)->y_, (*iter)->theta_, (*iter)->inv_SE3_);
@@ -733,70 +725,53 @@ double RRT_Analytic_Solver::Get_Cost(std::vector<RRT_Node *>& node_vector){
 
 void RRT_Analytic_Solver::Get_param(std::vector<RRT_Node *>& node_vector){
   std::vector<RRT_Node*>::iterator iter;
-  sejong::Vector full_apex_state(9);
-  sejong::Vector apex_xy(3);
-  sejong::Vector apex_xy_vel(3);
-  sejong::Vector apex_xy_next_frame(3);
-  sejong::Vector foot_xy(3);
-  sejong::Vector foot_xy_next_frame(3);
+  dynacore::Vector full_apex_state(9);
 
   for(iter = node_vector.begin() + 1; iter != node_vector.end(); ++iter){
-    (*iter)->parent_ = *(iter - 1);
-    (*iter)->initial_state_prev_frame_ = sejong::Vector::Zero(6);
-    (*iter)->foot_curr_frame_ = sejong::Vector::Zero(3);
-    (*iter)->foot_prev_frame_ = sejong::Vector::Zero(3);
-    (*iter)->apex_state_curr_frame_ = sejong::Vector::Zero(4);
-    (*iter)->foot_glob_ = sejong::Vector::Zero(4);
-    (*iter)->SE3_ = sejong::Matrix(3,3);
-    (*iter)->inv_SE3_ = sejong::Matrix(3,3);
-    (*iter)->idx_ = (*iter)->parent_->idx_ + 1;
-    (*iter)->apex_vel_decomp_prev_frame_ = sejong::Vector::Zero(3);
-
-    _get_SE3((*iter)->x_, (*iter)->y_, (*iter)->theta_, (*iter)->SE3_);
-    _get_inv_SE3((*iter)->x_, (*iter)->y_, (*iter)->theta_, (*iter)->inv_SE3_);
+    RRT_Node* parent(*(iter - 1));
+    RRT_NodeState& state(_state(*iter));
+    const RRT_NodeState& parent_state(_state(parent));
+    (*iter)->parent_ = parent->id_;
+    state.initial_state_prev_frame_.setZero();
+    state.foot_curr_frame_.setZero();
+    state.foot_prev_frame_.setZero();
+    state.apex_state_curr_frame_.setZero();
+    state.foot_glob_.setZero();
+    (*iter)->idx_ = parent->idx_ + 1;
+    state.apex_vel_decomp_prev_frame_.setZero();
+
+    _get_SE3((*iter)->x_, (*iter)->y_, (*iter)->theta_, state.SE3_);
+    _get_inv_SE3((*iter)->x_, (*iter)->y_, (*iter)->theta_, state.inv_SE3_);
     _get_curr_xp_in_prev_frame(*iter);
     _get_apex_vel_decomp_in_prev_frame(*iter);
 
-    (*iter)->initial_state_prev_frame_[0] = _switching_state_x((*iter)->parent_->foot_curr_frame_[0], (*iter)->foot_prev_frame_[0], (*iter)->parent_->apex_state_curr_frame_[0], (*iter)->parent_->apex_state_curr_frame_[2], (*iter)->apex_vel_decomp_prev_frame_[1]);
+    state.initial_state_prev_frame_[0] = _switching_state_x(parent_state.foot_curr_frame_[0], state.foot_prev_frame_[0], parent_state.apex_state_curr_frame_[0], parent_state.apex_state_curr_frame_[2], state.apex_vel_decomp_prev_frame_[1]);
 
-    (*iter)->initial_state_prev_frame_[3] = _find_velocity((*iter)->initial_state_prev_frame_[0], (*iter)->parent_->foot_curr_frame_[0], (*iter)->parent_->apex_state_curr_frame_[0], (*iter)->parent_->apex_state_curr_frame_[2]);
+    state.initial_state_prev_frame_[3] = _find_velocity(state.initial_state_prev_frame_[0], parent_state.foot_curr_frame_[0], parent_state.apex_state_curr_frame_[0], parent_state.apex_state_curr_frame_[2]);
 
-    (*iter)->switching_time_ = _find_time((*iter)->initial_state_prev_frame_[0], (*iter)->initial_state_prev_frame_[3], (*iter)->parent_->apex_state_curr_frame_[0], (*iter)->parent_->apex_state_curr_frame_[2], (*iter)->parent_->foot_curr_frame_[0]);
+    state.switching_time_ = _find_time(state.initial_state_prev_frame_[0], state.initial_state_prev_frame_[3], parent_state.apex_state_curr_frame_[0], parent_state.apex_state_curr_frame_[2], parent_state.foot_curr_frame_[0]);
 
-    (*iter)->apex_time_ = _find_time((*iter)->foot_prev_frame_[0], (*iter)->apex_vel_decomp_prev_frame_[1], (*iter)->initial_state_prev_frame_[0], (*iter)->initial_state_prev_frame_[3], (*iter)->foot_prev_frame_[0]);
+    state.apex_time_ = _find_time(state.foot_prev_frame_[0], state.apex_vel_decomp_prev_frame_[1], state.initial_state_prev_frame_[0], state.initial_state_prev_frame_[3], state.foot_prev_frame_[0]);
 
-    (*iter)->cost_to_parent_ = (*iter)->switching_time_+(*iter)->apex_time_;
+    (*iter)->cost_to_parent_ = state.switching_time_+state.apex_time_;
 
-    //test
-    if((*iter)->cost_to_parent_<0){
-      std::cout<<"==============this node==============="<<std::endl;
-      std::cout<<"parent x,y,theat : "<<(*iter)->parent_->x_<<" "<<(*iter)->parent_->y_<<" "<<(*iter)->parent_->theta_<<std::endl;
-      std::cout<<"x,y,theat : "<<(*iter)->x_<<" "<<(*iter)->y_<<" "<<(*iter)->theta_<<std::endl;
-      sejong::pretty_print((*iter)->parent_->apex_state_curr_frame_, std::cout, "parent apex state curr frame");
-      std::cout<<"foot prev frame (x) : "<<(*iter)->foot_prev_frame_[0]<<std::endl;
-      std::cout<<"apex vel decomp prev frame (x) : "<<(*iter)->apex_vel_decomp_prev_frame_[1]<<std::endl;
-      std::cout<<"switching_time : "<<(*iter)->switching_time_<<std::endl;
-      std::cout<<"apex time : "<<(*iter)->apex_time_<<std::endl;
-      std::cout<<"==============this node end==============="<<std::endl;
-      exit(0);
-    }
-    //test end
+    _check_cost(*iter);
 
-    _find_y_switching_state((*iter)->parent_->apex_state_curr_frame_[1], (*iter)->parent_->apex_state_curr_frame_[3], (*iter)->switching_time_, (*iter)->parent_->foot_curr_frame_[1], (*iter)->initial_state_prev_frame_[1], (*iter)->initial_state_prev_frame_[4]);
+    _find_y_switching_state(parent_state.apex_state_curr_frame_[1], parent_state.apex_state_curr_frame_[3], state.switching_time_, parent_state.foot_curr_frame_[1], state.initial_state_prev_frame_[1], state.initial_state_prev_frame_[4]);
 
     //test
-    if( std::abs((*iter)->initial_state_prev_frame_[4]) < y_dot_des_ * cos((*iter)->theta_ - (*iter)->parent_->theta_)){
+    if( std::abs(state.initial_state_prev_frame_[4]) < y_dot_des_ * cos((*iter)->theta_ - parent->theta_)){
       //printf("computed v sw: %f \n",std::abs((*iter)->initial_state_prev_frame_[4]) );
       // printf("adjusted v sw: %f \n",y_dot_des_ * cos((*iter)->theta_ - (*iter)->parent_->theta_) );
 
-      if( (*iter)->initial_state_prev_frame_[4] < 0){
+      if( state.initial_state_prev_frame_[4] < 0){
         //(*iter)->initial_state_prev_frame_[4] = - y_dot_des_ * cos((*iter)->theta_ - (*iter)->parent_->theta_);
 
-        (*iter)->initial_state_prev_frame_[4] += 0.6 * (- y_dot_des_ * cos((*iter)->theta_ - (*iter)->parent_->theta_) - (*iter)->initial_state_prev_frame_[4] );
+        state.initial_state_prev_frame_[4] += 0.6 * (- y_dot_des_ * cos((*iter)->theta_ - parent->theta_) - state.initial_state_prev_frame_[4] );
 
       } else {
         //(*iter)->initial_state_prev_frame_[4] = y_dot_des_ * cos((*iter)->theta_ - (*iter)->parent_->theta_);
-        (*iter)->initial_state_prev_frame_[4] += 0.6 * (y_dot_des_ * cos((*iter)->theta_ - (*iter)->parent_->theta_) - (*iter)->initial_state_prev_frame_[4] );
+        state.initial_state_prev_frame_[4] += 0.6 * (y_dot_des_ * cos((*iter)->theta_ - parent->theta_) - state.initial_state_prev_frame_[4] );
 
       }
       //printf("adjusted v sw: %f \n",std::abs((*iter)->initial_state_prev_frame_[4]) );
@@ -804,75 +779,220 @@ void RRT_Analytic_Solver::Get_param(std::vector<RRT_Node *>& node_vector){
     }
     //test end
 
-    _get_yp_vel_constraint((*iter)->initial_state_prev_frame_[1], (*iter)->initial_state_prev_frame_[4], (*iter)->apex_time_, (*iter)->apex_vel_decomp_prev_frame_[2], (*iter)->foot_prev_frame_[1]);
+    _get_yp_vel_constraint(state.initial_state_prev_frame_[1], state.initial_state_prev_frame_[4], state.apex_time_, state.apex_vel_decomp_prev_frame_[2], state.foot_prev_frame_[1]);
+
+
+    _get_apex_state_in_glob_frame((*iter), full_apex_state);
+    _set_curr_frame((*iter), full_apex_state);
+  }
+}
+
+void RRT_Analytic_Solver::_check_cost(RRT_Node* node){
+  RRT_NodeState& state(_state(node));
+  const RRT_NodeState& parent_state(_state(_parent(node)));
+  if(node->cost_to_parent_<0){
+    std::cout<<"==============this node==============="<<std::endl;
+    std::cout<<"parent x,y,theat : "<<_parent(node)->x_<<" "<<_parent(node)->y_<<" "<<_parent(node)->theta_<<std::endl;
+    std::cout<<"x,y,theat : "<<node->x_<<" "<<node->y_<<" "<<node->theta_<<std::endl;
+    dynacore::pretty_print(dynacore::Vector(parent_state.apex_state_curr_frame_), std::cout, "parent apex state curr frame");
+    std::cout<<"foot prev frame (x) : "<<state.foot_prev_frame_[0]<<std::endl;
+    std::cout<<"apex vel decomp prev frame (x) : "<<state.apex_vel_decomp_prev_frame_[1]<<std::endl;
+    std::cout<<"switching_time : "<<state.switching_time_<<std::endl;
+    std::cout<<"apex time : "<<state.apex_time_<<std::endl;
+    std::cout<<"==============this node end==============="<<std::endl;
+    exit(0);
+  }
+}
 
+// foot and apex state in the node's own frame, from the apex state in the global frame
+void RRT_Analytic_Solver::_set_curr_frame(RRT_Node* node, const dynacore::Vector & full_apex_state){
+  RRT_NodeState& state(_state(node));
+  const RRT_NodeState& parent_state(_state(_parent(node)));
+  dynacore::Vect3 apex_xy;
+  dynacore::Vect3 apex_xy_vel;
+  dynacore::Vect3 foot_xy;
+
+  state.foot_prev_frame_[2] = 1.;
+  state.foot_glob_.head(3) = parent_state.SE3_ * state.foot_prev_frame_;
+  state.foot_glob_[2] = 0.;
+  state.foot_glob_[3] = node->theta_;
+
+  foot_xy = state.foot_glob_.head(3);
+  foot_xy[2] = 1.;
+  state.foot_curr_frame_ = state.inv_SE3_ * foot_xy;
+
+  apex_xy = full_apex_state.head(3);
+  apex_xy[2] = 1.;
+  state.apex_state_curr_frame_.head(2) = (state.inv_SE3_ * apex_xy).head(2);
+
+  apex_xy_vel[0] = full_apex_state[3];
+  apex_xy_vel[1] = full_apex_state[4];
+  apex_xy_vel[2] = 0.;
+  state.apex_state_curr_frame_.tail(2) = (state.inv_SE3_ * apex_xy_vel).head(2);
+}
 
-    (*iter)->foot_prev_frame_[2] = 1.;
-    (*iter)->foot_glob_.head(3) = (*iter)->parent_->SE3_ * (*iter)->foot_prev_frame_;
-    (*iter)->foot_glob_[2] = 0.;
-    (*iter)->foot_glob_[3] = (*iter)->theta_;
+void RRT_Analytic_Solver::Get_Costs(std::vector< std::vector<RRT_Node*>* >& paths, std::vector<double>& costs){
+  int num_path(paths.size());
+  for(int first(0); first < num_path; first += LIPM_Kernel::MAX_BATCH){
+    _get_param_batch(paths, first, std::min(LIPM_Kernel::MAX_BATCH, num_path - first));
+  }
+  costs.assign(num_path, 0.);
+  for(int i(0); i < num_path; ++i){
+    std::vector<RRT_Node*>::iterator iter;
+    for(iter = paths[i]->begin() + 1; iter != paths[i]->end(); ++iter){
+      costs[i] += (*iter)->cost_to_parent_;
+    }
+  }
+}
 
-    foot_xy = (*iter)->foot_glob_.head(3);
-    foot_xy[2] = 1.;
-    foot_xy_next_frame = (*iter)->inv_SE3_ * foot_xy;
-    (*iter)->foot_curr_frame_ = foot_xy_next_frame;
+// Get_param of paths[first, first + num): the k-th nodes of all the paths
+// are one step, each step gathers the frames node by node, evaluates the
+// pendulum for all of them at once, and scatters the results back
+void RRT_Analytic_Solver::_get_param_batch(std::vector< std::vector<RRT_Node*>* >& paths,
+                                           const int& first, const int& num){
+  typedef LIPM_Kernel::Array Array;
+  RRT_Node* nodes[LIPM_Kernel::MAX_BATCH];
+  dynacore::Vector full_apex_state(9);
+
+  int max_size(0);
+  for(int i(first); i < first + num; ++i){
+    max_size = std::max(max_size, (int)paths[i]->size());
+  }
 
-    _get_apex_state_in_glob_frame((*iter), full_apex_state);
-    apex_xy = full_apex_state.head(3);
-    apex_xy[2] = 1.;
-    apex_xy_next_frame = (*iter)->inv_SE3_ * apex_xy;
-    (*iter)->apex_state_curr_frame_.head(2) = apex_xy_next_frame.head(2);
-    // (*iter)->apex_state_curr_frame_[2] = (*iter)->apex_vel_decomp_prev_frame_[0];
-    // (*iter)->apex_state_curr_frame_[3] = 0.;
+  for(int k(1); k < max_size; ++k){
+    int n(0);
+    for(int i(first); i < first + num; ++i){
+      if((int)paths[i]->size() > k) ++n;
+    }
+    Array xp1(n), xp2(n), x0(n), x0dot(n), v_apex(n);
+    Array yp1(n), y0(n), y0dot(n), y_apex_vel(n), y_sw_vel_min(n);
+
+    n = 0;
+    for(int i(first); i < first + num; ++i){
+      if((int)paths[i]->size() <= k) continue;
+      RRT_Node* node((*paths[i])[k]);
+      RRT_Node* parent((*paths[i])[k - 1]);
+      RRT_NodeState& state(_state(node));
+      const RRT_NodeState& parent_state(_state(parent));
+      nodes[n] = node;
+      node->parent_ = parent->id_;
+      state.initial_state_prev_frame_.setZero();
+      state.foot_curr_frame_.setZero();
+      state.foot_prev_frame_.setZero();
+      state.apex_state_curr_frame_.setZero();
+      state.foot_glob_.setZero();
+      node->idx_ = parent->idx_ + 1;
+      state.apex_vel_decomp_prev_frame_.setZero();
+
+      _get_SE3(node->x_, node->y_, node->theta_, state.SE3_);
+      _get_inv_SE3(node->x_, node->y_, node->theta_, state.inv_SE3_);
+      _get_curr_xp_in_prev_frame(node);
+      _get_apex_vel_decomp_in_prev_frame(node);
+
+      xp1[n] = parent_state.foot_curr_frame_[0];
+      xp2[n] = state.foot_prev_frame_[0];
+      x0[n] = parent_state.apex_state_curr_frame_[0];
+      x0dot[n] = parent_state.apex_state_curr_frame_[2];
+      v_apex[n] = state.apex_vel_decomp_prev_frame_[1];
+      yp1[n] = parent_state.foot_curr_frame_[1];
+      y0[n] = parent_state.apex_state_curr_frame_[1];
+      y0dot[n] = parent_state.apex_state_curr_frame_[3];
+      y_apex_vel[n] = state.apex_vel_decomp_prev_frame_[2];
+      y_sw_vel_min[n] = y_dot_des_ * cos(node->theta_ - parent->theta_);
+      ++n;
+    }
 
-    //test
-    apex_xy_vel[0] = full_apex_state[3];
-    apex_xy_vel[1] = full_apex_state[4];
-    apex_xy_vel[2] = 0.;
-    (*iter)->apex_state_curr_frame_.tail(2) = ((*iter)->inv_SE3_ * apex_xy_vel).head(2);
-    //test end
+    // switching state and times in x
+    Array x_sw(n), xdot_sw(n), t_sw(n), t_apex(n);
+    lipm_.get_switching_state_x(xp1, xp2, x0, x0dot, v_apex, x_sw);
+    lipm_.get_velocity(x_sw, xp1, x0, x0dot, xdot_sw);
+    lipm_.get_time(x_sw, xdot_sw, x0, x0dot, xp1, t_sw);
+    lipm_.get_time(xp2, v_apex, x_sw, xdot_sw, xp2, t_apex);
+
+    Array exp_pos_sw(n), exp_neg_sw(n), exp_pos_apex(n), exp_neg_apex(n);
+    lipm_.get_exp(t_sw, exp_pos_sw, exp_neg_sw);
+    lipm_.get_exp(t_apex, exp_pos_apex, exp_neg_apex);
+
+    // switching state in y, lateral velocity pulled toward y_dot_des
+    Array y_sw(n), ydot_sw(n), yp2(n);
+    lipm_.get_state(y0, y0dot, yp1, exp_pos_sw, exp_neg_sw, y_sw, ydot_sw);
+    Array y_sw_vel_target( (ydot_sw < 0.).select(-y_sw_vel_min, y_sw_vel_min) );
+    ydot_sw = (ydot_sw.abs() < y_sw_vel_min).select(ydot_sw + 0.6 * (y_sw_vel_target - ydot_sw), ydot_sw);
+    lipm_.get_yp_vel_constraint(y_sw, ydot_sw, exp_pos_apex, exp_neg_apex, y_apex_vel, yp2);
+
+    // apex state in the previous frame
+    Array x_apex(n), xdot_apex(n), y_apex(n), ydot_apex(n);
+    lipm_.get_state(x_sw, xdot_sw, xp2, exp_pos_apex, exp_neg_apex, x_apex, xdot_apex);
+    lipm_.get_state(y_sw, ydot_sw, yp2, exp_pos_apex, exp_neg_apex, y_apex, ydot_apex);
+
+    for(int j(0); j < n; ++j){
+      RRT_Node* node(nodes[j]);
+      RRT_NodeState& state(_state(node));
+      state.initial_state_prev_frame_[0] = x_sw[j];
+      state.initial_state_prev_frame_[3] = xdot_sw[j];
+      state.switching_time_ = t_sw[j];
+      state.apex_time_ = t_apex[j];
+      node->cost_to_parent_ = t_sw[j] + t_apex[j];
+      _check_cost(node);
+
+      state.initial_state_prev_frame_[1] = y_sw[j];
+      state.initial_state_prev_frame_[4] = ydot_sw[j];
+      state.foot_prev_frame_[1] = yp2[j];
+
+      full_apex_state[0] = x_apex[j];
+      full_apex_state[1] = y_apex[j];
+      full_apex_state[2] = 1.0758;
+      full_apex_state[3] = xdot_apex[j];
+      full_apex_state[4] = ydot_apex[j];
+      full_apex_state[5] = 0.;
+      full_apex_state[6] = omega * omega * (x_apex[j] - xp2[j]);
+      full_apex_state[7] = omega * omega * (y_apex[j] - yp2[j]);
+      full_apex_state[8] = 0.;
+      _TF_to_global(node, full_apex_state);
+      _set_curr_frame(node, full_apex_state);
+    }
   }
 }
 
 void RRT_Analytic_Solver::Set_root_node(RRT_Param* param, RRT_Node *root){
+  RRT_NodeState& state(_state(root));
   _clear_vector();
   VEL = param->apex_vel;
   y_dot_des_ = param->y_dot_des;
   foot_list_.push_back(param->fixed_pivot);
   initial_state_list_.push_back(param->curr_com_state);
 
-  root->SE3_ = sejong::Matrix(3,3);
-  root->inv_SE3_ = sejong::Matrix(3,3);
-  root->initial_state_prev_frame_ = sejong::Vector::Zero(6);
-  root->foot_curr_frame_ = sejong::Vector::Zero(3);
-  root->apex_state_curr_frame_ = sejong::Vector::Zero(4);
-  root->foot_glob_ = sejong::Vector::Zero(4);
+  state.initial_state_prev_frame_.setZero();
+  state.foot_curr_frame_.setZero();
+  state.apex_state_curr_frame_.setZero();
+  state.foot_glob_.setZero();
 
   root->x_ = param->root_x;
   root->y_ = param->root_y;
   root->theta_ = param->root_theta;
   root->idx_ = 1;
-  _get_SE3(root->x_, root->y_, root->theta_, root->SE3_);
-  _get_inv_SE3(root->x_, root->y_, root->theta_, root->inv_SE3_);
-  SE3_list_.push_back(root->SE3_);
-  inv_SE3_list_.push_back(root->inv_SE3_);
+  _get_SE3(root->x_, root->y_, root->theta_, state.SE3_);
+  _get_inv_SE3(root->x_, root->y_, root->theta_, state.inv_SE3_);
+  SE3_list_.push_back(state.SE3_);
+  inv_SE3_list_.push_back(state.inv_SE3_);
 
   omega = sqrt(9.81/param->curr_com_state[2]);
+  lipm_.set_omega(omega);
 
-  sejong::Vector ini_state(6);
-  sejong::Vector full_apex_state(9);
+  dynacore::Vector ini_state(6);
+  dynacore::Vector full_apex_state(9);
   double xp1;
 
   _find_initial_root(param->curr_com_state, param->fixed_pivot,
                      root->x_, param->apex_vel, root,
                      ini_state);
 
-  root->initial_state_prev_frame_ = ini_state;
+  state.initial_state_prev_frame_ = ini_state;
   initial_state_list_.push_back(ini_state);
 
-  GetCoMState(1,root->apex_time_ , full_apex_state);
-  root->apex_state_curr_frame_<< 0, full_apex_state[1], full_apex_state[3], full_apex_state[4];
-  apex_state_list_.push_back(root->apex_state_curr_frame_);
+  GetCoMState(1,state.apex_time_ , full_apex_state);
+  state.apex_state_curr_frame_<< 0, full_apex_state[1], full_apex_state[3], full_apex_state[4];
+  apex_state_list_.push_back(state.apex_state_curr_frame_);
   std::cout<<"[ROOT NODE] SETTED"<<std::endl;
 }
 
@@ -890,41 +1010,45 @@ void RRT_Analytic_Solver::_clear_vector(){
 }
 
 void RRT_Analytic_Solver::_node_print(RRT_Node* node){
+  RRT_NodeState& state(_state(node));
   std::cout<<"=============================================="<<std::endl;
   std::cout<<"node's idx: "<<node->idx_<<std::endl;
   std::cout<<"node's x: "<<node->x_<<std::endl;
   std::cout<<"node's y: "<<node->y_<<std::endl;
   std::cout<<"node's theta: "<<node->theta_<<std::endl;
-  std::cout<<"node's SE3: "<<"\n"<<node->SE3_<<std::endl;
-  std::cout<<"node's inv_SE3: "<<"\n"<<node->inv_SE3_<<std::endl;
-  std::cout<<"node's switching_time: "<<node->switching_time_<<std::endl;
-  std::cout<<"node's apex_time: "<<node->apex_time_<<std::endl;
-  std::cout<<"node's foot_curr_frame: "<<"\n"<<node->foot_curr_frame_<<std::endl;
-  std::cout<<"node's apex_state_curr_frame: "<<"\n"<<node->apex_state_curr_frame_<<std::endl;
-  std::cout<<"node's foot_glob: "<<"\n"<<node->foot_glob_<<std::endl;
+  std::cout<<"node's SE3: "<<"\n"<<state.SE3_<<std::endl;
+  std::cout<<"node's inv_SE3: "<<"\n"<<state.inv_SE3_<<std::endl;
+  std::cout<<"node's switching_time: "<<state.switching_time_<<std::endl;
+  std::cout<<"node's apex_time: "<<state.apex_time_<<std::endl;
+  std::cout<<"node's foot_curr_frame: "<<"\n"<<state.foot_curr_frame_<<std::endl;
+  std::cout<<"node's apex_state_curr_frame: "<<"\n"<<state.apex_state_curr_frame_<<std::endl;
+  std::cout<<"node's foot_glob: "<<"\n"<<state.foot_glob_<<std::endl;
   std::cout<<"=============================================="<<std::endl;
 }
 
-void RRT_Analytic_Solver::_get_apex_state_in_glob_frame(RRT_Node* node, sejong::Vector & apex_full_state){
-  apex_full_state = sejong::Vector::Zero(9);
+void RRT_Analytic_Solver::_get_apex_state_in_glob_frame(RRT_Node* node, dynacore::Vector & apex_full_state){
+  RRT_NodeState& state(_state(node));
+  apex_full_state = dynacore::Vector::Zero(9);
 
   double foot_pos[2];
-  foot_pos[0] = node->foot_prev_frame_[0];
-  foot_pos[1] = node->foot_prev_frame_[1];
+  foot_pos[0] = state.foot_prev_frame_[0];
+  foot_pos[1] = state.foot_prev_frame_[1];
 
   double A[2];
   double B[2];
-  A[0] = 0.5 * ( (node->initial_state_prev_frame_[0] - foot_pos[0]) + 1./omega * node->initial_state_prev_frame_[3]);
-  B[0] = 0.5 * ( (node->initial_state_prev_frame_[0] - foot_pos[0]) - 1./omega * node->initial_state_prev_frame_[3]);
+  A[0] = 0.5 * ( (state.initial_state_prev_frame_[0] - foot_pos[0]) + 1./omega * state.initial_state_prev_frame_[3]);
+  B[0] = 0.5 * ( (state.initial_state_prev_frame_[0] - foot_pos[0]) - 1./omega * state.initial_state_prev_frame_[3]);
 
-  A[1] = 0.5 * ( (node->initial_state_prev_frame_[1] - foot_pos[1]) + 1./omega * node->initial_state_prev_frame_[4]);
-  B[1] = 0.5 * ( (node->initial_state_prev_frame_[1] - foot_pos[1]) - 1./omega * node->initial_state_prev_frame_[4]);
+  A[1] = 0.5 * ( (state.initial_state_prev_frame_[1] - foot_pos[1]) + 1./omega * state.initial_state_prev_frame_[4]);
+  B[1] = 0.5 * ( (state.initial_state_prev_frame_[1] - foot_pos[1]) - 1./omega * state.initial_state_prev_frame_[4]);
 
-  double time(node->apex_time_);
+  double time(state.apex_time_);
 
+  double exp_pos, exp_neg;
+  lipm_.get_exp(time, exp_pos, exp_neg);
   for (int i(0); i < 2; ++i){
-    apex_full_state[i] = A[i] * exp(omega*time) + B[i] * exp(-omega*time) + foot_pos[i];
-    apex_full_state[3 + i] = omega * (A[i] * exp(omega*time) - B[i] * exp(-omega*time));
+    apex_full_state[i] = A[i] * exp_pos + B[i] * exp_neg + foot_pos[i];
+    apex_full_state[3 + i] = omega * (A[i] * exp_pos - B[i] * exp_neg);
     apex_full_state[6 + i] = omega * omega * (apex_full_state[i] - foot_pos[i]);
   }
   apex_full_state[2] = 1.0758;
@@ -935,34 +1059,33 @@ void RRT_Analytic_Solver::_get_apex_state_in_glob_frame(RRT_Node* node, sejong::
 }
 void RRT_Analytic_Solver::_plotting_full_trajectory(RRT_Param* param){
 
-  RRT_Node ttemp = RRT_Node(0,0,0);
-  ttemp = *(param->root_node);
+  const RRT_Node* ttemp = param->root_node;
 
-  sejong::Vector node_pos(3);
-  sejong::Vector com_full_state(9);
+  dynacore::Vector node_pos(3);
+  dynacore::Vector com_full_state(9);
 
   for(int i(1); i < num_sequence_; ++i){
-    node_pos[0] = ttemp.x_;
-    node_pos[1] = ttemp.y_;
-    node_pos[2] = ttemp.theta_;
-    sejong::saveVector(node_pos, "RRT_node");
+    node_pos[0] = ttemp->x_;
+    node_pos[1] = ttemp->y_;
+    node_pos[2] = ttemp->theta_;
+    dynacore::saveVector(node_pos, "RRT_node");
 
-    ttemp = *(ttemp.sol_child_);
+    ttemp = node_pool_->get(ttemp->sol_child_);
   }
 
   for(int i(0); i < foot_list_.size(); ++i){
-    sejong::saveVector(foot_list_[i], "RRT_foot");
+    dynacore::saveVector(foot_list_[i], "RRT_foot");
   }
 
   for(int i(0); i < switching_time_list_[0]*1000; ++i){
     GetCoMState(0, i*0.001, com_full_state);
-    sejong::saveVector(com_full_state, "RRT_com");
+    dynacore::saveVector(com_full_state, "RRT_com");
   }
 
   for(int i(0); i < num_sequence_; ++i){
     for(int j(0); j < 1000 * (switching_time_list_[i+1] + apex_time_list_[i]); ++j){
       GetCoMState(i+1, j*0.001, com_full_state);
-      sejong::saveVector(com_full_state, "RRT_com");
+      dynacore::saveVector(com_full_state, "RRT_com");
     }
   }
   std::cout<<"[DATA SAVED FOR PLOTTING]"<<std::endl;
@@ -21,11 +21,11 @@ public:
                             PlanningParam * planner_param);
 
   //(x, y, z, xdot, ydot, zdot, xddot, yddot, zddot)
-  virtual bool GetCoMState(int step_idx, double time, sejong::Vector & com_full_state) = 0;
+  virtual bool GetCoMState(int step_idx, double time, dynacore::Vector & com_full_state) = 0;
   virtual double GetFinTime(int step_idx) = 0;
   virtual bool GetFootPlacement(int sequence_idx,
-                                sejong::Vector & foot_placement) = 0;
-  virtual bool GetOrientation(int sequence_idx, sejong::Quaternion &ori) = 0;
+                                dynacore::Vector & foot_placement) = 0;
+  virtual bool GetOrientation(int sequence_idx, dynacore::Quaternion &ori) = 0;
 
  protected:
 
@@ -5,9 +5,26 @@
 
 const double RRT_Node::NULL_COST = 0.0;
 
+RRT_NodeState::RRT_NodeState()
+{ reset(); }
+
+void RRT_NodeState::reset()
+{
+  switching_time_ = 0.;
+  apex_time_ = 0.;
+
+  initial_state_prev_frame_.setZero();
+  foot_curr_frame_.setZero();
+  foot_prev_frame_.setZero();
+  apex_vel_decomp_prev_frame_.setZero();
+  apex_state_curr_frame_.setZero();
+  foot_glob_.setZero();
+  SE3_.setIdentity();
+  inv_SE3_.setIdentity();
+}
 
 RRT_Node::RRT_Node()
-{ RRT_Node(0.,0.,0.); }
+{ reset(0., 0., 0.); }
 
 //nullptr{ RRT_Node(0.,0.,0.); }
 
@@ -19,12 +36,19 @@ RRT_Node::RRT_Node()
 // }
 
 RRT_Node::RRT_Node(const double x, const double y, const double theta)
+{ reset(x, y, theta); }
+
+void RRT_Node::reset(const double x, const double y, const double theta)
 {
+  idx_ = 0;
   x_ = x;
   y_ = y;
   theta_ = remainder( theta , 2.*M_PI );
   cost_to_parent_ = NULL_COST;
-  parent_ = NULL;
+
+  id_ = -1;
+  parent_ = -1;
+  sol_child_ = -1;
 }
 
 RRT_Node::~RRT_Node()
@@ -34,27 +58,6 @@ RRT_Node::~RRT_Node()
 } // does not delete parent_ because parent_ could still be a valid part of the tree
 
 
-double RRT_Node::get_cost_to_root() const
-{
-  // Recursive Implementation:
-  // if (parent_ == NULL)
-  //   return 0.;
-  // else
-  //   return cost_to_parent_ + parent_->get_cost_to_root;
-
-  // While Loop Implementation:
-  RRT_Node* p = parent_;
-  double total(cost_to_parent_);
-
-  while (p != NULL)
-  {
-    total += p->cost_to_parent_;
-    p = p->parent_;
-  }
-
-  return total;
-}
-
 std::string RRT_Node::to_string() const
 {
   std::string s;
@@ -88,16 +91,16 @@ void RRT_Node::print_node() const
 
 void RRT_Node::save_node(std::string name) const
 {
-  sejong::Vector node_data(3);
+  dynacore::Vector node_data(3);
   node_data << x_, y_, theta_;
-  sejong::saveVector(node_data, name);
+  dynacore::saveVector(node_data, name);
 }
 
-void RRT_Node::save_node_2(std::string name) const
+void RRT_Node::save_node_2(std::string name, double cost_to_root) const
 {
-  sejong::Vector node_data(4);
-  node_data << x_, y_, theta_, get_cost_to_root();
-  sejong::saveVector(node_data, name);
+  dynacore::Vector node_data(4);
+  node_data << x_, y_, theta_, cost_to_root;
+  dynacore::saveVector(node_data, name);
 }
 
 bool RRT_Node::operator ==(const RRT_Node& n) const
@@ -2,31 +2,54 @@
 #define RRT_NODE
 
 #include <Utils/wrap_eigen.hpp>
-#include <Utils/utilities.h>
+#include <Utils/utilities.hpp>
 #include <string>
 #include <sstream>
 #include <iomanip>
 
+// State of a node that only RRT_Analytic_Solver computes. Kept apart from
+// RRT_Node in RRT_NodePool, so a tree searched by euclidean cost does not
+// carry it.
+class RRT_NodeState{
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  typedef Eigen::Matrix<double, 3, 1> Vect3;
+  typedef Eigen::Matrix<double, 4, 1> Vect4;
+  typedef Eigen::Matrix<double, 6, 1> Vect6;
+  typedef Eigen::Matrix<double, 3, 3> SE2; // homogeneous 2D transform
+
+  double switching_time_, apex_time_;
+  Vect6 initial_state_prev_frame_;
+  Vect3 foot_curr_frame_, foot_prev_frame_, apex_vel_decomp_prev_frame_;
+  Vect4 apex_state_curr_frame_, foot_glob_;
+  SE2 SE3_, inv_SE3_;
+
+  RRT_NodeState();
+  void reset();
+};
+
 class RRT_Node{
 public:
+  double x_, y_, theta_, cost_to_parent_;
   int idx_;
-  double x_, y_, theta_, cost_to_parent_, switching_time_, apex_time_;
-  sejong::Vector initial_state_prev_frame_, foot_curr_frame_, foot_prev_frame_, apex_state_curr_frame_, foot_glob_, apex_vel_decomp_prev_frame_;
-  sejong::Matrix SE3_, inv_SE3_;
 
-  RRT_Node* parent_;
-  RRT_Node* sol_child_;
+  // indices in the RRT_NodePool the node belongs to, -1 for none
+  int id_;
+  int parent_;
+  int sol_child_;
 
   RRT_Node();
   // RRT_Node(const RRT_Node& n);
   RRT_Node(const double x, const double y, const double theta);
   ~RRT_Node(); // does not delete parent_ because parent_ could still be a valid part of the tree
+  // same state as RRT_Node(x, y, theta), used by RRT_NodePool to recycle nodes
+  void reset(const double x, const double y, const double theta);
 
-  double get_cost_to_root() const;
   std::string to_string() const;
   void print_node() const;
   void save_node(std::string name) const;
-  void save_node_2(std::string name) const;
+  void save_node_2(std::string name, double cost_to_root) const;
 
   bool operator== (const RRT_Node &n) const;
   bool operator!= (const RRT_Node &n) const;
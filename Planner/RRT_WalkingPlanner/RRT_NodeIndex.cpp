@@ -0,0 +1,178 @@
+#include "RRT_NodeIndex.h"
+#include <cmath>
+
+RRT_NodeIndex::RRT_NodeIndex():
+  x_min_(0.), y_min_(0.), cell_size_(1.), heading_size_(2.*M_PI),
+  num_x_(1), num_y_(1), num_heading_(1), num_nodes_(0),
+  cells_(1)
+{}
+
+RRT_NodeIndex::~RRT_NodeIndex(){} // does not delete nodes, tree_ owns them
+
+void RRT_NodeIndex::initialize(const dynacore::Vector& search_boundary, const double& cell_size,
+                               const int& num_heading)
+{
+  cell_size_ = cell_size;
+  num_heading_ = std::max(1, num_heading);
+  heading_size_ = 2.*M_PI / num_heading_;
+  x_min_ = search_boundary[0];
+  y_min_ = search_boundary[2];
+  num_x_ = std::max(1, (int)ceil( (search_boundary[1] - search_boundary[0]) / cell_size_ ));
+  num_y_ = std::max(1, (int)ceil( (search_boundary[3] - search_boundary[2]) / cell_size_ ));
+
+  cells_.clear();
+  cells_.resize(num_x_ * num_y_ * num_heading_);
+  num_nodes_ = 0;
+}
+
+void RRT_NodeIndex::insert(RRT_Node* node)
+{
+  int xy( _get_cell_y(node->y_) * num_x_ + _get_cell_x(node->x_) );
+  cells_[ xy * num_heading_ + _get_cell_heading(node->theta_) ].push_back(node);
+  ++num_nodes_;
+}
+
+void RRT_NodeIndex::clear()
+{
+  for (std::vector< std::vector<RRT_Node*> >::iterator it = cells_.begin(); it != cells_.end(); ++it)
+    it->clear();
+  num_nodes_ = 0;
+}
+
+void RRT_NodeIndex::rebuild(const std::vector<RRT_Node*>& nodes)
+{
+  clear();
+  for (std::vector<RRT_Node*>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+    if (*it != NULL) insert(*it);
+}
+
+// Points outside the boundary are clamped to the border cells. Their true
+// position is only farther away, so the bound still holds for them.
+double RRT_NodeIndex::get_ring_distance(const int& ring) const
+{
+  if (ring < 2) return 0.;
+  return (ring - 1) * cell_size_;
+}
+
+void RRT_NodeIndex::get_ring(const double& x, const double& y, const double& theta,
+                             const double& radius, const int& ring,
+                             std::vector<RRT_NodeBound>& cells) const
+{
+  int cx(_get_cell_x(x));
+  int cy(_get_cell_y(y));
+  double heading( remainder(theta, 2.*M_PI) );
+
+  for (int j(cy - ring); j <= cy + ring; ++j)
+  {
+    if (j < 0 || j >= num_y_) continue;
+    // full rows on the top and bottom of the ring, only the two ends otherwise
+    int step( (j == cy - ring || j == cy + ring) ? 1 : 2*ring );
+
+    // border cells also hold the nodes outside the boundary
+    double y_low( (j == 0) ? -HUGE_VAL : y_min_ + j * cell_size_ );
+    double y_high( (j == num_y_ - 1) ? HUGE_VAL : y_min_ + (j + 1) * cell_size_ );
+    double dy( std::max(0., std::max(y_low - y, y - y_high)) );
+
+    for (int i(cx - ring); i <= cx + ring; i += step)
+    {
+      if (i < 0 || i >= num_x_) continue;
+      double x_low( (i == 0) ? -HUGE_VAL : x_min_ + i * cell_size_ );
+      double x_high( (i == num_x_ - 1) ? HUGE_VAL : x_min_ + (i + 1) * cell_size_ );
+      double dx( std::max(0., std::max(x_low - x, x - x_high)) );
+      double dist( sqrt(dx*dx + dy*dy) );
+
+      int xy( j * num_x_ + i );
+      for (int k(0); k < num_heading_; ++k)
+      {
+        int cell( xy * num_heading_ + k );
+        if (cells_[cell].empty()) continue;
+
+        double low( -M_PI + k * heading_size_ );
+        double turn(0.);
+        if ( heading < low || heading > low + heading_size_ )
+          turn = radius * std::min( _get_heading_change(heading, low),
+                                    _get_heading_change(heading, low + heading_size_) );
+        cells.push_back( RRT_NodeBound(std::max(dist, turn), cell, false, NULL) );
+      }
+    }
+  }
+}
+
+double RRT_NodeIndex::get_distance_bound(const RRT_Node& node, const double& x, const double& y,
+                                         const double& theta, const double& radius)
+{
+  // straight segment can not be shorter than the distance, and the arcs
+  // have to turn at least the heading difference
+  double dist( sqrt( (node.x_ - x)*(node.x_ - x) + (node.y_ - y)*(node.y_ - y) ) );
+  double turn( _get_heading_change(theta, node.theta_) * radius );
+  return std::max(dist, turn);
+}
+
+double RRT_NodeIndex::get_lower_bound(const RRT_Node& node, const double& x, const double& y,
+                                      const double& theta, const double& radius)
+{
+  // shortest path to the end point with free heading, forward from node and
+  // backward from the sample
+  double forward( _get_point_bound(node.x_, node.y_, node.theta_, x, y, radius) );
+  double backward( _get_point_bound(x, y, theta + M_PI, node.x_, node.y_, radius) );
+
+  return std::max( get_distance_bound(node, x, y, theta, radius),
+                   std::max(forward, backward) );
+}
+
+// Length of the shortest curvature bounded path from (x0, y0, theta0) to the
+// point (x, y). Outside both turning circles it is the shorter of the
+// turn-then-straight paths; inside a circle only the distance is used.
+double RRT_NodeIndex::_get_point_bound(const double& x0, const double& y0, const double& theta0,
+                                       const double& x, const double& y, const double& radius)
+{
+  double c(cos(theta0)), s(sin(theta0));
+  double px(  c*(x - x0) + s*(y - y0) );
+  double py( -s*(x - x0) + c*(y - y0) );
+  double dist( sqrt(px*px + py*py) );
+
+  double min_length(-1.);
+  for (int side(-1); side < 2; side += 2)
+  {
+    // turning circle at (0, side * radius), target mirrored to a left turn
+    double vx(px), vy(side * py - radius);
+    double center_dist( sqrt(vx*vx + vy*vy) );
+    if (center_dist < radius) return dist;
+
+    double tangent( sqrt(center_dist*center_dist - radius*radius) );
+    // within [-pi, 3pi/2]: atan2 in [-pi, pi], acos in [0, pi/2]
+    double arc( atan2(vy, vx) - acos(radius / center_dist) + M_PI/2. );
+    if (arc < 0.) arc += 2.*M_PI;
+
+    double length( radius * arc + tangent );
+    if (min_length < 0. || length < min_length) min_length = length;
+  }
+  return min_length;
+}
+
+int RRT_NodeIndex::_get_cell_x(const double& x) const
+{
+  int i( (int)floor( (x - x_min_) / cell_size_ ) );
+  return std::min(std::max(i, 0), num_x_ - 1);
+}
+
+int RRT_NodeIndex::_get_cell_y(const double& y) const
+{
+  int j( (int)floor( (y - y_min_) / cell_size_ ) );
+  return std::min(std::max(j, 0), num_y_ - 1);
+}
+
+int RRT_NodeIndex::_get_cell_heading(const double& theta) const
+{
+  int k( (int)floor( (remainder(theta, 2.*M_PI) + M_PI) / heading_size_ ) );
+  return std::min(std::max(k, 0), num_heading_ - 1);
+}
+
+// |theta_0 - theta_1| on the circle; headings are normally within [-pi, pi]
+double RRT_NodeIndex::_get_heading_change(const double& theta_0, const double& theta_1)
+{
+  double diff( std::abs(theta_0 - theta_1) );
+  if (diff > 2.*M_PI) diff = fmod(diff, 2.*M_PI);
+  if (diff > M_PI) diff = 2.*M_PI - diff;
+  return diff;
+}
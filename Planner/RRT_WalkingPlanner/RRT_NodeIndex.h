@@ -0,0 +1,67 @@
+#ifndef RRT_NODE_INDEX
+#define RRT_NODE_INDEX
+
+#include <Utils/wrap_eigen.hpp>
+#include <vector>
+#include <algorithm>
+#include "RRT_Node.h"
+
+// Entry of the nearest neighbor search, either a whole cell (node == NULL)
+// or a single node. Ordered as a min-heap on the lower bound.
+struct RRT_NodeBound{
+  double bound;
+  int cell;
+  bool refined; // node bound from get_lower_bound, otherwise get_distance_bound
+  RRT_Node* node;
+
+  RRT_NodeBound(double b, int c, bool r, RRT_Node* n): bound(b), cell(c), refined(r), node(n) {}
+  bool operator< (const RRT_NodeBound& rhs) const { return bound > rhs.bound; }
+};
+
+// Grid over (x, y, theta) of the tree nodes, filled incrementally as the
+// tree grows. Planar cells are visited in square rings around a query
+// point; every node in ring r is at least get_ring_distance(r) away, and
+// every node of a cell at least the cell bound (distance to the cell box,
+// heading change to its heading bin). Both lower-bound the Dubins path
+// length to the node.
+class RRT_NodeIndex{
+public:
+  RRT_NodeIndex();
+  ~RRT_NodeIndex();
+
+  // search_boundary: x_min, x_max, y_min, y_max
+  void initialize(const dynacore::Vector& search_boundary, const double& cell_size,
+                  const int& num_heading);
+  void insert(RRT_Node* node);
+  void clear();
+  void rebuild(const std::vector<RRT_Node*>& nodes);
+
+  int get_num_nodes() const { return num_nodes_; }
+  int get_num_rings() const { return std::max(num_x_, num_y_); }
+  double get_ring_distance(const int& ring) const;
+  // Appends the non-empty cells at Chebyshev distance ring with their bound
+  void get_ring(const double& x, const double& y, const double& theta, const double& radius,
+                const int& ring, std::vector<RRT_NodeBound>& cells) const;
+  const std::vector<RRT_Node*>& get_cell(const int& cell) const { return cells_[cell]; }
+
+  // Lower bounds of the Dubins path length from node to (x, y, theta):
+  // distance and heading change only (cheap), or with the turning circles
+  static double get_distance_bound(const RRT_Node& node, const double& x, const double& y,
+                                   const double& theta, const double& radius);
+  static double get_lower_bound(const RRT_Node& node, const double& x, const double& y,
+                                const double& theta, const double& radius);
+
+protected:
+  double x_min_, y_min_, cell_size_, heading_size_;
+  int num_x_, num_y_, num_heading_, num_nodes_;
+  std::vector< std::vector<RRT_Node*> > cells_;
+
+  int _get_cell_x(const double& x) const;
+  int _get_cell_y(const double& y) const;
+  int _get_cell_heading(const double& theta) const;
+  static double _get_heading_change(const double& theta_0, const double& theta_1);
+  static double _get_point_bound(const double& x0, const double& y0, const double& theta0,
+                                 const double& x, const double& y, const double& radius);
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "RRT_NodePool.h"
+
+RRT_NodePool::RRT_NodePool(const int& block_size):
+  shift_(0),
+  num_used_(0)
+{
+  while ((1 << shift_) < block_size) ++shift_;
+  mask_ = (1 << shift_) - 1;
+}
+
+RRT_NodePool::~RRT_NodePool()
+{
+  for (std::vector<RRT_Node*>::iterator it = blocks_.begin(); it != blocks_.end(); ++it)
+    delete [] *it;
+  for (std::vector<RRT_NodeState*>::iterator it = state_blocks_.begin(); it != state_blocks_.end(); ++it)
+    delete [] *it;
+}
+
+RRT_Node* RRT_NodePool::allocate(const double x, const double y, const double theta)
+{
+  RRT_Node* node = _get_new_node();
+  int id( node->id_ );
+  node->reset(x, y, theta);
+  node->id_ = id;
+  if (state_blocks_[id >> shift_] != NULL)
+    state_blocks_[id >> shift_][id & mask_].reset();
+  return node;
+}
+
+RRT_Node* RRT_NodePool::allocate(const RRT_Node& node)
+{
+  RRT_Node* copy = _get_new_node();
+  int id( copy->id_ );
+  *copy = node;
+  copy->id_ = id;
+
+  RRT_NodeState* state = state_blocks_[id >> shift_];
+  if (state != NULL) state[id & mask_].reset();
+  if (node.id_ >= 0 && node.id_ < num_used_ && get(node.id_) == &node &&
+      state_blocks_[node.id_ >> shift_] != NULL)
+    get_state(copy) = state_blocks_[node.id_ >> shift_][node.id_ & mask_];
+  return copy;
+}
+
+void RRT_NodePool::release(RRT_Node* node)
+{
+  if (node != NULL) free_nodes_.push_back(node->id_);
+}
+
+void RRT_NodePool::clear()
+{
+  num_used_ = 0;
+  free_nodes_.clear();
+}
+
+RRT_NodeState& RRT_NodePool::get_state(const RRT_Node* node)
+{
+  RRT_NodeState*& block = state_blocks_[node->id_ >> shift_];
+  if (block == NULL) block = new RRT_NodeState[mask_ + 1];
+  return block[node->id_ & mask_];
+}
+
+double RRT_NodePool::get_cost_to_root(const RRT_Node* node) const
+{
+  double total(node->cost_to_parent_);
+  for (const RRT_Node* p = get_parent(node); p != NULL; p = get_parent(p))
+    total += p->cost_to_parent_;
+  return total;
+}
+
+RRT_Node* RRT_NodePool::_get_new_node()
+{
+  int id;
+  if (!free_nodes_.empty())
+  {
+    id = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+  else
+  {
+    id = num_used_++;
+    if ((id >> shift_) == (int)blocks_.size())
+    {
+      blocks_.push_back(new RRT_Node[mask_ + 1]);
+      state_blocks_.push_back(NULL);
+    }
+  }
+
+  RRT_Node* node = get(id);
+  node->id_ = id;
+  return node;
+}
@@ -0,0 +1,49 @@
+#ifndef RRT_NODE_POOL
+#define RRT_NODE_POOL
+
+#include <vector>
+#include "RRT_Node.h"
+
+// Storage of the planner's nodes. Nodes live in fixed blocks that are never
+// moved and are named by their 32-bit id (RRT_Node::id_), which parent_ and
+// sol_child_ refer to. Released nodes are reused by the next allocate();
+// clear() drops every node at once and keeps the blocks for the next tree.
+//
+// The solver state of a node (RRT_NodeState) is kept in a parallel block
+// that is only allocated when get_state() is first called for one of its
+// nodes, so a tree searched by euclidean cost stays at sizeof(RRT_Node) per
+// node.
+class RRT_NodePool{
+public:
+  // block_size is rounded up to a power of two
+  RRT_NodePool(const int& block_size = 1024);
+  ~RRT_NodePool();
+
+  RRT_Node* allocate(const double x, const double y, const double theta);
+  // copies the parent link and, for a node of this pool, the solver state
+  RRT_Node* allocate(const RRT_Node& node);
+  void release(RRT_Node* node);
+  void clear();
+
+  RRT_Node* get(const int& id) const
+  { return (id < 0) ? NULL : blocks_[id >> shift_] + (id & mask_); }
+  RRT_Node* get_parent(const RRT_Node* node) const { return get(node->parent_); }
+  // node must belong to this pool
+  RRT_NodeState& get_state(const RRT_Node* node);
+  double get_cost_to_root(const RRT_Node* node) const;
+
+  int get_num_nodes() const { return num_used_ - (int)free_nodes_.size(); }
+  int get_capacity() const { return (int)blocks_.size() * (mask_ + 1); }
+
+protected:
+  int shift_;
+  int mask_;
+  int num_used_; // nodes handed out from the blocks, including released ones
+  std::vector<RRT_Node*> blocks_;
+  std::vector<RRT_NodeState*> state_blocks_; // NULL until a state is asked for
+  std::vector<int> free_nodes_;
+
+  RRT_Node* _get_new_node();
+};
+
+#endif
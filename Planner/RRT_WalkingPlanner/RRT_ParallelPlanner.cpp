@@ -0,0 +1,95 @@
+#include "RRT_ParallelPlanner.h"
+#include <iostream>
+#include <thread>
+#include "EnvironmentSetup/Obstacle.h"
+
+RRT_ParallelPlanner::RRT_ParallelPlanner(const dynacore::Vector& search_boundary,
+                                         const RRT_Node& start, const RRT_Node& goal,
+                                         const std::vector<Obstacle>& obstacle_list,
+                                         const int& num_trees, const unsigned int& seed)
+{
+  std::vector<RRT_Analytic_Solver*> solvers(std::max(1, num_trees), (RRT_Analytic_Solver*)NULL);
+  _Init(search_boundary, start, goal, obstacle_list, solvers, seed);
+}
+
+RRT_ParallelPlanner::RRT_ParallelPlanner(const dynacore::Vector& search_boundary,
+                                         const RRT_Node& start, const RRT_Node& goal,
+                                         const std::vector<Obstacle>& obstacle_list,
+                                         const std::vector<RRT_Analytic_Solver*>& solvers,
+                                         const unsigned int& seed)
+{
+  _Init(search_boundary, start, goal, obstacle_list, solvers, seed);
+}
+
+void RRT_ParallelPlanner::_Init(const dynacore::Vector& search_boundary,
+                                const RRT_Node& start, const RRT_Node& goal,
+                                const std::vector<Obstacle>& obstacle_list,
+                                const std::vector<RRT_Analytic_Solver*>& solvers,
+                                const unsigned int& seed)
+{
+  best_tree_ = -1;
+  best_cost_ = 0.;
+  set_num_threads(0);
+
+  for (int i(0); i < (int)solvers.size(); ++i)
+  {
+    // trees do not write the shared data files
+    planners_.push_back(new RRT_Planner(search_boundary, start, goal, obstacle_list,
+                                        solvers[i], false));
+    planners_.back()->set_seed(seed + i);
+  }
+  std::cout << "[RRT Parallel Planner] " << planners_.size() << " trees, seed "
+            << seed << std::endl;
+}
+
+RRT_ParallelPlanner::~RRT_ParallelPlanner()
+{
+  for (std::vector<RRT_Planner*>::iterator it = planners_.begin(); it != planners_.end(); ++it)
+    delete *it;
+}
+
+void RRT_ParallelPlanner::set_num_threads(const int& num_threads)
+{
+  num_threads_ = num_threads;
+  if (num_threads_ < 1) num_threads_ = std::max(1, (int)std::thread::hardware_concurrency());
+}
+
+bool RRT_ParallelPlanner::build_RRT(const int& num_samples)
+{
+  std::atomic<int> next_tree(0);
+  int num_trees( planners_.size() );
+  int num_workers( std::min(num_threads_, num_trees) );
+
+  std::vector<std::thread> workers;
+  for (int w(1); w < num_workers; ++w)
+    workers.push_back( std::thread(&RRT_ParallelPlanner::_build_trees, this,
+                                   &next_tree, num_samples) );
+  _build_trees(&next_tree, num_samples);
+  for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+    it->join();
+
+  best_tree_ = -1;
+  for (int i(0); i < num_trees; ++i)
+  {
+    if (!planners_[i]->has_solution()) continue;
+    double cost( planners_[i]->get_cost_to_root(planners_[i]->goal_) );
+    if (best_tree_ < 0 || cost < best_cost_)
+    {
+      best_tree_ = i;
+      best_cost_ = cost;
+    }
+  }
+  return best_tree_ >= 0;
+}
+
+void RRT_ParallelPlanner::_build_trees(std::atomic<int>* next_tree, int num_samples)
+{
+  for (int i((*next_tree)++); i < (int)planners_.size(); i = (*next_tree)++)
+    planners_[i]->build_RRT(num_samples);
+}
+
+void RRT_ParallelPlanner::get_solution(std::vector<RRT_Node*>& solution) const
+{
+  solution.clear();
+  if (best_tree_ >= 0) planners_[best_tree_]->get_solution(solution);
+}
@@ -0,0 +1,54 @@
+#ifndef RRT_PARALLEL_PLANNER
+#define RRT_PARALLEL_PLANNER
+
+#include <atomic>
+#include "RRT_Planner.h"
+
+// Several RRT_Planner trees grown at the same time on worker threads. Tree
+// i samples with seed + i, so every tree is reproducible; the solution with
+// the lowest cost wins, ties to the lower tree. The result depends on the
+// seed and the number of trees, not on the number of threads.
+class RRT_ParallelPlanner{
+public:
+  // Euclidean cost on the Dubins paths
+  RRT_ParallelPlanner(const dynacore::Vector& search_boundary,
+                      const RRT_Node& start, const RRT_Node& goal,
+                      const std::vector<Obstacle>& obstacle_list,
+                      const int& num_trees, const unsigned int& seed);
+  // One solver per tree: RRT_Analytic_Solver keeps the lists of the last evaluation
+  RRT_ParallelPlanner(const dynacore::Vector& search_boundary,
+                      const RRT_Node& start, const RRT_Node& goal,
+                      const std::vector<Obstacle>& obstacle_list,
+                      const std::vector<RRT_Analytic_Solver*>& solvers,
+                      const unsigned int& seed);
+  ~RRT_ParallelPlanner();
+
+  // 0: one thread per core
+  void set_num_threads(const int& num_threads);
+  int get_num_threads() const { return num_threads_; }
+  int get_num_trees() const { return (int)planners_.size(); }
+
+  // Grows every tree for up to num_samples, true if any of them reached the goal
+  bool build_RRT(const int& num_samples);
+
+  int get_best_tree() const { return best_tree_; } // -1 without a solution
+  double get_best_cost() const { return best_cost_; }
+  RRT_Planner* get_planner(const int& tree) { return planners_[tree]; }
+  void get_solution(std::vector<RRT_Node*>& solution) const;
+
+protected:
+  std::vector<RRT_Planner*> planners_;
+  int num_threads_;
+  int best_tree_;
+  double best_cost_;
+
+  // workers take the next tree until none is left
+  void _build_trees(std::atomic<int>* next_tree, int num_samples);
+  void _Init(const dynacore::Vector& search_boundary,
+             const RRT_Node& start, const RRT_Node& goal,
+             const std::vector<Obstacle>& obstacle_list,
+             const std::vector<RRT_Analytic_Solver*>& solvers,
+             const unsigned int& seed);
+};
+
+#endif
@@ -4,68 +4,70 @@
 #include "PIPM_Planner_ConfSpace.h"
 #include "EnvironmentSetup/Obstacle.h"
 #include "EnvironmentSetup/ObstacleBuilder.h"
+#include <algorithm>
 
 #define SAVE_DATA
 
 
-RRT_Planner::RRT_Planner(const sejong::Vector& search_boundary,
+RRT_Planner::RRT_Planner(const dynacore::Vector& search_boundary,
                          const RRT_Node& start, const RRT_Node& goal,
                          const std::vector<Obstacle>& obstacle_list,
-                         RRT_Analytic_Solver * RRT_analytic_solver)
+                         RRT_Analytic_Solver * RRT_analytic_solver, const bool& save_data)
 {
   analytic_solver_ = RRT_analytic_solver;
-  _Init(search_boundary,start,goal,obstacle_list);
+  _Init(search_boundary,start,goal,obstacle_list,save_data);
 }
 
-RRT_Planner::RRT_Planner(const sejong::Vector& search_boundary,
+RRT_Planner::RRT_Planner(const dynacore::Vector& search_boundary,
                          const RRT_Node& start, const RRT_Node& goal,
                          const std::vector<Obstacle>& obstacle_list)
 {
   analytic_solver_ = NULL;
-  _Init(search_boundary,start,goal,obstacle_list);
+  _Init(search_boundary,start,goal,obstacle_list,true);
 }
 
 
-void RRT_Planner::_Init(const sejong::Vector& search_boundary,
+void RRT_Planner::_Init(const dynacore::Vector& search_boundary,
                    const RRT_Node& start, const RRT_Node& goal,
-                   const std::vector<Obstacle>& obstacle_list)
+                   const std::vector<Obstacle>& obstacle_list, const bool& save_data)
 
 {
   max_turn_ = M_PI / 4.0;
   x_p_ = 0.2;
   safety_margin_ = 0.5;
   found_solution_ = false;
+  save_data_ = save_data;
   rad = 1.;
-  histogram_cost_compare_ = sejong::Vector::Zero(20);
+  num_nearby_nodes_ = 20;
+  index_cell_size_ = 0.5;
+  index_num_heading_ = 16;
+  histogram_cost_compare_ = dynacore::Vector::Zero(20);
 
   search_boundary_ = search_boundary;
 #ifdef SAVE_DATA
-  sejong::saveVector(search_boundary_, "axes");
+  if (save_data_) dynacore::saveVector(search_boundary_, "axes");
 #endif
 
-  tree_.push_back(new RRT_Node(start));
+  node_index_.initialize(search_boundary_, index_cell_size_, index_num_heading_);
+  tree_.push_back(node_pool_.allocate(start));
+  tree_.back()->parent_ = -1;
+  node_index_.insert(tree_.back());
 #ifdef SAVE_DATA
-  start.save_node_2("tree");
+  if (save_data_) start.save_node_2("tree", start.cost_to_parent_);
 #endif
-  goal_ = new RRT_Node(goal);
+  goal_ = node_pool_.allocate(goal);
+  goal_->parent_ = -1;
+  if (analytic_solver_ != NULL) analytic_solver_->Set_node_pool(&node_pool_);
 
   obstacle_list_ = obstacle_list;
 
-  std::cout << "[RRT Planner] constructed" << std::endl;
+  if (save_data_) std::cout << "[RRT Planner] constructed" << std::endl;
 
-  srand((unsigned)time(NULL));
+  rng_.seed((unsigned)time(NULL));
 }
 
 
-RRT_Planner::~RRT_Planner() {
-
-  std::vector<RRT_Node*>::iterator it = tree_.begin();
-  for (; it != tree_.end(); ++it )
-    delete *it;
-
-  if(!found_solution_)
-    delete goal_;
-}
+RRT_Planner::~RRT_Planner() {} // node_pool_ frees every node at once
 
 bool RRT_Planner::build_RRT(const int& num_samples) {
 
@@ -80,7 +82,7 @@ bool RRT_Planner::build_RRT(const int& num_samples) {
       rand_sample(sample);
     }
 
-    if(i%30 == 0){
+    if(save_data_ && i%30 == 0){
       std::cout<<i<<"th : "<<std::endl;
       sample.print_node();
 }
@@ -96,7 +98,7 @@ bool RRT_Planner::build_RRT(const int& num_samples) {
     if ( *(new_branch.back()) == *goal_ )
     {
       //std::cout << "Found solution after " << i << " samples" << std::endl;
-      delete goal_;
+      node_pool_.release(goal_);
       found_solution_ = true;
       goal_ = new_branch.back();
       return true; // connected start to goal
@@ -117,7 +119,7 @@ void RRT_Planner::get_solution(std::vector<RRT_Node*>& solution) const
     while (n != NULL)
     {
       solution.push_back(n);
-      n = n->parent_;
+      n = node_pool_.get_parent(n);
     }
     std::reverse(solution.begin(),solution.end());
 
@@ -126,17 +128,17 @@ void RRT_Planner::get_solution(std::vector<RRT_Node*>& solution) const
     for (; it != solution.end(); ++it){
       // std::cout << "Node " << i << ": " << "x = " << (*it)->x_ << ", y = " << (*it)->y_ << ", theta = " << (*it)->theta_ << ", cost = " << (*it)->cost_to_parent_ << std::endl;
       // (*it)->print_node();
-      (*it)->save_node_2("soln");
+      (*it)->save_node_2("soln", node_pool_.get_cost_to_root(*it));
     }
-    ObstacleBuilder::save_obs_vectors(obstacle_list_, solution.back()->get_cost_to_root(), 0.2);
+    ObstacleBuilder::save_obs_vectors(obstacle_list_, node_pool_.get_cost_to_root(solution.back()), 0.2);
 #endif
   }
 
-  // sejong::Vector idx = sejong::Vector::LinSpaced(20,1,20);
-  // sejong::Matrix hist(20,2);
+  // dynacore::Vector idx = dynacore::Vector::LinSpaced(20,1,20);
+  // dynacore::Matrix hist(20,2);
   // hist << idx, histogram_cost_compare_;
 
-  // sejong::pretty_print(hist, std::cout, "Histogram of solutions");
+  // dynacore::pretty_print(hist, std::cout, "Histogram of solutions");
 }
 
 
@@ -173,12 +175,12 @@ void RRT_Planner::shortcut_solution(const int num_iterations, std::vector<RRT_No
       shortcut_length = (int)floor((variate1 * std_dev) + mean);
       _bound_shortcut_length(shortcut_length, min_shortcut, max_shortcut);
 
-      start_index = SJ_RAND_INT(0, solution.size()-shortcut_length );
+      start_index = _get_rand_int(0, solution.size()-shortcut_length );
 
       // std::cout << start_index << " -> " << (start_index+shortcut_length);// << std::endl;
 
-      cost =  (solution[start_index+shortcut_length])->get_cost_to_root()
-            - (solution[start_index])->get_cost_to_root();
+      cost =  node_pool_.get_cost_to_root(solution[start_index+shortcut_length])
+            - node_pool_.get_cost_to_root(solution[start_index]);
 
       // std::cout << " cost = " << cost << ", " << std::endl; //<< " -> ";
 
@@ -204,7 +206,7 @@ void RRT_Planner::shortcut_solution(const int num_iterations, std::vector<RRT_No
 
         for(; it < it_end && it_shrtct < tmp_path.end(); ++it, ++it_shrtct)
         {
-          delete *it;
+          node_pool_.release(*it);
           *it = *it_shrtct;
         }
 
@@ -212,7 +214,7 @@ void RRT_Planner::shortcut_solution(const int num_iterations, std::vector<RRT_No
         {
           for (; it != it_end; ++it)
           {
-            delete *it;
+            node_pool_.release(*it);
             *it = NULL;
           }
           // Warning: I don't understand the code
@@ -232,7 +234,7 @@ void RRT_Planner::shortcut_solution(const int num_iterations, std::vector<RRT_No
           it++;
 
           for(; it != solution.end(); ++it, ++it_p ) // starts from first new node
-            (*it)->parent_ = *it_p;
+            (*it)->parent_ = (*it_p)->id_;
         }
 
         tmp_path.clear();
@@ -241,13 +243,14 @@ void RRT_Planner::shortcut_solution(const int num_iterations, std::vector<RRT_No
       {
         std::vector<RRT_Node*>::iterator it = tmp_path.begin();
         for (; it != tmp_path.end(); ++it )
-          delete *it;
+          node_pool_.release(*it);
         tmp_path.clear();
       }
 
       max_shortcut = solution.size()-1;
     }
     tree_ = solution;
+    node_index_.rebuild(tree_);
     // std::cout << "Revised solution " << revision_count << " times." << std::endl;
   }
 #ifdef SAVE_DATA
@@ -256,7 +259,7 @@ void RRT_Planner::shortcut_solution(const int num_iterations, std::vector<RRT_No
     {
       // std::cout << "Node " << i << ": " << "x = " << (*it)->x_ << ", y = " << (*it)->y_ << ", theta = " << (*it)->theta_ << ", cost = " << (*it)->cost_to_parent_ << std::endl;
       // (*it)->print_node();
-      (*it)->save_node_2("soln2");
+      (*it)->save_node_2("soln2", node_pool_.get_cost_to_root(*it));
     }
 #endif
 
@@ -278,56 +281,89 @@ void RRT_Planner::get_nearest_neighbor_path(const RRT_Node& sample, RRT_Node*& n
   std::list<path_type> nearby_nodes_type;
   std::list<double>    nearby_nodes_cost;
 
-  std::vector<RRT_Node*>::iterator it = tree_.begin();
+  std::vector<RRT_Node*>::const_iterator it;
+  std::vector<RRT_NodeBound> candidates; // min-heap on the lower bound
   std::list  <RRT_Node*>::iterator it_nearby_nodes;
   std::list  <path_type>::iterator it_nearby_nodes_type;
   std::list  <double   >::iterator it_nearby_nodes_cost;
 
   // std::cout << "\n\nTree_Size = " << tree_.size() << std::endl;
 
-  // Using dubins path length to gather a list of the nearest 20 nodes:
-  for (; nearby_nodes.size() < 20 && it != tree_.end(); ++it )
+  // Using dubins path length to gather a list of the nearest 20 nodes.
+  // Best-first on a lower bound of the path length: rings of grid cells are
+  // added while they can hold a node below the top of the heap, a cell is
+  // opened when it reaches the top, the tighter node bound is computed when
+  // a node reaches the top, and the exact length only when that bound can
+  // still beat the current 20th candidate.
+  bool is_full(false);
+  int ring(0);
+  while (true)
   {
-    soln_type = UNKNOWN;
-    get_path(**it, sample, false, path, cost, soln_type);
+    while ( ring < node_index_.get_num_rings() &&
+            ( candidates.empty() || node_index_.get_ring_distance(ring) <= candidates.front().bound ) )
+    {
+      size_t num_before( candidates.size() );
+      node_index_.get_ring(sample.x_, sample.y_, sample.theta_, rad, ring, candidates);
+      for (size_t i(num_before); i < candidates.size(); ++i)
+        std::push_heap(candidates.begin(), candidates.begin() + i + 1);
+      ++ring;
+    }
+    if (candidates.empty()) break;
 
-    it_nearby_nodes      = nearby_nodes.begin();
-    it_nearby_nodes_type = nearby_nodes_type.begin();
-    it_nearby_nodes_cost = nearby_nodes_cost.begin();
+    RRT_NodeBound top( candidates.front() );
+    std::pop_heap(candidates.begin(), candidates.end());
+    candidates.pop_back();
 
-    // Sorted insert
-    for(; it_nearby_nodes != nearby_nodes.end() && cost > *it_nearby_nodes_cost;
-        ++it_nearby_nodes, ++it_nearby_nodes_type, ++it_nearby_nodes_cost ) {}
-    nearby_nodes.insert(      it_nearby_nodes      , *it       );
-    nearby_nodes_type.insert( it_nearby_nodes_type , soln_type );
-    nearby_nodes_cost.insert( it_nearby_nodes_cost , cost      );
+    if ( is_full && top.bound > nearby_nodes_cost.back() ) break;
 
-    // ++counter;
-    // std::cout << "Inserted node " << counter << std::endl;
-  }
+    if (top.node == NULL)
+    {
+      const std::vector<RRT_Node*>& cell = node_index_.get_cell(top.cell);
+      for (it = cell.begin(); it != cell.end(); ++it )
+      {
+        double bound( RRT_NodeIndex::get_distance_bound(**it, sample.x_, sample.y_, sample.theta_, rad) );
+        if ( !is_full || bound <= nearby_nodes_cost.back() )
+        {
+          candidates.push_back( RRT_NodeBound(bound, top.cell, false, *it) );
+          std::push_heap(candidates.begin(), candidates.end());
+        }
+      }
+      continue;
+    }
 
-  for (; it != tree_.end(); ++it )
-  {
-    get_path(**it, sample, false, path, cost, soln_type);
+    if (!top.refined)
+    {
+      top.bound = RRT_NodeIndex::get_lower_bound(*top.node, sample.x_, sample.y_, sample.theta_, rad);
+      top.refined = true;
+      candidates.push_back(top);
+      std::push_heap(candidates.begin(), candidates.end());
+      continue;
+    }
+
+    soln_type = UNKNOWN;
+    get_path(*top.node, sample, false, path, cost, soln_type);
 
     it_nearby_nodes      = nearby_nodes.begin();
     it_nearby_nodes_type = nearby_nodes_type.begin();
     it_nearby_nodes_cost = nearby_nodes_cost.begin();
 
-    // Sorted insert and delete
+    // Sorted insert (and delete once full)
     for(; it_nearby_nodes != nearby_nodes.end() && cost > *it_nearby_nodes_cost;
         ++it_nearby_nodes, ++it_nearby_nodes_type, ++it_nearby_nodes_cost ) {}
-    if(it_nearby_nodes != nearby_nodes.end())
+    if(!is_full || it_nearby_nodes != nearby_nodes.end())
     {
-      nearby_nodes.insert(      it_nearby_nodes      , *it       );
+      nearby_nodes.insert(      it_nearby_nodes      , top.node  );
       nearby_nodes_type.insert( it_nearby_nodes_type , soln_type );
       nearby_nodes_cost.insert( it_nearby_nodes_cost , cost      );
 
-      nearby_nodes.pop_back();
-      nearby_nodes_type.pop_back();
-      nearby_nodes_cost.pop_back();
+      if(is_full)
+      {
+        nearby_nodes.pop_back();
+        nearby_nodes_type.pop_back();
+        nearby_nodes_cost.pop_back();
+      }
+      is_full = ( (int)nearby_nodes.size() >= num_nearby_nodes_ );
     }
-
   }
 
 
@@ -339,6 +375,40 @@ void RRT_Planner::get_nearest_neighbor_path(const RRT_Node& sample, RRT_Node*& n
   int idx(0);
   int soln(0);
 
+  if (analytic_solver_ != NULL)
+  {
+    // All the candidate paths are timed together (one pendulum step of
+    // every path at once), then the first minimum is kept as below
+    std::vector< std::vector<RRT_Node*> > candidate_paths(nearby_nodes.size());
+    std::vector< std::vector<RRT_Node*>* > candidate_ptrs(nearby_nodes.size());
+    std::vector<double> candidate_costs;
+    for (; it_nearby_nodes != nearby_nodes.end(); ++it_nearby_nodes, ++it_nearby_nodes_type, ++idx)
+    {
+      get_path(**it_nearby_nodes, sample, true, candidate_paths[idx], cost, *it_nearby_nodes_type, false);
+      candidate_ptrs[idx] = &candidate_paths[idx];
+    }
+    analytic_solver_->Get_Costs(candidate_ptrs, candidate_costs);
+
+    it_nearby_nodes = nearby_nodes.begin();
+    for (idx = 0; idx < (int)candidate_paths.size(); ++idx, ++it_nearby_nodes)
+    {
+      _check_time(candidate_paths[idx], candidate_costs[idx]);
+      if (idx == 0 || candidate_costs[idx] < candidate_costs[soln])
+      {
+        soln = idx;
+        nearest_neighbor = *it_nearby_nodes;
+      }
+    }
+    for (idx = 0; idx < (int)candidate_paths.size(); ++idx)
+    {
+      if (idx == soln) continue;
+      for (it = candidate_paths[idx].begin(); it != candidate_paths[idx].end(); ++it)
+        node_pool_.release(*it);
+    }
+    path.swap(candidate_paths[soln]);
+    return;
+  }
+
   get_path(**it_nearby_nodes, sample, true, path, cost, *it_nearby_nodes_type);
 
   nearest_neighbor = *it_nearby_nodes;
@@ -365,9 +435,9 @@ void RRT_Planner::get_nearest_neighbor_path(const RRT_Node& sample, RRT_Node*& n
 
 void RRT_Planner::rand_sample(RRT_Node& rand_node)
 {
-  rand_node = RRT_Node( SJ_RAND(search_boundary_(0),search_boundary_(1)) ,
-                        SJ_RAND(search_boundary_(2),search_boundary_(3)) ,
-                        SJ_RAND(      0.0          ,      2.*M_PI      ) );
+  rand_node = RRT_Node( _get_rand(search_boundary_(0),search_boundary_(1)) ,
+                        _get_rand(search_boundary_(2),search_boundary_(3)) ,
+                        _get_rand(      0.0          ,      2.*M_PI      ) );
 }
 
 
@@ -388,7 +458,7 @@ void RRT_Planner::prune_for_collisions(std::vector<RRT_Node*>& path)
     {
       // if(found_solution_)
       //   std::cout << "Node " << idx << (*it_n)->to_string() << "\n";
-      delete *it_n;
+      node_pool_.release(*it_n);
     }
     else
     {
@@ -396,7 +466,7 @@ void RRT_Planner::prune_for_collisions(std::vector<RRT_Node*>& path)
       {
         hit_obstacle = true;
         it_n_remove = it_n;
-        delete *it_n;
+        node_pool_.release(*it_n);
       }
       else
       {
@@ -410,11 +480,11 @@ void RRT_Planner::prune_for_collisions(std::vector<RRT_Node*>& path)
           // if(idx == 15) margin = 0.74;
           ++idx;
 
-          if( it_obs->is_collision( (*it_n)->get_cost_to_root(), (*it_n)->x_, (*it_n)->y_,  margin) )
+          if( it_obs->is_collision( node_pool_.get_cost_to_root(*it_n), (*it_n)->x_, (*it_n)->y_,  margin) )
           {
             hit_obstacle = true;
             it_n_remove = it_n;
-            delete *it_n;
+            node_pool_.release(*it_n);
             break;
           }
         }
@@ -435,25 +505,26 @@ bool RRT_Planner::_is_out_of_bounds(const RRT_Node* node){
 
 
 void RRT_Planner::get_path(const RRT_Node& start, const RRT_Node& end, const bool& calc_nodes,
-                            std::vector<RRT_Node*>& path, double& cost, path_type& soln_type)
+                            std::vector<RRT_Node*>& path, double& cost, path_type& soln_type,
+                            const bool& calc_cost)
 {
 #ifdef SAVE_DATA
   std::string error_str("");
-  sejong::Vector err_track(8);
+  Eigen::Matrix<double, 8, 1> err_track;
 #endif
 
   // Define inscribed circles:
-  sejong::Vector center_cw_0(2);
-  sejong::Vector center_ccw_0(2);
-  sejong::Vector center_cw_1(2);
-  sejong::Vector center_ccw_1(2);
+  dynacore::Vect2 center_cw_0;
+  dynacore::Vect2 center_ccw_0;
+  dynacore::Vect2 center_cw_1;
+  dynacore::Vect2 center_ccw_1;
 
   center_cw_0  << start.x_ + rad*sin(start.theta_), start.y_ - rad*cos(start.theta_);
   center_ccw_0 << start.x_ - rad*sin(start.theta_), start.y_ + rad*cos(start.theta_);
   center_cw_1  <<   end.x_ + rad*sin(  end.theta_),   end.y_ - rad*cos(  end.theta_);
   center_ccw_1 <<   end.x_ - rad*sin(  end.theta_),   end.y_ + rad*cos(  end.theta_);
 
-  sejong::Vector center_to_center(2);
+  dynacore::Vect2 center_to_center;
   double theta_tangent, turn_0, turn_1;
 
   cost = 0.;
@@ -495,7 +566,7 @@ void RRT_Planner::get_path(const RRT_Node& start, const RRT_Node& end, const boo
         _get_nodes_on_path(turn_0, center_cw_0,
                            turn_1, center_cw_1,
                            start, end, rad, path);
-        cost = _get_cost(path);
+        if(calc_cost) cost = _get_cost(path);
 
       }
       else
@@ -561,7 +632,7 @@ void RRT_Planner::get_path(const RRT_Node& start, const RRT_Node& end, const boo
           _get_nodes_on_path(turn_0, center_cw_0,
                              turn_1, center_ccw_1,
                              start, end, rad, path);
-          cost = _get_cost(path);
+          if(calc_cost) cost = _get_cost(path);
         }
         else
         {
@@ -638,7 +709,7 @@ void RRT_Planner::get_path(const RRT_Node& start, const RRT_Node& end, const boo
           _get_nodes_on_path(turn_0, center_ccw_0,
                              turn_1, center_ccw_1,
                              start, end, rad, path);
-          cost = _get_cost(path);
+          if(calc_cost) cost = _get_cost(path);
         }
         else
         {
@@ -704,7 +775,7 @@ void RRT_Planner::get_path(const RRT_Node& start, const RRT_Node& end, const boo
           _get_nodes_on_path(turn_0, center_ccw_0,
                              turn_1, center_cw_1,
                              start, end, rad, path);
-          cost = _get_cost(path);
+          if(calc_cost) cost = _get_cost(path);
         }
         else
         {
@@ -728,7 +799,7 @@ void RRT_Planner::get_path(const RRT_Node& start, const RRT_Node& end, const boo
 
     std::cout << "calc_nodes: " << calc_nodes << ", soln_type: " << soln_type << ", cost: " << cost << std::endl;
     std::cout << "error_str: " << error_str << std::endl;
-    sejong::pretty_print(err_track, std::cout , "turn_vec");
+    dynacore::pretty_print(dynacore::Vector(err_track), std::cout , "turn_vec");
   }
 #endif
   // Lowest cost path is stored in:     std::vector<RRT_Node*>& path
@@ -740,26 +811,26 @@ void RRT_Planner::get_path(const RRT_Node& start, const RRT_Node& end, const boo
 void RRT_Planner::_fix_angle(double& angle, int POS_or_NEG)
 {
   angle = remainder( angle , 2.*M_PI );
-  if (POS_or_NEG == RRT_Planner::POS && sejong::sgn(angle) == RRT_Planner::NEG)
+  if (POS_or_NEG == RRT_Planner::POS && dynacore::sgn(angle) == RRT_Planner::NEG)
     angle +=  2. * M_PI;
-  else if (POS_or_NEG == RRT_Planner::NEG && sejong::sgn(angle) == RRT_Planner::POS)
+  else if (POS_or_NEG == RRT_Planner::NEG && dynacore::sgn(angle) == RRT_Planner::POS)
     angle += -2. * M_PI;
 }
 
 
-double RRT_Planner::_get_dubins_path_length(const double& turn_0, sejong::Vector& center_0,
-                                            const double& turn_1, sejong::Vector& center_1,
+double RRT_Planner::_get_dubins_path_length(const double& turn_0, dynacore::Vect2& center_0,
+                                            const double& turn_1, dynacore::Vect2& center_1,
                                             const RRT_Node& start, const RRT_Node& end,
                                             const double& radius)
 {
   double t0_length, sl_length, t1_length;
   Eigen::Rotation2D< double > rot;
-  sejong::Vector rad_v(2);
-  sejong::Vector start_v(2);
-  sejong::Vector end_v(2);
-  sejong::Vector beg_of_sl(2);
-  sejong::Vector end_of_sl(2);
-  sejong::Vector strait_line(2);
+  dynacore::Vect2 rad_v;
+  dynacore::Vect2 start_v;
+  dynacore::Vect2 end_v;
+  dynacore::Vect2 beg_of_sl;
+  dynacore::Vect2 end_of_sl;
+  dynacore::Vect2 strait_line;
 
 
   start_v << start.x_, start.y_;
@@ -783,20 +854,20 @@ double RRT_Planner::_get_dubins_path_length(const double& turn_0, sejong::Vector
 }
 
 
-void RRT_Planner::_get_nodes_on_path(const double& turn_0, sejong::Vector& center_0,
-                                       const double& turn_1, sejong::Vector& center_1,
+void RRT_Planner::_get_nodes_on_path(const double& turn_0, dynacore::Vect2& center_0,
+                                       const double& turn_1, dynacore::Vect2& center_1,
                                        const RRT_Node& start, const RRT_Node& end,
                                        const double& radius, std::vector<RRT_Node*>& nodes)
 {
   double tot_length, step_length, progress, num_steps, t0_length, sl_length, t1_length;
   Eigen::Rotation2D< double > rot;
-  sejong::Vector apex(2);
-  sejong::Vector rad_v(2);
-  sejong::Vector start_v(2);
-  sejong::Vector end_v(2);
-  sejong::Vector beg_of_sl(2);
-  sejong::Vector end_of_sl(2);
-  sejong::Vector strait_line(2);
+  dynacore::Vect2 apex;
+  dynacore::Vect2 rad_v;
+  dynacore::Vect2 start_v;
+  dynacore::Vect2 end_v;
+  dynacore::Vect2 beg_of_sl;
+  dynacore::Vect2 end_of_sl;
+  dynacore::Vect2 strait_line;
 
 
   start_v << start.x_, start.y_;
@@ -821,7 +892,7 @@ void RRT_Planner::_get_nodes_on_path(const double& turn_0, sejong::Vector& cente
   step_length  = tot_length / num_steps;
 
   nodes.clear();
-  nodes.push_back(new RRT_Node(start));
+  nodes.push_back(node_pool_.allocate(start));
   progress = 0.;
 
   for (int i(1); i < num_steps; ++i)
@@ -831,31 +902,31 @@ void RRT_Planner::_get_nodes_on_path(const double& turn_0, sejong::Vector& cente
     if ( progress < t0_length )
     {
       rad_v = start_v - center_0;
-      rot = Eigen::Rotation2D<double>( sejong::sgn(turn_0) * progress / radius );
+      rot = Eigen::Rotation2D<double>( dynacore::sgn(turn_0) * progress / radius );
       apex = center_0 + rot * rad_v;
 
-      RRT_Node* n = new RRT_Node( apex(0), apex(1), start.theta_ + rot.angle() );
+      RRT_Node* n = node_pool_.allocate( apex(0), apex(1), start.theta_ + rot.angle() );
       nodes.push_back(n);
     }
     else if ( progress < t0_length + sl_length )
     {
       apex = beg_of_sl + strait_line * (progress - t0_length) / sl_length;
 
-      RRT_Node* n = new RRT_Node( apex(0), apex(1), start.theta_ + turn_0 );
+      RRT_Node* n = node_pool_.allocate( apex(0), apex(1), start.theta_ + turn_0 );
       nodes.push_back(n);
     }
     else
     {
       rad_v = end_v - center_1;
-      rot = (Eigen::Rotation2D<double>( sejong::sgn(turn_1) * (tot_length-progress) / radius )).inverse();
+      rot = (Eigen::Rotation2D<double>( dynacore::sgn(turn_1) * (tot_length-progress) / radius )).inverse();
       apex = center_1 + rot * rad_v;
 
-      RRT_Node* n = new RRT_Node( apex(0), apex(1), end.theta_ + rot.angle() );
+      RRT_Node* n = node_pool_.allocate( apex(0), apex(1), end.theta_ + rot.angle() );
       nodes.push_back(n);
     }
   }
 
-  nodes.push_back(new RRT_Node(end));
+  nodes.push_back(node_pool_.allocate(end));
 
 }
 
@@ -877,7 +948,7 @@ bool RRT_Planner::append_path_to_tree(std::vector<RRT_Node*>& new_branch,
 
   if ( (*parent_on_tree) ==  *(new_branch.front()) && !new_branch.empty()) // forward branch
   {
-    delete new_branch.front();
+    node_pool_.release(new_branch.front());
     new_branch.front() = parent_on_tree;
     std::vector<RRT_Node*>::iterator it = new_branch.begin();
     std::vector<RRT_Node*>::iterator it_p = it;
@@ -885,10 +956,11 @@ bool RRT_Planner::append_path_to_tree(std::vector<RRT_Node*>& new_branch,
 
     for(; it != new_branch.end(); ++it, ++it_p ) // starts from first new node
     {
-      (*it)->parent_ = *it_p;
+      (*it)->parent_ = (*it_p)->id_;
       tree_.push_back(*it);  // Note: this assumes that new_branch.front() is already in tree_
+      node_index_.insert(*it);
 #ifdef SAVE_DATA
-      (*it)->save_node_2("tree");
+      if (save_data_) (*it)->save_node_2("tree", node_pool_.get_cost_to_root(*it));
 #endif
     }
   }
@@ -909,10 +981,11 @@ void RRT_Planner::delete_tree_except_solution()
     for (; it != tree_.end(); ++it)
     {
       if(std::find(soln.begin(), soln.end(), *it) == soln.end())
-        delete *it;
+        node_pool_.release(*it);
     }
     // tree_.clear();
     tree_ = soln;
+    node_index_.rebuild(tree_);
   }
 }
 
@@ -932,7 +1005,7 @@ void RRT_Planner::_keep_min_delete_tmp(std::vector<RRT_Node*>&     path, double&
 
   // Delete nodes in tmp_path
   for( std::vector<RRT_Node*>::iterator it = tmp_path.begin(); it != tmp_path.end(); ++it )
-    delete *it;
+    node_pool_.release(*it);
   tmp_path.clear();
   tmp_cost = 0.0;
 }
@@ -952,8 +1025,13 @@ double RRT_Planner::_get_cost_eucl(std::vector<RRT_Node*>& nodes){
 
 double RRT_Planner::_get_time(std::vector<RRT_Node*>& nodes){
   double ret(analytic_solver_->Get_Cost(nodes));
+  _check_time(nodes, ret);
+  return ret;
+}
+
+void RRT_Planner::_check_time(std::vector<RRT_Node*>& nodes, const double& ret){
   std::vector<RRT_Node*>::iterator debug_iter;
-  sejong::Vector debug_vector(3);
+  dynacore::Vector debug_vector(3);
   if(ret<0) {
     std::cout<<"negative time : exit for debugging :"<<ret<<std::endl;
     for(debug_iter = nodes.begin() + 1; debug_iter != nodes.end(); ++debug_iter){
@@ -963,12 +1041,11 @@ double RRT_Planner::_get_time(std::vector<RRT_Node*>& nodes){
       (*debug_iter)->print_node();
       std::cout<<(*debug_iter)->cost_to_parent_<<std::endl;
 #ifdef SAVE_DATA
-      sejong::saveVector(debug_vector,"debugging_nodes");
+      dynacore::saveVector(debug_vector,"debugging_nodes");
 #endif
     }
     exit(0);
   }
-  return ret;
 }
 
 double RRT_Planner::_tmp_get_cost(std::vector<RRT_Node*>& nodes)
@@ -976,7 +1053,7 @@ double RRT_Planner::_tmp_get_cost(std::vector<RRT_Node*>& nodes)
   double cost(0.0);
   for(std::vector<RRT_Node*>::size_type i = 0; i < nodes.size()-1; i++)
   {
-    nodes[i+1]->parent_ = nodes[i]; // Assigns parents to all except nodes[0]
+    nodes[i+1]->parent_ = nodes[i]->id_; // Assigns parents to all except nodes[0]
     nodes[i+1]->cost_to_parent_ = sqrt(pow(nodes[i]->x_-nodes[i+1]->x_,2.)+pow(nodes[i]->y_-nodes[i+1]->y_,2.));// + step_length/4.;
     cost += nodes[i+1]->cost_to_parent_;
   }
@@ -997,10 +1074,22 @@ void RRT_Planner::print_path(std::vector<RRT_Node*>& nodes)
 
 // Probability utility functions //
 
+// Not std::uniform_*_distribution: their output differs between standard
+// libraries, and a seed should give the same tree everywhere
+double RRT_Planner::_get_rand(const double& low, const double& high)
+{
+  return low + (high - low) * ( (double)rng_() / (double)std::mt19937::max() );
+}
+
+int RRT_Planner::_get_rand_int(const int& low, const int& high)
+{
+  return low + (int)( rng_() % (unsigned int)(high - low + 1) );
+}
+
 void RRT_Planner::_get_normal_dist(double& variate1, double& variate2)
 {
-  double u1(SJ_RAND(0.,1.));
-  double u2(SJ_RAND(0.,1.));
+  double u1(_get_rand(0.,1.));
+  double u2(_get_rand(0.,1.));
   variate1 = sqrt(-2.*log(u1))*cos(2*M_PI*u2);
   variate2 = sqrt(-2.*log(u1))*sin(2*M_PI*u2);
 
@@ -1009,7 +1098,7 @@ void RRT_Planner::_get_normal_dist(double& variate1, double& variate2)
 // returns pseudorandom sample from geometric distribution in variate from set k = {0,1,2,...}
 void RRT_Planner::_get_geometric_dist(const double& p, int& variate)
 {
-  variate = (int)floor(log(SJ_RAND(0.,1.))/log(1.-p));
+  variate = (int)floor(log(_get_rand(0.,1.))/log(1.-p));
 }
 
 void RRT_Planner::_bound_shortcut_length(int& shortcut_length, const int& min_shortcut, const int& max_shortcut)
@@ -2,7 +2,10 @@
 #define RRT_PLANNER
 
 #include <Utils/wrap_eigen.hpp>
+#include <random>
 #include "RRT_Node.h"
+#include "RRT_NodeIndex.h"
+#include "RRT_NodePool.h"
 #include "Configuration.h"
 
 class RRT_Analytic_Solver;
@@ -11,13 +14,14 @@ class Obstacle;
 class RRT_Planner{
 public:
   // Initialize with a solver to compute path's cost according to dynamically feasible times
-  RRT_Planner(const sejong::Vector& search_boundary,
+  // save_data: write the tree and progress to files/stdout (off for parallel trees)
+  RRT_Planner(const dynacore::Vector& search_boundary,
               const RRT_Node& start, const RRT_Node& goal,
               const std::vector<Obstacle>& obstacle_list,
-              RRT_Analytic_Solver * solver);
+              RRT_Analytic_Solver * solver, const bool& save_data = true);
 
   // If initialized without a solver, it defaults to computing cost via euclidean distance between nodes on dubin's path
-  RRT_Planner(const sejong::Vector& search_boundary,
+  RRT_Planner(const dynacore::Vector& search_boundary,
               const RRT_Node& start, const RRT_Node& goal,
               const std::vector<Obstacle>& obstacle_list);
   ~RRT_Planner();
@@ -25,23 +29,37 @@ public:
 
   enum path_type { RSR, RSL, LSL, LSR, UNKNOWN };
 
-  sejong::Vector search_boundary_; // 4 dim: x_min, x_max, y_min, y_max
-  sejong::Vector histogram_cost_compare_;
+  dynacore::Vector search_boundary_; // 4 dim: x_min, x_max, y_min, y_max
+  dynacore::Vector histogram_cost_compare_;
   double max_turn_, x_p_, safety_margin_, rad;
+  // Nearest neighbor search: Dubins lengths are only computed for nodes whose
+  // lower bound can beat the current num_nearby_nodes_ candidates
+  int num_nearby_nodes_;
+  double index_cell_size_;
+  int index_num_heading_;
 
   std::vector<Obstacle> obstacle_list_;
 
   std::vector<RRT_Node*> tree_;
   RRT_Node* goal_;
 
+  // Samples come from the planner's own generator, seeded with the time by default
+  void set_seed(const unsigned int& seed) { rng_.seed(seed); }
+  bool has_solution() const { return found_solution_; }
+  // node of this planner's tree
+  double get_cost_to_root(const RRT_Node* node) const { return node_pool_.get_cost_to_root(node); }
+
   bool build_RRT(const int& num_samples);
   void get_nearest_neighbor_path(const RRT_Node& sample, RRT_Node*& nearest_neighbor,
                                          std::vector<RRT_Node*>& path);
   void rand_sample(RRT_Node& rand_node);
   void prune_for_collisions(std::vector<RRT_Node*>& path);
   // bool collision_check(const std::vector<RRT_Node*>& path);
+  // With calc_cost false the nodes of a known soln_type are made but not
+  // timed (cost stays 0), for Get_Costs() to time several paths at once
   void get_path(const RRT_Node& start, const RRT_Node& end, const bool& calc_nodes,
-                std::vector<RRT_Node*>& path, double& cost, path_type& soln_type);
+                std::vector<RRT_Node*>& path, double& cost, path_type& soln_type,
+                const bool& calc_cost = true);
   // void get_path_check_obs(const RRT_Node& start, const RRT_Node& end, std::vector<RRT_Node*>& path, double& cost);
   void get_solution(std::vector<RRT_Node*>& solution) const;
   void shortcut_solution(const int num_iterations, std::vector<RRT_Node*>& solution);
@@ -52,30 +70,35 @@ public:
 
 protected:
 
-  void _Init(const sejong::Vector& search_boundary,
+  void _Init(const dynacore::Vector& search_boundary,
              const RRT_Node& start, const RRT_Node& goal,
-             const std::vector<Obstacle>& obstacle_list);
+             const std::vector<Obstacle>& obstacle_list, const bool& save_data);
 
   RRT_Analytic_Solver * analytic_solver_;
+  RRT_NodePool node_pool_; // owns tree_, goal_ and the temporary paths
+  RRT_NodeIndex node_index_;
   static const int POS = 1;
   static const int NEG = -1;
 
   bool found_solution_;
+  bool save_data_;
+  std::mt19937 rng_;
 
 
   void _fix_angle(double& angle, int POS_or_NEG);
-  void _get_nodes_on_path(const double& turn_0, sejong::Vector& center_0,
-                          const double& turn_1, sejong::Vector& center_1,
+  void _get_nodes_on_path(const double& turn_0, dynacore::Vect2& center_0,
+                          const double& turn_1, dynacore::Vect2& center_1,
                           const RRT_Node& start, const RRT_Node& end,
                           const double& radius, std::vector<RRT_Node*>& nodes);
-  double _get_dubins_path_length(const double& turn_0, sejong::Vector& center_0,
-                               const double& turn_1, sejong::Vector& center_1,
+  double _get_dubins_path_length(const double& turn_0, dynacore::Vect2& center_0,
+                               const double& turn_1, dynacore::Vect2& center_1,
                                const RRT_Node& start, const RRT_Node& end,
                                const double& radius);
   double _tmp_get_cost(std::vector<RRT_Node*>& nodes);
   double _get_cost(std::vector<RRT_Node*>& nodes);
   double _get_cost_eucl(std::vector<RRT_Node*>& nodes);
   double _get_time(std::vector<RRT_Node*>& nodes);
+  void _check_time(std::vector<RRT_Node*>& nodes, const double& ret);
 
   void _keep_min_delete_tmp(std::vector<RRT_Node*>&     path, double&     cost,
                             std::vector<RRT_Node*>& tmp_path, double& tmp_cost);
@@ -83,6 +106,8 @@ protected:
 
   bool _is_out_of_bounds(const RRT_Node* node);
 
+  double _get_rand(const double& low, const double& high);
+  int _get_rand_int(const int& low, const int& high);
   void _get_normal_dist(double& variate1, double& variate2);
   void _get_geometric_dist(const double& p, int& variate);
   void _bound_shortcut_length(int& shortcut_length, const int& min_shortcut, const int& max_shortcut);
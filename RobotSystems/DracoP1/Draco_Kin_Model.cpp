@@ -12,6 +12,13 @@ using namespace RigidBodyDynamics;
 
 Draco_Kin_Model::Draco_Kin_Model( RigidBodyDynamics::Model* model){
   model_ = model;
+  link_table_.initialize(model_);
+  link_table_.setLink(LK_body, "body");
+  link_table_.setLink(LK_upperLeg, "upperLeg");
+  link_table_.setLink(LK_lowerLeg, "lowerLeg");
+  link_table_.setLink(LK_foot, "foot");
+  link_table_.setLink(LK_FootToe, "FootToe");
+  link_table_.setLink(LK_FootHeel, "FootHeel");
   Ig_ = Matrix::Zero(6,6);
   Jg_ = Matrix::Zero(6, model_->qdot_size);
 }
@@ -42,7 +49,7 @@ void Draco_Kin_Model::_UpdateCentroidFrame(const sejong::Vector & q, const sejon
   Matrix I = Matrix::Zero(6, 6);
   Matrix Jsp = Matrix::Zero(6, model_->qdot_size);
 
-  int start_idx = _find_body_idx(LK_body);
+  int start_idx = link_table_.getBodyId(LK_body);
   Matrix3d p;
   Matrix3d cmm;
   Matrix3d R;
@@ -93,7 +100,7 @@ void Draco_Kin_Model::getCoMJacobian(const sejong::Vector & Q, sejong::Matrix &
 
   double mass;
   double tot_mass(0.0);
-  int start_idx = _find_body_idx(LK_body);
+  int start_idx = link_table_.getBodyId(LK_body);
 
   for (int i(start_idx); i< model_->mBodies.size() ; ++i){
     mass = model_->mBodies[i].mMass;
@@ -112,7 +119,7 @@ void Draco_Kin_Model::getCoMPos(const sejong::Vector & q, sejong::Vect3 & CoM_po
   CoM_pos.setZero();
   Vector3d link_pos;
 
-  int start_idx = _find_body_idx(LK_body);
+  int start_idx = link_table_.getBodyId(LK_body);
   double mass;
   double tot_mass(0.0);
   for (int i(start_idx); i< model_->mBodies.size() ; ++i){
@@ -128,7 +135,7 @@ void Draco_Kin_Model::getCoMPos(const sejong::Vector & q, sejong::Vect3 & CoM_po
 
 void Draco_Kin_Model::getCoMVel(const sejong::Vector & q, const sejong::Vector & qdot, sejong::Vect3 & CoM_vel) const {
 
-  int start_idx = _find_body_idx(LK_body);
+  int start_idx = link_table_.getBodyId(LK_body);
   CoM_vel = sejong::Vector::Zero(3);
   Vector3d link_vel;
 
@@ -149,22 +156,17 @@ void Draco_Kin_Model::getCoMVel(const sejong::Vector & q, const sejong::Vector &
 void Draco_Kin_Model::getPosition(const Vector & q, int link_id, Vect3 & pos){
   Vector3d zero;
   // zero << 0.0, 0.0, 0.0;
-  int bodyid = _find_body_idx(link_id);
-  if(bodyid >=model_->fixed_body_discriminator){
-    zero = model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass;
-  }
-  else{
-    zero =  model_->mBodies[bodyid].mCenterOfMass;
-  }
+  int bodyid = link_table_.getBodyId(link_id);
+  zero = link_table_.getPoint(link_id);
 
-  pos = CalcBodyToBaseCoordinates(*model_, q, _find_body_idx(link_id), zero, false);
-  // pos = CalcBaseToBodyCoordinates(*model_, q, _find_body_idx(link_id), zero, false);
+  pos = CalcBodyToBaseCoordinates(*model_, q, bodyid, zero, false);
+  // pos = CalcBaseToBodyCoordinates(*model_, q, link_table_.getBodyId(link_id), zero, false);
 
 }
 
 void Draco_Kin_Model::getOrientation(const Vector & q, int link_id, sejong::Quaternion & ori){
   Matrix3d R;
-  R = CalcBodyWorldOrientation( *model_, q, _find_body_idx(link_id), false);
+  R = CalcBodyWorldOrientation( *model_, q, link_table_.getBodyId(link_id), false);
   ori = R.transpose();
   //std::cout<<"mat R : \n"<<R<<std::endl;
   //sejong::pretty_print(ori,std::cout,"quat");
@@ -184,29 +186,18 @@ void Draco_Kin_Model::getVelocity(const Vector & q, const Vector &qdot,
                                   int link_id, Vect3 & vel){
   Vector3d zero;
   // zero << 0.0, 0.0, 0.0;
-  int bodyid = _find_body_idx(link_id);
-  if(bodyid >=model_->fixed_body_discriminator){
-    zero = model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass;
-  }
-  else{
-    zero =  model_->mBodies[bodyid].mCenterOfMass;
-  }
+  int bodyid = link_table_.getBodyId(link_id);
+  zero = link_table_.getPoint(link_id);
 
-  vel = CalcPointVelocity ( *model_, q, qdot, _find_body_idx(link_id), zero, false);
+  vel = CalcPointVelocity ( *model_, q, qdot, bodyid, zero, false);
 
 }
 void Draco_Kin_Model::getAngVel(const Vector & q, const Vector & qdot,
                                 int link_id, Vect3 & ang_vel){
-  unsigned int bodyid = _find_body_idx(link_id);
+  unsigned int bodyid = link_table_.getBodyId(link_id);
   Vector vel;
-  if(bodyid >=model_->fixed_body_discriminator){
-    vel = CalcPointVelocity6D(*model_, q, qdot, bodyid,
-                              model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass, false);
-  }
-  else{
-    vel = CalcPointVelocity6D(*model_, q, qdot, bodyid,
-                              model_->mBodies[bodyid].mCenterOfMass, false);
-  }
+  vel = CalcPointVelocity6D(*model_, q, qdot, bodyid,
+                            link_table_.getPoint(link_id), false);
   ang_vel = vel.head(3);
 }
 
@@ -214,19 +205,12 @@ void Draco_Kin_Model::getJacobian(const Vector & q, int link_id, Matrix &J){
 
   J = Matrix::Zero(6, model_->qdot_size);
 
-  unsigned int bodyid = _find_body_idx(link_id);
+  unsigned int bodyid = link_table_.getBodyId(link_id);
   Vector3d zero_vector = Vector3d::Zero();
 
-  if(bodyid >=model_->fixed_body_discriminator){
-    CalcPointJacobian6D(*model_, q, bodyid,
-                        model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass,
-                        J, false);
-  }
-  else{
-    CalcPointJacobian6D(*model_, q, bodyid,
-                        model_->mBodies[bodyid].mCenterOfMass,
-                        J, false);
-  }
+  CalcPointJacobian6D(*model_, q, bodyid,
+                      link_table_.getPoint(link_id),
+                      J, false);
   Matrix3d R;
   // R = CalcBodyWorldOrientation(*model_, q, bodyid, false);
   // J.block(0,0, 3, model_->qdot_size) = R.transpose() * J.block(0,0, 3, model_->qdot_size);
@@ -235,35 +219,9 @@ void Draco_Kin_Model::getJacobian(const Vector & q, int link_id, Matrix &J){
 void Draco_Kin_Model::getJacobianDot6D_Analytic(const Vector & q, const Vector & qdot, int link_id, Matrix & J){
   J = Matrix::Zero(6, model_->qdot_size);
 
-  unsigned int bodyid = _find_body_idx(link_id);
+  unsigned int bodyid = link_table_.getBodyId(link_id);
 
-  if(bodyid >=model_->fixed_body_discriminator){
-    CalcPointJacobianDot(*model_, q, qdot, bodyid,
-                         model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass,
-                         J, true);
-  }
-  else{
-    CalcPointJacobianDot(*model_, q, qdot, bodyid,
-                         model_->mBodies[bodyid].mCenterOfMass,
-                         J, true);
-  }
-}
-
-
-unsigned int Draco_Kin_Model::_find_body_idx(int id) const {
-  switch(id){
-  case LK_body:
-    return model_->GetBodyId("body");
-  case LK_upperLeg:
-    return model_->GetBodyId("upperLeg");
-  case LK_lowerLeg:
-    return model_->GetBodyId("lowerLeg");
-  case LK_foot:
-    return model_->GetBodyId("foot");
-  case LK_FootToe:
-    return model_->GetBodyId("FootToe");
-  case LK_FootHeel:
-    return model_->GetBodyId("FootHeel");
-  }
-  return (unsigned int)(id + 2);
+  CalcPointJacobianDot(*model_, q, qdot, bodyid,
+                       link_table_.getPoint(link_id),
+                       J, true);
 }
@@ -3,6 +3,7 @@
 
 #include <Utils/wrap_eigen.hpp>
 #include <rbdl/rbdl.h>
+#include <RBDL_LinkTable.hpp>
 #include <Configuration.h>
 
 using namespace sejong;
@@ -43,7 +44,7 @@ protected:
     sejong::Matrix Jg_;
 
     RigidBodyDynamics::Model* model_;
-    unsigned int _find_body_idx(int id) const ;
+    RBDL_LinkTable link_table_;
 };
 
 #endif
@@ -3,6 +3,7 @@
 
 #include <Utils/wrap_eigen.hpp>
 #include <rbdl/rbdl.h>
+#include <RBDL_LinkTable.hpp>
 
 class Quadruped_Kin_Model{
     public:
@@ -37,7 +38,7 @@ class Quadruped_Kin_Model{
         dynacore::Matrix Jg_;
 
         RigidBodyDynamics::Model* model_;
-        unsigned int _find_body_idx(int id) const ;
+        RBDL_LinkTable link_table_;
 };
 
 #endif
@@ -11,6 +11,11 @@ Quadruped_Kin_Model::Quadruped_Kin_Model( RigidBodyDynamics::Model* model):
     gravity_(9.81)
 {
     model_ = model;
+    link_table_.initialize(model_);
+    link_table_.setLink(quadruped_link::body, "body");
+    link_table_.setLink(quadruped_link::fl_Foot, "foot_fl");
+    link_table_.setLink(quadruped_link::fr_Foot, "foot_fr");
+    link_table_.setLink(quadruped_link::imu, "imu");
     Ig_ = dynacore::Matrix::Zero(6,6);
     Jg_ = dynacore::Matrix::Zero(6, model_->qdot_size);
 }
@@ -44,7 +49,7 @@ void Quadruped_Kin_Model::_UpdateCentroidFrame(const dynacore::Vector & q,
     dynacore::Matrix I = dynacore::Matrix::Zero(6, 6);
     dynacore::Matrix Jsp = dynacore::Matrix::Zero(6, model_->qdot_size);
 
-    int start_idx = _find_body_idx(quadruped_link::body);
+    int start_idx = link_table_.getBodyId(quadruped_link::body);
     Matrix3d p;
     Matrix3d cmm;
     Matrix3d R;
@@ -95,7 +100,7 @@ void Quadruped_Kin_Model::getCoMJacobian(dynacore::Matrix & Jcom) const {
 
     double mass;
     double tot_mass(0.0);
-    int start_idx = _find_body_idx(quadruped_link::body);
+    int start_idx = link_table_.getBodyId(quadruped_link::body);
 
     for (int i(start_idx); i< model_->mBodies.size() ; ++i){
         mass = model_->mBodies[i].mMass;
@@ -115,7 +120,7 @@ void Quadruped_Kin_Model::getCoMPos(dynacore::Vect3 & CoM_pos)const {
     CoM_pos.setZero();
     Vector3d link_pos;
 
-    int start_idx = _find_body_idx(quadruped_link::body);
+    int start_idx = link_table_.getBodyId(quadruped_link::body);
     double mass;
     double tot_mass(0.0);
     for (int i(start_idx); i< model_->mBodies.size() ; ++i){
@@ -132,7 +137,7 @@ void Quadruped_Kin_Model::getCoMPos(dynacore::Vect3 & CoM_pos)const {
 
 void Quadruped_Kin_Model::getCoMVel(dynacore::Vect3 & CoM_vel) const {
     dynacore::Vector q, qdot;
-    int start_idx = _find_body_idx(quadruped_link::body);
+    int start_idx = link_table_.getBodyId(quadruped_link::body);
     CoM_vel.setZero();
     Vector3d link_vel;
 
@@ -154,22 +159,17 @@ void Quadruped_Kin_Model::getPos(int link_id, dynacore::Vect3 & pos){
     Vector3d zero;
     dynacore::Vector q;
 
-    int bodyid = _find_body_idx(link_id);
-    if(bodyid >=model_->fixed_body_discriminator){
-        zero = model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass;
-    }
-    else{
-        zero =  model_->mBodies[bodyid].mCenterOfMass;
-    }
+    int bodyid = link_table_.getBodyId(link_id);
+    zero = link_table_.getPoint(link_id);
 
-    pos = CalcBodyToBaseCoordinates(*model_, q, _find_body_idx(link_id), zero, false);
+    pos = CalcBodyToBaseCoordinates(*model_, q, bodyid, zero, false);
 
 }
 
 void Quadruped_Kin_Model::getOri(int link_id, dynacore::Quaternion & ori){
     Matrix3d R;
     dynacore::Vector q;
-    R = CalcBodyWorldOrientation( *model_, q, _find_body_idx(link_id), false);
+    R = CalcBodyWorldOrientation( *model_, q, link_table_.getBodyId(link_id), false);
     ori = R.transpose();
 
     if(ori.w() < 0.){
@@ -184,29 +184,18 @@ void Quadruped_Kin_Model::getLinearVel(int link_id, dynacore::Vect3 & vel){
     Vector3d zero;
     dynacore::Vector q, qdot;
 
-    int bodyid = _find_body_idx(link_id);
-    if(bodyid >=model_->fixed_body_discriminator){
-        zero = model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass;
-    }
-    else{
-        zero =  model_->mBodies[bodyid].mCenterOfMass;
-    }
+    int bodyid = link_table_.getBodyId(link_id);
+    zero = link_table_.getPoint(link_id);
 
-    vel = CalcPointVelocity ( *model_, q, qdot, _find_body_idx(link_id), zero, false);
+    vel = CalcPointVelocity ( *model_, q, qdot, bodyid, zero, false);
 }
 
 void Quadruped_Kin_Model::getAngularVel(int link_id, dynacore::Vect3 & ang_vel){
-    unsigned int bodyid = _find_body_idx(link_id);
+    unsigned int bodyid = link_table_.getBodyId(link_id);
     dynacore::Vector vel, q, qdot;
 
-    if(bodyid >=model_->fixed_body_discriminator){
-        vel = CalcPointVelocity6D(*model_, q, qdot, bodyid,
-                model_->mFixedBodies[bodyid - model_->fixed_body_discriminator].mCenterOfMass, false);
-    }
-    else{
-        vel = CalcPointVelocity6D(*model_, q, qdot, bodyid,
-                model_->mBodies[bodyid].mCenterOfMass, false);
-    }
+    vel = CalcPointVelocity6D(*model_, q, qdot, bodyid,
+            link_table_.getPoint(link_id), false);
     ang_vel = vel.head(3);
 }
 
@@ -214,20 +203,12 @@ void Quadruped_Kin_Model::getJacobian(int link_id, dynacore::Matrix &J){
     dynacore::Vector q;
     J = dynacore::Matrix::Zero(6, model_->qdot_size);
 
-    unsigned int bodyid = _find_body_idx(link_id);
+    unsigned int bodyid = link_table_.getBodyId(link_id);
     Vector3d zero_vector = Vector3d::Zero();
 
-    if(bodyid >=model_->fixed_body_discriminator){
-        CalcPointJacobian6D(*model_, q, bodyid,
-                model_->mFixedBodies
-                [bodyid - model_->fixed_body_discriminator].mCenterOfMass,
-                J, false);
-    }
-    else{
-        CalcPointJacobian6D(*model_, q, bodyid,
-                model_->mBodies[bodyid].mCenterOfMass,
-                J, false);
-    }
+    CalcPointJacobian6D(*model_, q, bodyid,
+            link_table_.getPoint(link_id),
+            J, false);
     // Virtual rotation joint axis must be always aligned with the global frame
     // Orientation
     //J.block(0,3,3,3) = dynacore::Matrix::Identity(3,3);
@@ -246,30 +227,8 @@ void Quadruped_Kin_Model::getJacobian(int link_id, dynacore::Matrix &J){
 void Quadruped_Kin_Model::getJDotQdot(int link_id, dynacore::Vector & JDotQdot){
     dynacore::Vector q, qdot, qddot;
 
-    unsigned int bodyid = _find_body_idx(link_id);
-    if(bodyid >=model_->fixed_body_discriminator){
-        JDotQdot = CalcPointAcceleration6D(*model_, q, qdot, qddot, bodyid,
-                model_->mFixedBodies
-                [bodyid - model_->fixed_body_discriminator].mCenterOfMass, false);
-    }
-    else{
-        JDotQdot = CalcPointAcceleration6D(*model_, q, qdot, qddot, bodyid,
-                model_->mBodies[bodyid].mCenterOfMass, false);
-    }
+    unsigned int bodyid = link_table_.getBodyId(link_id);
+    JDotQdot = CalcPointAcceleration6D(*model_, q, qdot, qddot, bodyid,
+            link_table_.getPoint(link_id), false);
     JDotQdot[5] -= gravity_;
 }
-
-
-unsigned int Quadruped_Kin_Model::_find_body_idx(int id) const {
-    switch(id){
-        case quadruped_link::body:
-            return model_->GetBodyId("body");
-        case quadruped_link::fl_Foot:
-            return model_->GetBodyId("foot_fl");
-        case quadruped_link::fr_Foot:
-            return model_->GetBodyId("foot_fr");
-        case quadruped_link::imu:
-            return model_->GetBodyId("imu");
-    }
-    return (unsigned int)(id + 2);
-}
@@ -0,0 +1,69 @@
+#ifndef RBDL_LINK_TABLE
+#define RBDL_LINK_TABLE
+
+#include <rbdl/rbdl.h>
+#include <stdio.h>
+#include <vector>
+
+// Link id (robot enum) -> RBDL body id and the point used for the link
+// (its center of mass, for fixed bodies too), resolved once when the model
+// is built so that kinematic queries do not look up the body names.
+// Ids that are not named map to body id + 2 as before.
+class RBDL_LinkTable{
+public:
+    RBDL_LinkTable():model_(NULL){ zero_point_.setZero(); }
+    ~RBDL_LinkTable(){}
+
+    void initialize(RigidBodyDynamics::Model* model){
+        model_ = model;
+        body_id_.clear();
+        point_.clear();
+        for(int i(0); i + 2 < (int)model_->mBodies.size(); ++i) _Resize(i + 1);
+    }
+
+    // the same bodies in a copy of the model
+    void setModel(RigidBodyDynamics::Model* model){ model_ = model; }
+
+    void setLink(int link_id, const char* body_name){
+        _Resize(link_id + 1);
+        body_id_[link_id] = model_->GetBodyId(body_name);
+        if(!model_->IsBodyId(body_id_[link_id])){
+            printf("[Link Table] body %s (link %d) is not in the model\n", body_name, link_id);
+        }
+        point_[link_id] = _GetPoint(body_id_[link_id]);
+    }
+
+    unsigned int getBodyId(int link_id) const {
+        if(link_id >= 0 && link_id < (int)body_id_.size()) return body_id_[link_id];
+        return (unsigned int)(link_id + 2);
+    }
+    const RigidBodyDynamics::Math::Vector3d & getPoint(int link_id) const {
+        if(link_id >= 0 && link_id < (int)point_.size()) return point_[link_id];
+        return zero_point_;
+    }
+
+protected:
+    void _Resize(int num_link){
+        for(int i(body_id_.size()); i < num_link; ++i){
+            body_id_.push_back((unsigned int)(i + 2));
+            point_.push_back(_GetPoint(i + 2));
+        }
+    }
+
+    RigidBodyDynamics::Math::Vector3d _GetPoint(unsigned int body_id) const {
+        if(body_id >= model_->fixed_body_discriminator){
+            if(body_id - model_->fixed_body_discriminator < model_->mFixedBodies.size())
+                return model_->mFixedBodies[body_id - model_->fixed_body_discriminator].mCenterOfMass;
+        } else if(body_id < model_->mBodies.size()){
+            return model_->mBodies[body_id].mCenterOfMass;
+        }
+        return zero_point_;
+    }
+
+    RigidBodyDynamics::Model* model_;
+    std::vector<unsigned int> body_id_;
+    std::vector<RigidBodyDynamics::Math::Vector3d> point_;
+    RigidBodyDynamics::Math::Vector3d zero_point_;
+};
+
+#endif
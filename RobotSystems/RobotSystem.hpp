@@ -2,6 +2,7 @@
 #define ROBOT_MODEL
 
 #include <Utils/wrap_eigen.hpp>
+#include <Utils/tree_ltl.hpp>
 
 class RobotSystem{
 public:
@@ -29,6 +30,32 @@ public:
     virtual void getFullJacobian(int link_id, dynacore::Matrix & J) const = 0;
     virtual void getFullJDotQdot(int link_id, dynacore::Vector & JDotQdot) const = 0;
 
+    // A = L^T L; a dense factor unless the system knows its kinematic tree
+    virtual bool getMassInertiaFactor(dynacore::TreeLTL & A_ltl) const {
+        dynacore::Matrix A;
+        getMassInertia(A);
+        if(A_ltl.size() != A.rows()) A_ltl.setChain(A.rows());
+        return A_ltl.factorize(A);
+    }
+    // Ainv * B and J * Ainv * J^T without forming Ainv
+    virtual void getInverseMassInertiaProduct(const dynacore::Matrix & B,
+            dynacore::Matrix & AinvB) const {
+        dynacore::TreeLTL A_ltl;
+        getMassInertiaFactor(A_ltl);
+        A_ltl.inverseProduct(B, AinvB);
+    }
+    virtual void getInverseMassInertiaGram(const dynacore::Matrix & J,
+            dynacore::Matrix & JAinvJt) const {
+        dynacore::TreeLTL A_ltl;
+        getMassInertiaFactor(A_ltl);
+        A_ltl.inverseGram(J, JAinvJt);
+    }
+    // reflected inertia of the actuators per dof, already on the diagonal
+    // of getMassInertia; empty if the model has none
+    virtual void getRotorInertia(dynacore::Vector & rotor_inertia) const {
+        rotor_inertia.resize(0);
+    }
+
     virtual void UpdateSystem(const dynacore::Vector & q, const dynacore::Vector & qdot) = 0;
 };
 
@@ -0,0 +1,642 @@
+#include <rbdl/rbdl.h>
+#include <rbdl/urdfreader.h>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// urdf_codegen <urdf file> <name> <output directory>
+//
+// Writes <name>_Gen.hpp / <name>_Gen.cpp defining the URDF_GenDynamics
+// <name>_Gen: the RNEA, the CRBA, the factorization of the mass matrix and
+// the point Jacobians of the robot, unrolled over its bodies with the joint
+// types and the tree resolved here. The URDF is read with RBDL so that the
+// body and dof order are the ones of the model the code runs on.
+
+using namespace RigidBodyDynamics;
+using namespace RigidBodyDynamics::Math;
+
+enum GenJointKind{
+    kRevoluteX,
+    kRevoluteY,
+    kRevoluteZ,
+    kRevolute,
+    kPrismatic,
+    kSpherical,
+    kTranslationXYZ
+};
+
+struct GenJoint{
+    GenJointKind kind;
+    int rbdl_type;
+    unsigned int parent;
+    int q_index;
+    int num_dof;
+    int w_index; // quaternion w of the spherical joint
+    // motion subspace, one column per dof (body coordinates)
+    std::vector<SpatialVector> S;
+    bool rotated_X_T; // X_T.E is not the identity
+    bool base_rotated; // X_base.E is not the identity for all q
+    bool is_virtual;
+    std::string name; // body id and name, for the comments
+};
+
+static std::string _Num(double x){
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.17g", x);
+    std::string str(buf);
+    if(str.find_first_of(".eEn") == std::string::npos) str += ".";
+    return str;
+}
+
+static std::string _Fmt(const char* fmt, int a, int b = 0, int c = 0){
+    char buf[256];
+    snprintf(buf, sizeof(buf), fmt, a, b, c);
+    return std::string(buf);
+}
+
+// sum of coef * term, dropping the zero coefficients
+struct LinearForm{
+    std::vector<std::pair<double, std::string> > terms;
+
+    void add(double coef, const std::string & term){
+        if(coef != 0.) terms.push_back(std::make_pair(coef, term));
+    }
+    bool empty() const { return terms.empty(); }
+    std::string str() const {
+        std::string out;
+        for(size_t i(0); i < terms.size(); ++i){
+            double c(terms[i].first);
+            std::string t(fabs(c) == 1. ? terms[i].second :
+                    _Num(fabs(c)) + " * " + terms[i].second);
+            if(out.empty()) out = (c < 0. ? "-" : "") + t;
+            else out += (c < 0. ? " - " : " + ") + t;
+        }
+        return out.empty() ? "0." : out;
+    }
+};
+
+// S.col(m)^T x with x[k] = printf(fmt, k)
+static std::string _SDot(const GenJoint & joint, int m, const char* fmt){
+    LinearForm form;
+    for(int k(0); k < 6; ++k) form.add(joint.S[m][k], _Fmt(fmt, k));
+    return form.str();
+}
+
+static std::string _Vec3(const SpatialVector & s, int offset){
+    return "Vector3d(" + _Num(s[offset]) + ", " + _Num(s[offset + 1]) + ", "
+        + _Num(s[offset + 2]) + ")";
+}
+
+class URDF_CodeGen{
+public:
+    URDF_CodeGen(const std::string & urdf_file, const std::string & name):
+        urdf_file_(urdf_file), name_(name){}
+
+    bool load();
+    bool write(const std::string & dir);
+
+protected:
+    void _WriteHeader(FILE* fp);
+    void _WriteSource(FILE* fp);
+    void _WriteCheck(FILE* fp);
+    void _WriteKinematics(FILE* fp);
+    void _WriteInverseDynamics(FILE* fp);
+    void _WriteMassMatrix(FILE* fp);
+    void _WriteInverseMass(FILE* fp);
+    void _WriteJacobian(FILE* fp);
+
+    // dof ancestors of dof k from its parent to the root
+    std::vector<int> _DofAncestors(int k) const;
+
+    std::string urdf_file_;
+    std::string name_;
+    Model model_;
+    std::vector<GenJoint> joints_; // by body id, 0 unused
+    std::vector<int> dof_parent_; // -1 at the root
+    std::vector<int> dof_body_;
+};
+
+bool URDF_CodeGen::load(){
+    if(!Addons::URDFReadFromFile(urdf_file_.c_str(), &model_, true, false)){
+        fprintf(stderr, "[urdf_codegen] can not read %s\n", urdf_file_.c_str());
+        return false;
+    }
+    int num_body(model_.mBodies.size());
+    joints_.resize(num_body);
+    dof_parent_.assign(model_.qdot_size, -1);
+    dof_body_.assign(model_.qdot_size, 0);
+
+    for(int i(1); i < num_body; ++i){
+        const Joint & rbdl_joint(model_.mJoints[i]);
+        GenJoint & joint(joints_[i]);
+        joint.rbdl_type = rbdl_joint.mJointType;
+        joint.parent = model_.lambda[i];
+        joint.q_index = rbdl_joint.q_index;
+        joint.num_dof = rbdl_joint.mDoFCount;
+        joint.w_index = 0;
+        joint.is_virtual = model_.mBodies[i].mIsVirtual;
+        joint.name = _Fmt("%d", i);
+        if(!model_.GetBodyName(i).empty()) joint.name += " " + model_.GetBodyName(i);
+        joint.rotated_X_T = (model_.X_T[i].E != Matrix3d::Identity());
+
+        SpatialVector axis;
+        if(joint.num_dof == 1) axis = rbdl_joint.mJointAxes[0];
+
+        switch(rbdl_joint.mJointType){
+            case JointTypeRevoluteX: joint.kind = kRevoluteX; break;
+            case JointTypeRevoluteY: joint.kind = kRevoluteY; break;
+            case JointTypeRevoluteZ: joint.kind = kRevoluteZ; break;
+            case JointTypeRevolute: joint.kind = kRevolute; break;
+            case JointTypePrismatic: joint.kind = kPrismatic; break;
+            case JointTypeSpherical: joint.kind = kSpherical; break;
+            case JointTypeTranslationXYZ: joint.kind = kTranslationXYZ; break;
+            case JointTypeHelical:
+                // the URDF reader makes a helical joint of a revolute joint
+                // about an axis that is not a coordinate axis
+                if(axis.tail(3).isZero(0.)){
+                    joint.kind = kRevolute;
+                    break;
+                }
+            default:
+                fprintf(stderr, "[urdf_codegen] body %s: joint type %d is not supported\n",
+                        joint.name.c_str(), rbdl_joint.mJointType);
+                return false;
+        }
+
+        if(joint.num_dof == 1){
+            joint.S.push_back(axis);
+        } else {
+            int offset(joint.kind == kSpherical ? 0 : 3);
+            for(int m(0); m < 3; ++m){
+                SpatialVector col(SpatialVector::Zero());
+                col[offset + m] = 1.;
+                joint.S.push_back(col);
+            }
+        }
+        if(joint.kind == kSpherical) joint.w_index = model_.multdof3_w_index[i];
+
+        bool translation(joint.kind == kTranslationXYZ || joint.kind == kPrismatic);
+        joint.base_rotated = !translation || joint.rotated_X_T ||
+            (joint.parent != 0 && joints_[joint.parent].base_rotated);
+
+        for(int m(0); m < joint.num_dof; ++m){
+            int k(joint.q_index + m);
+            dof_body_[k] = i;
+            if(m > 0){
+                dof_parent_[k] = k - 1;
+            } else if(joint.parent != 0){
+                const GenJoint & parent(joints_[joint.parent]);
+                dof_parent_[k] = parent.q_index + parent.num_dof - 1;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<int> URDF_CodeGen::_DofAncestors(int k) const {
+    std::vector<int> anc;
+    for(int i(dof_parent_[k]); i >= 0; i = dof_parent_[i]) anc.push_back(i);
+    return anc;
+}
+
+bool URDF_CodeGen::write(const std::string & dir){
+    std::string header(dir + "/" + name_ + "_Gen.hpp");
+    std::string source(dir + "/" + name_ + "_Gen.cpp");
+
+    FILE* fp = fopen(header.c_str(), "w");
+    if(!fp){
+        fprintf(stderr, "[urdf_codegen] can not write %s\n", header.c_str());
+        return false;
+    }
+    _WriteHeader(fp);
+    fclose(fp);
+
+    fp = fopen(source.c_str(), "w");
+    if(!fp){
+        fprintf(stderr, "[urdf_codegen] can not write %s\n", source.c_str());
+        return false;
+    }
+    _WriteSource(fp);
+    fclose(fp);
+    return true;
+}
+
+void URDF_CodeGen::_WriteHeader(FILE* fp){
+    std::string guard(name_ + "_GEN_HPP");
+    fprintf(fp, "// Written by urdf_codegen from %s\n", urdf_file_.c_str());
+    fprintf(fp, "#ifndef %s\n#define %s\n\n", guard.c_str(), guard.c_str());
+    fprintf(fp, "#include <URDF_RobotSystem/URDF_GenDynamics.hpp>\n\n");
+    fprintf(fp, "extern const URDF_GenDynamics %s_Gen;\n\n", name_.c_str());
+    fprintf(fp, "#endif\n");
+}
+
+void URDF_CodeGen::_WriteSource(FILE* fp){
+    fprintf(fp, "// Written by urdf_codegen from %s\n", urdf_file_.c_str());
+    fprintf(fp, "#include \"%s_Gen.hpp\"\n", name_.c_str());
+    fprintf(fp, "#include <URDF_RobotSystem/URDF_GenSpatial.hpp>\n\n");
+    fprintf(fp, "using namespace RigidBodyDynamics;\n");
+    fprintf(fp, "using namespace RigidBodyDynamics::Math;\n");
+    fprintf(fp, "using namespace urdf_gen;\n\n");
+    fprintf(fp, "namespace {\n\n");
+    fprintf(fp, "const int num_body = %d;\n", (int)model_.mBodies.size());
+    fprintf(fp, "const int num_q = %d;\n", model_.q_size);
+    fprintf(fp, "const int num_qdot = %d;\n\n", model_.qdot_size);
+    fprintf(fp, "typedef Eigen::Matrix<double, num_qdot, num_qdot> MassMatrix;\n\n");
+
+    _WriteCheck(fp);
+    _WriteKinematics(fp);
+    _WriteInverseDynamics(fp);
+    _WriteMassMatrix(fp);
+    _WriteInverseMass(fp);
+    _WriteJacobian(fp);
+
+    fprintf(fp, "}\n\n");
+    fprintf(fp, "const URDF_GenDynamics %s_Gen = {\n", name_.c_str());
+    fprintf(fp, "    \"%s\",\n", urdf_file_.c_str());
+    fprintf(fp, "    num_q,\n    num_qdot,\n    num_body,\n");
+    fprintf(fp, "    _Check,\n    _Kinematics,\n    _InverseDynamics,\n    _MassMatrix,\n");
+    fprintf(fp, "    _InverseMass,\n    _Jacobian\n};\n");
+}
+
+// What the code takes from the URDF apart from the numbers it reads from
+// the model: the joint types, the tree, the dof indices and the X_T
+// without rotation.
+void URDF_CodeGen::_WriteCheck(FILE* fp){
+    int num_body(model_.mBodies.size());
+    std::string type, parent, q_index, rotated, axis;
+    for(int i(1); i < num_body; ++i){
+        const GenJoint & joint(joints_[i]);
+        std::string sep(i > 1 ? ", " : "");
+        type += sep + _Fmt("%d", joint.rbdl_type);
+        parent += sep + _Fmt("%d", joint.parent);
+        q_index += sep + _Fmt("%d", joint.q_index);
+        rotated += sep + (joint.rotated_X_T ? "true" : "false");
+        SpatialVector s(joint.num_dof == 1 ? joint.S[0] : SpatialVector::Zero());
+        axis += (i > 1 ? ",\n    " : "    ");
+        for(int k(0); k < 6; ++k) axis += (k > 0 ? ", " : "") + _Num(s[k]);
+    }
+    fprintf(fp, "const int joint_type[num_body - 1] = {%s};\n", type.c_str());
+    fprintf(fp, "const unsigned int parent[num_body - 1] = {%s};\n", parent.c_str());
+    fprintf(fp, "const unsigned int q_index[num_body - 1] = {%s};\n", q_index.c_str());
+    fprintf(fp, "const bool rotated_X_T[num_body - 1] = {%s};\n", rotated.c_str());
+    fprintf(fp, "const double axis[num_body - 1][6] = {\n%s};\n\n", axis.c_str());
+
+    fprintf(fp, "bool _Check(const Model & model){\n");
+    fprintf(fp, "    if((int)model.mBodies.size() != num_body || (int)model.q_size != num_q ||\n");
+    fprintf(fp, "            (int)model.qdot_size != num_qdot) return false;\n");
+    fprintf(fp, "    for(int i(1); i < num_body; ++i){\n");
+    fprintf(fp, "        const Joint & joint(model.mJoints[i]);\n");
+    fprintf(fp, "        if(joint.mJointType != joint_type[i - 1] || model.lambda[i] != parent[i - 1] ||\n");
+    fprintf(fp, "                joint.q_index != q_index[i - 1]) return false;\n");
+    fprintf(fp, "        if(!rotated_X_T[i - 1] && model.X_T[i].E != Matrix3d::Identity()) return false;\n");
+    fprintf(fp, "        if(joint.mDoFCount == 1){\n");
+    fprintf(fp, "            for(int k(0); k < 6; ++k) if(joint.mJointAxes[0][k] != axis[i - 1][k]) return false;\n");
+    fprintf(fp, "        }\n");
+    fprintf(fp, "    }\n");
+    fprintf(fp, "    return true;\n");
+    fprintf(fp, "}\n\n");
+}
+
+// UpdateKinematics: X_lambda, X_base, v and the velocity product c.
+void URDF_CodeGen::_WriteKinematics(FILE* fp){
+    int num_body(model_.mBodies.size());
+
+    fprintf(fp, "void _Kinematics(Model & model, const double* q, const double* qdot){\n");
+    fprintf(fp, "    model.v[0].setZero();\n");
+
+    const char* v_fmt = "v[%d]";
+    for(int i(1); i < num_body; ++i){
+        const GenJoint & joint(joints_[i]);
+        int p(joint.parent);
+        int k(joint.q_index);
+
+        fprintf(fp, "\n    // %s\n", joint.name.c_str());
+        fprintf(fp, "    {\n");
+        fprintf(fp, "        SpatialTransform & X_lambda = model.X_lambda[%d];\n", i);
+        fprintf(fp, "        SpatialVector & v = model.v[%d];\n", i);
+
+        std::string X_T(joint.rotated_X_T ? _Fmt("model.X_T[%d]", i) : _Fmt("model.X_T[%d].r", i));
+        switch(joint.kind){
+            case kRevoluteX:
+            case kRevoluteY:
+            case kRevoluteZ:
+                fprintf(fp, "        Revolute%c(q[%d], %s, X_lambda);\n",
+                        'X' + (joint.kind - kRevoluteX), k, X_T.c_str());
+                break;
+            case kRevolute:
+                fprintf(fp, "        Revolute(q[%d], %s, %s, X_lambda);\n",
+                        k, _Vec3(joint.S[0], 0).c_str(), X_T.c_str());
+                break;
+            case kPrismatic:
+                fprintf(fp, "        Prismatic(q[%d], %s, model.X_T[%d], X_lambda);\n",
+                        k, _Vec3(joint.S[0], 3).c_str(), i);
+                break;
+            case kSpherical:
+                fprintf(fp, "        Spherical(q[%d], q[%d], q[%d], q[%d], %s, X_lambda);\n",
+                        k, k + 1, k + 2, joint.w_index, X_T.c_str());
+                break;
+            case kTranslationXYZ:
+                fprintf(fp, "        TranslationXYZ(q[%d], q[%d], q[%d], %s, X_lambda);\n",
+                        k, k + 1, k + 2, X_T.c_str());
+                break;
+        }
+
+        if(p == 0){
+            fprintf(fp, "        model.X_base[%d] = X_lambda;\n", i);
+            fprintf(fp, "        v.setZero();\n");
+        } else {
+            if(joints_[p].base_rotated)
+                fprintf(fp, "        model.X_base[%d] = X_lambda * model.X_base[%d];\n", i, p);
+            else
+                fprintf(fp, "        TranslateBase(X_lambda, model.X_base[%d], model.X_base[%d]);\n", p, i);
+            fprintf(fp, "        v = X_lambda.apply(model.v[%d]);\n", p);
+        }
+
+        // v_J = S qdot, c = v x v_J
+        if(joint.num_dof == 1){
+            for(int m(0); m < 6; ++m){
+                LinearForm form;
+                form.add(joint.S[0][m], _Fmt("qdot[%d]", k));
+                if(!form.empty()) fprintf(fp, "        v[%d] += %s;\n", m, form.str().c_str());
+            }
+            // crossm(v, S) with S fixed
+            const SpatialVector & s(joint.S[0]);
+            LinearForm c[6];
+            c[0].add(-s[1], _Fmt(v_fmt, 2)); c[0].add(s[2], _Fmt(v_fmt, 1));
+            c[1].add(s[0], _Fmt(v_fmt, 2)); c[1].add(-s[2], _Fmt(v_fmt, 0));
+            c[2].add(-s[0], _Fmt(v_fmt, 1)); c[2].add(s[1], _Fmt(v_fmt, 0));
+            c[3].add(-s[1], _Fmt(v_fmt, 5)); c[3].add(s[2], _Fmt(v_fmt, 4));
+            c[3].add(-s[4], _Fmt(v_fmt, 2)); c[3].add(s[5], _Fmt(v_fmt, 1));
+            c[4].add(s[0], _Fmt(v_fmt, 5)); c[4].add(-s[2], _Fmt(v_fmt, 3));
+            c[4].add(s[3], _Fmt(v_fmt, 2)); c[4].add(-s[5], _Fmt(v_fmt, 0));
+            c[5].add(-s[0], _Fmt(v_fmt, 4)); c[5].add(s[1], _Fmt(v_fmt, 3));
+            c[5].add(-s[3], _Fmt(v_fmt, 1)); c[5].add(s[4], _Fmt(v_fmt, 0));
+            std::string args;
+            for(int m(0); m < 6; ++m) args += (m > 0 ? ", " : "") + c[m].str();
+            fprintf(fp, "        model.c[%d] = qdot[%d] * SpatialVector(%s);\n", i, k, args.c_str());
+        } else {
+            int offset(joint.kind == kSpherical ? 0 : 3);
+            std::string v_J;
+            for(int m(0); m < 6; ++m){
+                v_J += (m > 0 ? ", " : "");
+                if(m >= offset && m < offset + 3) v_J += _Fmt("qdot[%d]", k + m - offset);
+                else v_J += "0.";
+            }
+            fprintf(fp, "        SpatialVector v_J(%s);\n", v_J.c_str());
+            fprintf(fp, "        v += v_J;\n");
+            fprintf(fp, "        model.c[%d] = crossm(v, v_J);\n", i);
+        }
+
+        fprintf(fp, "    }\n");
+    }
+    fprintf(fp, "}\n\n");
+}
+
+// RNEA on the kinematics: the accelerations with gravity and the
+// gravity-only ones forward, then the forces back to the root.
+void URDF_CodeGen::_WriteInverseDynamics(FILE* fp){
+    int num_body(model_.mBodies.size());
+
+    fprintf(fp, "void _InverseDynamics(Model & model, double* grav, double* coriolis){\n");
+    fprintf(fp, "    SpatialVector a_grav[num_body];\n");
+    fprintf(fp, "    SpatialVector f_grav[num_body];\n\n");
+    fprintf(fp, "    model.a[0].set(0., 0., 0., -model.gravity[0], -model.gravity[1], -model.gravity[2]);\n");
+    fprintf(fp, "    a_grav[0] = model.a[0];\n");
+
+    for(int i(1); i < num_body; ++i){
+        const GenJoint & joint(joints_[i]);
+        int p(joint.parent);
+
+        fprintf(fp, "\n    // %s\n", joint.name.c_str());
+        fprintf(fp, "    {\n");
+        fprintf(fp, "        SpatialTransform & X_lambda = model.X_lambda[%d];\n", i);
+        fprintf(fp, "        model.a[%d] = X_lambda.apply(model.a[%d]) + model.c[%d];\n", i, p, i);
+        fprintf(fp, "        a_grav[%d] = X_lambda.apply(a_grav[%d]);\n", i, p);
+        if(joint.is_virtual){
+            fprintf(fp, "        model.f[%d].setZero();\n", i);
+            fprintf(fp, "        f_grav[%d].setZero();\n", i);
+        } else {
+            fprintf(fp, "        SpatialVector & v = model.v[%d];\n", i);
+            fprintf(fp, "        SpatialRigidBodyInertia & I = model.I[%d];\n", i);
+            fprintf(fp, "        model.f[%d] = I * model.a[%d] + crossf(v, I * v);\n", i, i);
+            fprintf(fp, "        f_grav[%d] = I * a_grav[%d];\n", i, i);
+        }
+        fprintf(fp, "    }\n");
+    }
+
+    fprintf(fp, "\n");
+    for(int i(num_body - 1); i > 0; --i){
+        const GenJoint & joint(joints_[i]);
+        std::string f(_Fmt("model.f[%d]", i) + "[%d]");
+        std::string fg(_Fmt("f_grav[%d]", i) + "[%d]");
+        for(int m(0); m < joint.num_dof; ++m){
+            fprintf(fp, "    coriolis[%d] = %s;\n", joint.q_index + m, _SDot(joint, m, f.c_str()).c_str());
+            fprintf(fp, "    grav[%d] = %s;\n", joint.q_index + m, _SDot(joint, m, fg.c_str()).c_str());
+        }
+        if(joint.parent != 0){
+            fprintf(fp, "    model.f[%d] += model.X_lambda[%d].applyTranspose(model.f[%d]);\n",
+                    joint.parent, i, i);
+            fprintf(fp, "    f_grav[%d] += model.X_lambda[%d].applyTranspose(f_grav[%d]);\n",
+                    joint.parent, i, i);
+        }
+    }
+    fprintf(fp, "    for(int k(0); k < num_qdot; ++k) coriolis[k] -= grav[k];\n");
+    fprintf(fp, "}\n\n");
+}
+
+// CRBA; F carried on to the base frame gives the momentum matrix.
+void URDF_CodeGen::_WriteMassMatrix(FILE* fp){
+    int num_body(model_.mBodies.size());
+
+    fprintf(fp, "void _MassMatrix(Model & model, double* A, double* Ag_base,\n");
+    fprintf(fp, "        SpatialRigidBodyInertia & I_tot){\n");
+    fprintf(fp, "    Eigen::Map<MassMatrix> H(A);\n");
+    fprintf(fp, "    Eigen::Map<Eigen::Matrix<double, 6, num_qdot> > Ag(Ag_base);\n");
+    fprintf(fp, "    SpatialVector F;\n");
+    fprintf(fp, "    Matrix63 F3;\n\n");
+    fprintf(fp, "    for(int i(1); i < num_body; ++i) model.Ic[i] = model.I[i];\n");
+    fprintf(fp, "    I_tot = SpatialRigidBodyInertia();\n");
+
+    for(int i(num_body - 1); i > 0; --i){
+        const GenJoint & joint(joints_[i]);
+        int k(joint.q_index);
+
+        fprintf(fp, "\n    // %s\n", joint.name.c_str());
+        if(joint.parent != 0){
+            fprintf(fp, "    model.Ic[%d] = model.Ic[%d] + model.X_lambda[%d].applyTranspose(model.Ic[%d]);\n",
+                    joint.parent, joint.parent, i, i);
+        } else {
+            fprintf(fp, "    I_tot = I_tot + model.X_lambda[%d].applyTranspose(model.Ic[%d]);\n", i, i);
+        }
+
+        bool multi(joint.num_dof == 3);
+        const char* F(multi ? "F3" : "F");
+        switch(joint.kind){
+            case kRevoluteX:
+            case kRevoluteY:
+            case kRevoluteZ:
+                fprintf(fp, "    F = InertiaRotation%c(model.Ic[%d]);\n",
+                        'X' + (joint.kind - kRevoluteX), i);
+                break;
+            case kRevolute:
+            case kPrismatic:
+                fprintf(fp, "    F = model.Ic[%d] * SpatialVector(%s", i, _Num(joint.S[0][0]).c_str());
+                for(int m(1); m < 6; ++m) fprintf(fp, ", %s", _Num(joint.S[0][m]).c_str());
+                fprintf(fp, ");\n");
+                break;
+            case kSpherical:
+                fprintf(fp, "    F3 = model.Ic[%d].toMatrix().leftCols<3>();\n", i);
+                break;
+            case kTranslationXYZ:
+                fprintf(fp, "    F3 = model.Ic[%d].toMatrix().rightCols<3>();\n", i);
+                break;
+        }
+
+        // H(dofs of i, dofs of j) = F^T S_j for j = i and its ancestors
+        unsigned int j(i);
+        while(true){
+            const GenJoint & anc(joints_[j]);
+            for(int col(0); col < joint.num_dof; ++col){
+                std::string f(multi ? std::string("F3(%d, ") + _Fmt("%d", col) + ")" : std::string("F[%d]"));
+                for(int m(0); m < anc.num_dof; ++m){
+                    int r(anc.q_index + m);
+                    std::string expr(_SDot(anc, m, f.c_str()));
+                    if(j == (unsigned int)i)
+                        fprintf(fp, "    H(%d, %d) = %s;\n", r, k + col, expr.c_str());
+                    else
+                        fprintf(fp, "    H(%d, %d) = H(%d, %d) = %s;\n", k + col, r, r, k + col, expr.c_str());
+                }
+            }
+            if(multi)
+                fprintf(fp, "    F3 = ApplyTranspose(model.X_lambda[%d], F3);\n", j);
+            else
+                fprintf(fp, "    F = model.X_lambda[%d].applyTranspose(F);\n", j);
+            if(anc.parent == 0) break;
+            j = anc.parent;
+        }
+        if(multi) fprintf(fp, "    Ag.block<6, 3>(0, %d) = %s;\n", k, F);
+        else fprintf(fp, "    Ag.col(%d) = %s;\n", k, F);
+    }
+    fprintf(fp, "}\n\n");
+}
+
+// A = L^T L (RBDL's SparseFactorizeLTL) and Ainv = L^-1 L^-T, L^-1 having
+// the sparsity of L. Only the entries of dofs on a common path are touched.
+void URDF_CodeGen::_WriteInverseMass(FILE* fp){
+    int n(model_.qdot_size);
+    std::vector<std::vector<int> > anc(n);
+    for(int k(0); k < n; ++k) anc[k] = _DofAncestors(k);
+
+    fprintf(fp, "bool _InverseMass(const double* A, double* Ainv){\n");
+    fprintf(fp, "    MassMatrix L = Eigen::Map<const MassMatrix>(A);\n");
+    fprintf(fp, "    MassMatrix Linv;\n");
+    fprintf(fp, "    Eigen::Map<MassMatrix> H_inv(Ainv);\n\n");
+
+    for(int k(n - 1); k >= 0; --k){
+        fprintf(fp, "    if(!(L(%d, %d) > 1.e-10)) return false;\n", k, k);
+        fprintf(fp, "    L(%d, %d) = sqrt(L(%d, %d));\n", k, k, k, k);
+        for(size_t a(0); a < anc[k].size(); ++a)
+            fprintf(fp, "    L(%d, %d) /= L(%d, %d);\n", k, anc[k][a], k, k);
+        for(size_t a(0); a < anc[k].size(); ++a){
+            int i(anc[k][a]);
+            for(size_t b(a); b < anc[k].size(); ++b){
+                int j(anc[k][b]);
+                fprintf(fp, "    L(%d, %d) -= L(%d, %d) * L(%d, %d);\n", i, j, k, i, k, j);
+            }
+        }
+    }
+
+    fprintf(fp, "\n");
+    for(int k(0); k < n; ++k){
+        fprintf(fp, "    Linv(%d, %d) = 1. / L(%d, %d);\n", k, k, k, k);
+        // (L Linv)(k, i) = 0 summed over the path from k to i
+        for(size_t a(0); a < anc[k].size(); ++a){
+            int i(anc[k][a]);
+            std::string sum;
+            for(size_t b(0); b <= a; ++b){
+                int m(anc[k][b]);
+                sum += (b > 0 ? " + " : "") + _Fmt("L(%d, %d) * Linv(%d, ", k, m, m) + _Fmt("%d)", i);
+            }
+            fprintf(fp, "    Linv(%d, %d) = -(%s) * Linv(%d, %d);\n", k, i, sum.c_str(), k, k);
+        }
+    }
+
+    fprintf(fp, "\n");
+    for(int i(0); i < n; ++i){
+        std::vector<int> path_i(anc[i]);
+        path_i.insert(path_i.begin(), i);
+        for(int j(i); j < n; ++j){
+            std::vector<int> path_j(anc[j]);
+            path_j.insert(path_j.begin(), j);
+            std::string sum;
+            for(size_t a(0); a < path_i.size(); ++a){
+                for(size_t b(0); b < path_j.size(); ++b){
+                    if(path_i[a] != path_j[b]) continue;
+                    int m(path_i[a]);
+                    sum += (sum.empty() ? "" : " + ") + _Fmt("Linv(%d, %d) * Linv(%d, ", i, m, j) + _Fmt("%d)", m);
+                }
+            }
+            if(sum.empty()) sum = "0.";
+            if(i == j) fprintf(fp, "    H_inv(%d, %d) = %s;\n", i, i, sum.c_str());
+            else fprintf(fp, "    H_inv(%d, %d) = H_inv(%d, %d) = %s;\n", i, j, j, i, sum.c_str());
+        }
+    }
+    fprintf(fp, "    return true;\n");
+    fprintf(fp, "}\n\n");
+}
+
+void URDF_CodeGen::_WriteJacobian(FILE* fp){
+    int num_body(model_.mBodies.size());
+
+    fprintf(fp, "void _Jacobian(const Model & model, unsigned int body_id,\n");
+    fprintf(fp, "        const Vector3d & point, double* J){\n");
+    fprintf(fp, "    switch(body_id){\n");
+    for(int i(1); i < num_body; ++i){
+        fprintf(fp, "    case %d:\n", i);
+        for(unsigned int j(i); j != 0; j = joints_[j].parent){
+            const GenJoint & joint(joints_[j]);
+            int col(6 * joint.q_index);
+            switch(joint.kind){
+                case kRevoluteX:
+                case kRevoluteY:
+                case kRevoluteZ:
+                    fprintf(fp, "        RevoluteColumn(model.X_base[%d], %d, point, J + %d);\n",
+                            j, joint.kind - kRevoluteX, col);
+                    break;
+                case kRevolute:
+                    fprintf(fp, "        RevoluteColumn(model.X_base[%d], %s, point, J + %d);\n",
+                            j, _Vec3(joint.S[0], 0).c_str(), col);
+                    break;
+                case kPrismatic:
+                    fprintf(fp, "        PrismaticColumn(model.X_base[%d], %s, J + %d);\n",
+                            j, _Vec3(joint.S[0], 3).c_str(), col);
+                    break;
+                case kSpherical:
+                    for(int m(0); m < 3; ++m)
+                        fprintf(fp, "        RevoluteColumn(model.X_base[%d], %d, point, J + %d);\n",
+                                j, m, col + 6 * m);
+                    break;
+                case kTranslationXYZ:
+                    for(int m(0); m < 3; ++m)
+                        fprintf(fp, "        TranslationColumn(model.X_base[%d], %d, J + %d);\n",
+                                j, m, col + 6 * m);
+                    break;
+            }
+        }
+        fprintf(fp, "        break;\n");
+    }
+    fprintf(fp, "    }\n");
+    fprintf(fp, "}\n\n");
+}
+
+int main(int argc, char** argv){
+    if(argc != 4){
+        fprintf(stderr, "usage: urdf_codegen <urdf file> <name> <output directory>\n");
+        return 1;
+    }
+    URDF_CodeGen codegen(argv[1], argv[2]);
+    if(!codegen.load()) return 1;
+    if(!codegen.write(argv[3])) return 1;
+    return 0;
+}
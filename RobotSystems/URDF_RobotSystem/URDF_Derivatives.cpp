@@ -0,0 +1,265 @@
+#include "URDF_RobotSystem.hpp"
+#include <stdio.h>
+
+using namespace RigidBodyDynamics;
+using namespace RigidBodyDynamics::Math;
+
+// Derivatives of the RNEA in the base frame (Carpentier, Mansard, "Analytical
+// Derivatives of Rigid Body Dynamics Algorithms", 2018). With everything in
+// the base frame, moving dof k turns the bodies beyond it (and their s, I)
+// by its motion s_k; only the velocity and acceleration the parent of k
+// already had (v_p, a_p) do not turn. For the subtree force F_i of a body i
+// beyond k and the torque tau_i = s_i^T F_i this leaves
+//
+//   dtau_i/dq_k    = s_i^T (Ic_i u_k + D_i w_k),  w_k = s_k x v_p,
+//                    u_k = -(s_k x a_p) - v_p x w_k
+//   dtau_i/dqdot_k = s_i^T (Ic_i e_k - D_i s_k),  e_k = (v_p + v_k) x s_k
+//
+// with Ic_i the composite inertia and D_i the sum over the subtree of
+// I v x - v x* I - (h x*)(.), h = I v. The joints before k see the subtree
+// force of k change by the same terms (plus s_k x* F_k for q).
+
+// at most 6 dofs per joint, so the per body terms stay on the stack
+typedef Eigen::Matrix<double, Eigen::Dynamic, 6, 0, 6, 6> JointRowMatrix;
+typedef Eigen::Matrix<double, 6, Eigen::Dynamic, 0, 6, 6> JointColMatrix;
+
+// m x* h = ForceCrossDual(h) * m
+static SpatialMatrix ForceCrossDual(const SpatialVector & h){
+    Matrix3d n_skew = VectorCrossMatrix(Vector3d(h[0], h[1], h[2]));
+    Matrix3d f_skew = VectorCrossMatrix(Vector3d(h[3], h[4], h[5]));
+    SpatialMatrix C = SpatialMatrix::Zero();
+    C.block<3, 3>(0, 0) = -n_skew;
+    C.block<3, 3>(0, 3) = -f_skew;
+    C.block<3, 3>(3, 0) = -f_skew;
+    return C;
+}
+
+bool URDF_RobotSystem::_RNEADerivatives(const dynacore::Vector & qddot, bool velocity,
+        bool gravity, dynacore::Matrix & dtau_dq, dynacore::Matrix * dtau_dqdot) const {
+    Model & model = *model_;
+    int nqdot(model.qdot_size);
+    dtau_dq = dynacore::Matrix::Zero(nqdot, nqdot);
+    if(dtau_dqdot) *dtau_dqdot = dynacore::Matrix::Zero(nqdot, nqdot);
+    if(!derivative_joint_){
+        printf("[%s Model] derivatives need joints moving with their body\n",
+                setting_.name.c_str());
+        return false;
+    }
+    _RequireLazy(KINEMATICS);
+
+    int num_body(model.mBodies.size());
+    v_base_[0].setZero();
+    a_base_[0].setZero();
+    if(gravity) a_base_[0].tail<3>() = -model.gravity;
+
+    for(int i(1); i < num_body; ++i){
+        unsigned int lambda = model.lambda[i];
+        unsigned int q_index = model.mJoints[i].q_index;
+        int num_dof(S_[i].cols());
+
+        s_base_[i] = model.X_base[i].inverse().toMatrix() * S_[i];
+        v_base_[i] = v_base_[lambda];
+        a_base_[i] = a_base_[lambda] + s_base_[i] * qddot.segment(q_index, num_dof);
+        if(velocity){
+            SpatialVector v_J = s_base_[i] * qdot_.segment(q_index, num_dof);
+            v_base_[i] += v_J;
+            a_base_[i] += crossm(v_base_[i], v_J);
+        }
+
+        if(!model.mBodies[i].mIsVirtual){
+            SpatialMatrix I_base = model.X_base[i].applyTranspose(model.I[i]).toMatrix();
+            SpatialVector h = I_base * v_base_[i];
+            f_base_[i] = I_base * a_base_[i] + crossf(v_base_[i], h);
+            Ic_d_[i] = I_base;
+            D_[i] = I_base * crossm(v_base_[i]) - crossf(v_base_[i]) * I_base - ForceCrossDual(h);
+        } else {
+            f_base_[i].setZero();
+            Ic_d_[i].setZero();
+            D_[i].setZero();
+        }
+    }
+
+    for(int i(num_body - 1); i > 0; --i){
+        unsigned int lambda = model.lambda[i];
+        if(lambda != 0){
+            f_base_[lambda] += f_base_[i];
+            Ic_d_[lambda] += Ic_d_[i];
+            D_[lambda] += D_[i];
+        }
+    }
+
+    for(int k(1); k < num_body; ++k){
+        unsigned int lambda = model.lambda[k];
+        unsigned int q_index = model.mJoints[k].q_index;
+        for(int c(0); c < s_base_[k].cols(); ++c){
+            SpatialVector s = s_base_[k].col(c);
+            SpatialVector w = crossm(s, v_base_[lambda]);
+            u_d_.col(q_index + c) = -crossm(s, a_base_[lambda]) - crossm(v_base_[lambda], w);
+            w_d_.col(q_index + c) = w;
+            e_d_.col(q_index + c) = crossm(v_base_[lambda] + v_base_[k], s);
+        }
+    }
+
+    JointRowMatrix sIc, sD;
+    JointColMatrix P_q, P_qdot;
+    for(int i(1); i < num_body; ++i){
+        unsigned int q_i = model.mJoints[i].q_index;
+        int n_i(s_base_[i].cols());
+        sIc.noalias() = s_base_[i].transpose() * Ic_d_[i];
+        sD.noalias() = s_base_[i].transpose() * D_[i];
+
+        // the joints that move body i, i itself included
+        for(unsigned int k(i); k != 0; k = model.lambda[k]){
+            unsigned int q_k = model.mJoints[k].q_index;
+            int n_k(s_base_[k].cols());
+            dtau_dq.block(q_i, q_k, n_i, n_k).noalias() = sIc * u_d_.middleCols(q_k, n_k);
+            dtau_dq.block(q_i, q_k, n_i, n_k).noalias() += sD * w_d_.middleCols(q_k, n_k);
+            if(dtau_dqdot){
+                dtau_dqdot->block(q_i, q_k, n_i, n_k).noalias() = sIc * e_d_.middleCols(q_k, n_k);
+                dtau_dqdot->block(q_i, q_k, n_i, n_k).noalias() -= sD * s_base_[k];
+            }
+        }
+
+        // the joints before i: the subtree force of i changes
+        P_q.resize(6, n_i);
+        for(int c(0); c < n_i; ++c){
+            SpatialVector s = s_base_[i].col(c);
+            P_q.col(c) = crossf(s, f_base_[i]) + Ic_d_[i] * u_d_.col(q_i + c)
+                + D_[i] * w_d_.col(q_i + c);
+        }
+        if(dtau_dqdot){
+            P_qdot.noalias() = Ic_d_[i] * e_d_.middleCols(q_i, n_i);
+            P_qdot.noalias() -= D_[i] * s_base_[i];
+        }
+        for(unsigned int j(model.lambda[i]); j != 0; j = model.lambda[j]){
+            unsigned int q_j = model.mJoints[j].q_index;
+            dtau_dq.block(q_j, q_i, s_base_[j].cols(), n_i).noalias() =
+                s_base_[j].transpose() * P_q;
+            if(dtau_dqdot){
+                dtau_dqdot->block(q_j, q_i, s_base_[j].cols(), n_i).noalias() =
+                    s_base_[j].transpose() * P_qdot;
+            }
+        }
+    }
+    return true;
+}
+
+void URDF_RobotSystem::getInverseDynamicsDerivatives(const dynacore::Vector & qddot,
+        dynacore::Matrix & dtau_dq, dynacore::Matrix & dtau_dqdot) const {
+    _RNEADerivatives(qddot, true, true, dtau_dq, &dtau_dqdot);
+}
+
+// A qddot + coriolis + grav = tau holds for all q, qdot, so
+// A dqddot = -dtau of the RNEA at that qddot
+void URDF_RobotSystem::getForwardDynamicsDerivatives(const dynacore::Vector & tau,
+        dynacore::Vector & qddot, dynacore::Matrix & dqddot_dq,
+        dynacore::Matrix & dqddot_dqdot) const {
+    _RequireLazy(DYNAMICS | MASS_FACTOR);
+    dynacore::Matrix rhs(tau - coriolis_ - grav_);
+    dynacore::Matrix sol;
+    A_ltl_.inverseProduct(rhs, sol);
+    qddot = sol.col(0);
+
+    dynacore::Matrix dtau_dq, dtau_dqdot;
+    _RNEADerivatives(qddot, true, true, dtau_dq, &dtau_dqdot);
+    A_ltl_.inverseProduct(-dtau_dq, dqddot_dq);
+    A_ltl_.inverseProduct(-dtau_dqdot, dqddot_dqdot);
+}
+
+void URDF_RobotSystem::getGravityDerivative(dynacore::Matrix & dgrav_dq) const {
+    dynacore::Vector zero_qddot = dynacore::Vector::Zero(model_->qdot_size);
+    _RNEADerivatives(zero_qddot, false, true, dgrav_dq, NULL);
+}
+
+void URDF_RobotSystem::getCoriolisDerivatives(dynacore::Matrix & dcori_dq,
+        dynacore::Matrix & dcori_dqdot) const {
+    dynacore::Vector zero_qddot = dynacore::Vector::Zero(model_->qdot_size);
+    _RNEADerivatives(zero_qddot, true, false, dcori_dq, &dcori_dqdot);
+}
+
+void URDF_RobotSystem::getMassInertiaDerivative(const dynacore::Vector & x,
+        dynacore::Matrix & dAx_dq) const {
+    _RNEADerivatives(x, false, false, dAx_dq, NULL);
+}
+
+// Column j of the point Jacobian is [w_j; v_j + w_j x p] for s_j = [w_j; v_j]
+// in the base frame. Moving dof k turns s_j (k before or at j) to s_k x s_j
+// and moves the point p by the velocity of s_k at p.
+void URDF_RobotSystem::getFullJacobianDerivative(int link_id,
+        std::vector<dynacore::Matrix> & dJ_dq) const {
+    _RequireLazy(KINEMATICS);
+    Model & model = *model_;
+    int nqdot(model.qdot_size);
+    dJ_dq.assign(nqdot, dynacore::Matrix::Zero(6, nqdot));
+    if(!derivative_joint_){
+        printf("[%s Model] derivatives need joints moving with their body\n",
+                setting_.name.c_str());
+        return;
+    }
+    Vector3d point;
+    unsigned int body_id = _GetBodyPoint(link_id, point);
+
+    // the joints from the body to the root
+    std::vector<unsigned int> path;
+    for(unsigned int k(body_id); k != 0; k = model.lambda[k]){
+        s_base_[k] = model.X_base[k].inverse().toMatrix() * S_[k];
+        path.push_back(k);
+    }
+
+    for(int m(path.size() - 1); m >= 0; --m){
+        unsigned int k = path[m];
+        for(int c(0); c < s_base_[k].cols(); ++c){
+            SpatialVector s_k = s_base_[k].col(c);
+            Vector3d w_k(s_k.head<3>());
+            Vector3d dpoint = w_k.cross(point) + s_k.tail<3>();
+            dynacore::Matrix & dJ = dJ_dq[model.mJoints[k].q_index + c];
+
+            for(int n(path.size() - 1); n >= 0; --n){
+                unsigned int j = path[n];
+                for(int d(0); d < s_base_[j].cols(); ++d){
+                    SpatialVector s_j = s_base_[j].col(d);
+                    SpatialVector ds = SpatialVector::Zero();
+                    // k before or at j on the path
+                    if(m >= n) ds = crossm(s_k, s_j);
+                    Vector3d w_j(s_j.head<3>());
+                    Vector3d dw(ds.head<3>());
+                    int col(model.mJoints[j].q_index + d);
+                    dJ.block<3, 1>(0, col) = dw;
+                    dJ.block<3, 1>(3, col) = ds.tail<3>() + dw.cross(point) + w_j.cross(dpoint);
+                }
+            }
+        }
+    }
+}
+
+// Along the motion: s_j turns with the velocity of its body, s_j' = v_j x s_j
+void URDF_RobotSystem::getFullJDot(int link_id, dynacore::Matrix & JDot) const {
+    _RequireLazy(KINEMATICS);
+    Model & model = *model_;
+    JDot = dynacore::Matrix::Zero(6, model.qdot_size);
+    if(!derivative_joint_){
+        printf("[%s Model] derivatives need joints moving with their body\n",
+                setting_.name.c_str());
+        return;
+    }
+    Vector3d point;
+    unsigned int body_id = _GetBodyPoint(link_id, point);
+    SpatialVector v_body = model.X_base[body_id].inverse().apply(model.v[body_id]);
+    Vector3d w_body(v_body.head<3>());
+    Vector3d point_vel = w_body.cross(point) + v_body.tail<3>();
+
+    for(unsigned int j(body_id); j != 0; j = model.lambda[j]){
+        SpatialTransform body_to_base = model.X_base[j].inverse();
+        SpatialVector v_j = body_to_base.apply(model.v[j]);
+        dynacore::Matrix s_j = body_to_base.toMatrix() * S_[j];
+        for(int d(0); d < s_j.cols(); ++d){
+            SpatialVector s = s_j.col(d);
+            SpatialVector ds = crossm(v_j, s);
+            Vector3d dw(ds.head<3>());
+            Vector3d w(s.head<3>());
+            int col(model.mJoints[j].q_index + d);
+            JDot.block<3, 1>(0, col) = dw;
+            JDot.block<3, 1>(3, col) = ds.tail<3>() + dw.cross(point) + w.cross(point_vel);
+        }
+    }
+}
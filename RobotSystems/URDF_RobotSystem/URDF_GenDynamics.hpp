@@ -0,0 +1,41 @@
+#ifndef URDF_GEN_DYNAMICS
+#define URDF_GEN_DYNAMICS
+
+#include <rbdl/rbdl.h>
+
+// Robot specific dynamics written by urdf_codegen (RobotSystems/URDF_CodeGen)
+// for one URDF. The functions work on the RBDL model loaded from the same
+// file and fill its X_lambda, X_base, v, a, f and Ic as RBDL would, so the
+// RBDL queries on the model stay valid. Matrices are column major.
+struct URDF_GenDynamics{
+    const char* urdf_file;
+    int num_q;
+    int num_qdot;
+    int num_body;
+
+    // false if the model is not the one the code was generated from
+    bool (*check)(const RigidBodyDynamics::Model & model);
+
+    // X_lambda, X_base, v and c of the bodies (UpdateKinematics)
+    void (*kinematics)(RigidBodyDynamics::Model & model,
+            const double* q, const double* qdot);
+
+    // gravity and Coriolis (RNEA) on the kinematics, model.a with gravity
+    void (*inverse_dynamics)(RigidBodyDynamics::Model & model,
+            double* grav, double* coriolis);
+
+    // mass matrix (CRBA) on the kinematics, the momentum matrix about the
+    // base origin and the inertia of the robot
+    void (*mass_matrix)(RigidBodyDynamics::Model & model,
+            double* A, double* Ag_base,
+            RigidBodyDynamics::Math::SpatialRigidBodyInertia & I_tot);
+
+    // A = L^T L with L as sparse as the tree; false if A is close to singular
+    bool (*inverse_mass)(const double* A, double* Ainv);
+
+    // 6 x num_qdot point Jacobian of a movable body, point in base coordinates
+    void (*jacobian)(const RigidBodyDynamics::Model & model, unsigned int body_id,
+            const RigidBodyDynamics::Math::Vector3d & point, double* J);
+};
+
+#endif
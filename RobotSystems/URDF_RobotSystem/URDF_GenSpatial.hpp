@@ -0,0 +1,185 @@
+#ifndef URDF_GEN_SPATIAL
+#define URDF_GEN_SPATIAL
+
+#include <rbdl/rbdl.h>
+#include <math.h>
+
+// Joint specific pieces of the spatial algebra for the code urdf_codegen
+// writes; the rest is RBDL's own. X_lambda = X_J * X_T as jcalc does, the
+// Jacobian columns as CalcPointJacobian6D. The overloads taking only r_T are
+// for joints whose X_T has no rotation.
+namespace urdf_gen{
+
+using namespace RigidBodyDynamics::Math;
+
+inline void RevoluteX(double q, const Vector3d & r_T, SpatialTransform & X){
+    double s(sin(q)), c(cos(q));
+    X.E << 1., 0., 0.,
+           0., c, s,
+           0., -s, c;
+    X.r = r_T;
+}
+
+inline void RevoluteX(double q, const SpatialTransform & X_T, SpatialTransform & X){
+    double s(sin(q)), c(cos(q));
+    X.E.row(0) = X_T.E.row(0);
+    X.E.row(1) = c * X_T.E.row(1) + s * X_T.E.row(2);
+    X.E.row(2) = -s * X_T.E.row(1) + c * X_T.E.row(2);
+    X.r = X_T.r;
+}
+
+inline void RevoluteY(double q, const Vector3d & r_T, SpatialTransform & X){
+    double s(sin(q)), c(cos(q));
+    X.E << c, 0., -s,
+           0., 1., 0.,
+           s, 0., c;
+    X.r = r_T;
+}
+
+inline void RevoluteY(double q, const SpatialTransform & X_T, SpatialTransform & X){
+    double s(sin(q)), c(cos(q));
+    X.E.row(0) = c * X_T.E.row(0) - s * X_T.E.row(2);
+    X.E.row(1) = X_T.E.row(1);
+    X.E.row(2) = s * X_T.E.row(0) + c * X_T.E.row(2);
+    X.r = X_T.r;
+}
+
+inline void RevoluteZ(double q, const Vector3d & r_T, SpatialTransform & X){
+    double s(sin(q)), c(cos(q));
+    X.E << c, s, 0.,
+           -s, c, 0.,
+           0., 0., 1.;
+    X.r = r_T;
+}
+
+inline void RevoluteZ(double q, const SpatialTransform & X_T, SpatialTransform & X){
+    double s(sin(q)), c(cos(q));
+    X.E.row(0) = c * X_T.E.row(0) + s * X_T.E.row(1);
+    X.E.row(1) = -s * X_T.E.row(0) + c * X_T.E.row(1);
+    X.E.row(2) = X_T.E.row(2);
+    X.r = X_T.r;
+}
+
+// Xrot: the axis is used as given, like RBDL (URDF axes are not normalized)
+inline Matrix3d RotationAbout(double q, const Vector3d & axis){
+    double s(sin(q)), c(cos(q));
+    return Matrix3d(
+            axis[0] * axis[0] * (1. - c) + c,
+            axis[1] * axis[0] * (1. - c) + axis[2] * s,
+            axis[0] * axis[2] * (1. - c) - axis[1] * s,
+
+            axis[0] * axis[1] * (1. - c) - axis[2] * s,
+            axis[1] * axis[1] * (1. - c) + c,
+            axis[1] * axis[2] * (1. - c) + axis[0] * s,
+
+            axis[0] * axis[2] * (1. - c) + axis[1] * s,
+            axis[1] * axis[2] * (1. - c) - axis[0] * s,
+            axis[2] * axis[2] * (1. - c) + c);
+}
+
+inline void Revolute(double q, const Vector3d & axis, const Vector3d & r_T, SpatialTransform & X){
+    X.E = RotationAbout(q, axis);
+    X.r = r_T;
+}
+
+inline void Revolute(double q, const Vector3d & axis, const SpatialTransform & X_T, SpatialTransform & X){
+    X.E = RotationAbout(q, axis) * X_T.E;
+    X.r = X_T.r;
+}
+
+inline void Prismatic(double q, const Vector3d & axis, const SpatialTransform & X_T, SpatialTransform & X){
+    X.E = X_T.E;
+    X.r = X_T.r + X_T.E.transpose() * (axis * q);
+}
+
+inline void Spherical(double x, double y, double z, double w,
+        const Vector3d & r_T, SpatialTransform & X){
+    X.E = Quaternion(x, y, z, w).toMatrix();
+    X.r = r_T;
+}
+
+inline void Spherical(double x, double y, double z, double w,
+        const SpatialTransform & X_T, SpatialTransform & X){
+    X.E = Quaternion(x, y, z, w).toMatrix() * X_T.E;
+    X.r = X_T.r;
+}
+
+inline void TranslationXYZ(double x, double y, double z,
+        const Vector3d & r_T, SpatialTransform & X){
+    X.E.setIdentity();
+    X.r = r_T + Vector3d(x, y, z);
+}
+
+inline void TranslationXYZ(double x, double y, double z,
+        const SpatialTransform & X_T, SpatialTransform & X){
+    X.E = X_T.E;
+    X.r = X_T.r + X_T.E.transpose() * Vector3d(x, y, z);
+}
+
+// X_base = X_lambda * X_base of the parent, the parent not rotated
+inline void TranslateBase(const SpatialTransform & X_lambda, const SpatialTransform & X_parent,
+        SpatialTransform & X_base){
+    X_base.E = X_lambda.E;
+    X_base.r = X_parent.r + X_lambda.r;
+}
+
+// I * S of the coordinate axis rotations
+inline SpatialVector InertiaRotationX(const SpatialRigidBodyInertia & I){
+    return SpatialVector(I.Ixx, I.Iyx, I.Izx, 0., -I.h[2], I.h[1]);
+}
+
+inline SpatialVector InertiaRotationY(const SpatialRigidBodyInertia & I){
+    return SpatialVector(I.Iyx, I.Iyy, I.Izy, I.h[2], 0., -I.h[0]);
+}
+
+inline SpatialVector InertiaRotationZ(const SpatialRigidBodyInertia & I){
+    return SpatialVector(I.Izx, I.Izy, I.Izz, -I.h[1], I.h[0], 0.);
+}
+
+inline Matrix63 ApplyTranspose(SpatialTransform & X, const Matrix63 & F){
+    Matrix63 res;
+    for(int i(0); i < 3; ++i) res.col(i) = X.applyTranspose(SpatialVector(F.col(i)));
+    return res;
+}
+
+// a x e_k
+inline Vector3d CrossUnit(const Vector3d & a, int k){
+    switch(k){
+        case 0: return Vector3d(0., a[2], -a[1]);
+        case 1: return Vector3d(-a[2], 0., a[0]);
+        default: return Vector3d(a[1], -a[0], 0.);
+    }
+}
+
+// Jacobian columns (6 entries from col) of a joint of the body at X_base:
+// its motion subspace in base coordinates, moved to the point
+inline void RevoluteColumn(const SpatialTransform & X_base, int k,
+        const Vector3d & point, double* col){
+    Vector3d w(X_base.E.row(k).transpose());
+    Vector3d v(X_base.E.transpose() * CrossUnit(X_base.E * X_base.r, k) - point.cross(w));
+    col[0] = w[0]; col[1] = w[1]; col[2] = w[2];
+    col[3] = v[0]; col[4] = v[1]; col[5] = v[2];
+}
+
+inline void RevoluteColumn(const SpatialTransform & X_base, const Vector3d & axis,
+        const Vector3d & point, double* col){
+    Vector3d w(X_base.E.transpose() * axis);
+    Vector3d v(X_base.E.transpose() * (X_base.E * X_base.r).cross(axis) - point.cross(w));
+    col[0] = w[0]; col[1] = w[1]; col[2] = w[2];
+    col[3] = v[0]; col[4] = v[1]; col[5] = v[2];
+}
+
+inline void TranslationColumn(const SpatialTransform & X_base, int k, double* col){
+    col[0] = 0.; col[1] = 0.; col[2] = 0.;
+    col[3] = X_base.E(k, 0); col[4] = X_base.E(k, 1); col[5] = X_base.E(k, 2);
+}
+
+inline void PrismaticColumn(const SpatialTransform & X_base, const Vector3d & axis, double* col){
+    Vector3d v(X_base.E.transpose() * axis);
+    col[0] = 0.; col[1] = 0.; col[2] = 0.;
+    col[3] = v[0]; col[4] = v[1]; col[5] = v[2];
+}
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+#include "URDF_RobotBatch.hpp"
+#include <pthread.h>
+#include <string.h>
+#include <stdio.h>
+
+void* _RunBatch(void* arg){
+    URDF_RobotBatch::Work* work = (URDF_RobotBatch::Work*)arg;
+    work->batch->_Evaluate(work->thread_idx, work->start, work->end);
+    return NULL;
+}
+
+URDF_RobotBatch::URDF_RobotBatch(const URDF_RobotSystem & robot, int num_thread):
+    Q_(NULL),
+    Qdot_(NULL),
+    output_(NULL)
+{
+    // the copies would share the custom joints and their jcalc state
+    if(num_thread < 1 || robot.hasCustomJoint()) num_thread = 1;
+    for(int i(0); i < num_thread; ++i){
+        URDF_RobotSystem* copy = new URDF_RobotSystem(robot);
+        copy->setLazyUpdate(true);
+        robot_.push_back(copy);
+    }
+}
+
+URDF_RobotBatch::~URDF_RobotBatch(){
+    for(int i(0); i < robot_.size(); ++i) delete robot_[i];
+}
+
+// Contiguous ranges of configurations, so the threads only meet in the
+// output at the range ends; the last range runs in the calling thread.
+bool URDF_RobotBatch::evaluate(const dynacore::Matrix & Q, const dynacore::Matrix & Qdot,
+        const URDF_BatchOutput & output){
+    int num(Q.cols());
+    if(Q.rows() != robot_[0]->getNumQ() || (Qdot.size() != 0 &&
+                (Qdot.rows() != robot_[0]->getNumQdot() || Qdot.cols() != num))){
+        printf("[Robot Batch] Q (%d x %d) or Qdot (%d x %d) has the wrong size\n",
+                (int)Q.rows(), num, (int)Qdot.rows(), (int)Qdot.cols());
+        return false;
+    }
+    if(num == 0) return true;
+    Q_ = &Q;
+    Qdot_ = &Qdot;
+    output_ = &output;
+
+    int num_thread(robot_.size());
+    if(num_thread > num) num_thread = num;
+    std::vector<Work> work(num_thread);
+    int start(0);
+    for(int i(0); i < num_thread; ++i){
+        work[i].batch = this;
+        work[i].thread_idx = i;
+        work[i].start = start;
+        work[i].end = start + num / num_thread + (i < num % num_thread ? 1 : 0);
+        start = work[i].end;
+    }
+
+    std::vector<pthread_t> thread(num_thread);
+    std::vector<bool> started(num_thread, false);
+    for(int i(0); i < num_thread - 1; ++i){
+        int ret = pthread_create(&thread[i], NULL, _RunBatch, &work[i]);
+        if(ret != 0){
+            printf("[Robot Batch] fail to start a thread (%s), evaluating in this one\n",
+                    strerror(ret));
+            _Evaluate(i, work[i].start, work[i].end);
+        } else {
+            started[i] = true;
+        }
+    }
+    _Evaluate(num_thread - 1, work[num_thread - 1].start, work[num_thread - 1].end);
+    for(int i(0); i < num_thread - 1; ++i){
+        if(started[i]) pthread_join(thread[i], NULL);
+    }
+    return true;
+}
+
+void URDF_RobotBatch::_Evaluate(int thread_idx, int start, int end){
+    URDF_RobotSystem* robot = robot_[thread_idx];
+    const URDF_BatchOutput & out(*output_);
+    int num(Q_->cols());
+    int nqdot(robot->getNumQdot());
+    bool b_qdot(Qdot_->size() != 0);
+
+    dynacore::Vector q(Q_->rows());
+    dynacore::Vector qdot = dynacore::Vector::Zero(nqdot);
+    dynacore::Vector grav;
+    dynacore::Vect3 vec3;
+    dynacore::Matrix A, J;
+
+    for(int i(start); i < end; ++i){
+        q = Q_->col(i);
+        if(b_qdot) qdot = Qdot_->col(i);
+        robot->UpdateSystem(q, qdot);
+
+        if(out.com_pos){
+            robot->getCoMPosition(vec3);
+            for(int k(0); k < 3; ++k) out.com_pos[k * num + i] = vec3[k];
+        }
+        if(out.com_vel){
+            robot->getCoMVelocity(vec3);
+            for(int k(0); k < 3; ++k) out.com_vel[k * num + i] = vec3[k];
+        }
+        if(out.mass_diag){
+            robot->getMassInertia(A);
+            for(int k(0); k < nqdot; ++k) out.mass_diag[k * num + i] = A(k, k);
+        }
+        if(out.grav){
+            robot->getGravity(grav);
+            for(int k(0); k < nqdot; ++k) out.grav[k * num + i] = grav[k];
+        }
+        for(int l(0); l < out.links.size(); ++l){
+            if(out.link_pos){
+                robot->getPos(out.links[l], vec3);
+                for(int k(0); k < 3; ++k) out.link_pos[(3 * l + k) * num + i] = vec3[k];
+            }
+            if(out.jacobian){
+                robot->getFullJacobian(out.links[l], J);
+                double* entry = out.jacobian + (6 * nqdot * l) * num + i;
+                for(int k(0); k < 6 * nqdot; ++k) entry[k * num] = J.data()[k];
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#ifndef URDF_ROBOT_BATCH
+#define URDF_ROBOT_BATCH
+
+#include "URDF_RobotSystem.hpp"
+#include <vector>
+
+// Caller buffers of URDF_RobotBatch::evaluate, structure of arrays: entry k
+// of configuration i is at [k * num + i] for num configurations. NULL
+// buffers are not computed.
+struct URDF_BatchOutput{
+    URDF_BatchOutput():
+        com_pos(NULL),
+        com_vel(NULL),
+        mass_diag(NULL),
+        grav(NULL),
+        link_pos(NULL),
+        jacobian(NULL){}
+
+    double* com_pos; // 3
+    double* com_vel; // 3
+    double* mass_diag; // qdot_size, diagonal of the mass matrix
+    double* grav; // qdot_size
+
+    std::vector<int> links; // of link_pos and jacobian, in that order
+    double* link_pos; // 3 per link
+    double* jacobian; // 6 x qdot_size per link, column major (getFullJacobian)
+};
+
+// Kinematics and dynamics of one robot at many configurations, split over
+// threads. Each thread has its own copy of the robot and of its RBDL model
+// (lazy update, only the stages the outputs need), so nothing is shared
+// but the configurations and the output buffers, which the threads write
+// in disjoint entries. The copies of a model with custom joints would
+// still share the joints, so it gets one copy, evaluated in the calling
+// thread, and the robot it is built from must not be updated meanwhile.
+class URDF_RobotBatch{
+public:
+    URDF_RobotBatch(const URDF_RobotSystem & robot, int num_thread);
+    ~URDF_RobotBatch();
+
+    // Q: q_size x num, Qdot: qdot_size x num or empty (zero velocity);
+    // column i is configuration i. false (nothing computed) when a size
+    // does not match.
+    bool evaluate(const dynacore::Matrix & Q, const dynacore::Matrix & Qdot,
+            const URDF_BatchOutput & output);
+
+    int getNumThread() const { return robot_.size(); }
+
+protected:
+    struct Work{
+        URDF_RobotBatch* batch;
+        int thread_idx;
+        int start;
+        int end;
+    };
+    friend void* _RunBatch(void* arg);
+    void _Evaluate(int thread_idx, int start, int end);
+
+    std::vector<URDF_RobotSystem*> robot_;
+
+    // of the current evaluate
+    const dynacore::Matrix* Q_;
+    const dynacore::Matrix* Qdot_;
+    const URDF_BatchOutput* output_;
+};
+
+#endif
@@ -0,0 +1,510 @@
+#include "URDF_RobotSystem.hpp"
+#include "rbdl/urdfreader.h"
+#include <stdio.h>
+
+using namespace RigidBodyDynamics;
+using namespace RigidBodyDynamics::Math;
+
+URDF_RobotSystem::URDF_RobotSystem(const URDF_RobotSetting & setting):
+    setting_(setting),
+    start_idx_(0),
+    tot_mass_(0.),
+    custom_joint_(false),
+    gen_dynamics_(NULL),
+    lazy_update_(false),
+    valid_(ALL_STAGES)
+{
+    if (!Addons::URDFReadFromFile
+            (setting_.urdf_file.c_str(), model_.model, true, false)) {
+        std::cerr << "Error loading model " << setting_.urdf_file << std::endl;
+        abort();
+    }
+    model_.link_table.initialize(model_.model);
+    for(int i(0); i < setting_.link_names.size(); ++i){
+        model_.link_table.setLink(setting_.link_names[i].first,
+                setting_.link_names[i].second.c_str());
+    }
+
+    int num_body(model_->mBodies.size());
+    start_idx_ = model_.link_table.getBodyId(setting_.root_link);
+    for(int i(start_idx_); i < num_body; ++i) tot_mass_ += model_->mBodies[i].mMass;
+    // dof k moves with the previous dof of its joint or the last one of
+    // the parent joint
+    std::vector<int> dof_parent(model_->qdot_size, -1);
+    for(int i(1); i < num_body; ++i){
+        const Joint & joint(model_->mJoints[i]);
+        int num_dof(joint.mDoFCount);
+        if(joint.mJointType == JointTypeCustom){
+            custom_joint_ = true;
+            num_dof = model_->mCustomJoints[joint.custom_joint_index]->mDoFCount;
+        }
+        unsigned int lambda = model_->lambda[i];
+        if(lambda != 0){
+            const Joint & parent(model_->mJoints[lambda]);
+            int parent_dof(parent.mDoFCount);
+            if(parent.mJointType == JointTypeCustom)
+                parent_dof = model_->mCustomJoints[parent.custom_joint_index]->mDoFCount;
+            dof_parent[joint.q_index] = parent.q_index + parent_dof - 1;
+        }
+        for(int m(1); m < num_dof; ++m) dof_parent[joint.q_index + m] = joint.q_index + m - 1;
+    }
+    A_ltl_.setTree(dof_parent);
+
+    int nqdot(model_->qdot_size);
+    q_ = dynacore::Vector::Zero(model_->q_size);
+    qdot_ = dynacore::Vector::Zero(nqdot);
+    A_ = dynacore::Matrix::Zero(nqdot, nqdot);
+    Ainv_ = dynacore::Matrix::Zero(nqdot, nqdot);
+    grav_ = dynacore::Vector::Zero(nqdot);
+    coriolis_ = dynacore::Vector::Zero(nqdot);
+
+    a_grav_.resize(num_body, SpatialVector::Zero());
+    f_grav_.resize(num_body, SpatialVector::Zero());
+    Ic_base_.resize(num_body);
+    Ag_base_ = dynacore::Matrix::Zero(6, nqdot);
+
+    com_pos_.setZero();
+    com_vel_.setZero();
+    Jcom_ = dynacore::Matrix::Zero(3, nqdot);
+    Ig_ = dynacore::Matrix::Zero(6, 6);
+    Jg_ = dynacore::Matrix::Zero(6, nqdot);
+    centroid_vel_ = dynacore::Vector::Zero(6);
+
+    // a single dof moves along a constant S, the spherical and translation
+    // joints along their body axes; jcalc does not run with the generated
+    // code, so multdof3_S is not used
+    derivative_joint_ = true;
+    S_.resize(num_body);
+    for(int i(1); i < num_body; ++i){
+        const Joint & joint(model_->mJoints[i]);
+        if(joint.mJointType != JointTypeCustom && joint.mDoFCount == 1){
+            S_[i] = model_->S[i];
+        } else if(joint.mJointType == JointTypeSpherical){
+            S_[i] = dynacore::Matrix::Zero(6, 3);
+            S_[i].topRows(3).setIdentity();
+        } else if(joint.mJointType == JointTypeTranslationXYZ){
+            S_[i] = dynacore::Matrix::Zero(6, 3);
+            S_[i].bottomRows(3).setIdentity();
+        } else {
+            derivative_joint_ = false;
+        }
+    }
+    s_base_.resize(num_body);
+    v_base_.resize(num_body, SpatialVector::Zero());
+    a_base_.resize(num_body, SpatialVector::Zero());
+    f_base_.resize(num_body, SpatialVector::Zero());
+    Ic_d_.resize(num_body, SpatialMatrix::Zero());
+    D_.resize(num_body, SpatialMatrix::Zero());
+    u_d_ = dynacore::Matrix::Zero(6, nqdot);
+    w_d_ = dynacore::Matrix::Zero(6, nqdot);
+    e_d_ = dynacore::Matrix::Zero(6, nqdot);
+
+    gen_dynamics_ = setting_.gen_dynamics;
+    if(gen_dynamics_ && !_CheckGenDynamics()){
+        printf("[%s Model] generated code of %s does not fit, using RBDL\n",
+                setting_.name.c_str(), gen_dynamics_->urdf_file);
+        gen_dynamics_ = NULL;
+    }
+
+    printf("[%s Model] Contructed\n", setting_.name.c_str());
+}
+
+URDF_RobotSystem::~URDF_RobotSystem(){}
+
+// The generated code sums the composite inertias of all bodies, the ones
+// before the root link must not carry mass.
+bool URDF_RobotSystem::_CheckGenDynamics() const {
+    if(custom_joint_ || gen_dynamics_->num_q != model_->q_size ||
+            gen_dynamics_->num_qdot != model_->qdot_size) return false;
+    for(int i(1); i < start_idx_; ++i){
+        if(model_->mBodies[i].mMass != 0.) return false;
+    }
+    return gen_dynamics_->check(*model_);
+}
+
+void URDF_RobotSystem::UpdateSystem(const dynacore::Vector & q, const dynacore::Vector & qdot){
+    q_ = q;
+    qdot_ = qdot;
+    valid_ = 0;
+    if(!lazy_update_) _Require(ALL_STAGES);
+}
+
+void URDF_RobotSystem::setLazyUpdate(bool lazy){
+    lazy_update_ = lazy;
+    if(!lazy_update_) _Require(ALL_STAGES);
+}
+
+void URDF_RobotSystem::setRotorInertia(const dynacore::Vector & rotor_inertia){
+    int nqdot(model_->qdot_size);
+    if(rotor_inertia.size() > nqdot){
+        printf("[%s Model] %d rotor inertias for %d dofs, ignored\n",
+                setting_.name.c_str(), (int)rotor_inertia.size(), nqdot);
+        return;
+    }
+    if(rotor_inertia.size() == 0){
+        rotor_inertia_.resize(0);
+        return;
+    }
+    rotor_inertia_ = dynacore::Vector::Zero(nqdot);
+    rotor_inertia_.tail(rotor_inertia.size()) = rotor_inertia;
+}
+
+void URDF_RobotSystem::getRotorInertia(dynacore::Vector & rotor_inertia) const {
+    rotor_inertia = rotor_inertia_;
+}
+
+Model* URDF_RobotSystem::getModel() const {
+    _RequireLazy(KINEMATICS | DYNAMICS);
+    return model_.model;
+}
+
+void URDF_RobotSystem::_Require(unsigned int stages) const {
+    if(stages & CENTROID) stages |= MOMENTUM;
+    // the generated code computes the momentum matrix with the mass matrix
+    if(gen_dynamics_ && (stages & MOMENTUM)) stages |= MASS_MATRIX;
+    // the inverse of the RBDL path is taken from the factor
+    if(!gen_dynamics_ && (stages & INVERSE_MASS)) stages |= MASS_FACTOR;
+    if(stages & (INVERSE_MASS | MASS_FACTOR)) stages |= MASS_MATRIX;
+    if(stages & (DYNAMICS | MASS_MATRIX | MOMENTUM)) stages |= KINEMATICS;
+
+    stages &= ~valid_;
+    if(stages & KINEMATICS) _UpdateKinematics();
+    if(stages & DYNAMICS) _UpdateDynamics();
+    if(stages & MASS_MATRIX) _UpdateMassMatrix();
+    if(stages & ~valid_ & MOMENTUM) _UpdateMomentumMatrix();
+    if(stages & MASS_FACTOR) _UpdateMassFactor();
+    if(stages & INVERSE_MASS) _UpdateInverseMassInertia();
+    if(stages & CENTROID) _UpdateCentroidFrame();
+}
+
+// Positions and velocities of the bodies as UpdateKinematicsCustom, with the
+// velocity products c the RNEA starts from.
+void URDF_RobotSystem::_UpdateKinematics() const {
+    Model & model = *model_;
+    valid_ |= KINEMATICS;
+
+    if(gen_dynamics_){
+        gen_dynamics_->kinematics(model, q_.data(), qdot_.data());
+        return;
+    }
+    if(custom_joint_){
+        UpdateKinematicsCustom(model, &q_, &qdot_, NULL);
+        return;
+    }
+
+    int num_body(model.mBodies.size());
+    model.v[0].setZero();
+
+    for(int i(1); i < num_body; ++i){
+        unsigned int lambda = model.lambda[i];
+
+        jcalc(model, i, q_, qdot_);
+        model.X_lambda[i] = model.X_J[i] * model.X_T[i];
+        if(lambda != 0){
+            model.X_base[i] = model.X_lambda[i] * model.X_base[lambda];
+        } else {
+            model.X_base[i] = model.X_lambda[i];
+        }
+
+        model.v[i] = model.X_lambda[i].apply(model.v[lambda]) + model.v_J[i];
+        model.c[i] = model.c_J[i] + crossm(model.v[i], model.v_J[i]);
+    }
+}
+
+// InverseDynamics(q, qdot, 0) and InverseDynamics(q, 0, 0) in one pass on
+// the kinematics: the gravity-only RNEA has no velocity terms, only its own
+// accelerations. model_->a keeps the accelerations with gravity, which
+// getFullJDotQdot relies on.
+void URDF_RobotSystem::_UpdateDynamics() const {
+    Model & model = *model_;
+    valid_ |= DYNAMICS;
+
+    if(gen_dynamics_){
+        gen_dynamics_->inverse_dynamics(model, grav_.data(), coriolis_.data());
+        return;
+    }
+    if(custom_joint_){
+        dynacore::Vector zero_qdot = dynacore::Vector::Zero(model.qdot_size);
+        InverseDynamics(model, q_, zero_qdot, zero_qdot, grav_);
+        InverseDynamics(model, q_, qdot_, zero_qdot, coriolis_);
+        coriolis_ -= grav_;
+        return;
+    }
+
+    int num_body(model.mBodies.size());
+    model.a[0].set(0., 0., 0., -model.gravity[0], -model.gravity[1], -model.gravity[2]);
+    a_grav_[0] = model.a[0];
+
+    for(int i(1); i < num_body; ++i){
+        unsigned int lambda = model.lambda[i];
+
+        model.a[i] = model.X_lambda[i].apply(model.a[lambda]) + model.c[i];
+        a_grav_[i] = model.X_lambda[i].apply(a_grav_[lambda]);
+
+        if(!model.mBodies[i].mIsVirtual){
+            model.f[i] = model.I[i] * model.a[i] + crossf(model.v[i], model.I[i] * model.v[i]);
+            f_grav_[i] = model.I[i] * a_grav_[i];
+        } else {
+            model.f[i].setZero();
+            f_grav_[i].setZero();
+        }
+    }
+
+    for(int i(num_body - 1); i > 0; --i){
+        unsigned int q_index = model.mJoints[i].q_index;
+        unsigned int lambda = model.lambda[i];
+
+        if(model.mJoints[i].mDoFCount == 1){
+            coriolis_[q_index] = model.S[i].dot(model.f[i]);
+            grav_[q_index] = model.S[i].dot(f_grav_[i]);
+        } else if(model.mJoints[i].mDoFCount == 3){
+            coriolis_.segment<3>(q_index) = model.multdof3_S[i].transpose() * model.f[i];
+            grav_.segment<3>(q_index) = model.multdof3_S[i].transpose() * f_grav_[i];
+        }
+
+        if(lambda != 0){
+            model.f[lambda] = model.f[lambda] + model.X_lambda[i].applyTranspose(model.f[i]);
+            f_grav_[lambda] = f_grav_[lambda] + model.X_lambda[i].applyTranspose(f_grav_[i]);
+        }
+    }
+    coriolis_ -= grav_;
+}
+
+void URDF_RobotSystem::_UpdateMassMatrix() const {
+    valid_ |= MASS_MATRIX;
+    if(gen_dynamics_){
+        gen_dynamics_->mass_matrix(*model_, A_.data(), Ag_base_.data(), I_tot_);
+        com_pos_ = I_tot_.h / tot_mass_;
+        valid_ |= MOMENTUM;
+    } else {
+        // CRBA only writes the entries of joints on a common path
+        A_.setZero();
+        CompositeRigidBodyAlgorithm(*model_, q_, A_, false);
+    }
+    // the rotors spin with their joint only, the momentum is left as it is
+    if(rotor_inertia_.size()) A_.diagonal() += rotor_inertia_;
+}
+
+// A is symmetric positive definite unless a joint moves no inertia; the
+// factor falls back to the pseudo inverse then.
+void URDF_RobotSystem::_UpdateMassFactor() const {
+    valid_ |= MASS_FACTOR;
+    A_ltl_.factorize(A_);
+}
+
+void URDF_RobotSystem::_UpdateInverseMassInertia() const {
+    valid_ |= INVERSE_MASS;
+    if(gen_dynamics_ && gen_dynamics_->inverse_mass(A_.data(), Ainv_.data())) return;
+
+    _Require(MASS_FACTOR);
+    A_ltl_.inverse(Ainv_);
+}
+
+// Momentum about the base origin: column j of Ag_base_ is the composite
+// inertia of the bodies beyond joint j (base frame) times its motion
+// subspace.
+void URDF_RobotSystem::_UpdateMomentumMatrix() const {
+    Model & model = *model_;
+    valid_ |= MOMENTUM;
+    int num_body(model.mBodies.size());
+
+    I_tot_ = SpatialRigidBodyInertia();
+    com_pos_.setZero();
+    for(int i(1); i < num_body; ++i){
+        if(i < start_idx_){
+            Ic_base_[i] = SpatialRigidBodyInertia();
+            continue;
+        }
+        Ic_base_[i] = model.X_base[i].applyTranspose(model.I[i]);
+        I_tot_ = I_tot_ + Ic_base_[i];
+        com_pos_ += model.mBodies[i].mMass * (model.X_base[i].r
+                + model.X_base[i].E.transpose() * model.mBodies[i].mCenterOfMass);
+    }
+    com_pos_ /= tot_mass_;
+
+    for(int i(num_body - 1); i > 0; --i){
+        unsigned int lambda = model.lambda[i];
+        if(lambda != 0) Ic_base_[lambda] = Ic_base_[lambda] + Ic_base_[i];
+    }
+
+    for(int i(1); i < num_body; ++i){
+        unsigned int q_index = model.mJoints[i].q_index;
+        SpatialTransform body_to_base = model.X_base[i].inverse();
+
+        if(model.mJoints[i].mJointType == JointTypeCustom){
+            unsigned int k = model.mJoints[i].custom_joint_index;
+            Ag_base_.block(0, q_index, 6, model.mCustomJoints[k]->mDoFCount) =
+                Ic_base_[i].toMatrix() * body_to_base.toMatrix() * model.mCustomJoints[k]->S;
+        } else if(model.mJoints[i].mDoFCount == 1){
+            Ag_base_.col(q_index) = Ic_base_[i] * body_to_base.apply(model.S[i]);
+        } else if(model.mJoints[i].mDoFCount == 3){
+            Ag_base_.block<6, 3>(0, q_index) =
+                Ic_base_[i].toMatrix() * body_to_base.toMatrix() * model.multdof3_S[i];
+        }
+    }
+}
+
+// The centroid frame (at the CoM, base orientation) only changes the
+// reference point of the momentum.
+void URDF_RobotSystem::_UpdateCentroidFrame() const {
+    valid_ |= CENTROID;
+    // linear momentum = total mass * CoM velocity
+    Jcom_ = Ag_base_.bottomRows(3) / tot_mass_;
+    com_vel_ = Jcom_ * qdot_;
+
+    if(!setting_.update_centroid) return;
+
+    // centroid frame -> base frame: [I 0; [com]x I]
+    Matrix3d com_skew = VectorCrossMatrix(com_pos_);
+    SpatialMatrix X_g = SpatialMatrix::Identity();
+    X_g.block<3, 3>(3, 0) = com_skew;
+
+    Ig_ = X_g.transpose() * I_tot_.toMatrix() * X_g;
+    dynacore::Matrix Ag(6, model_->qdot_size);
+    Ag.topRows(3) = Ag_base_.topRows(3) - com_skew * Ag_base_.bottomRows(3);
+    Ag.bottomRows(3) = Ag_base_.bottomRows(3);
+
+    Jg_ = Ig_.inverse() * Ag;
+    centroid_vel_ = Jg_ * qdot_;
+}
+
+bool URDF_RobotSystem::getMassInertia(dynacore::Matrix & A) const {
+    _RequireLazy(MASS_MATRIX);
+    A = A_;
+    return true;
+}
+
+bool URDF_RobotSystem::getInverseMassInertia(dynacore::Matrix & Ainv) const {
+    _RequireLazy(INVERSE_MASS);
+    Ainv = Ainv_;
+    return true;
+}
+
+bool URDF_RobotSystem::getMassInertiaFactor(dynacore::TreeLTL & A_ltl) const {
+    _RequireLazy(MASS_FACTOR);
+    A_ltl = A_ltl_;
+    return A_ltl_.isFactorized();
+}
+
+void URDF_RobotSystem::getInverseMassInertiaProduct(const dynacore::Matrix & B,
+        dynacore::Matrix & AinvB) const {
+    _RequireLazy(MASS_FACTOR);
+    A_ltl_.inverseProduct(B, AinvB);
+}
+
+void URDF_RobotSystem::getInverseMassInertiaGram(const dynacore::Matrix & J,
+        dynacore::Matrix & JAinvJt) const {
+    _RequireLazy(MASS_FACTOR);
+    A_ltl_.inverseGram(J, JAinvJt);
+}
+
+bool URDF_RobotSystem::getGravity(dynacore::Vector & grav) const {
+    _RequireLazy(DYNAMICS);
+    grav = grav_;
+    return true;
+}
+
+bool URDF_RobotSystem::getCoriolis(dynacore::Vector & coriolis) const {
+    _RequireLazy(DYNAMICS);
+    coriolis = coriolis_;
+    return true;
+}
+
+void URDF_RobotSystem::getCentroidJacobian(dynacore::Matrix & Jcent) const {
+    _RequireLazy(CENTROID);
+    Jcent = Jg_;
+}
+
+void URDF_RobotSystem::getCentroidInertia(dynacore::Matrix & Icent) const {
+    _RequireLazy(CENTROID);
+    Icent = Ig_;
+}
+
+void URDF_RobotSystem::getCentroidVelocity(dynacore::Vector & centroid_vel) const {
+    _RequireLazy(CENTROID);
+    centroid_vel = centroid_vel_;
+}
+
+void URDF_RobotSystem::getCoMPosition(dynacore::Vect3 & com_pos) const {
+    _RequireLazy(MOMENTUM);
+    com_pos = com_pos_;
+}
+
+void URDF_RobotSystem::getCoMVelocity(dynacore::Vect3 & com_vel) const {
+    _RequireLazy(CENTROID);
+    if(setting_.com_vel_from_centroid) com_vel = centroid_vel_.tail(3);
+    else com_vel = com_vel_;
+}
+
+void URDF_RobotSystem::getCoMJacobian(dynacore::Matrix & J) const {
+    _RequireLazy(CENTROID);
+    J = Jcom_;
+}
+
+void URDF_RobotSystem::getPos(int link_id, dynacore::Vect3 & pos) const {
+    _RequireLazy(KINEMATICS);
+    dynacore::Vector q;
+    pos = CalcBodyToBaseCoordinates(*model_, q, model_.link_table.getBodyId(link_id),
+            model_.link_table.getPoint(link_id), false);
+}
+
+void URDF_RobotSystem::getOri(int link_id, dynacore::Quaternion & ori) const {
+    _RequireLazy(KINEMATICS);
+    dynacore::Vector q;
+    Matrix3d R = CalcBodyWorldOrientation(*model_, q, model_.link_table.getBodyId(link_id), false);
+    ori = R.transpose();
+    if(setting_.flip_ori && ori.w() < 0.){
+        ori.w() *= (-1.);
+        ori.x() *= (-1.);
+        ori.y() *= (-1.);
+        ori.z() *= (-1.);
+    }
+}
+
+void URDF_RobotSystem::getLinearVel(int link_id, dynacore::Vect3 & vel) const {
+    _RequireLazy(KINEMATICS);
+    dynacore::Vector q, qdot;
+    vel = CalcPointVelocity(*model_, q, qdot, model_.link_table.getBodyId(link_id),
+            model_.link_table.getPoint(link_id), false);
+}
+
+void URDF_RobotSystem::getAngularVel(int link_id, dynacore::Vect3 & ang_vel) const {
+    _RequireLazy(KINEMATICS);
+    dynacore::Vector q, qdot;
+    SpatialVector vel = CalcPointVelocity6D(*model_, q, qdot, model_.link_table.getBodyId(link_id),
+            model_.link_table.getPoint(link_id), false);
+    ang_vel = vel.head(3);
+}
+
+unsigned int URDF_RobotSystem::_GetBodyPoint(int link_id, Vector3d & point) const {
+    dynacore::Vector q;
+    unsigned int body_id(model_.link_table.getBodyId(link_id));
+    point = CalcBodyToBaseCoordinates(*model_, q, body_id, model_.link_table.getPoint(link_id), false);
+    if(model_->IsFixedBodyId(body_id)){
+        body_id = model_->mFixedBodies[body_id - model_->fixed_body_discriminator].mMovableParent;
+    }
+    return body_id;
+}
+
+void URDF_RobotSystem::getFullJacobian(int link_id, dynacore::Matrix & J) const {
+    _RequireLazy(KINEMATICS);
+    dynacore::Vector q;
+    J = dynacore::Matrix::Zero(6, model_->qdot_size);
+    if(gen_dynamics_){
+        Vector3d point;
+        unsigned int body_id = _GetBodyPoint(link_id, point);
+        gen_dynamics_->jacobian(*model_, body_id, point, J.data());
+        return;
+    }
+    CalcPointJacobian6D(*model_, q, model_.link_table.getBodyId(link_id),
+            model_.link_table.getPoint(link_id), J, false);
+}
+
+// model_->a includes the base acceleration that stands for gravity
+void URDF_RobotSystem::getFullJDotQdot(int link_id, dynacore::Vector & JDotQdot) const {
+    _RequireLazy(DYNAMICS);
+    dynacore::Vector q, qdot, qddot;
+    JDotQdot = CalcPointAcceleration6D(*model_, q, qdot, qddot, model_.link_table.getBodyId(link_id),
+            model_.link_table.getPoint(link_id), false);
+    JDotQdot[5] -= setting_.gravity;
+}
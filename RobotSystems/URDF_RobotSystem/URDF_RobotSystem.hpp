@@ -0,0 +1,245 @@
+#ifndef URDF_ROBOT_SYSTEM
+#define URDF_ROBOT_SYSTEM
+
+#include <rbdl/rbdl.h>
+#include <RobotSystem.hpp>
+#include <RBDL_LinkTable.hpp>
+#include "URDF_GenDynamics.hpp"
+#include <string>
+#include <vector>
+
+// What differs between the URDF robots: the file, the names of the links the
+// controllers ask for and the conventions of the former per-robot Kin models.
+struct URDF_RobotSetting{
+    URDF_RobotSetting():
+        root_link(0),
+        flip_ori(true),
+        update_centroid(true),
+        com_vel_from_centroid(false),
+        gravity(9.81),
+        gen_dynamics(NULL){}
+
+    void addLink(int link_id, const std::string & link_name){
+        link_names.push_back(std::make_pair(link_id, link_name));
+    }
+
+    std::string name; // printed when constructed
+    std::string urdf_file;
+    std::vector<std::pair<int, std::string> > link_names;
+
+    int root_link; // the mass sums (CoM, centroid) start at its body
+    bool flip_ori; // getOri returns w >= 0
+    bool update_centroid; // centroid inertia, Jacobian and velocity
+    bool com_vel_from_centroid; // getCoMVelocity = centroid velocity (linear)
+    double gravity; // taken out of getFullJDotQdot
+
+    // code generated from the URDF (urdf_codegen), used instead of the
+    // RBDL algorithms when it matches the model
+    const URDF_GenDynamics* gen_dynamics;
+};
+
+// The RBDL model of a URDF_RobotSystem and the link table into it. A copy
+// gets its own model, with the table pointing into that one. The custom
+// joints of a model are pointers and stay shared between the copies.
+struct URDF_Model{
+    URDF_Model(): model(new RigidBodyDynamics::Model()){}
+    URDF_Model(const URDF_Model & rbdl):
+        model(new RigidBodyDynamics::Model(*rbdl.model)),
+        link_table(rbdl.link_table){
+        link_table.setModel(model);
+    }
+    ~URDF_Model(){ delete model; }
+
+    RigidBodyDynamics::Model* operator->() const { return model; }
+    RigidBodyDynamics::Model & operator*() const { return *model; }
+
+    RigidBodyDynamics::Model* model;
+    RBDL_LinkTable link_table;
+
+private:
+    URDF_Model & operator=(const URDF_Model & rbdl); // not defined
+};
+
+// RobotSystem built from a URDF (floating base). UpdateSystem does one
+// kinematics pass, gravity and Coriolis in a single RNEA on top of it, the
+// mass matrix with CRBA and the CoM / centroid quantities from composite
+// inertias in the base frame, O(n) instead of a Jacobian per body. With
+// setting.gen_dynamics the same is done by the code generated for the robot.
+//
+// The getters only read what UpdateSystem computed; UpdateSystem writes the
+// model and the cached members, so no other thread may call a getter while
+// it runs.
+//
+// In the lazy mode (URDF_RobotBatch copies) UpdateSystem only keeps q and
+// qdot; each getter computes the stages it depends on (kinematics, RNEA,
+// CRBA, ...) the first time it is called after UpdateSystem and reuses them
+// until the next one, so the getters can be called in any order. The
+// getters then write the cached state, the robot belongs to one thread.
+class URDF_RobotSystem: public RobotSystem{
+public:
+    // The implicit copy has its own RBDL model, e.g. for another thread,
+    // unless the model has custom joints (hasCustomJoint). The cached
+    // members are copied as they are, lazy or not.
+    URDF_RobotSystem(const URDF_RobotSetting & setting);
+    virtual ~URDF_RobotSystem();
+
+    virtual bool getMassInertia(dynacore::Matrix & A) const;
+    virtual bool getInverseMassInertia(dynacore::Matrix & Ainv) const;
+    virtual bool getGravity(dynacore::Vector & grav) const;
+    virtual bool getCoriolis(dynacore::Vector & coriolis) const;
+
+    virtual void getCentroidJacobian(dynacore::Matrix & Jcent) const;
+    virtual void getCentroidInertia(dynacore::Matrix & Icent) const;
+    virtual void getCoMPosition(dynacore::Vect3 & com_pos) const;
+    virtual void getCoMVelocity(dynacore::Vect3 & com_vel) const;
+
+    virtual void getPos(int link_id, dynacore::Vect3 & pos) const;
+    virtual void getOri(int link_id, dynacore::Quaternion & ori) const;
+    virtual void getLinearVel(int link_id, dynacore::Vect3 & lin_vel) const;
+    virtual void getAngularVel(int link_id, dynacore::Vect3 & ang_vel) const;
+
+    virtual void getCentroidVelocity(dynacore::Vector & centroid_vel) const;
+    virtual void getCoMJacobian(dynacore::Matrix & J) const;
+
+    virtual void getFullJacobian(int link_id, dynacore::Matrix & J) const;
+    virtual void getFullJDotQdot(int link_id, dynacore::Vector & JDotQdot) const;
+
+    virtual bool getMassInertiaFactor(dynacore::TreeLTL & A_ltl) const;
+    virtual void getRotorInertia(dynacore::Vector & rotor_inertia) const;
+    virtual void getInverseMassInertiaProduct(const dynacore::Matrix & B,
+            dynacore::Matrix & AinvB) const;
+    virtual void getInverseMassInertiaGram(const dynacore::Matrix & J,
+            dynacore::Matrix & JAinvJt) const;
+
+    virtual void UpdateSystem(const dynacore::Vector & q, const dynacore::Vector & qdot);
+
+    // Analytic derivatives at the q, qdot of the last UpdateSystem (one
+    // pass over the tree for all columns, URDF_Derivatives.cpp). Column k
+    // of a d/dq is the derivative along the motion of dof k: q (+) dq with
+    // dq in the coordinates of qdot, a rotation about the body axes for the
+    // spherical base joint. These are the columns of the Jacobians.
+    //
+    // tau = A(q) qddot + coriolis + grav
+    void getInverseDynamicsDerivatives(const dynacore::Vector & qddot,
+            dynacore::Matrix & dtau_dq, dynacore::Matrix & dtau_dqdot) const;
+    // qddot = Ainv (tau - coriolis - grav); d/dtau is Ainv
+    void getForwardDynamicsDerivatives(const dynacore::Vector & tau,
+            dynacore::Vector & qddot, dynacore::Matrix & dqddot_dq,
+            dynacore::Matrix & dqddot_dqdot) const;
+    void getGravityDerivative(dynacore::Matrix & dgrav_dq) const;
+    void getCoriolisDerivatives(dynacore::Matrix & dcori_dq,
+            dynacore::Matrix & dcori_dqdot) const;
+    // d(A(q) x)/dq
+    void getMassInertiaDerivative(const dynacore::Vector & x, dynacore::Matrix & dAx_dq) const;
+    // dJ_dq[k] = dJ/dq_k of getFullJacobian, and dJ/dt
+    void getFullJacobianDerivative(int link_id, std::vector<dynacore::Matrix> & dJ_dq) const;
+    void getFullJDot(int link_id, dynacore::Matrix & JDot) const;
+
+    // Reflected rotor inertia of the last rotor_inertia.size() dofs (the
+    // joints after the floating base), added to the diagonal of the mass
+    // matrix so its factor and inverse include it. Empty: none. It applies
+    // from the next UpdateSystem.
+    void setRotorInertia(const dynacore::Vector & rotor_inertia);
+
+    // kinematics and RNEA of the last UpdateSystem are in the model
+    RigidBodyDynamics::Model* getModel() const;
+    int getNumQ() const { return model_->q_size; }
+    int getNumQdot() const { return model_->qdot_size; }
+    bool hasCustomJoint() const { return custom_joint_; }
+
+protected:
+    URDF_RobotSystem & operator=(const URDF_RobotSystem & robot); // not defined
+
+    friend class URDF_RobotBatch;
+    // lazy: the getters compute what they need, see above
+    void setLazyUpdate(bool lazy);
+    bool isLazyUpdate() const { return lazy_update_; }
+
+    enum UpdateStage{
+        KINEMATICS = 1, // X_lambda, X_base, v, c of the model
+        DYNAMICS = 2, // gravity, Coriolis, model a and f
+        MASS_MATRIX = 4,
+        MOMENTUM = 8, // I_tot_, com_pos_, Ag_base_
+        INVERSE_MASS = 16,
+        CENTROID = 32, // Jcom_, com_vel_ and the centroid frame
+        MASS_FACTOR = 64, // A_ltl_
+        ALL_STAGES = 127
+    };
+
+    // computes the stages (and what they depend on) not valid yet
+    void _Require(unsigned int stages) const;
+    // of the getters: in the eager mode UpdateSystem computed everything
+    // and they must not write the model
+    void _RequireLazy(unsigned int stages) const {
+        if(lazy_update_) _Require(stages);
+    }
+
+    void _UpdateKinematics() const;
+    void _UpdateDynamics() const;
+    void _UpdateMassMatrix() const;
+    void _UpdateMomentumMatrix() const;
+    void _UpdateMassFactor() const;
+    void _UpdateInverseMassInertia() const;
+    void _UpdateCentroidFrame() const;
+    bool _CheckGenDynamics() const;
+
+    // dtau/dq (and dtau/dqdot) of the RNEA with qddot, with or without the
+    // velocity and gravity terms
+    bool _RNEADerivatives(const dynacore::Vector & qddot, bool velocity, bool gravity,
+            dynacore::Matrix & dtau_dq, dynacore::Matrix * dtau_dqdot) const;
+    // movable body of the link and the link point in the base frame
+    unsigned int _GetBodyPoint(int link_id, RigidBodyDynamics::Math::Vector3d & point) const;
+
+    URDF_RobotSetting setting_;
+    URDF_Model model_;
+    unsigned int start_idx_;
+    double tot_mass_;
+    bool custom_joint_; // custom joints: RBDL's own kinematics / InverseDynamics
+    const URDF_GenDynamics* gen_dynamics_;
+    bool lazy_update_;
+
+    dynacore::Vector rotor_inertia_; // qdot_size or empty
+
+    dynacore::Vector q_;
+    dynacore::Vector qdot_;
+    mutable unsigned int valid_; // UpdateStage bits computed for q_, qdot_
+
+    mutable dynacore::Matrix A_;
+    mutable dynacore::Matrix Ainv_;
+    mutable dynacore::Vector grav_;
+    mutable dynacore::Vector coriolis_;
+    mutable dynacore::TreeLTL A_ltl_; // tree of the dofs from the model
+
+    // gravity-only accelerations / forces of the RNEA
+    mutable std::vector<RigidBodyDynamics::Math::SpatialVector> a_grav_;
+    mutable std::vector<RigidBodyDynamics::Math::SpatialVector> f_grav_;
+    // composite inertias from start_idx_ on, in the base frame
+    mutable std::vector<RigidBodyDynamics::Math::SpatialRigidBodyInertia> Ic_base_;
+    mutable RigidBodyDynamics::Math::SpatialRigidBodyInertia I_tot_; // base frame
+    mutable dynacore::Matrix Ag_base_; // momentum about the base origin = Ag_base_ * qdot
+
+    mutable dynacore::Vect3 com_pos_;
+    mutable dynacore::Vect3 com_vel_;
+    mutable dynacore::Matrix Jcom_;
+    mutable dynacore::Matrix Ig_;
+    mutable dynacore::Matrix Jg_;
+    mutable dynacore::Vector centroid_vel_;
+
+    // derivatives: motion subspaces of the joints (body frame), empty when
+    // a joint does not move with its body (custom, Euler angles)
+    std::vector<dynacore::Matrix> S_;
+    bool derivative_joint_;
+    // base frame RNEA: s, v, a, subtree force, composite inertia and its
+    // velocity term per body, the column terms per dof
+    mutable std::vector<dynacore::Matrix> s_base_;
+    mutable std::vector<RigidBodyDynamics::Math::SpatialVector> v_base_;
+    mutable std::vector<RigidBodyDynamics::Math::SpatialVector> a_base_;
+    mutable std::vector<RigidBodyDynamics::Math::SpatialVector> f_base_;
+    mutable std::vector<RigidBodyDynamics::Math::SpatialMatrix> Ic_d_;
+    mutable std::vector<RigidBodyDynamics::Math::SpatialMatrix> D_;
+    mutable dynacore::Matrix u_d_;
+    mutable dynacore::Matrix w_d_;
+    mutable dynacore::Matrix e_d_;
+};
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef SIMULATION_CONFIG_H
+#define SIMULATION_CONFIG_H
+
+#define SIM_MODEL_PATH "/root/repo/Simulator/SimulationModel"
+#define SIM_DATA_PATH "/root/repo/Simulator/ResultData"
+
+#endif
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <Utils/wrap_eigen.hpp>
+#include <rbdl/rbdl.h>
+#include <stdlib.h>
+
+#ifdef PARITY_VALKYRIE
+#include <Valkyrie/Valkyrie_Model.hpp>
+#endif
+#ifdef PARITY_MERCURY
+#include <Mercury/Mercury_Model.hpp>
+#endif
+#ifdef PARITY_NAO
+#include <NAO/NAO_Model.hpp>
+#endif
+#ifdef PARITY_ATLAS
+#include <Atlas/Atlas_Model.hpp>
+#endif
+#ifdef PARITY_DRACOBIP
+#include <DracoBip/DracoBip_Model.hpp>
+#endif
+#ifdef PARITY_CHEETAH3
+#include <Cheetah3/Cheetah3_Model.hpp>
+#endif
+#ifdef PARITY_QUADRUPED
+#include <Mini_cheetah/Quadruped_Model.hpp>
+#endif
+#ifdef PARITY_SAGITP3
+#include <SagitP3/SagitP3_Model.hpp>
+#endif
+
+// getInverseDynamicsDerivatives against central differences of
+// tau = A qddot + coriolis + grav at random states, for the robots whose
+// model is part of the build (the same list as the parity test).
+
+static const int num_state = 3;
+static const double step = 1.e-5;
+static const double tolerance = 1.e-5;
+
+static double _Random(){ return 2. * rand() / RAND_MAX - 1.; }
+
+// q (+) dq along the motion of the dofs: a rotation about the body axes
+// for the spherical joints (quaternion x, y, z at q_index, w at the end)
+static dynacore::Vector _Integrate(const URDF_RobotSystem & robot,
+        const dynacore::Vector & q, const dynacore::Vector & dq){
+    RigidBodyDynamics::Model & model = *robot.getModel();
+    dynacore::Vector q_next(q);
+    q_next.head(robot.getNumQdot()) += dq;
+    for(int i(1); i < model.mJoints.size(); ++i){
+        if(model.mJoints[i].mJointType != RigidBodyDynamics::JointTypeSpherical) continue;
+        unsigned int q_index = model.mJoints[i].q_index;
+        unsigned int w_index = model.multdof3_w_index[i];
+        Eigen::Quaterniond ori(q[w_index], q[q_index], q[q_index + 1], q[q_index + 2]);
+        dynacore::Vect3 rot = dq.segment(q_index, 3);
+        double angle(rot.norm());
+        if(angle > 0.) ori = ori * Eigen::Quaterniond(Eigen::AngleAxisd(angle, rot / angle));
+        q_next.segment(q_index, 3) = ori.vec();
+        q_next[w_index] = ori.w();
+    }
+    return q_next;
+}
+
+static dynacore::Vector _Tau(URDF_RobotSystem & robot, const dynacore::Vector & q,
+        const dynacore::Vector & qdot, const dynacore::Vector & qddot){
+    dynacore::Matrix A;
+    dynacore::Vector cori, grav;
+    robot.UpdateSystem(q, qdot);
+    robot.getMassInertia(A);
+    robot.getCoriolis(cori);
+    robot.getGravity(grav);
+    return A * qddot + cori + grav;
+}
+
+static void _CheckDerivatives(URDF_RobotSystem & robot, const std::string & robot_name,
+        double tol = tolerance){
+    int nq(robot.getNumQ());
+    int nqdot(robot.getNumQdot());
+    RigidBodyDynamics::Model & model = *robot.getModel();
+    srand(0);
+
+    for(int s(0); s < num_state; ++s){
+        dynacore::Vector q(nq), qdot(nqdot), qddot(nqdot);
+        for(int i(0); i < nq; ++i) q[i] = _Random();
+        for(int i(0); i < nqdot; ++i) qdot[i] = _Random();
+        for(int i(0); i < nqdot; ++i) qddot[i] = _Random();
+        for(int i(1); i < model.mJoints.size(); ++i){
+            if(model.mJoints[i].mJointType != RigidBodyDynamics::JointTypeSpherical) continue;
+            unsigned int q_index = model.mJoints[i].q_index;
+            unsigned int w_index = model.multdof3_w_index[i];
+            Eigen::Quaterniond ori(q[w_index], q[q_index], q[q_index + 1], q[q_index + 2]);
+            ori.normalize();
+            q.segment(q_index, 3) = ori.vec();
+            q[w_index] = ori.w();
+        }
+
+        dynacore::Matrix dtau_dq, dtau_dqdot;
+        robot.UpdateSystem(q, qdot);
+        robot.getInverseDynamicsDerivatives(qddot, dtau_dq, dtau_dqdot);
+
+        dynacore::Matrix fd_dq(nqdot, nqdot), fd_dqdot(nqdot, nqdot);
+        for(int k(0); k < nqdot; ++k){
+            dynacore::Vector dq = dynacore::Vector::Zero(nqdot);
+            dq[k] = step;
+            fd_dq.col(k) = (_Tau(robot, _Integrate(robot, q, dq), qdot, qddot) -
+                    _Tau(robot, _Integrate(robot, q, -dq), qdot, qddot)) / (2. * step);
+            fd_dqdot.col(k) = (_Tau(robot, q, qdot + dq, qddot) -
+                    _Tau(robot, q, qdot - dq, qddot)) / (2. * step);
+        }
+
+        double scale = std::max(1., fd_dq.cwiseAbs().maxCoeff());
+        EXPECT_LE((dtau_dq - fd_dq).cwiseAbs().maxCoeff() / scale, tol)
+            << robot_name << " state " << s << " dtau_dq";
+        scale = std::max(1., fd_dqdot.cwiseAbs().maxCoeff());
+        EXPECT_LE((dtau_dqdot - fd_dqdot).cwiseAbs().maxCoeff() / scale, tol)
+            << robot_name << " state " << s << " dtau_dqdot";
+    }
+}
+
+#ifdef PARITY_VALKYRIE
+TEST(URDF_Derivative, Valkyrie){
+    Valkyrie_Model robot;
+    _CheckDerivatives(robot, "Valkyrie");
+}
+#endif
+
+#ifdef PARITY_MERCURY
+TEST(URDF_Derivative, Mercury){
+    Mercury_Model robot;
+    _CheckDerivatives(robot, "Mercury");
+}
+#endif
+
+// NAO has joint axes of norm 1 - 1.2e-6 (SagitP3 1 - 3.9e-5). The RBDL
+// joint transform (Xrot) of such an axis is off a rotation by that much,
+// which the analytic derivatives do not see: 3e-5 on the base force rows
+// of NAO, independent of the step.
+#ifdef PARITY_NAO
+TEST(URDF_Derivative, NAO){
+    NAO_Model robot;
+    _CheckDerivatives(robot, "NAO", 1.e-4);
+}
+#endif
+
+#ifdef PARITY_ATLAS
+TEST(URDF_Derivative, Atlas){
+    Atlas_Model robot;
+    _CheckDerivatives(robot, "Atlas");
+}
+#endif
+
+#ifdef PARITY_DRACOBIP
+TEST(URDF_Derivative, DracoBip){
+    DracoBip_Model robot;
+    _CheckDerivatives(robot, "DracoBip");
+}
+#endif
+
+#ifdef PARITY_CHEETAH3
+TEST(URDF_Derivative, Cheetah3){
+    Cheetah3_Model robot;
+    _CheckDerivatives(robot, "Cheetah3");
+}
+#endif
+
+#ifdef PARITY_QUADRUPED
+TEST(URDF_Derivative, Mini_cheetah){
+    Quadruped_Model robot;
+    _CheckDerivatives(robot, "Mini_cheetah");
+}
+#endif
+
+#ifdef PARITY_SAGITP3
+TEST(URDF_Derivative, SagitP3){
+    SagitP3_Model robot;
+    _CheckDerivatives(robot, "SagitP3", 2.e-3);
+}
+#endif
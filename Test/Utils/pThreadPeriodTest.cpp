@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <Utils/dynacore_pThread.hpp>
+
+// Runs num_period periods; the work of period slow_idx takes slow_time.
+// run() is called in the test thread, the timing is the same as in start().
+class PeriodicLoop: public dynacore_pThread{
+public:
+    PeriodicLoop(double period, int num_period, int slow_idx = -1, double slow_time = 0.):
+        dynacore_pThread(),
+        period_(period),
+        num_loop_(num_period),
+        slow_idx_(slow_idx),
+        slow_time_(slow_time),
+        num_late_(0){}
+
+    virtual void run(){
+        startPeriod(period_);
+        for(int i(0); i < num_loop_; ++i){
+            if(i == slow_idx_) usleep((useconds_t)(slow_time_ * 1.e6));
+            if(!waitNextPeriod()) ++num_late_;
+        }
+    }
+    int getNumLate() const { return num_late_; }
+
+protected:
+    double period_;
+    int num_loop_;
+    int slow_idx_;
+    double slow_time_;
+    int num_late_;
+};
+
+TEST(pThreadPeriod, Jitter){
+    PeriodicLoop loop(0.001, 500);
+    loop.run();
+    printf("[pThread] 500 x 1 ms: overrun %ld, lateness max %.1f us, average %.1f us\n",
+            loop.getNumOverrun(), loop.getMaxLateness() * 1.e6,
+            loop.getAverageLateness() * 1.e6);
+
+    EXPECT_EQ(500, loop.getNumPeriod());
+    // the loop does no work, only a loaded machine delays it
+    EXPECT_LE(loop.getNumOverrun(), 25);
+    EXPECT_GE(loop.getMaxLateness(), 0.);
+    EXPECT_LT(loop.getMaxLateness(), 0.02);
+    EXPECT_LT(loop.getAverageLateness(), 0.001);
+}
+
+TEST(pThreadPeriod, Overrun){
+    // 7 ms of work in a 2 ms period: the deadlines at +2, +4 and +6 ms are
+    // missed and skipped, the loop continues at +8 ms
+    PeriodicLoop loop(0.002, 20, 5, 0.007);
+    loop.run();
+
+    EXPECT_EQ(20, loop.getNumPeriod());
+    EXPECT_GE(loop.getNumLate(), 1);
+    EXPECT_GE(loop.getNumOverrun(), 3);
+    EXPECT_LE(loop.getNumOverrun(), 6);
+    // lateness is of the wake up after the skipped periods, not the 7 ms
+    EXPECT_LT(loop.getMaxLateness(), 0.007);
+}
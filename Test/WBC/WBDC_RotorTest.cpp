@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <Utils/wrap_eigen.hpp>
+#include <WBDC_Rotor/WBDC_Rotor.hpp>
+#include <Mercury/Mercury_Model.hpp>
+#include <Mercury/Mercury_Definition.h>
+
+// WBDC_Rotor with the rotor inertia in the A of UpdateSetting against the
+// handling it replaced: a rotor-free A for the solve, the rotor term only
+// added to cmd_ff. One fixed task set on Mercury that fully determines
+// qddot (the base held by the contact, every joint by the task), so both
+// must give the same cmd and cmd_ff.
+
+static const double tolerance = 1.e-9;
+
+class BaseContact: public WBDC_ContactSpec{
+public:
+    BaseContact(): WBDC_ContactSpec(6){
+        Jc_ = dynacore::Matrix::Zero(6, mercury::num_qdot);
+        Jc_.leftCols(6).setIdentity();
+        JcDotQdot_ = dynacore::Vector::Zero(6);
+        // Fz >= 0
+        Uf_ = dynacore::Matrix::Zero(1, 6);
+        Uf_(0, idx_Fz_) = 1.;
+        ieq_vec_ = dynacore::Vector::Zero(1);
+    }
+protected:
+    virtual bool _UpdateJc(){ return true; }
+    virtual bool _UpdateJcDotQdot(){ return true; }
+    virtual bool _UpdateUf(){ return true; }
+    virtual bool _UpdateInequalityVector(){ return true; }
+};
+
+class JointTask: public Task{
+public:
+    JointTask(): Task(mercury::num_act_joint){
+        Jt_ = dynacore::Matrix::Zero(mercury::num_act_joint, mercury::num_qdot);
+        Jt_.rightCols(mercury::num_act_joint).setIdentity();
+        JtDotQdot_ = dynacore::Vector::Zero(mercury::num_act_joint);
+    }
+protected:
+    virtual bool _UpdateCommand(void* pos_des, const dynacore::Vector & vel_des,
+            const dynacore::Vector & acc_des){
+        op_cmd_ = acc_des;
+        return true;
+    }
+    virtual bool _UpdateTaskJacobian(){ return true; }
+    virtual bool _UpdateTaskJDotQdot(){ return true; }
+    virtual bool _AdditionalUpdate(){ return true; }
+};
+
+struct RotorResult{
+    dynacore::Vector cmd;
+    dynacore::Vector cmd_ff;
+};
+
+// b_in_A: the rotor in A (current), else the old handling
+static RotorResult _Solve(const dynacore::Vector & rotor_inertia, bool b_in_A){
+    dynacore::Vector q = dynacore::Vector::Zero(mercury::num_q);
+    q[mercury::num_q - 1] = 1.;
+    for(int i(0); i < mercury::num_act_joint; ++i) q[mercury::num_virtual + i] = 0.1 * (i + 1);
+    dynacore::Vector qdot = dynacore::Vector::Zero(mercury::num_qdot);
+    for(int i(0); i < mercury::num_qdot; ++i) qdot[i] = 0.05 * (i % 4 - 1.5);
+
+    Mercury_Model robot;
+    if(b_in_A) robot.setRotorInertia(rotor_inertia.tail(mercury::num_act_joint));
+    robot.UpdateSystem(q, qdot);
+
+    dynacore::Matrix A;
+    dynacore::TreeLTL A_ltl;
+    dynacore::Vector cori, grav;
+    robot.getMassInertia(A);
+    robot.getMassInertiaFactor(A_ltl);
+    robot.getCoriolis(cori);
+    robot.getGravity(grav);
+
+    std::vector<bool> act_list(mercury::num_qdot, true);
+    for(int i(0); i < mercury::num_virtual; ++i) act_list[i] = false;
+    WBDC_Rotor wbdc(act_list);
+    WBDC_Rotor_ExtraData data;
+    data.cost_weight = dynacore::Vector::Constant(mercury::num_act_joint + 6, 1000.);
+    data.cost_weight.tail(6).setConstant(0.1);
+    if(b_in_A) data.rotor_inertia = rotor_inertia;
+    wbdc.UpdateSetting(A, A_ltl, cori, grav);
+
+    BaseContact contact;
+    JointTask task;
+    dynacore::Vector acc_des(mercury::num_act_joint);
+    for(int i(0); i < mercury::num_act_joint; ++i) acc_des[i] = 2. - 0.7 * i;
+    task.UpdateTask(NULL, dynacore::Vector::Zero(mercury::num_act_joint), acc_des);
+    std::vector<Task*> task_list(1, &task);
+    std::vector<ContactSpec*> contact_list(1, &contact);
+
+    RotorResult result;
+    wbdc.MakeTorque(task_list, contact_list, result.cmd, &data);
+    EXPECT_TRUE(data.b_qp_converged_);
+    result.cmd_ff = data.cmd_ff;
+    // the old cmd_ff: (A + A_rotor) qddot + cori + grav - Jc^T Fr
+    if(!b_in_A)
+        result.cmd_ff += rotor_inertia.cwiseProduct(data.result_qddot_).tail(mercury::num_act_joint);
+    return result;
+}
+
+static void _Compare(const dynacore::Vector & rotor_inertia, double tol){
+    RotorResult prev = _Solve(rotor_inertia, false);
+    RotorResult cur = _Solve(rotor_inertia, true);
+    ASSERT_EQ(prev.cmd.size(), cur.cmd.size());
+    ASSERT_EQ(prev.cmd_ff.size(), cur.cmd_ff.size());
+    double scale = std::max(1., prev.cmd_ff.cwiseAbs().maxCoeff());
+    EXPECT_LE((cur.cmd - prev.cmd).cwiseAbs().maxCoeff() / scale, tol);
+    EXPECT_LE((cur.cmd_ff - prev.cmd_ff).cwiseAbs().maxCoeff() / scale, tol);
+}
+
+TEST(WBDC_Rotor, ZeroRotorInertia){
+    _Compare(dynacore::Vector::Zero(mercury::num_qdot), 0.);
+}
+
+TEST(WBDC_Rotor, RotorInertia){
+    dynacore::Vector rotor_inertia = dynacore::Vector::Zero(mercury::num_qdot);
+    for(int i(0); i < mercury::num_act_joint; ++i)
+        rotor_inertia[mercury::num_virtual + i] = 0.01 * (i + 1);
+    _Compare(rotor_inertia, tolerance);
+}
@@ -78,32 +78,55 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
     return true;
   }
 
-	bool getCurveDerPoint(double u, int d, double * ret){
+  bool getCurveDerPoint(double u, int d, double * ret){
     if (d > DEGREE)  return 0.0;
 
-    if( u < Knots_[0])
-      u = Knots_[0];
-    else if ( u > Knots_[NumKnots_-1]){
-      u = Knots_[NumKnots_-1];
-    }
+    _ClampParam(u);
 
-    double** _CK = new double* [d + 1];
-    for(int i(0); i<d+1; ++i){
-      _CK[i] = new double[DIM];
-    }
+    double _CK[DEGREE + 1][DIM];
     if(_CurveDerivsAlg1V(_CK, u, d)){
       for(int m(0); m<DIM; ++m)  ret[m] = _CK[d][m];
-
-      for(int p(0); p < d+1; ++p) delete [] _CK[p];
-      SP_SAFE_DELETE_AR(_CK);
       return true;
-    } else {
-      for(int p(0); p < d+1; ++p) delete [] _CK[p];
-      SP_SAFE_DELETE_AR(_CK);
     }
     return false;
   }
 
+  // Position, velocity and acceleration from a single span search and
+  // basis function evaluation (acc is zero when DEGREE < 2)
+  bool getCurvePosVelAcc(double u, double * pos, double * vel, double * acc){
+    _ClampParam(u);
+
+    int _span;
+    if (!_findSpan(_span, u))  return false;
+
+    _EvalPosVelAcc(_span, u, pos, vel, acc);
+    return true;
+  }
+
+  // Batched evaluation for trajectory previews. Outputs are row-major
+  // [num][DIM]; vel and acc may be NULL. Sorted u reuses the previous span
+  // instead of searching again.
+  bool getCurvePoints(const double * u, int num, double * pos,
+                      double * vel = NULL, double * acc = NULL){
+    double _vel[DIM];
+    double _acc[DIM];
+    int _span(-1);
+
+    for(int i(0); i<num; ++i){
+      double _u(u[i]);
+      _ClampParam(_u);
+
+      if(_span < 0 || _u < Knots_[_span] || _u >= Knots_[_span + 1] ||
+         SP_IS_EQUAL(_u, Knots_[NumKnots_-1])){
+        if (!_findSpan(_span, _u))  return false;
+      }
+      _EvalPosVelAcc(_span, _u, pos + i*DIM,
+                     vel ? vel + i*DIM : _vel,
+                     acc ? acc + i*DIM : _acc);
+    }
+    return true;
+  }
+
  protected:
   inline void _CalcKnot(double Tf) {
     int _i(0);
@@ -127,38 +150,58 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
   }
 
 
-  bool _CurveDerivsAlg1V( double ** CK, double u, int d ) {
-    assert(d <= DEGREE);
-
-    int _k(0);
-    int _j(0);
-
-    double** _nders = new double* [d+1];
+  inline void _ClampParam(double & u){
+    if( u < Knots_[0])
+      u = Knots_[0];
+    else if ( u > Knots_[NumKnots_-1]){
+      u = Knots_[NumKnots_-1];
+    }
+  }
 
-    for (_k = 0; _k < d+1; ++_k)
-      _nders[_k] = new double[DEGREE + 1];
+  bool _CurveDerivsAlg1V( double CK[][DIM], double u, int d ) {
+    assert(d <= DEGREE);
 
     int _span;
     if (!_findSpan(_span, u))   return false;
 
+    double _nders[DEGREE + 1][DEGREE + 1];
     _BasisFunsDers(_nders, _span, u, d);
 
-    for (_k = 0; _k <= d; ++_k) {
+    for (int _k(0); _k <= d; ++_k) {
       // Clean Up Column
       for (int m(0); m <DIM; ++m) CK[_k][m] = 0.;
 
-      for (_j = 0; _j <= DEGREE; ++_j) {
+      for (int _j(0); _j <= DEGREE; ++_j) {
         for (int m(0); m < DIM; ++m ){
           CK[_k][m] += _nders[_k][_j]*CPoints_[ _span - DEGREE+_j][m];
         }
       }
     }
-    for (_k = 0; _k < d+1; ++_k)    delete [] _nders[_k];
-    delete [] _nders;
-
     return true;
   }
-  bool _BasisFunsDers(double** ders, double u, int n ) {
+
+  inline void _EvalPosVelAcc(int span, double u,
+                             double * pos, double * vel, double * acc){
+    const int _n(DEGREE < 2 ? DEGREE : 2);
+    double _nders[DEGREE + 1][DEGREE + 1];
+    _BasisFunsDers(_nders, span, u, _n);
+
+    for (int m(0); m < DIM; ++m){
+      pos[m] = 0.;
+      vel[m] = 0.;
+      acc[m] = 0.;
+    }
+    const double (*_cp)[DIM] = CPoints_ + (span - DEGREE);
+    for (int _j(0); _j <= DEGREE; ++_j){
+      for (int m(0); m < DIM; ++m)  pos[m] += _nders[0][_j] * _cp[_j][m];
+      if (_n > 0)
+        for (int m(0); m < DIM; ++m)  vel[m] += _nders[1][_j] * _cp[_j][m];
+      if (_n > 1)
+        for (int m(0); m < DIM; ++m)  acc[m] += _nders[2][_j] * _cp[_j][m];
+    }
+  }
+
+  bool _BasisFunsDers(double ders[][DEGREE + 1], double u, int n ) {
     //int _span = FindSpan(u);
     int _span;
     if(!_findSpan(_span,u)) return false;
@@ -167,7 +210,8 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
     return true;
   }
 
-  bool _BasisFunsDers( double** ders, int span, double u, int n ) {
+  bool _BasisFunsDers( double ders[][DEGREE + 1], int span, double u, int n ) {
+    assert(n <= DEGREE);
     int _j, _r, _k;
     int _s1, _s2;
     int _j1, _j2;
@@ -181,13 +225,10 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
     double _d = 0.0;
 
     // to store the basis functions and knot differences
-    double** _ndu = new double*[DEGREE + 1];
-    for (_j = 0; _j <= DEGREE; ++_j)
-      _ndu[_j] = new double[DEGREE + 1];
+    double _ndu[DEGREE + 1][DEGREE + 1];
     // to store (in an alternating fashion) the two most recently computed
     // rows a(k,j) and a(k-1,j)
-    double** _a = new double*[2];
-    for (_j = 0; _j < 2; ++_j)  _a[_j] = new double[DEGREE + 1];
+    double _a[2][DEGREE + 1];
 
     _ndu[0][0] = 1.0;
     for (_j = 1; _j <= DEGREE; ++_j) {
@@ -261,13 +302,6 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
       _r *= (DEGREE - _k);
     }
 
-    // Deallocate
-    for (_j = 0; _j <= DEGREE; ++_j)    delete[] _ndu[_j];
-    delete[] _ndu;
-
-    for (_j = 0; _j < 2; ++_j)		delete[] _a[_j];
-    delete[] _a;
-    
     return true;
   }
 
@@ -350,11 +384,7 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
       CPoints_[NumCPs_ -1][m] = fin[m];
     }
     // Initial Constraints
-    double** d_mat = new double* [CONST_LEVEL_INI + 1];
-
-    for(int i(0); i< CONST_LEVEL_INI + 1; ++i)
-      d_mat[i] = new double[CONST_LEVEL_INI + 2];
-
+    double d_mat[DEGREE + 1][DEGREE + 1];
     _BasisFunsDers(d_mat, 0., CONST_LEVEL_INI);
 
     double ini_const[DIM];
@@ -371,15 +401,8 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
       }
     }
 
-    for(int p(0); p < CONST_LEVEL_INI + 1; ++p) delete [] d_mat[p];
-    SP_SAFE_DELETE_AR (d_mat);
-
     // Final Constraints
-    double ** c_mat = new double*[CONST_LEVEL_FIN + 1];
-
-    for(int i(0); i< CONST_LEVEL_FIN + 1; ++i)
-      c_mat[i] = new double[CONST_LEVEL_FIN + 2];
-
+    double c_mat[DEGREE + 1][DEGREE + 1];
     _BasisFunsDers(c_mat, Tf, CONST_LEVEL_FIN);
 
     // Vel, Acc, ...
@@ -396,8 +419,6 @@ template<int DIM, int DEGREE, int NUM_MIDDLE, int CONST_LEVEL_INI, int CONST_LEV
       }
       ++idx;
     }
-    for(int p(0); p < CONST_LEVEL_FIN + 1; ++p) delete [] c_mat[p];
-    SP_SAFE_DELETE_AR(c_mat);
   }
 
   void _PrintCP(int i){
@@ -115,6 +115,7 @@ void DataManager::run(){
 
     double* data = new double[tot_num_array_data_];
 
+    startPeriod(0.005);
     while (true){
         // Generate Sending Message
         int st_idx(0);
@@ -126,7 +127,7 @@ void DataManager::run(){
         COMM::send_data(socket2_, PORT_DATA_RECEIVE, data, 
                 data_setup.tot_num_array_data * sizeof(double), IP_ADDR);
 
-        usleep(5000);
+        waitNextPeriod();
     }
 
     delete [] data;
@@ -1,6 +1,8 @@
 #include "LQR.hpp"
 #include <Eigen/Eigenvalues>
 #include <iostream>
+#include <algorithm>
+#include <stdio.h>
 
 using namespace std;
 
@@ -43,7 +45,7 @@ namespace dynacore{
                     ++col_num;
                 }
             } else {
-                if( ((es.eigenvalues()[i]).real())*( (es.eigenvalues()[i]).real()) < 1.0){
+                if( std::abs(es.eigenvalues()[i]) < 1.0){
                     V.col(col_num) = es.eigenvectors().col(i);
                     ++col_num;
                 }
@@ -56,4 +58,209 @@ namespace dynacore{
         Eigen::MatrixXcd Stmp = V.block(n, 0, n, n) * (V.block(0, 0, n, n)).inverse();
         S = Stmp.real();
     }
+
+    // X = F' X F + W by doubling: X += F' X F, F = F F
+    static bool _SolveStein(const Matrix & F, const Matrix & W, Matrix & X, double tol){
+        Matrix Fk = F;
+        Matrix FX, dX, FF;
+        X = W;
+        for(int i(0); i<64; ++i){
+            FX.noalias() = Fk.transpose() * X;
+            dX.noalias() = FX * Fk;
+            X += dX;
+            if(dX.norm() <= tol * X.norm()) return true;
+            FF.noalias() = Fk * Fk;
+            Fk.swap(FF);
+            // F is not Schur stable
+            if(!Fk.allFinite() || Fk.norm() > 1.e12) return false;
+        }
+        return false;
+    }
+
+    // Ac'X + X Ac + W = 0 through the Cayley transform:
+    // X = Ad' X Ad + 2p M^-T W M^-1, Ad = M^-1 (pI + Ac), M = pI - Ac
+    static bool _SolveLyapunov(const Matrix & Ac, const Matrix & W, Matrix & X, double tol){
+        int n = Ac.rows();
+        double p = std::max(Ac.norm() / sqrt((double)n), 1.e-6);
+        Matrix I = Matrix::Identity(n, n);
+        Eigen::PartialPivLU<Matrix> M(p * I - Ac);
+        Matrix Ad = M.solve(p * I + Ac);
+        Matrix MinvT = M.solve(I).transpose();
+        Matrix Wd = 2. * p * MinvT * W * MinvT.transpose();
+        return _SolveStein(Ad, Wd, X, tol);
+    }
+
+    static bool _Converged(const Matrix & S_new, const Matrix & S_old, double tol){
+        return (S_new - S_old).norm() <= tol * std::max(1., S_new.norm());
+    }
+
+    void LQRGain(const Matrix & A,
+                 const Matrix & B,
+                 const Matrix & R,
+                 const Matrix & S,
+                 Matrix & K, bool descrete){
+        if(!descrete){
+            K = R.ldlt().solve(B.transpose() * S);
+        } else {
+            Matrix BtS = B.transpose() * S;
+            Matrix RBSB = R + BtS * B;
+            K = RBSB.ldlt().solve(BtS * A);
+        }
+    }
+
+    bool SolveDARE(const Matrix & A,
+                   const Matrix & B,
+                   const Matrix & Q,
+                   const Matrix & R,
+                   Matrix & S, bool warm_start,
+                   double tol, int max_iter){
+        int n = A.rows();
+        Matrix X;
+        if(warm_start){
+            // Hewer: K from S, then S = Ac' S Ac + Q + K'RK
+            X = S;
+            Matrix K, Ac, W, res;
+            for(int iter(0); iter<max_iter; ++iter){
+                LQRGain(A, B, R, X, K, true);
+                // residual A'SA - S + Q - A'SB K
+                Matrix XA = X * A;
+                res = A.transpose() * XA - X + Q - (B.transpose() * XA).transpose() * K;
+                if(res.norm() <= tol * std::max(1., X.norm())){
+                    S = 0.5 * (X + X.transpose());
+                    return true;
+                }
+                Ac = A - B * K;
+                W = Q + K.transpose() * R * K;
+                if(!_SolveStein(Ac, W, X, tol)) return false;
+            }
+            return false;
+        }
+
+        // Structure-preserving doubling
+        Matrix Ak = A;
+        Matrix G = B * R.ldlt().solve(B.transpose());
+        Matrix H = Q;
+        Matrix I = Matrix::Identity(n, n);
+        Matrix WA, WG, H_new;
+        for(int iter(0); iter<max_iter; ++iter){
+            Eigen::PartialPivLU<Matrix> W(I + G * H);
+            WA = W.solve(Ak);
+            WG = W.solve(G);
+            H_new = H + Ak.transpose() * H * WA;
+            G += Ak * WG * Ak.transpose();
+            Ak = Ak * WA;
+            bool converged = _Converged(H_new, H, tol);
+            H.swap(H_new);
+            if(!H.allFinite()) return false;
+            if(converged){
+                S = 0.5 * (H + H.transpose());
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool SolveCARE(const Matrix & A,
+                   const Matrix & B,
+                   const Matrix & Q,
+                   const Matrix & R,
+                   Matrix & S, bool warm_start,
+                   double tol, int max_iter){
+        Matrix X;
+        if(warm_start) X = S;
+        else LQR(A, B, Q, R, X, false);
+
+        // Newton-Kleinman: K from S, then Ac'S + S Ac + Q + K'RK = 0
+        Matrix K, Ac, W, res;
+        for(int iter(0); iter<max_iter; ++iter){
+            LQRGain(A, B, R, X, K, false);
+            // residual A'S + SA + Q - SB K
+            res = A.transpose() * X;
+            res += res.transpose().eval();
+            res += Q - (X * B) * K;
+            if(res.norm() <= tol * std::max(1., X.norm())){
+                S = 0.5 * (X + X.transpose());
+                return true;
+            }
+            Ac = A - B * K;
+            W = Q + K.transpose() * R * K;
+            if(!_SolveLyapunov(Ac, W, X, tol)) return false;
+        }
+        return false;
+    }
+
+    LQRGainSchedule::LQRGainSchedule(bool descrete):descrete_(descrete){}
+    LQRGainSchedule::~LQRGainSchedule(){}
+
+    void LQRGainSchedule::setCost(const Matrix & Q, const Matrix & R){
+        Q_ = Q;
+        R_ = R;
+        points_.clear();
+    }
+
+    bool LQRGainSchedule::addOperatingPoint(double key, const Matrix & A, const Matrix & B){
+        OperatingPoint pt;
+        pt.key = key;
+        int idx = _FindNearest(key);
+        bool solved(false);
+        if(idx >= 0){
+            pt.S = points_[idx].S;
+            solved = _Solve(A, B, pt.S, true);
+        }
+        if(!solved) solved = _Solve(A, B, pt.S, false);
+        if(!solved){
+            printf("[LQR Gain Schedule] Riccati solver failed at %f\n", key);
+            return false;
+        }
+        LQRGain(A, B, R_, pt.S, pt.K, descrete_);
+
+        std::vector<OperatingPoint>::iterator it = points_.begin();
+        while(it != points_.end() && it->key < key) ++it;
+        if(it != points_.end() && it->key == key) *it = pt;
+        else points_.insert(it, pt);
+        return true;
+    }
+
+    bool LQRGainSchedule::getGain(double key, Matrix & K) const{
+        if(points_.empty()) return false;
+        if(key <= points_.front().key){ K = points_.front().K; return true; }
+        if(key >= points_.back().key){ K = points_.back().K; return true; }
+
+        int i(1);
+        while(points_[i].key < key) ++i;
+        const OperatingPoint & lo = points_[i - 1];
+        const OperatingPoint & hi = points_[i];
+        double alpha = (key - lo.key) / (hi.key - lo.key);
+        K = (1. - alpha) * lo.K + alpha * hi.K;
+        return true;
+    }
+
+    bool LQRGainSchedule::solve(double key, const Matrix & A, const Matrix & B,
+                                Matrix & K, Matrix & S) const{
+        int idx = _FindNearest(key);
+        bool solved(false);
+        if(idx >= 0){
+            S = points_[idx].S;
+            solved = _Solve(A, B, S, true);
+        }
+        if(!solved) solved = _Solve(A, B, S, false);
+        if(solved) LQRGain(A, B, R_, S, K, descrete_);
+        return solved;
+    }
+
+    int LQRGainSchedule::_FindNearest(double key) const{
+        int idx(-1);
+        double dist(0.);
+        for(int i(0); i<(int)points_.size(); ++i){
+            double d = fabs(points_[i].key - key);
+            if(idx < 0 || d < dist){ idx = i; dist = d; }
+        }
+        return idx;
+    }
+
+    bool LQRGainSchedule::_Solve(const Matrix & A, const Matrix & B,
+                                 Matrix & S, bool warm_start) const{
+        if(descrete_) return SolveDARE(A, B, Q_, R_, S, warm_start);
+        return SolveCARE(A, B, Q_, R_, S, warm_start);
+    }
 }
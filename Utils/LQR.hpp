@@ -4,12 +4,79 @@
 #include "wrap_eigen.hpp"
 
 namespace dynacore{
+    // Riccati solution from the eigenvectors of the Hamiltonian (continuous)
+    // or symplectic (discrete, needs A invertible) matrix
     void LQR(const Matrix & A,
              const Matrix & B,
              const Matrix & Q,
              const Matrix & R,
              Matrix & S,
              bool descrete = false);
+
+    // Iterative Riccati solvers. With warm_start, S holds the initial guess
+    // (e.g. the solution of a nearby problem) and has to give a stabilizing
+    // gain; the iteration is then Newton-Kleinman (continuous) or Hewer
+    // (discrete), a few steps when the guess is close. Without it the
+    // discrete solver uses the doubling algorithm and the continuous one
+    // starts from LQR(). Returns false (S unchanged) when not converged.
+    bool SolveDARE(const Matrix & A,
+                   const Matrix & B,
+                   const Matrix & Q,
+                   const Matrix & R,
+                   Matrix & S,
+                   bool warm_start = false,
+                   double tol = 1.e-10,
+                   int max_iter = 50);
+    bool SolveCARE(const Matrix & A,
+                   const Matrix & B,
+                   const Matrix & Q,
+                   const Matrix & R,
+                   Matrix & S,
+                   bool warm_start = false,
+                   double tol = 1.e-10,
+                   int max_iter = 50);
+
+    // u = -K x
+    // discrete: K = (R + B'SB)^-1 B'SA, continuous: K = R^-1 B'S
+    void LQRGain(const Matrix & A,
+                 const Matrix & B,
+                 const Matrix & R,
+                 const Matrix & S,
+                 Matrix & K,
+                 bool descrete = false);
+
+    // Gains precomputed at scalar operating points (e.g. CoM height) and
+    // linearly interpolated in between, clamped outside of the range. Q and
+    // R are shared by all the points; a problem re-linearized online is
+    // warm-started from the closest cached solution.
+    class LQRGainSchedule{
+    public:
+        LQRGainSchedule(bool descrete = true);
+        ~LQRGainSchedule();
+
+        void setCost(const Matrix & Q, const Matrix & R);
+        bool addOperatingPoint(double key, const Matrix & A, const Matrix & B);
+        void clear(){ points_.clear(); }
+        int getNumPoints() const { return points_.size(); }
+
+        bool getGain(double key, Matrix & K) const;
+        bool solve(double key, const Matrix & A, const Matrix & B,
+                   Matrix & K, Matrix & S) const;
+
+    protected:
+        struct OperatingPoint{
+            double key;
+            Matrix S;
+            Matrix K;
+        };
+        bool descrete_;
+        Matrix Q_;
+        Matrix R_;
+        std::vector<OperatingPoint> points_; // sorted by key
+
+        int _FindNearest(double key) const;
+        bool _Solve(const Matrix & A, const Matrix & B, Matrix & S, bool warm_start) const;
+    };
 }
 
 #endif
@@ -0,0 +1,78 @@
+#ifndef SEQLOCK_DATA
+#define SEQLOCK_DATA
+
+#include <atomic>
+#include <stdint.h>
+#include <Eigen/Core>
+
+namespace dynacore{
+// Publishes a value from one writer thread to any number of reader threads
+// (e.g. MoCap/UDP receiver thread -> 1 kHz control thread).
+//
+// Two copies are kept. The writer always fills the copy that readers are
+// not pointed at, so a read only has to retry when the writer completes
+// two updates while the reader is copying. Neither side takes a lock or
+// allocates. T should be a fixed-size (trivially copyable) type.
+template <typename T>
+class SeqLockData{
+public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    SeqLockData(): seq_(0){
+        buffer_seq_[0].store(0, std::memory_order_relaxed);
+        buffer_seq_[1].store(0, std::memory_order_relaxed);
+    }
+    explicit SeqLockData(const T & init): seq_(0){
+        buffer_[0] = init;
+        buffer_[1] = init;
+        buffer_seq_[0].store(0, std::memory_order_relaxed);
+        buffer_seq_[1].store(0, std::memory_order_relaxed);
+    }
+
+    // Writer side (single writer)
+    void write(const T & data){
+        uint64_t next = seq_.load(std::memory_order_relaxed) + 1;
+        int idx = next & 1;
+        uint64_t bseq = buffer_seq_[idx].load(std::memory_order_relaxed);
+
+        buffer_seq_[idx].store(bseq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        buffer_[idx] = data;
+        buffer_seq_[idx].store(bseq + 2, std::memory_order_release);
+
+        seq_.store(next, std::memory_order_release);
+    }
+
+    // Reader side: copy of the latest complete value.
+    // Returns the number of writes so far (0: never written)
+    uint64_t read(T & data) const {
+        while(true){
+            uint64_t seq = seq_.load(std::memory_order_acquire);
+            int idx = seq & 1;
+            uint64_t bseq = buffer_seq_[idx].load(std::memory_order_acquire);
+            if(bseq & 1) continue;
+
+            data = buffer_[idx];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(buffer_seq_[idx].load(std::memory_order_relaxed) == bseq) return seq;
+        }
+    }
+
+    // Copies the value only when it was written after 'last_seq'
+    // (updated to the version that was read)
+    bool readNew(T & data, uint64_t & last_seq) const {
+        if(seq_.load(std::memory_order_acquire) == last_seq) return false;
+        last_seq = read(data);
+        return true;
+    }
+
+    uint64_t getVersion() const { return seq_.load(std::memory_order_acquire); }
+
+private:
+    T buffer_[2];
+    std::atomic<uint64_t> buffer_seq_[2];
+    std::atomic<uint64_t> seq_;
+};
+}
+
+#endif
@@ -0,0 +1,338 @@
+#include "comm_udp.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <stdexcept>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <climits>
+#endif
+
+#define SHM_RING_MAGIC 0x44594e41u
+#define SHM_RING_LENGTH 16
+#define SHM_MIN_SLOT_SIZE 4096
+#define SHM_MAX_HANDLE 64
+#define SHM_SPIN_COUNT 2000
+#define SHM_MAX_NAME 64
+// how long an opener waits for the creator to size and initialize a segment
+#define SHM_INIT_TIMEOUT_US 1000000
+
+namespace COMM{
+    // Layout of the mapped segment: one header followed by SHM_RING_LENGTH
+    // slots of slot_size bytes. The k-th message (k >= 1) lives in slot
+    // (k-1) % SHM_RING_LENGTH, and its slot sequence is 2k once it is
+    // complete (2k-1 while the writer is copying).
+    struct ShmSlot{
+        std::atomic<uint64_t> seq;
+        uint32_t size;
+        uint32_t pad;
+        // followed by slot_size bytes of payload
+    };
+
+    struct ShmHeader{
+        std::atomic<uint32_t> magic;
+        uint32_t slot_size;
+        std::atomic<uint64_t> write_seq;
+        // futex word: bumped on each publish, readers sleep on it
+        std::atomic<uint32_t> wake_word;
+        std::atomic<uint32_t> num_sleeper;
+        // set by a writer that unlinks the segment (exit, larger slots);
+        // its readers then open the new segment of the name
+        std::atomic<uint32_t> closed;
+    };
+
+    struct ShmHandle{
+        ShmHeader* header;
+        size_t map_size;
+        uint64_t read_seq;
+        bool b_writer;
+        char name[SHM_MAX_NAME];
+    };
+
+    static ShmHandle shm_handle_list[SHM_MAX_HANDLE];
+    static int num_shm_handle(0);
+    static std::mutex shm_open_mutex;
+
+    static Transport _InitialTransport(){
+        const char* env = getenv("DYNACORE_COMM");
+        if(env && strcmp(env, "shm") == 0) return SHM_TRANSPORT;
+        return UDP_TRANSPORT;
+    }
+    static std::atomic<int> selected_transport(_InitialTransport());
+
+    void set_transport(Transport transport){ selected_transport = transport; }
+    Transport get_transport(){ return (Transport)selected_transport.load(); }
+
+    static size_t _SlotStride(uint32_t slot_size){
+        return sizeof(ShmSlot) + slot_size;
+    }
+    static ShmSlot* _GetSlot(ShmHeader* header, uint64_t msg_seq){
+        char* base = (char*)header + sizeof(ShmHeader);
+        return (ShmSlot*)(base + ((msg_seq - 1) % SHM_RING_LENGTH) *
+                _SlotStride(header->slot_size));
+    }
+
+    static void _Wake(ShmHeader* header){
+        header->wake_word.fetch_add(1, std::memory_order_release);
+        // Only pay for the syscall when somebody is actually sleeping
+        if(header->num_sleeper.load(std::memory_order_seq_cst) > 0){
+#ifdef __linux__
+            syscall(SYS_futex, (uint32_t*)&header->wake_word,
+                    FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+        }
+    }
+
+    static void _Sleep(ShmHeader* header, uint64_t read_seq){
+        header->num_sleeper.fetch_add(1, std::memory_order_seq_cst);
+        uint32_t word = header->wake_word.load(std::memory_order_acquire);
+        if(header->write_seq.load(std::memory_order_acquire) <= read_seq &&
+                !header->closed.load(std::memory_order_acquire)){
+#ifdef __linux__
+            syscall(SYS_futex, (uint32_t*)&header->wake_word,
+                    FUTEX_WAIT, word, NULL, NULL, 0);
+#else
+            (void)word;
+            usleep(100);
+#endif
+        }
+        header->num_sleeper.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    // Maps the segment of shm_name, creating it if it does not exist. A
+    // segment whose creator died before initializing it is removed and
+    // created again, and so is one with too small slots opened by a writer.
+    static ShmHeader* _MapRing(const char* shm_name, int data_size, bool b_writer,
+            size_t & map_size){
+        uint32_t slot_size = (data_size > SHM_MIN_SLOT_SIZE) ? data_size : SHM_MIN_SLOT_SIZE;
+        slot_size = (slot_size + 63) & ~63u;
+
+        while(true){
+            map_size = sizeof(ShmHeader) + SHM_RING_LENGTH * _SlotStride(slot_size);
+            bool b_creator(true);
+            int fd = shm_open(shm_name, O_RDWR | O_CREAT | O_EXCL, 0666);
+            if(fd < 0 && errno == EEXIST){
+                b_creator = false;
+                fd = shm_open(shm_name, O_RDWR, 0666);
+                // removed in between
+                if(fd < 0 && errno == ENOENT) continue;
+            }
+            if(fd < 0){
+                perror("[SHM] shm_open");
+                throw std::runtime_error("[SHM] fail to open shared memory\n");
+            }
+
+            if(b_creator){
+                if(ftruncate(fd, map_size) < 0){
+                    perror("[SHM] ftruncate");
+                    close(fd);
+                    shm_unlink(shm_name);
+                    throw std::runtime_error("[SHM] fail to size shared memory\n");
+                }
+            }else{
+                // Wait until the creator has sized the segment
+                struct stat st;
+                int wait_time(0);
+                while(fstat(fd, &st) == 0 && st.st_size < (off_t)sizeof(ShmHeader) &&
+                        wait_time < SHM_INIT_TIMEOUT_US){
+                    usleep(100);
+                    wait_time += 100;
+                }
+                if(st.st_size < (off_t)sizeof(ShmHeader)){
+                    printf("[SHM] %s was never sized by its creator, creating it again\n", shm_name);
+                    close(fd);
+                    shm_unlink(shm_name);
+                    continue;
+                }
+                map_size = st.st_size;
+            }
+            void* addr = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            if(addr == MAP_FAILED){
+                perror("[SHM] mmap");
+                throw std::runtime_error("[SHM] fail to map shared memory\n");
+            }
+
+            ShmHeader* header = (ShmHeader*)addr;
+            if(b_creator){
+                header->slot_size = slot_size;
+                header->write_seq.store(0, std::memory_order_relaxed);
+                header->wake_word.store(0, std::memory_order_relaxed);
+                header->num_sleeper.store(0, std::memory_order_relaxed);
+                header->closed.store(0, std::memory_order_relaxed);
+                for(uint64_t k(1); k <= SHM_RING_LENGTH; ++k){
+                    _GetSlot(header, k)->seq.store(0, std::memory_order_relaxed);
+                }
+                header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+                return header;
+            }
+
+            int wait_time(0);
+            while(header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC &&
+                    wait_time < SHM_INIT_TIMEOUT_US){
+                usleep(100);
+                wait_time += 100;
+            }
+            if(header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC){
+                printf("[SHM] %s was never initialized by its creator, creating it again\n", shm_name);
+                munmap(addr, map_size);
+                shm_unlink(shm_name);
+                continue;
+            }
+            if(header->closed.load(std::memory_order_acquire)){
+                // being removed by its writer
+                munmap(addr, map_size);
+                usleep(100);
+                continue;
+            }
+            if((int)header->slot_size < data_size){
+                if(b_writer){
+                    printf("[SHM] %s: message size %i exceeds slot size %u, creating it again\n",
+                            shm_name, data_size, header->slot_size);
+                    shm_unlink(shm_name);
+                    header->closed.store(1, std::memory_order_release);
+                    _Wake(header);
+                    munmap(addr, map_size);
+                    continue;
+                }
+                printf("[SHM] %s: message size %i exceeds slot size %u\n",
+                        shm_name, data_size, header->slot_size);
+            }
+            return header;
+        }
+    }
+
+    // A writer that exits normally closes its rings, so the readers move to
+    // the segment of the next writer and nothing is left in /dev/shm. After
+    // a crash the segment stays; the next writer continues its sequence.
+    static void _CloseWriterRings(){
+        std::lock_guard<std::mutex> lock(shm_open_mutex);
+        for(int i(0); i < num_shm_handle; ++i){
+            ShmHandle & hdl = shm_handle_list[i];
+            if(!hdl.b_writer || hdl.header->closed.load()) continue;
+            // unlinked first, the woken readers must not find it again
+            shm_unlink(hdl.name);
+            hdl.header->closed.store(1, std::memory_order_release);
+            _Wake(hdl.header);
+        }
+    }
+
+    static int _OpenRing(const char* shm_name, int data_size, bool b_writer){
+        std::lock_guard<std::mutex> lock(shm_open_mutex);
+        if(num_shm_handle >= SHM_MAX_HANDLE){
+            std::cerr<<"[SHM] too many shared memory handles"<<std::endl;
+            throw std::runtime_error("[SHM] too many shared memory handles\n");
+        }
+        ShmHandle & handle = shm_handle_list[num_shm_handle];
+        handle.header = _MapRing(shm_name, data_size, b_writer, handle.map_size);
+        handle.b_writer = b_writer;
+        strncpy(handle.name, shm_name, SHM_MAX_NAME - 1);
+        handle.name[SHM_MAX_NAME - 1] = '\0';
+        // A new reader starts after the messages already in the ring: they
+        // may be from an earlier run that left the segment behind
+        handle.read_seq = handle.header->write_seq.load(std::memory_order_acquire);
+
+        static bool b_exit_registered(false);
+        if(b_writer && !b_exit_registered){
+            atexit(_CloseWriterRings);
+            b_exit_registered = true;
+        }
+        ++num_shm_handle;
+        return num_shm_handle;
+    }
+
+    // The writer of the reader's segment has closed it: map the new one.
+    // Everything in it was written after the close, so it is read from the start.
+    static void _ReopenRing(ShmHandle & hdl, int data_size){
+        std::lock_guard<std::mutex> lock(shm_open_mutex);
+        munmap(hdl.header, hdl.map_size);
+        hdl.header = _MapRing(hdl.name, data_size, false, hdl.map_size);
+        hdl.read_seq = 0;
+    }
+
+    void send_data_shm(int & handle, const char* shm_name, void* data, int data_size){
+        if(handle == 0){ handle = _OpenRing(shm_name, data_size, true); }
+        ShmHeader* header = shm_handle_list[handle - 1].header;
+        if(data_size > (int)header->slot_size){
+            printf("[SHM] %s: message size %i exceeds slot size %u\n",
+                    shm_name, data_size, header->slot_size);
+            return;
+        }
+        uint64_t msg_seq = header->write_seq.load(std::memory_order_relaxed) + 1;
+        ShmSlot* slot = _GetSlot(header, msg_seq);
+
+        slot->seq.store(2*msg_seq - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot->size = data_size;
+        memcpy((char*)slot + sizeof(ShmSlot), data, data_size);
+        slot->seq.store(2*msg_seq, std::memory_order_release);
+
+        header->write_seq.store(msg_seq, std::memory_order_release);
+        _Wake(header);
+    }
+
+    void receive_data_shm(int & handle, const char* shm_name, void* data, int data_size){
+        if(handle == 0){ handle = _OpenRing(shm_name, data_size, false); }
+        ShmHandle & hdl = shm_handle_list[handle - 1];
+
+        while(true){
+            ShmHeader* header = hdl.header;
+            uint64_t write_seq = header->write_seq.load(std::memory_order_acquire);
+            int spin(0);
+            bool b_closed(false);
+            while(write_seq <= hdl.read_seq){
+                if(header->closed.load(std::memory_order_acquire)){
+                    b_closed = true;
+                    break;
+                }
+                if(++spin > SHM_SPIN_COUNT){
+                    _Sleep(header, hdl.read_seq);
+                    spin = 0;
+                }
+                write_seq = header->write_seq.load(std::memory_order_acquire);
+            }
+            if(b_closed){
+                _ReopenRing(hdl, data_size);
+                continue;
+            }
+            // Too slow: the oldest messages have been overwritten
+            if(write_seq - hdl.read_seq > SHM_RING_LENGTH - 1){
+                hdl.read_seq = write_seq - (SHM_RING_LENGTH - 1);
+            }
+            uint64_t msg_seq = hdl.read_seq + 1;
+            ShmSlot* slot = _GetSlot(header, msg_seq);
+
+            uint64_t seq_before = slot->seq.load(std::memory_order_acquire);
+            if(seq_before != 2*msg_seq){
+                // overwritten while we were catching up
+                hdl.read_seq = msg_seq;
+                continue;
+            }
+            int size = slot->size;
+            if(size > data_size) size = data_size;
+            memcpy(data, (char*)slot + sizeof(ShmSlot), size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t seq_after = slot->seq.load(std::memory_order_relaxed);
+
+            hdl.read_seq = msg_seq;
+            if(seq_after == seq_before) return;
+        }
+    }
+
+    void remove_data_shm(const char* shm_name){
+        shm_unlink(shm_name);
+    }
+}
@@ -12,7 +12,21 @@
 #include <iostream>
 namespace COMM{
 
+    static bool _UseShm(const char* ip_addr){
+        return (get_transport() == SHM_TRANSPORT) &&
+            (strncmp(ip_addr, "127.", 4) == 0);
+    }
+    static void _ShmName(int port, char* shm_name, int len){
+        snprintf(shm_name, len, "/dynacore_%d", port);
+    }
+
     void send_data(int & _socket, int port, void* data, int data_size, const char* ip_addr){
+        if(_UseShm(ip_addr)){
+            char shm_name[32];
+            _ShmName(port, shm_name, 32);
+            send_data_shm(_socket, shm_name, data, data_size);
+            return;
+        }
         int slen;
         if(_socket == 0){
             // printf("[Send Data] Open Socket\n");
@@ -39,6 +53,12 @@ namespace COMM{
     void receive_data(int & _socket, int port, void* data, int data_size, const char* ip_addr){
 	struct sockaddr_in si_me, so; 
 
+        if(_UseShm(ip_addr)){
+            char shm_name[32];
+            _ShmName(port, shm_name, 32);
+            receive_data_shm(_socket, shm_name, data, data_size);
+            return;
+        }
         if(_socket == 0){
             // printf("[Recieve Data] Open Socket\n");
             if ((_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) <= -1){
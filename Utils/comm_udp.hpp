@@ -4,12 +4,35 @@
 #include <string>
 
 namespace COMM{
+    // UDP_TRANSPORT: every message goes through a datagram socket
+    // SHM_TRANSPORT: messages to/from a loopback address go through a
+    //                POSIX shared memory ring named after the port
+    //                (other addresses keep using UDP)
+    enum Transport{
+        UDP_TRANSPORT,
+        SHM_TRANSPORT
+    };
+    // Default is taken from the DYNACORE_COMM environment variable
+    // ("shm" or "udp"), UDP when it is not set.
+    void set_transport(Transport transport);
+    Transport get_transport();
+
+    // When SHM_TRANSPORT is selected for a loopback address, 'socket' holds
+    // the shared memory handle instead of a file descriptor
     void receive_data(int &socket, int port, void* data, int data_size, const char* ip_addr);
     void send_data(int &socket, int port, void * data, int data_size, const char* ip_addr);
 //    void check_send_socket(int* socket, int* ret_socket);
 
     void receive_data_unix(const char* server_name, void* data, int data_size);
     void send_data_unix   (const char* server_name, void* data, int data_size);
+
+    // Shared memory ring (one writer, any number of readers).
+    // 'handle' must be 0 on the first call and is kept by the caller.
+    // Readers never block the writer: a reader that falls more than
+    // a ring length behind skips to the oldest message still available.
+    void receive_data_shm(int &handle, const char* shm_name, void* data, int data_size);
+    void send_data_shm   (int &handle, const char* shm_name, void* data, int data_size);
+    void remove_data_shm (const char* shm_name);
 }
 
 #endif
@@ -1,15 +1,45 @@
 #include "dynacore_pThread.hpp"
+#include <string.h>
+#include <errno.h>
+#include <alloca.h>
+#include <sys/mman.h>
+
+#define NSEC_PER_SEC 1000000000L
+
+dynacore_pThreadOption dynacore_pThread::default_thread_option_;
+
+void dynacore_pThread::setDefaultThreadOption(const dynacore_pThreadOption & option)
+{
+    default_thread_option_ = option;
+}
 
 dynacore_pThread::dynacore_pThread() :
     sejong_thread(),
     firstLoopFlag(false),
-    isRunning(false)
-{}
+    isRunning(false),
+    thread_option_(default_thread_option_),
+    period_ns_(0)
+{
+    next_period_.tv_sec = 0;
+    next_period_.tv_nsec = 0;
+    _ResetStat();
+}
+
+void dynacore_pThread::_ResetStat()
+{
+    period_stat_.num_overrun = 0;
+    period_stat_.num_period = 0;
+    period_stat_.max_lateness = 0.;
+    period_stat_.sum_lateness = 0.;
+    published_stat_.write(period_stat_);
+}
 
 dynacore_pThread::~dynacore_pThread()
 {
-    pthread_cancel(sejong_thread);
-    pthread_join(sejong_thread, NULL);
+    if(isRunning){
+        pthread_cancel(sejong_thread);
+        pthread_join(sejong_thread, NULL);
+    }
 }
 void dynacore_pThread::terminate()
 {
@@ -21,8 +51,26 @@ bool dynacore_pThread::isFirstLoop()
     return firstLoopFlag;
 }
 
+void dynacore_pThread::_PrepareThread()
+{
+    if(thread_option_.b_lock_memory){
+        if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0){
+            printf("[Thread] mlockall failed: %s\n", strerror(errno));
+        }
+    }
+    if(thread_option_.prefault_stack_size > 0){
+        // Touch the stack once so that page faults do not happen in the loop
+        volatile unsigned char* stack_mem =
+            (volatile unsigned char*)alloca(thread_option_.prefault_stack_size);
+        for(size_t i(0); i < thread_option_.prefault_stack_size; i += 4096){
+            stack_mem[i] = 0;
+        }
+    }
+}
+
 void *runThread(void * arg)
 {
+    ((dynacore_pThread*) arg)->_PrepareThread();
     ((dynacore_pThread*) arg)->run();
     return NULL;
 }
@@ -38,7 +86,38 @@ void dynacore_pThread::start()
         sigemptyset(&sigset);
         sigaddset(&sigset, SIGINT);
         pthread_sigmask(SIG_BLOCK, &sigset, &oldset);
-        pthread_create(&sejong_thread, NULL, runThread, this);
+
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if(thread_option_.stack_size > 0){
+            pthread_attr_setstacksize(&attr, thread_option_.stack_size);
+        }
+        if(thread_option_.sched_policy != SCHED_OTHER){
+            struct sched_param param;
+            param.sched_priority = thread_option_.priority;
+            pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+            pthread_attr_setschedpolicy(&attr, thread_option_.sched_policy);
+            pthread_attr_setschedparam(&attr, &param);
+        }
+#ifdef __linux__
+        if(!thread_option_.cpu_list.empty()){
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            for(size_t i(0); i < thread_option_.cpu_list.size(); ++i){
+                CPU_SET(thread_option_.cpu_list[i], &cpu_set);
+            }
+            pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpu_set);
+        }
+#endif
+        int ret = pthread_create(&sejong_thread, &attr, runThread, this);
+        if(ret != 0){
+            // e.g. EPERM for real-time policy without privilege
+            printf("[Thread] fail to apply thread option (%s), start with default\n",
+                    strerror(ret));
+            pthread_create(&sejong_thread, NULL, runThread, this);
+        }
+        pthread_attr_destroy(&attr);
+
         struct sigaction s;
         s.sa_handler = sigint;
         sigemptyset(&s.sa_mask);
@@ -50,3 +129,55 @@ void dynacore_pThread::start()
     }
 }
 
+void dynacore_pThread::startPeriod(double period)
+{
+    period_ns_ = (long)(period * NSEC_PER_SEC);
+    _ResetStat();
+    clock_gettime(CLOCK_MONOTONIC, &next_period_);
+}
+
+static void _AddNanoSec(struct timespec & ts, long nsec)
+{
+    ts.tv_nsec += nsec;
+    while(ts.tv_nsec >= NSEC_PER_SEC){
+        ts.tv_nsec -= NSEC_PER_SEC;
+        ++ts.tv_sec;
+    }
+}
+
+static double _TimeDiff(const struct timespec & a, const struct timespec & b)
+{
+    return (a.tv_sec - b.tv_sec) + (a.tv_nsec - b.tv_nsec)/(double)NSEC_PER_SEC;
+}
+
+bool dynacore_pThread::waitNextPeriod()
+{
+    bool b_on_time(true);
+    _AddNanoSec(next_period_, period_ns_);
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if(_TimeDiff(now, next_period_) > 0.){
+        // Deadline already passed: skip the missed periods
+        b_on_time = false;
+        while(_TimeDiff(now, next_period_) > 0.){
+            _AddNanoSec(next_period_, period_ns_);
+            ++period_stat_.num_overrun;
+        }
+    }
+#ifdef __linux__
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next_period_, NULL) == EINTR){}
+#else
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double remain = _TimeDiff(next_period_, now);
+    if(remain > 0.) usleep((useconds_t)(remain * 1.e6));
+#endif
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double lateness = _TimeDiff(now, next_period_);
+    if(lateness > period_stat_.max_lateness) period_stat_.max_lateness = lateness;
+    period_stat_.sum_lateness += lateness;
+    ++period_stat_.num_period;
+    published_stat_.write(period_stat_);
+
+    return b_on_time;
+}
@@ -6,25 +6,91 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
- 
+#include <time.h>
+#include <vector>
+#include <Utils/SeqLockData.hpp>
+
+// Thread attributes applied in dynacore_pThread::start().
+// Failures (e.g. no permission for SCHED_FIFO) are reported and the thread
+// still starts with the default attributes.
+struct dynacore_pThreadOption{
+    dynacore_pThreadOption():
+        sched_policy(SCHED_OTHER),
+        priority(0),
+        stack_size(0),
+        prefault_stack_size(0),
+        b_lock_memory(false){}
+
+    int sched_policy; // SCHED_OTHER, SCHED_FIFO, SCHED_RR
+    int priority;     // ignored for SCHED_OTHER
+    std::vector<int> cpu_list; // empty: any core
+    size_t stack_size; // 0: default
+    size_t prefault_stack_size; // touched before run() (0: none)
+    bool b_lock_memory; // mlockall(MCL_CURRENT | MCL_FUTURE)
+};
+
 class dynacore_pThread{
 protected:
     pthread_t sejong_thread;
     bool firstLoopFlag;
     bool isRunning;
 
+    dynacore_pThreadOption thread_option_;
+    static dynacore_pThreadOption default_thread_option_;
+
+    // Periodic execution (clock_nanosleep with TIMER_ABSTIME)
+    struct PeriodStat{
+        long num_overrun;
+        long num_period;
+        double max_lateness; // (sec)
+        double sum_lateness; // (sec)
+    };
+    struct timespec next_period_;
+    long period_ns_;
+    // Updated by this thread, published for the getters of other threads
+    PeriodStat period_stat_;
+    dynacore::SeqLockData<PeriodStat> published_stat_;
 
     void terminate();
     bool isFirstLoop();
+    // memory locking and stack prefaulting (called in the new thread)
+    void _PrepareThread();
+    friend void *runThread(void * arg);
+
+    void startPeriod(double period);
+    // Sleep until the next period. Returns false when a deadline was missed;
+    // the missed periods are skipped (counted in num_overrun).
+    bool waitNextPeriod();
 
 public:
     dynacore_pThread();
     virtual ~dynacore_pThread(void);
     virtual void run(void) = 0;
 
+    void setThreadOption(const dynacore_pThreadOption & option){ thread_option_ = option; }
+    // Option given to threads constructed afterwards
+    static void setDefaultThreadOption(const dynacore_pThreadOption & option);
     void start();
+
+    // Any thread
+    long getNumOverrun() const { return _ReadStat().num_overrun; }
+    long getNumPeriod() const { return _ReadStat().num_period; }
+    double getMaxLateness() const { return _ReadStat().max_lateness; }
+    double getAverageLateness() const {
+        PeriodStat stat = _ReadStat();
+        return (stat.num_period > 0) ? stat.sum_lateness/stat.num_period : 0.;
+    }
+
+private:
+    void _ResetStat();
+    PeriodStat _ReadStat() const {
+        PeriodStat stat;
+        published_stat_.read(stat);
+        return stat;
+    }
 };
 void *runData(void * arg);
+void *runThread(void * arg);
 void sigint(int signo);
 
 
@@ -0,0 +1,120 @@
+#include "tree_ltl.hpp"
+#include "pseudo_inverse.hpp"
+#include <math.h>
+
+namespace dynacore{
+    TreeLTL::TreeLTL(): factorized_(false){}
+
+    TreeLTL::~TreeLTL(){}
+
+    void TreeLTL::setTree(const std::vector<int> & parent){
+        parent_ = parent;
+        L_ = Matrix::Zero(parent_.size(), parent_.size());
+        factorized_ = false;
+    }
+
+    void TreeLTL::setChain(int n){
+        std::vector<int> parent(n);
+        for(int k(0); k < n; ++k) parent[k] = k - 1;
+        setTree(parent);
+    }
+
+    // Featherstone, Rigid Body Dynamics Algorithms, 6.5. RBDL's
+    // SparseFactorizeLTL is the same on Model::lambda_q, which only follows
+    // the tree for serial chains.
+    bool TreeLTL::factorize(const Matrix & A){
+        int n(parent_.size());
+        factorized_ = false;
+        if(A.rows() != n || A.cols() != n){
+            pseudoInverse(A, 1.e-10, Ainv_, 0);
+            return false;
+        }
+
+        for(int k(0); k < n; ++k){
+            L_(k, k) = A(k, k);
+            for(int i(parent_[k]); i >= 0; i = parent_[i]) L_(k, i) = A(k, i);
+        }
+
+        for(int k(n - 1); k >= 0; --k){
+            if(!(L_(k, k) > 1.e-10)){
+                pseudoInverse(A, 1.e-10, Ainv_, 0);
+                return false;
+            }
+            L_(k, k) = sqrt(L_(k, k));
+            for(int i(parent_[k]); i >= 0; i = parent_[i]) L_(k, i) /= L_(k, k);
+            for(int i(parent_[k]); i >= 0; i = parent_[i]){
+                for(int j(i); j >= 0; j = parent_[j]) L_(i, j) -= L_(k, i) * L_(k, j);
+            }
+        }
+        factorized_ = true;
+        return true;
+    }
+
+    void TreeLTL::solveL(Matrix & X) const {
+        Matrix Xt(X.transpose());
+        _SolveLRight(Xt);
+        X = Xt.transpose();
+    }
+
+    void TreeLTL::solveLT(Matrix & X) const {
+        Matrix Xt(X.transpose());
+        _SolveLTRight(Xt);
+        X = Xt.transpose();
+    }
+
+    // The solves on X^T: a dof is a column, so every update is an axpy over
+    // the right hand sides.
+    void TreeLTL::_SolveLRight(Matrix & Xt) const {
+        int n(parent_.size());
+        for(int i(0); i < n; ++i){
+            for(int j(parent_[i]); j >= 0; j = parent_[j]) Xt.col(i) -= L_(i, j) * Xt.col(j);
+            Xt.col(i) /= L_(i, i);
+        }
+    }
+
+    void TreeLTL::_SolveLTRight(Matrix & Xt) const {
+        int n(parent_.size());
+        for(int i(n - 1); i >= 0; --i){
+            Xt.col(i) /= L_(i, i);
+            for(int j(parent_[i]); j >= 0; j = parent_[j]) Xt.col(j) -= L_(i, j) * Xt.col(i);
+        }
+    }
+
+    void TreeLTL::inverseProduct(const Matrix & B, Matrix & AinvB) const {
+        if(!factorized_){
+            AinvB = Ainv_ * B;
+            return;
+        }
+        Matrix Bt(B.transpose());
+        _SolveLTRight(Bt);
+        _SolveLRight(Bt);
+        AinvB = Bt.transpose();
+    }
+
+    void TreeLTL::inverseGram(const Matrix & J, Matrix & JAinvJt) const {
+        if(!factorized_){
+            JAinvJt = J * Ainv_ * J.transpose();
+            return;
+        }
+        Matrix Y(J);
+        _SolveLTRight(Y);
+        JAinvJt = Y * Y.transpose();
+    }
+
+    void TreeLTL::inverseGram(const Matrix & J, Matrix & JAinvJt, Matrix & AinvJt) const {
+        if(!factorized_){
+            AinvJt = Ainv_ * J.transpose();
+            JAinvJt = J * AinvJt;
+            return;
+        }
+        Matrix Y(J);
+        _SolveLTRight(Y);
+        JAinvJt = Y * Y.transpose();
+        _SolveLRight(Y);
+        AinvJt = Y.transpose();
+    }
+
+    void TreeLTL::inverse(Matrix & Ainv) const {
+        inverseProduct(Matrix::Identity(parent_.size(), parent_.size()), Ainv);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef TREE_LTL_HPP
+#define TREE_LTL_HPP
+
+#include "wrap_eigen.hpp"
+#include <vector>
+
+namespace dynacore{
+    // A = L^T L of a joint space mass matrix (Featherstone's LTL). With the
+    // dofs numbered from the root, L(i, j) can only be nonzero when j is i
+    // or one of its ancestors in the kinematic tree, so the factorization
+    // and the triangular solves only walk the ancestor chains; for branched
+    // robots this is a fraction of a dense Cholesky. The products with Ainv
+    // are two sparse solves and Ainv itself is never formed.
+    //
+    // If A can not be factorized (a joint moves no inertia) the pseudo
+    // inverse of A is used by the same calls.
+    class TreeLTL{
+    public:
+        TreeLTL();
+        ~TreeLTL();
+
+        // parent[k] < k is the dof the k-th one moves with, -1 at the root
+        void setTree(const std::vector<int> & parent);
+        // parent[k] = k - 1: a dense factorization, fits any matrix
+        void setChain(int n);
+
+        // only the entries of A the tree allows are read
+        bool factorize(const Matrix & A);
+
+        bool isFactorized() const { return factorized_; }
+        int size() const { return parent_.size(); }
+        const std::vector<int> & getTree() const { return parent_; }
+        const Matrix & getL() const { return L_; }
+
+        // X = L^-1 X and X = L^-T X
+        void solveL(Matrix & X) const;
+        void solveLT(Matrix & X) const;
+
+        // Ainv * B
+        void inverseProduct(const Matrix & B, Matrix & AinvB) const;
+        // J * Ainv * J^T, and Ainv * J^T in the same pass
+        void inverseGram(const Matrix & J, Matrix & JAinvJt) const;
+        void inverseGram(const Matrix & J, Matrix & JAinvJt, Matrix & AinvJt) const;
+        void inverse(Matrix & Ainv) const;
+
+    protected:
+        void _SolveLRight(Matrix & Xt) const;
+        void _SolveLTRight(Matrix & Xt) const;
+
+        std::vector<int> parent_;
+        Matrix L_;
+        Matrix Ainv_; // pseudo inverse when not factorized
+        bool factorized_;
+    };
+}
+
+#endif
@@ -0,0 +1,147 @@
+#include "CWC_Cache.hpp"
+#include <Geometry/Polyhedron/Polyhedron.h>
+#include <stdio.h>
+#include <stdexcept>
+
+CWC_Cache* CWC_Cache::getCache(){
+    static CWC_Cache cache;
+    return &cache;
+}
+
+const dynacore::Matrix & CWC_Cache::getCone(const std::vector<dynacore::Vect3> & points,
+        double mu, int num_edge){
+    std::vector<double> key;
+    _MakeKey(points, mu, num_edge, key);
+    std::map<std::vector<double>, dynacore::Matrix>::iterator it = cone_.find(key);
+    if(it != cone_.end()) return it->second;
+
+    dynacore::Matrix U;
+    if(!_ComputeCone(points, mu, num_edge, U)){
+        throw std::runtime_error("[CWC Cache] no contact wrench cone for the given surface");
+    }
+    dynacore::Matrix & cone = cone_[key];
+    cone.swap(U);
+    return cone;
+}
+
+const dynacore::Matrix & CWC_Cache::getRectangleCone(double x, double y, double mu){
+    std::vector<dynacore::Vect3> points(4);
+    points[0] << x, y, 0.;
+    points[1] << -x, y, 0.;
+    points[2] << -x, -y, 0.;
+    points[3] << x, -y, 0.;
+
+    std::vector<double> key;
+    _MakeKey(points, mu, 4, key);
+    std::map<std::vector<double>, dynacore::Matrix>::iterator it = cone_.find(key);
+    if(it != cone_.end()) return it->second;
+
+    dynacore::Matrix U;
+    if(!_ComputeCone(points, mu, 4, U)){
+        printf("[CWC Cache] analytic cone of the %g x %g rectangle\n", 2. * x, 2. * y);
+        _ComputeRectangleCone(x, y, mu, U);
+    }
+    dynacore::Matrix & cone = cone_[key];
+    cone.swap(U);
+    return cone;
+}
+
+void CWC_Cache::rotateCone(const dynacore::Matrix & U, const dynacore::Quaternion & ori,
+        dynacore::Matrix & Uf){
+    Eigen::Matrix3d R(ori);
+    Uf.resize(U.rows(), 6);
+    Uf.leftCols(3).noalias() = U.leftCols(3) * R.transpose();
+    Uf.rightCols(3).noalias() = U.rightCols(3) * R.transpose();
+}
+
+void CWC_Cache::_MakeKey(const std::vector<dynacore::Vect3> & points,
+        double mu, int num_edge, std::vector<double> & key){
+    key.clear();
+    key.push_back(mu);
+    key.push_back(num_edge);
+    for(int i(0); i < points.size(); ++i){
+        for(int k(0); k < 3; ++k) key.push_back(points[i][k]);
+    }
+}
+
+bool CWC_Cache::_ComputeCone(const std::vector<dynacore::Vect3> & points,
+        double mu, int num_edge, dynacore::Matrix & U){
+    // generators: rays [p x f; f] of the pyramid edges f at the points
+    double r(mu / cos(M_PI / num_edge));
+    Eigen::MatrixXd A_vrep(points.size() * num_edge, 6);
+    Eigen::VectorXd b_vrep = Eigen::VectorXd::Zero(A_vrep.rows());
+    dynacore::Vect3 f;
+    for(int i(0); i < points.size(); ++i){
+        for(int j(0); j < num_edge; ++j){
+            double theta(M_PI * (2. * j + 1.) / num_edge);
+            f << r * cos(theta), r * sin(theta), 1.;
+            A_vrep.block<1, 3>(i * num_edge + j, 0) = points[i].cross(f).transpose();
+            A_vrep.block<1, 3>(i * num_edge + j, 3) = f.transpose();
+        }
+    }
+
+    std::pair<Eigen::MatrixXd, Eigen::VectorXd> hrep;
+    try{
+        Polyhedron poly;
+        hrep = poly.hrep(A_vrep, b_vrep);
+    } catch(std::exception & e){
+        printf("[CWC Cache] %s\n", e.what());
+        return false;
+    }
+
+    // A w <= 0 -> -A w >= 0, without the trivial rows (0 <= 1 of the apex)
+    U.resize(hrep.first.rows(), 6);
+    int num_row(0);
+    for(int i(0); i < hrep.first.rows(); ++i){
+        double norm(hrep.first.row(i).norm());
+        if(norm < 1.e-9) continue;
+        U.row(num_row++) = -hrep.first.row(i) / norm;
+    }
+    U.conservativeResize(num_row, 6);
+    return num_row > 0;
+}
+
+void CWC_Cache::_ComputeRectangleCone(double x, double y, double mu, dynacore::Matrix & U){
+    // [tau; f]: fz >= 0, friction, CoP in the rectangle and the tau_z bounds
+    U = dynacore::Matrix::Zero(17, 6);
+
+    U(0, 5) = 1.;
+
+    U(1, 3) = 1.; U(1, 5) = mu;
+    U(2, 3) = -1.; U(2, 5) = mu;
+
+    U(3, 4) = 1.; U(3, 5) = mu;
+    U(4, 4) = -1.; U(4, 5) = mu;
+
+    U(5, 0) = 1.; U(5, 5) = y;
+    U(6, 0) = -1.; U(6, 5) = y;
+
+    U(7, 1) = 1.; U(7, 5) = x;
+    U(8, 1) = -1.; U(8, 5) = x;
+
+    U(9, 0) = -mu; U(9, 1) = -mu; U(9, 2) = 1;
+    U(9, 3) = y;   U(9, 4) = x;   U(9, 5) = (x + y)*mu;
+
+    U(10, 0) = -mu; U(10, 1) = mu; U(10, 2) = 1;
+    U(10, 3) = y;   U(10, 4) = -x; U(10, 5) = (x + y)*mu;
+
+    U(11, 0) = mu; U(11, 1) = -mu; U(11, 2) = 1;
+    U(11, 3) = -y; U(11, 4) = x;   U(11, 5) = (x + y)*mu;
+
+    U(12, 0) = mu; U(12, 1) = mu; U(12, 2) = 1;
+    U(12, 3) = -y; U(12, 4) = -x; U(12, 5) = (x + y)*mu;
+
+    U(13, 0) = -mu; U(13, 1) = -mu; U(13, 2) = -1;
+    U(13, 3) = -y;  U(13, 4) = -x;  U(13, 5) = (x + y)*mu;
+
+    U(14, 0) = -mu; U(14, 1) = mu; U(14, 2) = -1;
+    U(14, 3) = -y;  U(14, 4) = x;  U(14, 5) = (x + y)*mu;
+
+    U(15, 0) = mu; U(15, 1) = -mu; U(15, 2) = -1;
+    U(15, 3) = y;  U(15, 4) = -x;  U(15, 5) = (x + y)*mu;
+
+    U(16, 0) = mu; U(16, 1) = mu; U(16, 2) = -1;
+    U(16, 3) = y;  U(16, 4) = x;  U(16, 5) = (x + y)*mu;
+
+    for(int i(0); i < U.rows(); ++i) U.row(i).normalize();
+}
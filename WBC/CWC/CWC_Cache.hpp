@@ -0,0 +1,52 @@
+#ifndef CONTACT_WRENCH_CONE_CACHE
+#define CONTACT_WRENCH_CONE_CACHE
+
+#include <Utils/wrap_eigen.hpp>
+#include <map>
+#include <vector>
+
+// Contact wrench cones of surface contacts: U w >= 0 for the wrench
+// w = [tau; f] at the contact frame origin. The cone is spanned by the
+// wrenches of the friction pyramid edges at the vertices of the surface and
+// is converted to inequalities (cdd, Polyhedron::hrep) the first time a
+// geometry and friction coefficient is asked for; the cached cone is only
+// rotated into the world frame afterwards.
+//
+// The pyramid has num_edge faces tangent to the friction cone, for four
+// |fx| <= mu fz and |fy| <= mu fz.
+//
+// A cone cdd cannot compute is not cached: getCone throws
+// std::runtime_error, getRectangleCone falls back to the analytic pyramid
+// of the rectangle (mu, x, y faces and the 8 tau_z faces).
+class CWC_Cache{
+    public:
+        static CWC_Cache* getCache();
+
+        // points: vertices of the contact surface in the contact frame, z
+        // along the normal. Rows of unit norm.
+        const dynacore::Matrix & getCone(const std::vector<dynacore::Vect3> & points,
+                double mu, int num_edge = 4);
+        // rectangle 2x by 2y centered at the contact frame origin
+        const dynacore::Matrix & getRectangleCone(double x, double y, double mu);
+
+        // Uf = U diag(R^T, R^T): the cone U of the contact frame for world
+        // frame wrenches, R the orientation of the contact frame
+        static void rotateCone(const dynacore::Matrix & U, const dynacore::Quaternion & ori,
+                dynacore::Matrix & Uf);
+
+        int getNumCone() const { return cone_.size(); }
+
+    private:
+        CWC_Cache(){}
+        // false if cdd fails
+        bool _ComputeCone(const std::vector<dynacore::Vect3> & points,
+                double mu, int num_edge, dynacore::Matrix & U);
+        void _ComputeRectangleCone(double x, double y, double mu, dynacore::Matrix & U);
+        static void _MakeKey(const std::vector<dynacore::Vect3> & points,
+                double mu, int num_edge, std::vector<double> & key);
+
+        // key: mu, num_edge and the points
+        std::map<std::vector<double>, dynacore::Matrix> cone_;
+};
+
+#endif
@@ -0,0 +1,249 @@
+#include "QP_ADMM.hpp"
+#include <Utils/Clock.hpp>
+#include <limits>
+#include <vector>
+
+QP_ADMM::QP_ADMM():
+    sigma_(1.e-6),
+    alpha_(1.6),
+    rho_(0.1),
+    eps_abs_(1.e-5),
+    eps_rel_(1.e-5),
+    time_budget_(0.),
+    max_iter_(4000),
+    check_interval_(10),
+    warm_start_(true),
+    converged_(false),
+    num_iter_(0),
+    prim_res_(0.),
+    dual_res_(0.),
+    prim_ratio_(1.),
+    dual_ratio_(1.),
+    num_eq_(0),
+    c_(1.){}
+
+double QP_ADMM::solve(const MatrixRef & H, const VectorRef & g,
+        const MatrixRef & Aeq, const VectorRef & beq,
+        const MatrixRef & Cieq, const VectorRef & dieq,
+        dynacore::Vector & x){
+    dynacore::Clock clock;
+    clock.start();
+
+    int n(H.rows());
+    int m(beq.size() + dieq.size());
+    _SetProblem(H, g, Aeq, beq, Cieq, dieq);
+    _Equilibrate();
+
+    if(warm_start_ && x_ws_.size() == n && y_ws_.size() == m){
+        x_ = x_ws_.cwiseQuotient(D_);
+        z_ = z_ws_.cwiseProduct(E_);
+        y_ = c_ * y_ws_.cwiseQuotient(E_);
+    } else {
+        x_ = dynacore::Vector::Zero(n);
+        z_ = dynacore::Vector::Zero(m);
+        y_ = dynacore::Vector::Zero(m);
+    }
+    _Factorize(true);
+
+    rhs_.resize(n + m);
+    converged_ = false;
+    for(num_iter_ = 1; num_iter_ <= max_iter_; ++num_iter_){
+        rhs_.head(n) = sigma_ * x_ - q_;
+        rhs_.tail(m) = z_ - y_.cwiseQuotient(rho_vec_);
+        sol_ = ldlt_.solve(rhs_);
+
+        // z~ = z + (nu - y) / rho, relaxed with alpha
+        dynacore::Vector z_relax = alpha_ * (z_ + (sol_.tail(m) - y_).cwiseQuotient(rho_vec_))
+            + (1. - alpha_) * z_;
+        x_ = alpha_ * sol_.head(n) + (1. - alpha_) * x_;
+        z_ = (z_relax + y_.cwiseQuotient(rho_vec_)).cwiseMax(l_).cwiseMin(u_);
+        y_ += rho_vec_.cwiseProduct(z_relax - z_);
+
+        if(num_iter_ % check_interval_ == 0 || num_iter_ == max_iter_){
+            if(_CheckResidual()){
+                converged_ = true;
+                break;
+            }
+            if(time_budget_ > 0. && clock.stop() >= time_budget_) break;
+            _AdaptRho();
+        }
+    }
+    if(num_iter_ > max_iter_) num_iter_ = max_iter_;
+
+    x = D_.cwiseProduct(x_);
+    x_ws_ = x;
+    z_ws_ = z_.cwiseQuotient(E_);
+    y_ws_ = E_.cwiseProduct(y_) / c_;
+
+    if(!converged_) return std::numeric_limits<double>::infinity();
+    return 0.5 * x.dot(H * x) + g.dot(x);
+}
+
+void QP_ADMM::_SetProblem(const MatrixRef & H, const VectorRef & g,
+        const MatrixRef & Aeq, const VectorRef & beq,
+        const MatrixRef & Cieq, const VectorRef & dieq){
+    int n(H.rows());
+    num_eq_ = beq.size();
+    int m(num_eq_ + dieq.size());
+
+    std::vector<Eigen::Triplet<double> > triplet;
+    for(int j(0); j<n; ++j){
+        for(int i(0); i<n; ++i){
+            if(H(i, j) != 0.) triplet.push_back(Eigen::Triplet<double>(i, j, H(i, j)));
+        }
+    }
+    P_.resize(n, n);
+    P_.setFromTriplets(triplet.begin(), triplet.end());
+
+    triplet.clear();
+    for(int j(0); j<n; ++j){
+        for(int i(0); i<num_eq_; ++i){
+            if(Aeq(i, j) != 0.) triplet.push_back(Eigen::Triplet<double>(i, j, Aeq(i, j)));
+        }
+        for(int i(0); i<dieq.size(); ++i){
+            if(Cieq(i, j) != 0.)
+                triplet.push_back(Eigen::Triplet<double>(num_eq_ + i, j, Cieq(i, j)));
+        }
+    }
+    A_.resize(m, n);
+    A_.setFromTriplets(triplet.begin(), triplet.end());
+
+    q_ = g;
+    l_.resize(m);
+    u_.resize(m);
+    l_.head(num_eq_) = beq;
+    u_.head(num_eq_) = beq;
+    l_.tail(dieq.size()) = dieq;
+    u_.tail(dieq.size()).setConstant(std::numeric_limits<double>::infinity());
+}
+
+// Ruiz equilibration of [P A^T; A 0] and the cost scaling c
+void QP_ADMM::_Equilibrate(){
+    int n(P_.rows());
+    int m(A_.rows());
+    D_ = dynacore::Vector::Ones(n);
+    E_ = dynacore::Vector::Ones(m);
+    c_ = 1.;
+
+    dynacore::Vector d(n), e(m);
+    for(int iter(0); iter<10; ++iter){
+        d.setZero();
+        e.setZero();
+        for(int j(0); j<n; ++j){
+            for(SparseMatrix::InnerIterator it(P_, j); it; ++it){
+                d[j] = std::max(d[j], std::abs(it.value()));
+            }
+            for(SparseMatrix::InnerIterator it(A_, j); it; ++it){
+                d[j] = std::max(d[j], std::abs(it.value()));
+                e[it.row()] = std::max(e[it.row()], std::abs(it.value()));
+            }
+        }
+        for(int j(0); j<n; ++j){
+            d[j] = (d[j] < 1.e-4) ? 1. : 1. / sqrt(std::min(d[j], 1.e4));
+        }
+        for(int i(0); i<m; ++i){
+            e[i] = (e[i] < 1.e-4) ? 1. : 1. / sqrt(std::min(e[i], 1.e4));
+        }
+        for(int j(0); j<n; ++j){
+            for(SparseMatrix::InnerIterator it(P_, j); it; ++it){
+                it.valueRef() *= d[it.row()] * d[j];
+            }
+            for(SparseMatrix::InnerIterator it(A_, j); it; ++it){
+                it.valueRef() *= e[it.row()] * d[j];
+            }
+        }
+        q_ = q_.cwiseProduct(d);
+        D_ = D_.cwiseProduct(d);
+        E_ = E_.cwiseProduct(e);
+
+        // cost: mean column norm of P and the largest of q
+        double P_norm(0.);
+        for(int j(0); j<n; ++j){
+            double col(0.);
+            for(SparseMatrix::InnerIterator it(P_, j); it; ++it){
+                col = std::max(col, std::abs(it.value()));
+            }
+            P_norm += col;
+        }
+        P_norm /= n;
+        double cost_norm(std::max(P_norm, q_.lpNorm<Eigen::Infinity>()));
+        double gamma = (cost_norm < 1.e-4) ? 1. : 1. / std::min(cost_norm, 1.e4);
+        P_ *= gamma;
+        q_ *= gamma;
+        c_ *= gamma;
+    }
+    l_ = l_.cwiseProduct(E_);
+    u_ = u_.cwiseProduct(E_);
+}
+
+// lower triangle of [P + sigma I, A^T; A, -diag(1 / rho)], rho 1e3 times
+// larger on the equalities
+void QP_ADMM::_Factorize(bool new_problem){
+    int n(P_.rows());
+    int m(A_.rows());
+    rho_vec_.resize(m);
+    for(int i(0); i<m; ++i){
+        rho_vec_[i] = (i < num_eq_) ? 1.e3 * rho_ : rho_;
+    }
+
+    std::vector<Eigen::Triplet<double> > triplet;
+    triplet.reserve(P_.nonZeros() + A_.nonZeros() + n + m);
+    for(int j(0); j<n; ++j){
+        triplet.push_back(Eigen::Triplet<double>(j, j, sigma_));
+        for(SparseMatrix::InnerIterator it(P_, j); it; ++it){
+            if(it.row() >= j) triplet.push_back(Eigen::Triplet<double>(it.row(), j, it.value()));
+        }
+        for(SparseMatrix::InnerIterator it(A_, j); it; ++it){
+            triplet.push_back(Eigen::Triplet<double>(n + it.row(), j, it.value()));
+        }
+    }
+    for(int i(0); i<m; ++i){
+        triplet.push_back(Eigen::Triplet<double>(n + i, n + i, -1. / rho_vec_[i]));
+    }
+
+    SparseMatrix K(n + m, n + m);
+    K.setFromTriplets(triplet.begin(), triplet.end());
+
+    // same sparsity as the last problem: no new ordering
+    bool same_pattern(!new_problem ||
+            (K.rows() == K_.rows() && K.nonZeros() == K_.nonZeros() &&
+             std::equal(K.outerIndexPtr(), K.outerIndexPtr() + K.cols() + 1, K_.outerIndexPtr()) &&
+             std::equal(K.innerIndexPtr(), K.innerIndexPtr() + K.nonZeros(), K_.innerIndexPtr())));
+    K_.swap(K);
+    if(same_pattern) ldlt_.factorize(K_);
+    else ldlt_.compute(K_);
+}
+
+bool QP_ADMM::_CheckResidual(){
+    dynacore::Vector Ax = A_ * x_;
+    dynacore::Vector Px = P_ * x_;
+    dynacore::Vector Aty = A_.transpose() * y_;
+
+    prim_res_ = (Ax - z_).cwiseQuotient(E_).lpNorm<Eigen::Infinity>();
+    dual_res_ = (Px + q_ + Aty).cwiseQuotient(D_).lpNorm<Eigen::Infinity>() / c_;
+
+    double prim_scale = std::max(Ax.cwiseQuotient(E_).lpNorm<Eigen::Infinity>(),
+            z_.cwiseQuotient(E_).lpNorm<Eigen::Infinity>());
+    double dual_scale = std::max(Px.cwiseQuotient(D_).lpNorm<Eigen::Infinity>(),
+            std::max(Aty.cwiseQuotient(D_).lpNorm<Eigen::Infinity>(),
+                q_.cwiseQuotient(D_).lpNorm<Eigen::Infinity>())) / c_;
+
+    // scaled residuals relative to their terms, for the rho update
+    prim_ratio_ = (Ax - z_).lpNorm<Eigen::Infinity>() /
+        (std::max(Ax.lpNorm<Eigen::Infinity>(), z_.lpNorm<Eigen::Infinity>()) + 1.e-10);
+    dual_ratio_ = (Px + q_ + Aty).lpNorm<Eigen::Infinity>() /
+        (std::max(Px.lpNorm<Eigen::Infinity>(), std::max(Aty.lpNorm<Eigen::Infinity>(),
+                q_.lpNorm<Eigen::Infinity>())) + 1.e-10);
+
+    return prim_res_ <= eps_abs_ + eps_rel_ * prim_scale &&
+        dual_res_ <= eps_abs_ + eps_rel_ * dual_scale;
+}
+
+void QP_ADMM::_AdaptRho(){
+    double rho_new = rho_ * sqrt(prim_ratio_ / (dual_ratio_ + 1.e-10));
+    rho_new = std::min(std::max(rho_new, 1.e-6), 1.e6);
+    if(rho_new > 5. * rho_ || rho_new < 0.2 * rho_){
+        rho_ = rho_new;
+        _Factorize(false);
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef QP_ADMM_H
+#define QP_ADMM_H
+
+#include "QP_Solver.hpp"
+#include <Eigen/Sparse>
+
+// ADMM of OSQP (Stellato et al., 2020) on
+//
+//   min 0.5 x^T H x + g^T x,  l <= A x <= u
+//
+// with A = [Aeq; Cieq], l = [beq; dieq] and u = [beq; inf]. The problem is
+// equilibrated (Ruiz), H and A are kept sparse and each iteration solves
+// with the sparse LDL^T of [H + sigma I, A^T; A, -diag(1 / rho)], which is
+// factorized once per solve and again only when rho is adapted.
+//
+// It starts from the last solution when the dimensions are the same (warm
+// start) and stops when the primal and dual residuals are within the
+// tolerances, or at the iteration limit or the time budget with the last
+// iterate (isConverged() is then false and the cost infinity).
+class QP_ADMM: public QP_Solver{
+    public:
+        QP_ADMM();
+        virtual ~QP_ADMM(){}
+
+        virtual double solve(const MatrixRef & H, const VectorRef & g,
+                const MatrixRef & Aeq, const VectorRef & beq,
+                const MatrixRef & Cieq, const VectorRef & dieq,
+                dynacore::Vector & x);
+
+        virtual const char* getName() const { return "admm"; }
+
+        virtual bool isConverged() const { return converged_; }
+
+        virtual void setTimeBudget(double time_budget){ time_budget_ = time_budget; }
+        virtual void setTolerance(double eps_abs, double eps_rel){
+            eps_abs_ = eps_abs; eps_rel_ = eps_rel; }
+        virtual void setMaxIteration(int max_iter){ max_iter_ = max_iter; }
+        void setWarmStart(bool warm_start){ warm_start_ = warm_start; }
+
+        int getNumIteration() const { return num_iter_; }
+        double getPrimalResidual() const { return prim_res_; }
+        double getDualResidual() const { return dual_res_; }
+
+    private:
+        typedef Eigen::SparseMatrix<double> SparseMatrix;
+
+        void _SetProblem(const MatrixRef & H, const VectorRef & g,
+                const MatrixRef & Aeq, const VectorRef & beq,
+                const MatrixRef & Cieq, const VectorRef & dieq);
+        void _Equilibrate();
+        void _Factorize(bool new_problem);
+        // unscaled residuals, true if within the tolerances
+        bool _CheckResidual();
+        void _AdaptRho();
+
+        double sigma_;
+        double alpha_;
+        double rho_;
+        double eps_abs_;
+        double eps_rel_;
+        double time_budget_;
+        int max_iter_;
+        int check_interval_;
+        bool warm_start_;
+
+        bool converged_;
+        int num_iter_;
+        double prim_res_;
+        double dual_res_;
+        // scaled norms of the last residual check, for the rho update
+        double prim_ratio_;
+        double dual_ratio_;
+
+        // scaled problem: P = c D H D, q = c D g, A = E [Aeq; Cieq] D
+        int num_eq_;
+        SparseMatrix P_;
+        SparseMatrix A_;
+        dynacore::Vector q_;
+        dynacore::Vector l_;
+        dynacore::Vector u_;
+        dynacore::Vector D_;
+        dynacore::Vector E_;
+        double c_;
+
+        dynacore::Vector rho_vec_;
+        SparseMatrix K_;
+        Eigen::SimplicialLDLT<SparseMatrix, Eigen::Lower> ldlt_;
+
+        // scaled iterate
+        dynacore::Vector x_;
+        dynacore::Vector z_;
+        dynacore::Vector y_;
+        dynacore::Vector rhs_;
+        dynacore::Vector sol_;
+        // unscaled solution for the warm start
+        dynacore::Vector x_ws_;
+        dynacore::Vector z_ws_;
+        dynacore::Vector y_ws_;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#include "QP_Goldfarb.hpp"
+#include <cmath>
+
+double QP_Goldfarb::solve(const MatrixRef & H, const VectorRef & g,
+        const MatrixRef & Aeq, const VectorRef & beq,
+        const MatrixRef & Cieq, const VectorRef & dieq,
+        dynacore::Vector & x){
+    int n(H.rows());
+    int p(beq.size());
+    int m(dieq.size());
+
+    G_.resize(n, n);
+    g0_.resize(n);
+    for(int j(0); j<n; ++j){
+        for(int i(0); i<n; ++i) G_[i][j] = H(i, j);
+        g0_[j] = g[j];
+    }
+
+    // CE^T z + ce0 = 0, CI^T z + ci0 >= 0: row i of CE is column i of Aeq.
+    // The solver only reads CE and CI.
+    CE_.setView(const_cast<double*>(Aeq.data()), n, p, Aeq.outerStride());
+    ce0_.resize(p);
+    for(int i(0); i<p; ++i) ce0_[i] = -beq[i];
+
+    CI_.setView(const_cast<double*>(Cieq.data()), n, m, Cieq.outerStride());
+    ci0_.resize(m);
+    for(int i(0); i<m; ++i) ci0_[i] = -dieq[i];
+
+    double f = solve_quadprog(G_, g0_, CE_, ce0_, CI_, ci0_, z_);
+    converged_ = std::isfinite(f);
+
+    x.resize(n);
+    for(int i(0); i<n; ++i) x[i] = z_[i];
+    return f;
+}
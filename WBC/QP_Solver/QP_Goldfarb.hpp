@@ -0,0 +1,34 @@
+#ifndef QP_GOLDFARB_H
+#define QP_GOLDFARB_H
+
+#include "QP_Solver.hpp"
+#include <Optimizer/Goldfarb/QuadProg++.hh>
+
+// Goldfarb-Idnani active set method (QuadProg++). CE and CI are views of
+// the columns of Aeq and Cieq; H is copied because the solver factorizes
+// it in place.
+class QP_Goldfarb: public QP_Solver{
+    public:
+        QP_Goldfarb(): converged_(false){}
+        virtual ~QP_Goldfarb(){}
+
+        virtual double solve(const MatrixRef & H, const VectorRef & g,
+                const MatrixRef & Aeq, const VectorRef & beq,
+                const MatrixRef & Cieq, const VectorRef & dieq,
+                dynacore::Vector & x);
+
+        virtual const char* getName() const { return "goldfarb"; }
+        virtual bool isConverged() const { return converged_; }
+
+    private:
+        bool converged_;
+        GolDIdnani::GVect<double> z_;
+        GolDIdnani::GMatr<double> G_;
+        GolDIdnani::GVect<double> g0_;
+        GolDIdnani::GMatr<double> CE_;
+        GolDIdnani::GVect<double> ce0_;
+        GolDIdnani::GMatr<double> CI_;
+        GolDIdnani::GVect<double> ci0_;
+};
+
+#endif
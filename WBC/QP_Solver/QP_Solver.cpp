@@ -0,0 +1,34 @@
+#include "QP_Solver.hpp"
+#include "QP_Goldfarb.hpp"
+#include "QP_ADMM.hpp"
+#include <ParamHandler/ParamHandler.hpp>
+
+QP_Solver* QP_Solver::create(Type type){
+    if(type == ADMM) return new QP_ADMM();
+    return new QP_Goldfarb();
+}
+
+bool QP_Solver::getType(const std::string & name, Type & type){
+    if(name == "goldfarb" || name == "quadprog") type = GOLDFARB;
+    else if(name == "admm") type = ADMM;
+    else return false;
+    return true;
+}
+
+void QP_Solver::setStoppingRule(ParamHandler & handler){
+    if(handler.hasKey("qp_time_budget")){
+        double time_budget;
+        handler.getValue("qp_time_budget", time_budget);
+        setTimeBudget(time_budget);
+    }
+    if(handler.hasKey("qp_tolerance")){
+        Eigen::VectorXd eps;
+        handler.getVector("qp_tolerance", eps, 2);
+        setTolerance(eps[0], eps[1]);
+    }
+    if(handler.hasKey("qp_max_iteration")){
+        int max_iter;
+        handler.getInteger("qp_max_iteration", max_iter);
+        setMaxIteration(max_iter);
+    }
+}
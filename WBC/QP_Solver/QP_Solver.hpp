@@ -0,0 +1,62 @@
+#ifndef QP_SOLVER_H
+#define QP_SOLVER_H
+
+#include <Utils/wrap_eigen.hpp>
+#include <string>
+
+class ParamHandler;
+
+// Convex QP of the WBC classes:
+//
+//   min 0.5 x^T H x + g^T x
+//   s.t. Aeq x = beq
+//        Cieq x >= dieq
+//
+// The arguments are references to the caller's matrices (Eigen::Ref, no
+// copy for matrices, blocks or Maps of column major memory).
+class QP_Solver{
+    public:
+        typedef Eigen::Ref<const dynacore::Matrix> MatrixRef;
+        typedef Eigen::Ref<const dynacore::Vector> VectorRef;
+
+        QP_Solver(){}
+        virtual ~QP_Solver(){}
+
+        // x: H.rows(), the cost at x is returned. Infinity if no solution
+        // was found (isConverged() false): infeasible, or an iterative solver
+        // stopped at its iteration limit or time budget, x is then its last
+        // iterate.
+        virtual double solve(const MatrixRef & H, const VectorRef & g,
+                const MatrixRef & Aeq, const VectorRef & beq,
+                const MatrixRef & Cieq, const VectorRef & dieq,
+                dynacore::Vector & x) = 0;
+
+        virtual const char* getName() const = 0;
+        virtual bool isConverged() const = 0;
+
+        // Stopping rules of the iterative solvers; the active set solver
+        // always runs to the solution and ignores them.
+        // time_budget: milliseconds from the start of solve, no budget if
+        // <= 0. It is checked between iterations: the problem set-up and
+        // first factorization always run.
+        virtual void setTimeBudget(double time_budget){}
+        virtual void setTolerance(double eps_abs, double eps_rel){}
+        virtual void setMaxIteration(int max_iter){}
+
+        // Optional keys of a setting file:
+        //   qp_time_budget: 0.4          # ms
+        //   qp_tolerance: [1.e-5, 1.e-5] # absolute, relative
+        //   qp_max_iteration: 4000
+        // throws (ParamHandler) when one has the wrong type
+        void setStoppingRule(ParamHandler & handler);
+
+        enum Type{
+            GOLDFARB, // QuadProg++ active set
+            ADMM
+        };
+        static QP_Solver* create(Type type);
+        // "goldfarb" (or "quadprog") and "admm"; false for other names
+        static bool getType(const std::string & name, Type & type);
+};
+
+#endif
@@ -4,8 +4,10 @@
 #include <Utils/wrap_eigen.hpp>
 #include <Utils/utilities.hpp>
 #include <Utils/pseudo_inverse.hpp>
+#include <Utils/tree_ltl.hpp>
 #include "Task.hpp"
 #include "ContactSpec.hpp"
+#include <QP_Solver/QP_Solver.hpp>
 
 // Assume first 6 (or 3 in 2D case) joints are for the representation of 
 // a floating base. 
@@ -16,7 +18,9 @@ class WBC{
                 const dynacore::Matrix * Jc_internal = NULL):
             num_act_joint_(0),
             num_passive_(0),
-            b_internal_constraint_(false)
+            b_internal_constraint_(false),
+            qp_solver_(NULL),
+            fallback_solver_(NULL)
     {
         num_qdot_ = act_list.size();
         for(int i(0); i<num_qdot_; ++i){
@@ -48,10 +52,26 @@ class WBC{
         // dynacore::pretty_print(Sa_, std::cout, "Sa");
         // dynacore::pretty_print(Sv_, std::cout, "Sv");
     }
-        virtual ~WBC(){}
+        virtual ~WBC(){
+            delete qp_solver_;
+            delete fallback_solver_;
+        }
+
+        // QP of the WBC classes that solve one. A solve of an iterative
+        // solver that does not converge (e.g. ADMM out of its time budget)
+        // is done again with the active set solver.
+        void setQPSolver(QP_Solver::Type type){
+            delete qp_solver_;
+            delete fallback_solver_;
+            qp_solver_ = QP_Solver::create(type);
+            fallback_solver_ = NULL;
+            if(type != QP_Solver::GOLDFARB)
+                fallback_solver_ = QP_Solver::create(QP_Solver::GOLDFARB);
+        }
+        QP_Solver* getQPSolver() const { return qp_solver_; }
 
         virtual void UpdateSetting(const dynacore::Matrix & A,
-                const dynacore::Matrix & Ainv,
+                const dynacore::TreeLTL & A_ltl,
                 const dynacore::Vector & cori,
                 const dynacore::Vector & grav,
                 void* extra_setting = NULL) = 0;
@@ -62,6 +82,21 @@ class WBC{
                 void* extra_input = NULL) =0;
 
     protected:
+        // qp_solver_, then the fallback if it did not converge. b_converged
+        // false: no solution (infeasible), x is the last iterate.
+        double _SolveQP(const QP_Solver::MatrixRef & H, const QP_Solver::VectorRef & g,
+                const QP_Solver::MatrixRef & Aeq, const QP_Solver::VectorRef & beq,
+                const QP_Solver::MatrixRef & Cieq, const QP_Solver::VectorRef & dieq,
+                dynacore::Vector & x, bool & b_converged){
+            double f = qp_solver_->solve(H, g, Aeq, beq, Cieq, dieq, x);
+            b_converged = qp_solver_->isConverged();
+            if(!b_converged && fallback_solver_){
+                f = fallback_solver_->solve(H, g, Aeq, beq, Cieq, dieq, x);
+                b_converged = fallback_solver_->isConverged();
+            }
+            return f;
+        }
+
         // full rank fat matrix only
         void _WeightedInverse(const dynacore::Matrix & J,
                 const dynacore::Matrix & Winv,
@@ -71,6 +106,15 @@ class WBC{
             dynacore::pseudoInverse(lambda, threshold, lambda_inv);
             Jinv = Winv * J.transpose() * lambda_inv;
         }
+        // _WeightedInverse with Ainv, through the factor of A
+        void _DynConsistentInverse(const dynacore::Matrix & J,
+                dynacore::Matrix & Jinv, double threshold = 0.0001){
+            dynacore::Matrix lambda, AinvJt;
+            A_ltl_.inverseGram(J, lambda, AinvJt);
+            dynacore::Matrix lambda_inv;
+            dynacore::pseudoInverse(lambda, threshold, lambda_inv);
+            Jinv = AinvJt * lambda_inv;
+        }
 
         int num_qdot_;
         int num_act_joint_;
@@ -80,7 +124,7 @@ class WBC{
         dynacore::Matrix Sv_; // Virtual joint
 
         dynacore::Matrix A_;
-        dynacore::Matrix Ainv_;
+        dynacore::TreeLTL A_ltl_; // A = L^T L
         dynacore::Vector cori_;
         dynacore::Vector grav_;
 
@@ -89,6 +133,9 @@ class WBC{
         bool b_internal_constraint_;
         dynacore::Matrix Jci_; // internal constraint Jacobian
         dynacore::Matrix Nci_;
+
+        QP_Solver* qp_solver_;
+        QP_Solver* fallback_solver_; // GOLDFARB, for an iterative qp_solver_
 };
 
 #endif
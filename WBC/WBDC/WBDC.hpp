@@ -3,7 +3,6 @@
 
 #include <WBC.hpp>
 #include <Utils/utilities.hpp>
-#include <Optimizer/Goldfarb/QuadProg++.hh>
 
 #include <Task.hpp>
 #include "WBDC_ContactSpec.hpp"
@@ -12,8 +11,10 @@ class WBDC_ExtraData{
     public:
         dynacore::Vector cost_weight;
         dynacore::Vector opt_result_;
+        // false: no solution, not even from the fallback solver (WBC::_SolveQP)
+        bool b_qp_converged_;
 
-        WBDC_ExtraData(){}
+        WBDC_ExtraData(): b_qp_converged_(true){}
         ~WBDC_ExtraData(){}
 };
 
@@ -23,7 +24,7 @@ class WBDC: public WBC{
         virtual ~WBDC(){}
 
         virtual void UpdateSetting(const dynacore::Matrix & A,
-                const dynacore::Matrix & Ainv,
+                const dynacore::TreeLTL & A_ltl,
                 const dynacore::Vector & cori,
                 const dynacore::Vector & grav,
                 void* extra_setting = NULL);
@@ -47,18 +48,18 @@ class WBDC: public WBC{
         int dim_first_task_; // first task dimension
         WBDC_ExtraData* data_;
 
-        GolDIdnani::GVect<double> z;
+        dynacore::Vector z_;
         // Cost
-        GolDIdnani::GMatr<double> G;
-        GolDIdnani::GVect<double> g0;
+        dynacore::Matrix G_;
+        dynacore::Vector g0_;
 
         // Equality
-        GolDIdnani::GMatr<double> CE;
-        GolDIdnani::GVect<double> ce0;
+        dynacore::Matrix CE_;
+        dynacore::Vector ce0_;
 
         // Inequality
-        GolDIdnani::GMatr<double> CI;
-        GolDIdnani::GVect<double> ci0;
+        dynacore::Matrix CI_;
+        dynacore::Vector ci0_;
 
         int dim_rf_;
         int dim_relaxed_task_;
@@ -3,15 +3,17 @@
 #include <Eigen/LU>
 #include <Eigen/SVD>
 
-WBDC_Relax::WBDC_Relax(const std::vector<bool> & act_list): WBC(act_list){}
+WBDC_Relax::WBDC_Relax(const std::vector<bool> & act_list): WBC(act_list){
+    qp_solver_ = QP_Solver::create(QP_Solver::GOLDFARB);
+}
 
 void WBDC_Relax::UpdateSetting(const dynacore::Matrix & A,
-        const dynacore::Matrix & Ainv,
+        const dynacore::TreeLTL & A_ltl,
         const dynacore::Vector & cori,
         const dynacore::Vector & grav,
         void* extra_setting){
     A_ = A;
-    Ainv_ = Ainv;
+    A_ltl_ = A_ltl;
     cori_ = cori;
     grav_ = grav;
 }
@@ -58,14 +60,10 @@ void WBDC_Relax::MakeTorque(const std::vector<Task*> & task_list,
     //std::cout<<CI<<std::endl;
     //printf("ci0:\n");
     //std::cout<<ci0<<std::endl;
-    double f = solve_quadprog(G, g0, CE, ce0, CI, ci0, z);
+    double f = _SolveQP(G_, g0_, CE_, ce0_, CI_, ci0_, z_, data_->b_qp_converged_);
 
     _GetSolution(cmd);
-    data_->opt_result_ = dynacore::Vector(dim_opt_);
-    
-    for(int i(0); i<dim_opt_; ++i){
-        data_->opt_result_[i] = z[i];
-    }
+    data_->opt_result_ = z_;
     // if(f > 1.e5){
     //std::cout << "f: " << f << std::endl;
     //std::cout << "x: " << z << std::endl;
@@ -90,52 +88,35 @@ void WBDC_Relax::MakeTorque(const std::vector<Task*> & task_list,
 }
 
 void WBDC_Relax::_SetEqualityConstraint(){
-    dynacore::Matrix test_eq = Sv_ * tot_tau_Mtx_;
-    dynacore::Matrix sj_CE(dim_eq_cstr_, dim_opt_);
-    dynacore::Vector sj_ce0(dim_eq_cstr_);
-    sj_CE.setZero();
-    sj_ce0.setZero();
-    // Virtual Torque
-    sj_CE = Sv_ * tot_tau_Mtx_;
-    sj_ce0.head(num_passive_) = Sv_ * tot_tau_Vect_;
-
-    for(int i(0); i< dim_eq_cstr_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            CE[j][i] = sj_CE(i,j);
-        }
-        ce0[i] = sj_ce0[i];
-    }
-    //dynacore::pretty_print(sj_CE, std::cout, "WBDC_Relax: CE");
-    //dynacore::pretty_print(sj_ce0, std::cout, "WBDC_Relax: ce0");
+    // CE_ x = ce0_: virtual torque
+    CE_ = Sv_ * tot_tau_Mtx_;
+    ce0_ = dynacore::Vector::Zero(dim_eq_cstr_);
+    ce0_.head(num_passive_) = -Sv_ * tot_tau_Vect_;
+
+    //dynacore::pretty_print(CE_, std::cout, "WBDC_Relax: CE");
+    //dynacore::pretty_print(ce0_, std::cout, "WBDC_Relax: ce0");
 }
 
 void WBDC_Relax::_SetInEqualityConstraint(){
-    dynacore::Matrix sj_CI(dim_ieq_cstr_, dim_opt_);
-    dynacore::Vector sj_ci0(dim_ieq_cstr_);
-    sj_CI.setZero();
-    sj_ci0.setZero();
+    // CI_ x >= ci0_
+    CI_ = dynacore::Matrix::Zero(dim_ieq_cstr_, dim_opt_);
+    ci0_ = dynacore::Vector::Zero(dim_ieq_cstr_);
 
     // RF constraint
-    sj_CI.block(0,0, dim_rf_cstr_, dim_rf_) = Uf_;
-    (sj_ci0.head(dim_rf_cstr_)) = uf_ieq_vec_;
+    CI_.block(0,0, dim_rf_cstr_, dim_rf_) = Uf_;
+    (ci0_.head(dim_rf_cstr_)) = -uf_ieq_vec_;
 
     // Torque min & max
     // min
-    sj_CI.block(dim_rf_cstr_, 0, num_act_joint_, dim_opt_) = Sa_ * tot_tau_Mtx_;
-    sj_ci0.segment(dim_rf_cstr_, num_act_joint_) = Sa_ * tot_tau_Vect_ - data_->tau_min;
+    CI_.block(dim_rf_cstr_, 0, num_act_joint_, dim_opt_) = Sa_ * tot_tau_Mtx_;
+    ci0_.segment(dim_rf_cstr_, num_act_joint_) = -Sa_ * tot_tau_Vect_ + data_->tau_min;
 
     // max
-    sj_CI.block(dim_rf_cstr_ + num_act_joint_, 0, num_act_joint_, dim_opt_) = -Sa_ * tot_tau_Mtx_;
-    sj_ci0.tail(num_act_joint_) = -Sa_ * tot_tau_Vect_ + data_->tau_max;
+    CI_.block(dim_rf_cstr_ + num_act_joint_, 0, num_act_joint_, dim_opt_) = -Sa_ * tot_tau_Mtx_;
+    ci0_.tail(num_act_joint_) = Sa_ * tot_tau_Vect_ - data_->tau_max;
 
-    for(int i(0); i< dim_ieq_cstr_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            CI[j][i] = sj_CI(i,j);
-        }
-        ci0[i] = sj_ci0[i];
-    }
-    //dynacore::pretty_print(sj_CI, std::cout, "WBDC_Relax: CI");
-    //dynacore::pretty_print(sj_ci0, std::cout, "WBDC_Relax: ci0");
+    //dynacore::pretty_print(CI_, std::cout, "WBDC_Relax: CI");
+    //dynacore::pretty_print(ci0_, std::cout, "WBDC_Relax: ci0");
 }
 
 void WBDC_Relax::_ContactBuilding(const std::vector<ContactSpec*> & contact_list){
@@ -210,7 +191,7 @@ void WBDC_Relax::_TaskHierarchyBuilding(const std::vector<Task*> & task_list){
     Jt = Jc_;
     JtDotQdot = JcDotQdot_;
 
-    _WeightedInverse(Jt, Ainv_, Jt_inv);
+    _DynConsistentInverse(Jt, Jt_inv);
     B_ = Jt_inv;
     c_ = Jt_inv * JtDotQdot;
 
@@ -237,7 +218,7 @@ void WBDC_Relax::_TaskHierarchyBuilding(const std::vector<Task*> & task_list){
         task->getTaskJacobianDotQdot(JtDotQdot);
         task->getCommand(xddot);
         JtPre = Jt * Npre;
-        _WeightedInverse(JtPre, Ainv_, JtPre_inv);
+        _DynConsistentInverse(JtPre, JtPre_inv);
         I_JtPreInv_Jt = dynacore::Matrix::Identity(num_qdot_, num_qdot_) - JtPre_inv * Jt;
 
         // B matrix building
@@ -288,11 +269,9 @@ void WBDC_Relax::_TaskHierarchyBuilding(const std::vector<Task*> & task_list){
 }
 
 void WBDC_Relax::_GetSolution(dynacore::Vector & cmd){
-    dynacore::Vector result(dim_opt_);
-    for(int i(0); i<dim_opt_; ++i) result[i] = z[i];
-    dynacore::Vector tot_tau = tot_tau_Mtx_*result + tot_tau_Vect_;
+    dynacore::Vector tot_tau = tot_tau_Mtx_*z_ + tot_tau_Vect_;
     cmd = tot_tau.tail(num_act_joint_);
-    //dynacore::pretty_print(result, std::cout, "opt result");
+    //dynacore::pretty_print(z_, std::cout, "opt result");
     //dynacore::pretty_print(tot_tau, std::cout, "tot tau result");
 }
 
@@ -308,22 +287,11 @@ void WBDC_Relax::_MatrixInitialization(){
     tot_tau_Vect_ = A_*B_*task_cmd_ + A_*c_ + cori_ + grav_;
     // tot_tau_Vect_ =  cori_ + grav_;
 
-    G.resize(dim_opt_, dim_opt_);
-    g0.resize(dim_opt_);
-    CE.resize(dim_opt_, dim_eq_cstr_);
-    ce0.resize(dim_eq_cstr_);
-    CI.resize(dim_opt_, dim_ieq_cstr_);
-    ci0.resize(dim_ieq_cstr_);
-
-    for(int i(0); i<dim_opt_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            G[i][j] = 0.;
-        }
-        g0[i] = 0.;
-    }
+    G_ = dynacore::Matrix::Zero(dim_opt_, dim_opt_);
+    g0_ = dynacore::Vector::Zero(dim_opt_);
 
     // Set Cost
     for (int i(0); i < dim_opt_; ++i){
-        G[i][i] = data_->cost_weight[i];
+        G_(i, i) = data_->cost_weight[i];
     }
 }
@@ -3,7 +3,6 @@
 
 #include <WBC.hpp>
 #include <Utils/utilities.hpp>
-#include <Optimizer/Goldfarb/QuadProg++.hh>
 
 #include "WBDC_Relax_Task.hpp"
 #include <WBDC/WBDC_ContactSpec.hpp>
@@ -14,8 +13,10 @@ class WBDC_Relax_ExtraData{
   dynacore::Vector tau_min;
   dynacore::Vector tau_max;
   dynacore::Vector opt_result_;
+  // false: no solution, not even from the fallback solver (WBC::_SolveQP)
+  bool b_qp_converged_;
 
-  WBDC_Relax_ExtraData(){}
+  WBDC_Relax_ExtraData(): b_qp_converged_(true){}
   ~WBDC_Relax_ExtraData(){}
 };
 
@@ -25,7 +26,7 @@ class WBDC_Relax: public WBC{
   virtual ~WBDC_Relax(){}
 
   virtual void UpdateSetting(const dynacore::Matrix & A,
-                             const dynacore::Matrix & Ainv,
+                             const dynacore::TreeLTL & A_ltl,
                              const dynacore::Vector & cori,
                              const dynacore::Vector & grav,
                              void* extra_setting = NULL);
@@ -52,18 +53,18 @@ private:
   int dim_ieq_cstr_; // inequality constraints
   WBDC_Relax_ExtraData* data_;
 
-  GolDIdnani::GVect<double> z;
+  dynacore::Vector z_;
   // Cost
-  GolDIdnani::GMatr<double> G;
-  GolDIdnani::GVect<double> g0;
+  dynacore::Matrix G_;
+  dynacore::Vector g0_;
 
   // Equality
-  GolDIdnani::GMatr<double> CE;
-  GolDIdnani::GVect<double> ce0;
+  dynacore::Matrix CE_;
+  dynacore::Vector ce0_;
 
   // Inequality
-  GolDIdnani::GMatr<double> CI;
-  GolDIdnani::GVect<double> ci0;
+  dynacore::Matrix CI_;
+  dynacore::Vector ci0_;
 
   int dim_rf_;
   int dim_relaxed_task_;
@@ -5,17 +5,18 @@
 
 WBDC_Rotor::WBDC_Rotor(const std::vector<bool> & act_list,
         const dynacore::Matrix * Jci): WBC(act_list, Jci){
+    qp_solver_ = QP_Solver::create(QP_Solver::GOLDFARB);
     Sf_ = dynacore::Matrix::Zero(6, num_qdot_);
     Sf_.block(0,0, 6, 6).setIdentity();
 }
 
 void WBDC_Rotor::UpdateSetting(const dynacore::Matrix & A,
-        const dynacore::Matrix & Ainv,
+        const dynacore::TreeLTL & A_ltl,
         const dynacore::Vector & cori,
         const dynacore::Vector & grav,
         void* extra_setting){
     A_ = A;
-    Ainv_ = Ainv;
+    A_ltl_ = A_ltl;
     cori_ = cori;
     grav_ = grav;
     b_updatesetting_ = true;
@@ -55,7 +56,7 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
 
     if(b_internal_constraint_) {
         dynacore::Matrix JciBar;
-        _WeightedInverse(Jci_, Ainv_, JciBar);
+        _DynConsistentInverse(Jci_, JciBar);
         Nci_ -= JciBar * Jci_;
     }
     
@@ -67,7 +68,7 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
 
     _PrintDebug(3);    
     dynacore::Matrix JcN_Bar;
-    _WeightedInverse(JcN, Ainv_, JcN_Bar);
+    _DynConsistentInverse(JcN, JcN_Bar);
     dynacore::Matrix Npre = dynacore::Matrix::Identity(num_qdot_, num_qdot_)
         - JcN_Bar * JcN;
 
@@ -88,7 +89,7 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
     JtPre = Jt * Npre;
 //    dynacore::pretty_print(Jt, std::cout, "Jt");
 //    dynacore::pretty_print(JtPre, std::cout, "Jt Pre");
-    _WeightedInverse(JtPre, Ainv_, JtPreBar);
+    _DynConsistentInverse(JtPre, JtPreBar);
     Npre = Npre * (dynacore::Matrix::Identity(num_qdot_, num_qdot_)
             - JtPreBar * JtPre);
     
@@ -98,25 +99,18 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
     _PrintDebug(7);    
     _OptimizationPreparation();
     // Set equality constraints
-    dynacore::Matrix dyn_CE(dim_eq_cstr_, dim_opt_);
-    dynacore::Vector dyn_ce0(dim_eq_cstr_);
-    dyn_CE.block(0,0, dim_eq_cstr_, dim_first_task_) = Sf_ * A_ * JtPreBar;
-    dyn_CE.block(0, dim_first_task_, dim_eq_cstr_, dim_rf_) = -Sf_ * JcN.transpose();
-    dyn_ce0 = Sf_ * (A_ * (JtPreBar * (xddot - JtDotQdot - Jt * qddot_pre) + qddot_pre)
+    // CE_ x = ce0_
+    CE_.resize(dim_eq_cstr_, dim_opt_);
+    CE_.block(0,0, dim_eq_cstr_, dim_first_task_) = Sf_ * A_ * JtPreBar;
+    CE_.block(0, dim_first_task_, dim_eq_cstr_, dim_rf_) = -Sf_ * JcN.transpose();
+    ce0_ = -Sf_ * (A_ * (JtPreBar * (xddot - JtDotQdot - Jt * qddot_pre) + qddot_pre)
             + cori_ + grav_);
-    for(int i(0); i< dim_eq_cstr_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            CE[j][i] = dyn_CE(i,j);
-        }
-        ce0[i] = dyn_ce0[i];
-    }
     // Set inequality constraints
     _SetInEqualityConstraint();
 
     // Optimization
-    double f = solve_quadprog(G, g0, CE, ce0, CI, ci0, z);
-    dynacore::Vector delta(dim_first_task_);
-    for(int i(0); i<dim_first_task_; ++i) { delta[i] = z[i]; }
+    double f = _SolveQP(G_, g0_, CE_, ce0_, CI_, ci0_, z_, data_->b_qp_converged_);
+    dynacore::Vector delta = z_.head(dim_first_task_);
     qddot_pre = qddot_pre + JtPreBar * (xddot + delta - JtDotQdot - Jt * qddot_pre);
 
     // First Qddot is found
@@ -130,7 +124,7 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
         task->getCommand(xddot);
 
         JtPre = Jt * Npre;
-        _WeightedInverse(JtPre, Ainv_, JtPreBar);
+        _DynConsistentInverse(JtPre, JtPreBar);
 
         qddot_pre = qddot_pre + JtPreBar * (xddot - JtDotQdot - Jt * qddot_pre);
     
@@ -140,10 +134,7 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
 
     _GetSolution(qddot_pre, cmd);
 
-    data_->opt_result_ = dynacore::Vector(dim_opt_);
-    for(int i(0); i<dim_opt_; ++i){
-        data_->opt_result_[i] = z[i];
-    }
+    data_->opt_result_ = z_;
        //std::cout << "f: " << f << std::endl;
        //std::cout << "x: " << z << std::endl;
        //std::cout << "cmd: "<<cmd<<std::endl;
@@ -151,8 +142,8 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
     //dynacore::pretty_print(qddot_pre, std::cout, "qddot_pre");
     //dynacore::pretty_print(JcN, std::cout, "JcN");
     //dynacore::pretty_print(Nci_, std::cout, "Nci");
-    //dynacore::Vector eq_check = dyn_CE * data_->opt_result_;
-    //dynacore::pretty_print(dyn_ce0, std::cout, "dyn ce0");
+    //dynacore::Vector eq_check = CE_ * data_->opt_result_;
+    //dynacore::pretty_print(ce0_, std::cout, "ce0");
     //dynacore::pretty_print(eq_check, std::cout, "eq_check");
  
     //dynacore::pretty_print(Jt, std::cout, "Jt");
@@ -200,20 +191,12 @@ void WBDC_Rotor::MakeTorque(const std::vector<Task*> & task_list,
 }
 
 void WBDC_Rotor::_SetInEqualityConstraint(){
-    dynacore::Matrix dyn_CI(dim_ieq_cstr_, dim_opt_); dyn_CI.setZero();
-    dynacore::Vector dyn_ci0(dim_ieq_cstr_);
-
-    dyn_CI.block(0, dim_first_task_, dim_rf_cstr_, dim_rf_) = Uf_;
-    dyn_ci0 = uf_ieq_vec_;
- 
-   for(int i(0); i< dim_ieq_cstr_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            CI[j][i] = dyn_CI(i,j);
-        }
-        ci0[i] = dyn_ci0[i];
-    }
-   // dynacore::pretty_print(dyn_CI, std::cout, "WBDC_Rotor: CI");
-    // dynacore::pretty_print(dyn_ci0, std::cout, "WBDC_Rotor: ci0");
+    // CI_ x >= ci0_
+    CI_ = dynacore::Matrix::Zero(dim_ieq_cstr_, dim_opt_);
+    CI_.block(0, dim_first_task_, dim_rf_cstr_, dim_rf_) = Uf_;
+    ci0_ = -uf_ieq_vec_;
+   // dynacore::pretty_print(CI_, std::cout, "WBDC_Rotor: CI");
+    // dynacore::pretty_print(ci0_, std::cout, "WBDC_Rotor: ci0");
 }
 
 void WBDC_Rotor::_ContactBuilding(const std::vector<ContactSpec*> & contact_list){
@@ -273,17 +256,14 @@ void WBDC_Rotor::_ContactBuilding(const std::vector<ContactSpec*> & contact_list
 }
 
 void WBDC_Rotor::_GetSolution(const dynacore::Vector & qddot, dynacore::Vector & cmd){
-    dynacore::Vector Fr(dim_rf_);
-    for(int i(0); i<dim_rf_; ++i) Fr[i] = z[i + dim_first_task_];
-    dynacore::Vector tot_tau = A_ * qddot + cori_ + grav_ - (Jc_).transpose() * Fr;
-    
-    cmd = tot_tau.tail(num_act_joint_);
+    dynacore::Vector Fr = z_.segment(dim_first_task_, dim_rf_);
+    dynacore::Vector tot_tau_ff = A_ * qddot + cori_ + grav_ - (Jc_).transpose() * Fr;
+    dynacore::Vector tot_tau = tot_tau_ff;
+    if(data_->rotor_inertia.size() == num_qdot_)
+        tot_tau -= data_->rotor_inertia.cwiseProduct(qddot);
 
-    dynacore::Vector tot_tau_ff = (A_ + data_->A_rotor) * qddot 
-        + cori_ + grav_ - (Jc_).transpose() * Fr;
-    dynacore::Vector tot_tau_ff_trc = tot_tau_ff.tail(num_qdot_-6);
- 
-    data_->cmd_ff = tot_tau_ff_trc.tail(num_act_joint_);
+    cmd = tot_tau.tail(num_act_joint_);
+    data_->cmd_ff = tot_tau_ff.tail(num_act_joint_);
     data_->reflected_reaction_force_ = Jc_.transpose() * Fr;
     data_->result_qddot_ = qddot;
 
@@ -292,7 +272,7 @@ void WBDC_Rotor::_GetSolution(const dynacore::Vector & qddot, dynacore::Vector &
      //dynacore::pretty_print(UNci_trc, std::cout, "UNci+trc");
      //dynacore::pretty_print(UNciBar_trc, std::cout, "UNciBar_trc");
      //dynacore::pretty_print(tot_tau_trc, std::cout, "tot tau trc");
-    //_WeightedInverse(UNci, Ainv_, UNciBar);
+    //_DynConsistentInverse(UNci, UNciBar);
     //cmd = UNciBar.transpose() * tot_tau;
     // dynacore::pretty_print(result, std::cout, "opt result");
      //dynacore::pretty_print(tot_tau, std::cout, "tot tau result");
@@ -304,22 +284,10 @@ void WBDC_Rotor::_OptimizationPreparation(){
     dim_eq_cstr_ = 6;
     dim_ieq_cstr_ = dim_rf_cstr_; 
 
-    G.resize(dim_opt_, dim_opt_); 
-    g0.resize(dim_opt_);
-    CE.resize(dim_opt_, dim_eq_cstr_);
-    ce0.resize(dim_eq_cstr_);
-    CI.resize(dim_opt_, dim_ieq_cstr_);
-    ci0.resize(dim_ieq_cstr_);
-
-    for(int i(0); i<dim_opt_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            G[i][j] = 0.;
-        }
-        g0[i] = 0.;
-    }
+    G_ = dynacore::Matrix::Zero(dim_opt_, dim_opt_);
+    g0_ = dynacore::Vector::Zero(dim_opt_);
     // Set Cost
-     for (int i(0); i < dim_opt_; ++i){
-        G[i][i] = data_->cost_weight[i];
+    for (int i(0); i < dim_opt_; ++i){
+        G_(i, i) = data_->cost_weight[i];
     }
 }
-
@@ -6,7 +6,6 @@
 
 #include <WBC.hpp>
 #include <Utils/utilities.hpp>
-#include <Optimizer/Goldfarb/QuadProg++.hh>
 
 #include <Task.hpp>
 #include <WBDC/WBDC_ContactSpec.hpp>
@@ -14,14 +13,19 @@
 class WBDC_Rotor_ExtraData{
     public:
         dynacore::Vector cost_weight;
-        dynacore::Matrix A_rotor;
+        // RobotSystem::getRotorInertia, included in the A of UpdateSetting;
+        // cmd_ff has it, the torque of MakeTorque does not
+        dynacore::Vector rotor_inertia;
 
         dynacore::Vector cmd_ff; //Feedforward torque cmd
         dynacore::Vector opt_result_;
 
         dynacore::Vector result_qddot_;
         dynacore::Vector reflected_reaction_force_;
-        WBDC_Rotor_ExtraData(){}
+        // false: no solution, not even from the fallback solver (WBC::_SolveQP)
+        bool b_qp_converged_;
+
+        WBDC_Rotor_ExtraData(): b_qp_converged_(true){}
         ~WBDC_Rotor_ExtraData(){}
 };
 
@@ -31,7 +35,7 @@ class WBDC_Rotor: public WBC{
         virtual ~WBDC_Rotor(){}
 
         virtual void UpdateSetting(const dynacore::Matrix & A,
-                const dynacore::Matrix & Ainv,
+                const dynacore::TreeLTL & A_ltl,
                 const dynacore::Vector & cori,
                 const dynacore::Vector & grav,
                 void* extra_setting = NULL);
@@ -55,18 +59,18 @@ class WBDC_Rotor: public WBC{
         int dim_first_task_; // first task dimension
         WBDC_Rotor_ExtraData* data_;
 
-        GolDIdnani::GVect<double> z;
+        dynacore::Vector z_;
         // Cost
-        GolDIdnani::GMatr<double> G;
-        GolDIdnani::GVect<double> g0;
+        dynacore::Matrix G_;
+        dynacore::Vector g0_;
 
         // Equality
-        GolDIdnani::GMatr<double> CE;
-        GolDIdnani::GVect<double> ce0;
+        dynacore::Matrix CE_;
+        dynacore::Vector ce0_;
 
         // Inequality
-        GolDIdnani::GMatr<double> CI;
-        GolDIdnani::GVect<double> ci0;
+        dynacore::Matrix CI_;
+        dynacore::Vector ci0_;
 
         int dim_rf_;
         int dim_relaxed_task_;
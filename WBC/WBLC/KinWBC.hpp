@@ -18,7 +18,6 @@ class KinWBC{
                 dynacore::Vector & jvel_cmd,
                 dynacore::Vector & jacc_cmd);
 
-        dynacore::Matrix Ainv_;
     private:
         void _PseudoInverse(const dynacore::Matrix J, dynacore::Matrix & Jinv);
         void _BuildProjectionMatrix(
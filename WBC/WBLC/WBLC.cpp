@@ -6,6 +6,7 @@
 WBLC::WBLC(const std::vector<bool> & act_list,
         const dynacore::Matrix * Jci): 
     WBC(act_list, Jci){
+    qp_solver_ = QP_Solver::create(QP_Solver::GOLDFARB);
     Sf_ = dynacore::Matrix::Zero(6, num_qdot_);
     Sf_.block(0,0, 6, 6).setIdentity();
 
@@ -18,13 +19,13 @@ WBLC::WBLC(const std::vector<bool> & act_list,
 }
 
 void WBLC::UpdateSetting(const dynacore::Matrix & A,
-        const dynacore::Matrix & Ainv,
+        const dynacore::TreeLTL & A_ltl,
         const dynacore::Vector & cori,
         const dynacore::Vector & grav,
         void* extra_setting){
 
     A_ = A;
-    Ainv_ = Ainv;
+    A_ltl_ = A_ltl;
     cori_ = cori;
     grav_ = grav;
     b_updatesetting_ = true;
@@ -48,7 +49,7 @@ void WBLC::MakeWBLC_Torque(
 
     if(b_internal_constraint_) {
         dynacore::Matrix JciBar;
-        _WeightedInverse(Jci_, Ainv_, JciBar);
+        _DynConsistentInverse(Jci_, JciBar);
         Nci_ -= JciBar * Jci_;
     }
     for(int i(0); i<num_act_joint_; ++i){
@@ -65,34 +66,23 @@ void WBLC::MakeWBLC_Torque(
 
     _Build_Equality_Constraint();
     _Build_Inequality_Constraint();
-    _OptimizationPreparation(Aeq_, beq_, Cieq_, dieq_);
+    _OptimizationPreparation();
 
-    double f = solve_quadprog(G, g0, CE, ce0, CI, ci0, z);
+    double f = _SolveQP(G_, g0_, Aeq_, beq_, Cieq_, dieq_, z_, data_->b_qp_converged_);
 
     _GetSolution(cmd);
     //std::cout << "f: " << f << std::endl;
-    //std::cout << "x: " << z << std::endl;
+    //std::cout << "x: " << z_ << std::endl;
     //std::cout << "cmd: "<<cmd<<std::endl;
 
     // if(f > 1.e5){
     //   std::cout << "f: " << f << std::endl;
-    //   std::cout << "x: " << z << std::endl;
+    //   std::cout << "x: " << z_ << std::endl;
     //   std::cout << "cmd: "<<cmd<<std::endl;
 
-    //   printf("G:\n");
-    //   std::cout<<G<<std::endl;
-    //   printf("g0:\n");
-    //   std::cout<<g0<<std::endl;
-
-    //   printf("CE:\n");
-    //   std::cout<<CE<<std::endl;
-    //   printf("ce0:\n");
-    //   std::cout<<ce0<<std::endl;
-
-    //   printf("CI:\n");
-    //   std::cout<<CI<<std::endl;
-    //   printf("ci0:\n");
-    //   std::cout<<ci0<<std::endl;
+    //   dynacore::pretty_print(G_, std::cout, "G");
+    //   dynacore::pretty_print(Aeq_, std::cout, "Aeq");
+    //   dynacore::pretty_print(Cieq_, std::cout, "Cieq");
     // }
 }
 
@@ -180,64 +170,22 @@ void WBLC::_BuildContactMtxVect(const std::vector<ContactSpec*> & contact_list){
     //dynacore::pretty_print(JcDotQdot_, std::cout, "JcDotQdot"); 
     //dynacore::pretty_print(Fr_ieq_, std::cout, "Fr_ieq"); 
 }
-void WBLC::_OptimizationPreparation(
-        const dynacore::Matrix & Aeq, 
-        const dynacore::Vector & beq,
-        const dynacore::Matrix & Cieq,
-        const dynacore::Vector & dieq){
-    G.resize(dim_opt_, dim_opt_); 
-    g0.resize(dim_opt_);
-    CE.resize(dim_opt_, dim_eq_cstr_);
-    ce0.resize(dim_eq_cstr_);
-    CI.resize(dim_opt_, dim_ieq_cstr_);
-    ci0.resize(dim_ieq_cstr_);
-
-    for(int i(0); i<dim_opt_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            G[i][j] = 0.;
-        }
-        g0[i] = 0.;
-    }
+void WBLC::_OptimizationPreparation(){
+    G_ = dynacore::Matrix::Zero(dim_opt_, dim_opt_);
+    g0_ = dynacore::Vector::Zero(dim_opt_);
+
     // Set Cost
     for (int i(0); i < num_qdot_; ++i){
-        G[i][i] = data_->W_qddot_[i];
+        G_(i, i) = data_->W_qddot_[i];
     }
     int idx_offset = num_qdot_;
     for (int i(0); i < dim_rf_; ++i){
-        G[i + idx_offset][i + idx_offset] = data_->W_rf_[i];
+        G_(i + idx_offset, i + idx_offset) = data_->W_rf_[i];
     }
     idx_offset += dim_rf_;
     for (int i(0); i < dim_rf_; ++i){
-        G[i + idx_offset][i + idx_offset] = data_->W_xddot_[i];
-    }
-
-    for(int i(0); i< dim_eq_cstr_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            CE[j][i] = Aeq(i,j);
-        }
-        ce0[i] = -beq[i];
-    }
-
-    for(int i(0); i< dim_ieq_cstr_; ++i){
-        for(int j(0); j<dim_opt_; ++j){
-            CI[j][i] = Cieq(i,j);
-        }
-        ci0[i] = -dieq[i];
+        G_(i + idx_offset, i + idx_offset) = data_->W_xddot_[i];
     }
-    //printf("G:\n");
-    //std::cout<<G<<std::endl;
-    //printf("g0:\n");
-    //std::cout<<g0<<std::endl;
-
-    //printf("CE:\n");
-    //std::cout<<CE<<std::endl;
-    //printf("ce0:\n");
-    //std::cout<<ce0<<std::endl;
-
-    //printf("CI:\n");
-    //std::cout<<CI<<std::endl;
-    //printf("ci0:\n");
-    //std::cout<<ci0<<std::endl;
 }
 
 
@@ -249,10 +197,8 @@ void WBLC::MakeTorque(const std::vector<Task*> & task_list,
 
 void WBLC::_GetSolution(dynacore::Vector & cmd){
 
-    dynacore::Vector delta_qddot(num_qdot_);
-    for(int i(0); i<num_qdot_; ++i) delta_qddot[i] = z[i];
-    data_->Fr_ = dynacore::Vector(dim_rf_);
-    for(int i(0); i<dim_rf_; ++i) data_->Fr_[i] = z[i + num_qdot_];
+    dynacore::Vector delta_qddot = z_.head(num_qdot_);
+    data_->Fr_ = z_.segment(num_qdot_, dim_rf_);
 
     dynacore::Vector tau = 
         A_ * (qddot_ + delta_qddot) + cori_ + grav_ - Jc_.transpose() * data_->Fr_;
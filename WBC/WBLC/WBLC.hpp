@@ -3,7 +3,6 @@
 
 #include <WBC.hpp>
 #include <Utils/utilities.hpp>
-#include <Optimizer/Goldfarb/QuadProg++.hh>
 #include <WBDC/WBDC_ContactSpec.hpp>
 
 class WBLC_ExtraData{
@@ -12,6 +11,9 @@ class WBLC_ExtraData{
         dynacore::Vector opt_result_;
         dynacore::Vector qddot_;
         dynacore::Vector Fr_;
+        // false: no solution, not even from the fallback solver
+        // (WBC::_SolveQP), the command is from its last iterate
+        bool b_qp_converged_;
 
         // Input
         dynacore::Vector W_qddot_;
@@ -21,7 +23,7 @@ class WBLC_ExtraData{
         dynacore::Vector tau_min_;
         dynacore::Vector tau_max_;
 
-        WBLC_ExtraData(){}
+        WBLC_ExtraData(): b_qp_converged_(true){}
         ~WBLC_ExtraData(){}
 };
 
@@ -31,7 +33,7 @@ class WBLC: public WBC{
         virtual ~WBLC(){}
 
         virtual void UpdateSetting(const dynacore::Matrix & A,
-                const dynacore::Matrix & Ainv,
+                const dynacore::TreeLTL & A_ltl,
                 const dynacore::Vector & cori,
                 const dynacore::Vector & grav,
                 void* extra_setting = NULL);
@@ -52,13 +54,6 @@ class WBLC: public WBC{
     private:
         std::vector<int> act_list_;
 
-        void _OptimizationPreparation(
-                const dynacore::Matrix & Aeq, 
-                const dynacore::Vector & beq,
-                const dynacore::Matrix & Cieq,
-                const dynacore::Vector & dieq);
-
-
         void _GetSolution(dynacore::Vector & cmd);
         void _OptimizationPreparation();
 
@@ -68,18 +63,10 @@ class WBLC: public WBC{
         int dim_first_task_; // first task dimension
         WBLC_ExtraData* data_;
 
-        GolDIdnani::GVect<double> z;
+        dynacore::Vector z_;
         // Cost
-        GolDIdnani::GMatr<double> G;
-        GolDIdnani::GVect<double> g0;
-
-        // Equality
-        GolDIdnani::GMatr<double> CE;
-        GolDIdnani::GVect<double> ce0;
-
-        // Inequality
-        GolDIdnani::GMatr<double> CI;
-        GolDIdnani::GVect<double> ci0;
+        dynacore::Matrix G_;
+        dynacore::Vector g0_;
 
         int dim_rf_;
         int dim_relaxed_task_;